@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised functions for zscilib using x86-64 SSE2 or AVX.
+ *
+ * This file maps a small set of SIMD primitives onto the widest instruction
+ * set enabled at build time, for the precision selected via
+ * CONFIG_ZSL_SINGLE_PRECISION. SSE2 is part of the x86-64 baseline. AVX is
+ * used when the compiler targets it (-mavx, -mavx2 or -march=native), and
+ * fused multiply-add when FMA is also available (-mfma).
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_X86_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_X86_H_
+
+#if !defined(__x86_64__) && !defined(__i386__)
+#error "CONFIG_ZSL_PLATFORM_OPT=3 requires an x86 target"
+#endif
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <zsl/zsl.h>
+
+#if defined(__AVX__)
+#if CONFIG_ZSL_SINGLE_PRECISION
+/** SIMD register holding ZSL_X86_W zsl_real_t values. */
+typedef __m256 zsl_x86_vreal_t;
+#define ZSL_X86_W               (8U)
+#define ZSL_X86_LOAD(p)         _mm256_loadu_ps(p)
+#define ZSL_X86_STORE(p, a)     _mm256_storeu_ps(p, a)
+#define ZSL_X86_SET1(s)         _mm256_set1_ps(s)
+#define ZSL_X86_ZERO()          _mm256_setzero_ps()
+#define ZSL_X86_ADD(a, b)       _mm256_add_ps(a, b)
+#define ZSL_X86_SUB(a, b)       _mm256_sub_ps(a, b)
+#define ZSL_X86_MUL(a, b)       _mm256_mul_ps(a, b)
+#define ZSL_X86_DIV(a, b)       _mm256_div_ps(a, b)
+#define ZSL_X86_SQRT(a)         _mm256_sqrt_ps(a)
+#define ZSL_X86_MIN(a, b)       _mm256_min_ps(a, b)
+#define ZSL_X86_MAX(a, b)       _mm256_max_ps(a, b)
+#define ZSL_X86_CMPGT(a, b)     _mm256_cmp_ps(a, b, _CMP_GT_OQ)
+#define ZSL_X86_CMPGE(a, b)     _mm256_cmp_ps(a, b, _CMP_GE_OQ)
+#define ZSL_X86_CMPEQ(a, b)     _mm256_cmp_ps(a, b, _CMP_EQ_OQ)
+#define ZSL_X86_SELECT(m, a, b) _mm256_blendv_ps(b, a, m)
+#define ZSL_X86_MOVEMASK(m)     _mm256_movemask_ps(m)
+#if defined(__FMA__)
+#define ZSL_X86_FMADD(a, b, c)  _mm256_fmadd_ps(a, b, c)
+#endif
+#else
+typedef __m256d zsl_x86_vreal_t;
+#define ZSL_X86_W               (4U)
+#define ZSL_X86_LOAD(p)         _mm256_loadu_pd(p)
+#define ZSL_X86_STORE(p, a)     _mm256_storeu_pd(p, a)
+#define ZSL_X86_SET1(s)         _mm256_set1_pd(s)
+#define ZSL_X86_ZERO()          _mm256_setzero_pd()
+#define ZSL_X86_ADD(a, b)       _mm256_add_pd(a, b)
+#define ZSL_X86_SUB(a, b)       _mm256_sub_pd(a, b)
+#define ZSL_X86_MUL(a, b)       _mm256_mul_pd(a, b)
+#define ZSL_X86_DIV(a, b)       _mm256_div_pd(a, b)
+#define ZSL_X86_SQRT(a)         _mm256_sqrt_pd(a)
+#define ZSL_X86_MIN(a, b)       _mm256_min_pd(a, b)
+#define ZSL_X86_MAX(a, b)       _mm256_max_pd(a, b)
+#define ZSL_X86_CMPGT(a, b)     _mm256_cmp_pd(a, b, _CMP_GT_OQ)
+#define ZSL_X86_CMPGE(a, b)     _mm256_cmp_pd(a, b, _CMP_GE_OQ)
+#define ZSL_X86_CMPEQ(a, b)     _mm256_cmp_pd(a, b, _CMP_EQ_OQ)
+#define ZSL_X86_SELECT(m, a, b) _mm256_blendv_pd(b, a, m)
+#define ZSL_X86_MOVEMASK(m)     _mm256_movemask_pd(m)
+#if defined(__FMA__)
+#define ZSL_X86_FMADD(a, b, c)  _mm256_fmadd_pd(a, b, c)
+#endif
+#endif
+#else  /* SSE2 */
+#if CONFIG_ZSL_SINGLE_PRECISION
+typedef __m128 zsl_x86_vreal_t;
+#define ZSL_X86_W               (4U)
+#define ZSL_X86_LOAD(p)         _mm_loadu_ps(p)
+#define ZSL_X86_STORE(p, a)     _mm_storeu_ps(p, a)
+#define ZSL_X86_SET1(s)         _mm_set1_ps(s)
+#define ZSL_X86_ZERO()          _mm_setzero_ps()
+#define ZSL_X86_ADD(a, b)       _mm_add_ps(a, b)
+#define ZSL_X86_SUB(a, b)       _mm_sub_ps(a, b)
+#define ZSL_X86_MUL(a, b)       _mm_mul_ps(a, b)
+#define ZSL_X86_DIV(a, b)       _mm_div_ps(a, b)
+#define ZSL_X86_SQRT(a)         _mm_sqrt_ps(a)
+#define ZSL_X86_MIN(a, b)       _mm_min_ps(a, b)
+#define ZSL_X86_MAX(a, b)       _mm_max_ps(a, b)
+#define ZSL_X86_CMPGT(a, b)     _mm_cmpgt_ps(a, b)
+#define ZSL_X86_CMPGE(a, b)     _mm_cmpge_ps(a, b)
+#define ZSL_X86_CMPEQ(a, b)     _mm_cmpeq_ps(a, b)
+#define ZSL_X86_SELECT(m, a, b) \
+	_mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b))
+#define ZSL_X86_MOVEMASK(m)     _mm_movemask_ps(m)
+#else
+typedef __m128d zsl_x86_vreal_t;
+#define ZSL_X86_W               (2U)
+#define ZSL_X86_LOAD(p)         _mm_loadu_pd(p)
+#define ZSL_X86_STORE(p, a)     _mm_storeu_pd(p, a)
+#define ZSL_X86_SET1(s)         _mm_set1_pd(s)
+#define ZSL_X86_ZERO()          _mm_setzero_pd()
+#define ZSL_X86_ADD(a, b)       _mm_add_pd(a, b)
+#define ZSL_X86_SUB(a, b)       _mm_sub_pd(a, b)
+#define ZSL_X86_MUL(a, b)       _mm_mul_pd(a, b)
+#define ZSL_X86_DIV(a, b)       _mm_div_pd(a, b)
+#define ZSL_X86_SQRT(a)         _mm_sqrt_pd(a)
+#define ZSL_X86_MIN(a, b)       _mm_min_pd(a, b)
+#define ZSL_X86_MAX(a, b)       _mm_max_pd(a, b)
+#define ZSL_X86_CMPGT(a, b)     _mm_cmpgt_pd(a, b)
+#define ZSL_X86_CMPGE(a, b)     _mm_cmpge_pd(a, b)
+#define ZSL_X86_CMPEQ(a, b)     _mm_cmpeq_pd(a, b)
+#define ZSL_X86_SELECT(m, a, b) \
+	_mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b))
+#define ZSL_X86_MOVEMASK(m)     _mm_movemask_pd(m)
+#endif
+#endif
+
+/*
+ * The comparisons return a mask with all bits of a lane set where the
+ * condition holds. ZSL_X86_SELECT(m, a, b) takes each lane from 'a' where 'm'
+ * is set and from 'b' elsewhere, and ZSL_X86_MOVEMASK packs the top bit of
+ * each lane of a mask into an integer.
+ */
+
+/** a * b + c, fused when the target supports FMA. */
+#ifndef ZSL_X86_FMADD
+#define ZSL_X86_FMADD(a, b, c)  ZSL_X86_ADD(ZSL_X86_MUL(a, b), c)
+#endif
+
+/**
+ * @brief Returns the sum of all lanes of 'a'.
+ */
+static inline zsl_real_t
+zsl_x86_hsum(zsl_x86_vreal_t a)
+{
+	zsl_real_t lanes[ZSL_X86_W];
+	zsl_real_t sum = 0.0;
+
+	ZSL_X86_STORE(lanes, a);
+	for (size_t i = 0; i < ZSL_X86_W; i++) {
+		sum += lanes[i];
+	}
+
+	return sum;
+}
+
+/**
+ * @brief Returns true if the 'na' values at 'a' and the 'nb' values at 'b'
+ *        share any storage.
+ */
+static inline bool
+zsl_x86_overlaps(const zsl_real_t *a, size_t na, const zsl_real_t *b,
+		 size_t nb)
+{
+	return ((uintptr_t)a < (uintptr_t)(b + nb)) &&
+	       ((uintptr_t)b < (uintptr_t)(a + na));
+}
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_X86_H_ */
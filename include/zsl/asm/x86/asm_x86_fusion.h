@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised sensor fusion functions for zscilib using x86-64 SSE2 or
+ *        AVX.
+ *
+ * This file contains lane-parallel versions of the Madgwick and Mahony
+ * filters, used by zsl_fus_madg_feed_multi and zsl_fus_mahn_feed_multi to
+ * update ZSL_X86_W filters at once. Each lane follows the same steps as the
+ * scalar code in madgwick.c and mahony.c, with the branches on invalid
+ * accelerometer or magnetometer samples replaced by per-lane masks.
+ */
+
+#include <stdbool.h>
+#include <zsl/zsl.h>
+#include <zsl/asm/x86/asm_x86.h>
+#include <zsl/orientation/fusion/fusion.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_X86_FUSION_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_X86_FUSION_H_
+
+#if CONFIG_ZSL_PLATFORM_OPT == 3
+
+/**
+ * @brief Normalises the ZSL_X86_W quaternions in 'q' (r, i, j, k).
+ */
+static inline void
+zsl_x86_fus_quat_to_unit(zsl_x86_vreal_t *q)
+{
+	zsl_x86_vreal_t n;
+
+	n = ZSL_X86_MUL(q[0], q[0]);
+	n = ZSL_X86_FMADD(q[1], q[1], n);
+	n = ZSL_X86_FMADD(q[2], q[2], n);
+	n = ZSL_X86_FMADD(q[3], q[3], n);
+	n = ZSL_X86_SQRT(n);
+
+	for (size_t i = 0; i < 4; i++) {
+		q[i] = ZSL_X86_DIV(q[i], n);
+	}
+}
+
+/**
+ * @brief Normalises the ZSL_X86_W vectors in 'v' (x, y, z) in the lanes set
+ *        in the returned mask, which are those whose norm is greater than
+ *        'min', or not less than 'min' if 'ge' is true.
+ */
+static inline zsl_x86_vreal_t
+zsl_x86_fus_vec_to_unit(zsl_x86_vreal_t *v, zsl_real_t min, bool ge)
+{
+	zsl_x86_vreal_t n, mask;
+
+	n = ZSL_X86_MUL(v[0], v[0]);
+	n = ZSL_X86_FMADD(v[1], v[1], n);
+	n = ZSL_X86_FMADD(v[2], v[2], n);
+	n = ZSL_X86_SQRT(n);
+
+	mask = ge ? ZSL_X86_CMPGE(n, ZSL_X86_SET1(min)) :
+	       ZSL_X86_CMPGT(n, ZSL_X86_SET1(min));
+
+	/* Leave the other lanes unchanged, rather than dividing by zero. */
+	n = ZSL_X86_SELECT(mask, n, ZSL_X86_SET1(1.0));
+	for (size_t i = 0; i < 3; i++) {
+		v[i] = ZSL_X86_DIV(v[i], n);
+	}
+
+	return mask;
+}
+
+/**
+ * @brief Fills 'r' with the rotation matrices, row by row, of the unit
+ *        quaternions in 'q'.
+ */
+static inline void
+zsl_x86_fus_rot_mtx(const zsl_x86_vreal_t *q, zsl_x86_vreal_t *r)
+{
+	zsl_x86_vreal_t two = ZSL_X86_SET1(2.0);
+	zsl_x86_vreal_t rr = ZSL_X86_MUL(q[0], q[0]);
+	zsl_x86_vreal_t ii = ZSL_X86_MUL(q[1], q[1]);
+	zsl_x86_vreal_t jj = ZSL_X86_MUL(q[2], q[2]);
+	zsl_x86_vreal_t kk = ZSL_X86_MUL(q[3], q[3]);
+	zsl_x86_vreal_t ij = ZSL_X86_MUL(q[1], q[2]);
+	zsl_x86_vreal_t ik = ZSL_X86_MUL(q[1], q[3]);
+	zsl_x86_vreal_t jk = ZSL_X86_MUL(q[2], q[3]);
+	zsl_x86_vreal_t ri = ZSL_X86_MUL(q[0], q[1]);
+	zsl_x86_vreal_t rj = ZSL_X86_MUL(q[0], q[2]);
+	zsl_x86_vreal_t rk = ZSL_X86_MUL(q[0], q[3]);
+
+	r[0] = ZSL_X86_SUB(ZSL_X86_SUB(ZSL_X86_ADD(rr, ii), jj), kk);
+	r[1] = ZSL_X86_MUL(two, ZSL_X86_SUB(ij, rk));
+	r[2] = ZSL_X86_MUL(two, ZSL_X86_ADD(ik, rj));
+	r[3] = ZSL_X86_MUL(two, ZSL_X86_ADD(ij, rk));
+	r[4] = ZSL_X86_SUB(ZSL_X86_ADD(ZSL_X86_SUB(rr, ii), jj), kk);
+	r[5] = ZSL_X86_MUL(two, ZSL_X86_SUB(jk, ri));
+	r[6] = ZSL_X86_MUL(two, ZSL_X86_SUB(ik, rj));
+	r[7] = ZSL_X86_MUL(two, ZSL_X86_ADD(jk, ri));
+	r[8] = ZSL_X86_ADD(ZSL_X86_SUB(ZSL_X86_SUB(rr, ii), jj), kk);
+}
+
+/**
+ * @brief Sets 'v' to r * (x, y, z) for the rotation matrices in 'r'.
+ */
+static inline void
+zsl_x86_fus_rot_vec(const zsl_x86_vreal_t *r, zsl_x86_vreal_t x,
+		    zsl_x86_vreal_t y, zsl_x86_vreal_t z, zsl_x86_vreal_t *v)
+{
+	for (size_t i = 0; i < 3; i++) {
+		v[i] = ZSL_X86_MUL(r[i * 3], x);
+		v[i] = ZSL_X86_FMADD(r[i * 3 + 1], y, v[i]);
+		v[i] = ZSL_X86_FMADD(r[i * 3 + 2], z, v[i]);
+	}
+}
+
+/**
+ * @brief Sets (bx, bz) to the horizontal and vertical components of the
+ *        unit magnetic field 'mg' in the earth's frame, or to the constants
+ *        'cbx' and 'cbz' derived from the inclination if 'incl' is true.
+ */
+static inline void
+zsl_x86_fus_mag_ref(const zsl_x86_vreal_t *r, const zsl_x86_vreal_t *mg,
+		    bool incl, zsl_real_t cbx, zsl_real_t cbz,
+		    zsl_x86_vreal_t *bx, zsl_x86_vreal_t *bz)
+{
+	zsl_x86_vreal_t h[3];
+
+	if (incl) {
+		*bx = ZSL_X86_SET1(cbx);
+		*bz = ZSL_X86_SET1(cbz);
+		return;
+	}
+
+	zsl_x86_fus_rot_vec(r, mg[0], mg[1], mg[2], h);
+	*bx = ZSL_X86_SQRT(ZSL_X86_FMADD(h[1], h[1], ZSL_X86_MUL(h[0], h[0])));
+	*bz = h[2];
+}
+
+/**
+ * @brief Integrates the angular velocities in 'g' over 'dt' into the unit
+ *        quaternions 'q', as zsl_quat_from_ang_vel does.
+ */
+static inline void
+zsl_x86_fus_integrate(zsl_x86_vreal_t *q, const zsl_x86_vreal_t *g,
+		      zsl_real_t dt)
+{
+	zsl_x86_vreal_t h = ZSL_X86_SET1(0.5 * dt);
+	zsl_x86_vreal_t w[4];
+
+	w[0] = ZSL_X86_SUB(ZSL_X86_ZERO(), ZSL_X86_MUL(g[0], q[1]));
+	w[0] = ZSL_X86_SUB(w[0], ZSL_X86_MUL(g[1], q[2]));
+	w[0] = ZSL_X86_SUB(w[0], ZSL_X86_MUL(g[2], q[3]));
+	w[1] = ZSL_X86_MUL(g[0], q[0]);
+	w[1] = ZSL_X86_FMADD(g[1], q[3], w[1]);
+	w[1] = ZSL_X86_SUB(w[1], ZSL_X86_MUL(g[2], q[2]));
+	w[2] = ZSL_X86_MUL(g[1], q[0]);
+	w[2] = ZSL_X86_SUB(w[2], ZSL_X86_MUL(g[0], q[3]));
+	w[2] = ZSL_X86_FMADD(g[2], q[1], w[2]);
+	w[3] = ZSL_X86_MUL(g[0], q[2]);
+	w[3] = ZSL_X86_SUB(w[3], ZSL_X86_MUL(g[1], q[1]));
+	w[3] = ZSL_X86_FMADD(g[2], q[0], w[3]);
+
+	for (size_t i = 0; i < 4; i++) {
+		q[i] = ZSL_X86_FMADD(h, w[i], q[i]);
+	}
+
+	zsl_x86_fus_quat_to_unit(q);
+}
+
+/**
+ * @brief Updates Madgwick filters l to l + ZSL_X86_W - 1 of a call to
+ *        zsl_fus_madg_feed_multi.
+ */
+static inline void
+zsl_x86_fus_madg(size_t l, const struct zsl_fus_vec_soa *a,
+		 const struct zsl_fus_vec_soa *m,
+		 const struct zsl_fus_vec_soa *g, bool incl, zsl_real_t cbx,
+		 zsl_real_t cbz, zsl_real_t beta, zsl_real_t dt,
+		 struct zsl_fus_quat_soa *q)
+{
+	zsl_x86_vreal_t zero = ZSL_X86_ZERO();
+	zsl_x86_vreal_t two = ZSL_X86_SET1(2.0);
+	zsl_x86_vreal_t four = ZSL_X86_SET1(4.0);
+	zsl_x86_vreal_t qv[4], av[3], mv[3], gv[3], r[9], f[3], s[4], t[4];
+	zsl_x86_vreal_t mask_a, mask_m, bx, bz, n;
+
+	qv[0] = ZSL_X86_LOAD(&q->r[l]);
+	qv[1] = ZSL_X86_LOAD(&q->i[l]);
+	qv[2] = ZSL_X86_LOAD(&q->j[l]);
+	qv[3] = ZSL_X86_LOAD(&q->k[l]);
+	zsl_x86_fus_quat_to_unit(qv);
+
+	for (size_t i = 0; i < 4; i++) {
+		s[i] = zero;
+	}
+
+	if (a != NULL) {
+		av[0] = ZSL_X86_LOAD(&a->x[l]);
+		av[1] = ZSL_X86_LOAD(&a->y[l]);
+		av[2] = ZSL_X86_LOAD(&a->z[l]);
+		mask_a = zsl_x86_fus_vec_to_unit(av, 1E-6, false);
+	} else {
+		mask_a = zero;
+	}
+
+	if (ZSL_X86_MOVEMASK(mask_a)) {
+		zsl_x86_fus_rot_mtx(qv, r);
+
+		/* Gradient of f_g, for the vertical rotated by q. */
+		f[0] = ZSL_X86_SUB(r[2], av[0]);
+		f[1] = ZSL_X86_SUB(r[5], av[1]);
+		f[2] = ZSL_X86_SUB(r[8], av[2]);
+		s[0] = ZSL_X86_SUB(ZSL_X86_MUL(ZSL_X86_MUL(two, qv[1]), f[1]),
+				   ZSL_X86_MUL(ZSL_X86_MUL(two, qv[2]), f[0]));
+		s[1] = ZSL_X86_MUL(ZSL_X86_MUL(two, qv[3]), f[0]);
+		s[1] = ZSL_X86_FMADD(ZSL_X86_MUL(two, qv[0]), f[1], s[1]);
+		s[1] = ZSL_X86_SUB(s[1], ZSL_X86_MUL(ZSL_X86_MUL(four, qv[1]), f[2]));
+		s[2] = ZSL_X86_MUL(ZSL_X86_MUL(two, qv[3]), f[1]);
+		s[2] = ZSL_X86_SUB(s[2], ZSL_X86_MUL(ZSL_X86_MUL(two, qv[0]), f[0]));
+		s[2] = ZSL_X86_SUB(s[2], ZSL_X86_MUL(ZSL_X86_MUL(four, qv[2]), f[2]));
+		s[3] = ZSL_X86_MUL(ZSL_X86_MUL(two, qv[1]), f[0]);
+		s[3] = ZSL_X86_FMADD(ZSL_X86_MUL(two, qv[2]), f[1], s[3]);
+
+		if (m != NULL) {
+			mv[0] = ZSL_X86_LOAD(&m->x[l]);
+			mv[1] = ZSL_X86_LOAD(&m->y[l]);
+			mv[2] = ZSL_X86_LOAD(&m->z[l]);
+			mask_m = zsl_x86_fus_vec_to_unit(mv, 1E-6, true);
+		} else {
+			mask_m = zero;
+		}
+
+		if (ZSL_X86_MOVEMASK(mask_m)) {
+			zsl_x86_vreal_t bx2, bz2;
+
+			zsl_x86_fus_mag_ref(r, mv, incl, cbx, cbz, &bx, &bz);
+			bx2 = ZSL_X86_MUL(two, bx);
+			bz2 = ZSL_X86_MUL(two, bz);
+
+			/* Gradient of f_b, for the field (bx, 0, bz) rotated
+			 * by q. */
+			for (size_t i = 0; i < 3; i++) {
+				f[i] = ZSL_X86_MUL(bx, r[i * 3]);
+				f[i] = ZSL_X86_FMADD(bz, r[i * 3 + 2], f[i]);
+				f[i] = ZSL_X86_SUB(f[i], mv[i]);
+			}
+
+			t[0] = ZSL_X86_SUB(ZSL_X86_MUL(bz2, qv[1]),
+					   ZSL_X86_MUL(bx2, qv[3]));
+			t[0] = ZSL_X86_MUL(t[0], f[1]);
+			t[0] = ZSL_X86_SUB(t[0], ZSL_X86_MUL(ZSL_X86_MUL(bz2, qv[2]),
+							     f[0]));
+			t[0] = ZSL_X86_FMADD(ZSL_X86_MUL(bx2, qv[2]), f[2], t[0]);
+
+			t[1] = ZSL_X86_MUL(ZSL_X86_MUL(bz2, qv[3]), f[0]);
+			t[1] = ZSL_X86_FMADD(ZSL_X86_MUL(bz2,
+							 ZSL_X86_ADD(qv[2], qv[0])),
+					     f[1], t[1]);
+			t[1] = ZSL_X86_FMADD(ZSL_X86_SUB(ZSL_X86_MUL(bx2, qv[3]),
+							 ZSL_X86_MUL(ZSL_X86_MUL(two, bz2),
+								     qv[1])),
+					     f[2], t[1]);
+
+			t[2] = ZSL_X86_SUB(ZSL_X86_ZERO(),
+					   ZSL_X86_ADD(ZSL_X86_MUL(ZSL_X86_MUL(two, bx2),
+								   qv[2]),
+						       ZSL_X86_MUL(bz2, qv[0])));
+			t[2] = ZSL_X86_MUL(t[2], f[0]);
+			t[2] = ZSL_X86_FMADD(ZSL_X86_SUB(ZSL_X86_MUL(bx2, qv[1]),
+							 ZSL_X86_MUL(bz2, qv[3])),
+					     f[1], t[2]);
+			t[2] = ZSL_X86_FMADD(ZSL_X86_SUB(ZSL_X86_MUL(bx2, qv[0]),
+							 ZSL_X86_MUL(bz2, qv[2])),
+					     f[2], t[2]);
+
+			t[3] = ZSL_X86_SUB(ZSL_X86_MUL(bz2, qv[1]),
+					   ZSL_X86_MUL(ZSL_X86_MUL(two, bx2), qv[3]));
+			t[3] = ZSL_X86_MUL(t[3], f[0]);
+			t[3] = ZSL_X86_FMADD(ZSL_X86_SUB(ZSL_X86_MUL(bz2, qv[2]),
+							 ZSL_X86_MUL(bx2, qv[0])),
+					     f[1], t[3]);
+			t[3] = ZSL_X86_FMADD(ZSL_X86_MUL(bx2, qv[1]), f[2], t[3]);
+
+			for (size_t i = 0; i < 4; i++) {
+				s[i] = ZSL_X86_ADD(s[i],
+						   ZSL_X86_SELECT(mask_m, t[i], zero));
+			}
+		}
+
+		/* Normalize the gradient, as zsl_vec_to_unit does, which sets
+		 * a zero gradient to (1, 0, 0, 0). */
+		n = ZSL_X86_MUL(s[0], s[0]);
+		for (size_t i = 1; i < 4; i++) {
+			n = ZSL_X86_FMADD(s[i], s[i], n);
+		}
+		n = ZSL_X86_SQRT(n);
+		mask_m = ZSL_X86_CMPEQ(n, zero);
+		n = ZSL_X86_SELECT(mask_m, ZSL_X86_SET1(1.0), n);
+		for (size_t i = 0; i < 4; i++) {
+			s[i] = ZSL_X86_DIV(s[i], n);
+		}
+		s[0] = ZSL_X86_SELECT(mask_m, ZSL_X86_SET1(1.0), s[0]);
+
+		/* Lanes without a valid accelerometer sample have no
+		 * gradient. */
+		for (size_t i = 0; i < 4; i++) {
+			s[i] = ZSL_X86_SELECT(mask_a, s[i], zero);
+		}
+	}
+
+	gv[0] = ZSL_X86_LOAD(&g->x[l]);
+	gv[1] = ZSL_X86_LOAD(&g->y[l]);
+	gv[2] = ZSL_X86_LOAD(&g->z[l]);
+	zsl_x86_fus_integrate(qv, gv, dt);
+
+	/* Apply the gradient descent step and normalize the output. */
+	n = ZSL_X86_SET1(dt * beta);
+	for (size_t i = 0; i < 4; i++) {
+		qv[i] = ZSL_X86_SUB(qv[i], ZSL_X86_MUL(n, s[i]));
+	}
+	zsl_x86_fus_quat_to_unit(qv);
+
+	ZSL_X86_STORE(&q->r[l], qv[0]);
+	ZSL_X86_STORE(&q->i[l], qv[1]);
+	ZSL_X86_STORE(&q->j[l], qv[2]);
+	ZSL_X86_STORE(&q->k[l], qv[3]);
+}
+
+/**
+ * @brief Updates Mahony filters l to l + ZSL_X86_W - 1 of a call to
+ *        zsl_fus_mahn_feed_multi.
+ */
+static inline void
+zsl_x86_fus_mahn(size_t l, const struct zsl_fus_vec_soa *a,
+		 const struct zsl_fus_vec_soa *m,
+		 const struct zsl_fus_vec_soa *g, bool incl, zsl_real_t cbx,
+		 zsl_real_t cbz, zsl_real_t kp, zsl_real_t ki, zsl_real_t lim,
+		 zsl_real_t dt, struct zsl_fus_vec_soa *intfb,
+		 struct zsl_fus_quat_soa *q)
+{
+	zsl_x86_vreal_t zero = ZSL_X86_ZERO();
+	zsl_x86_vreal_t qv[4], av[3], mv[3], gv[3], r[9], v[3], e[3], fb[3];
+	zsl_x86_vreal_t mask_a, mask_m, bx, bz;
+
+	qv[0] = ZSL_X86_LOAD(&q->r[l]);
+	qv[1] = ZSL_X86_LOAD(&q->i[l]);
+	qv[2] = ZSL_X86_LOAD(&q->j[l]);
+	qv[3] = ZSL_X86_LOAD(&q->k[l]);
+	zsl_x86_fus_quat_to_unit(qv);
+
+	gv[0] = ZSL_X86_LOAD(&g->x[l]);
+	gv[1] = ZSL_X86_LOAD(&g->y[l]);
+	gv[2] = ZSL_X86_LOAD(&g->z[l]);
+
+	if (a != NULL) {
+		av[0] = ZSL_X86_LOAD(&a->x[l]);
+		av[1] = ZSL_X86_LOAD(&a->y[l]);
+		av[2] = ZSL_X86_LOAD(&a->z[l]);
+		mask_a = zsl_x86_fus_vec_to_unit(av, 1E-6, false);
+	} else {
+		mask_a = zero;
+	}
+
+	if (ZSL_X86_MOVEMASK(mask_a)) {
+		zsl_x86_fus_rot_mtx(qv, r);
+
+		/* Gravity error: a x v, for the vertical 'v' rotated by q. */
+		e[0] = ZSL_X86_SUB(ZSL_X86_MUL(av[1], r[8]),
+				   ZSL_X86_MUL(av[2], r[5]));
+		e[1] = ZSL_X86_SUB(ZSL_X86_MUL(av[2], r[2]),
+				   ZSL_X86_MUL(av[0], r[8]));
+		e[2] = ZSL_X86_SUB(ZSL_X86_MUL(av[0], r[5]),
+				   ZSL_X86_MUL(av[1], r[2]));
+
+		if (m != NULL) {
+			mv[0] = ZSL_X86_LOAD(&m->x[l]);
+			mv[1] = ZSL_X86_LOAD(&m->y[l]);
+			mv[2] = ZSL_X86_LOAD(&m->z[l]);
+			mask_m = zsl_x86_fus_vec_to_unit(mv, 1E-6, true);
+		} else {
+			mask_m = zero;
+		}
+
+		if (ZSL_X86_MOVEMASK(mask_m)) {
+			zsl_x86_fus_mag_ref(r, mv, incl, cbx, cbz, &bx, &bz);
+
+			/* Magnetic error: m x bf, for the field (bx, 0, bz)
+			 * rotated by q. */
+			for (size_t i = 0; i < 3; i++) {
+				v[i] = ZSL_X86_MUL(bx, r[i * 3]);
+				v[i] = ZSL_X86_FMADD(bz, r[i * 3 + 2], v[i]);
+			}
+
+			fb[0] = ZSL_X86_SUB(ZSL_X86_MUL(mv[1], v[2]),
+					    ZSL_X86_MUL(mv[2], v[1]));
+			fb[1] = ZSL_X86_SUB(ZSL_X86_MUL(mv[2], v[0]),
+					    ZSL_X86_MUL(mv[0], v[2]));
+			fb[2] = ZSL_X86_SUB(ZSL_X86_MUL(mv[0], v[1]),
+					    ZSL_X86_MUL(mv[1], v[0]));
+
+			for (size_t i = 0; i < 3; i++) {
+				e[i] = ZSL_X86_ADD(e[i],
+						   ZSL_X86_SELECT(mask_m, fb[i], zero));
+			}
+		}
+
+		/* Compute and limit the integral feedback, which only changes
+		 * in lanes with a valid accelerometer sample. */
+		fb[0] = ZSL_X86_LOAD(&intfb->x[l]);
+		fb[1] = ZSL_X86_LOAD(&intfb->y[l]);
+		fb[2] = ZSL_X86_LOAD(&intfb->z[l]);
+
+		for (size_t i = 0; i < 3; i++) {
+			v[i] = ZSL_X86_FMADD(e[i], ZSL_X86_SET1(dt), fb[i]);
+			v[i] = ZSL_X86_MIN(v[i], ZSL_X86_SET1(lim));
+			v[i] = ZSL_X86_MAX(v[i], ZSL_X86_SET1(-lim));
+			fb[i] = ZSL_X86_SELECT(mask_a, v[i], fb[i]);
+
+			/* Apply the integral and proportional feedback. */
+			v[i] = ZSL_X86_FMADD(ZSL_X86_SET1(ki), fb[i], gv[i]);
+			v[i] = ZSL_X86_FMADD(ZSL_X86_SET1(kp), e[i], v[i]);
+			gv[i] = ZSL_X86_SELECT(mask_a, v[i], gv[i]);
+		}
+
+		ZSL_X86_STORE(&intfb->x[l], fb[0]);
+		ZSL_X86_STORE(&intfb->y[l], fb[1]);
+		ZSL_X86_STORE(&intfb->z[l], fb[2]);
+	}
+
+	zsl_x86_fus_integrate(qv, gv, dt);
+
+	ZSL_X86_STORE(&q->r[l], qv[0]);
+	ZSL_X86_STORE(&q->i[l], qv[1]);
+	ZSL_X86_STORE(&q->j[l], qv[2]);
+	ZSL_X86_STORE(&q->k[l], qv[3]);
+}
+
+#endif /* CONFIG_ZSL_PLATFORM_OPT == 3 */
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_X86_FUSION_H_ */
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised matrix functions for zscilib using x86-64 SSE2 or AVX.
+ *
+ * This file contains optimised matrix functions for x86-64 SSE2 or AVX.
+ */
+
+#include <zsl/zsl.h>
+#include <zsl/matrices.h>
+#include <zsl/asm/x86/asm_x86.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_X86_MATRICES_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_X86_MATRICES_H_
+
+#if CONFIG_ZSL_PLATFORM_OPT == 3
+
+#if !asm_mtx_add
+int
+zsl_mtx_add(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
+{
+	size_t n = ma->sz_rows * ma->sz_cols;
+	size_t i = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((ma->sz_rows != mb->sz_rows) || (mb->sz_rows != mc->sz_rows) ||
+	    (ma->sz_cols != mb->sz_cols) || (mb->sz_cols != mc->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (; i + ZSL_X86_W <= n; i += ZSL_X86_W) {
+		ZSL_X86_STORE(&mc->data[i],
+			      ZSL_X86_ADD(ZSL_X86_LOAD(&ma->data[i]),
+					  ZSL_X86_LOAD(&mb->data[i])));
+	}
+	for (; i < n; i++) {
+		mc->data[i] = ma->data[i] + mb->data[i];
+	}
+
+	return 0;
+}
+#define asm_mtx_add 1
+#endif
+
+#if !asm_mtx_mult
+int
+zsl_mtx_mult(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
+{
+	size_t m = ma->sz_rows;
+	size_t k = ma->sz_cols;
+	size_t n = mb->sz_cols;
+	size_t j;
+	zsl_x86_vreal_t av, c0, c1, c2, c3;
+	zsl_real_t sum;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that ma has the same number as columns as mb has rows. */
+	if (ma->sz_cols != mb->sz_rows) {
+		return -EINVAL;
+	}
+
+	/* Ensure that mc has ma rows and mb cols */
+	if ((mc->sz_rows != ma->sz_rows) || (mc->sz_cols != mb->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Rows of mc are written while ma and mb are still being read, so
+	 * leave aliased operands to the generic kernel, which copies them. */
+	if (zsl_x86_overlaps(ma->data, m * k, mc->data, m * n) ||
+	    zsl_x86_overlaps(mb->data, k * n, mc->data, m * n)) {
+		return zsl_mtx_gemm(false, false, 1.0, ma, mb, 0.0, mc);
+	}
+
+	/* Each row of mc is a linear combination of the rows of mb, so
+	 * broadcast ma[i][p] and stream row p of mb, four registers at a
+	 * time. */
+	for (size_t i = 0; i < m; i++) {
+		const zsl_real_t *a = &ma->data[i * k];
+		zsl_real_t *c = &mc->data[i * n];
+
+		for (j = 0; j + (4 * ZSL_X86_W) <= n; j += 4 * ZSL_X86_W) {
+			const zsl_real_t *b = &mb->data[j];
+
+			c0 = ZSL_X86_ZERO();
+			c1 = ZSL_X86_ZERO();
+			c2 = ZSL_X86_ZERO();
+			c3 = ZSL_X86_ZERO();
+			for (size_t p = 0; p < k; p++, b += n) {
+				av = ZSL_X86_SET1(a[p]);
+				c0 = ZSL_X86_FMADD(av, ZSL_X86_LOAD(b), c0);
+				c1 = ZSL_X86_FMADD(av,
+						   ZSL_X86_LOAD(b + ZSL_X86_W),
+						   c1);
+				c2 = ZSL_X86_FMADD(av,
+						   ZSL_X86_LOAD(b + 2 * ZSL_X86_W),
+						   c2);
+				c3 = ZSL_X86_FMADD(av,
+						   ZSL_X86_LOAD(b + 3 * ZSL_X86_W),
+						   c3);
+			}
+			ZSL_X86_STORE(&c[j], c0);
+			ZSL_X86_STORE(&c[j + ZSL_X86_W], c1);
+			ZSL_X86_STORE(&c[j + 2 * ZSL_X86_W], c2);
+			ZSL_X86_STORE(&c[j + 3 * ZSL_X86_W], c3);
+		}
+
+		for (; j + ZSL_X86_W <= n; j += ZSL_X86_W) {
+			const zsl_real_t *b = &mb->data[j];
+
+			c0 = ZSL_X86_ZERO();
+			for (size_t p = 0; p < k; p++, b += n) {
+				c0 = ZSL_X86_FMADD(ZSL_X86_SET1(a[p]),
+						   ZSL_X86_LOAD(b), c0);
+			}
+			ZSL_X86_STORE(&c[j], c0);
+		}
+
+		for (; j < n; j++) {
+			sum = 0.0;
+			for (size_t p = 0; p < k; p++) {
+				sum += a[p] * mb->data[(p * n) + j];
+			}
+			c[j] = sum;
+		}
+	}
+
+	return 0;
+}
+#define asm_mtx_mult 1
+#endif
+
+#if !asm_mtx_trans
+int
+zsl_mtx_trans(struct zsl_mtx *ma, struct zsl_mtx *mb)
+{
+	size_t m = ma->sz_rows;
+	size_t n = ma->sz_cols;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Ensure that ma and mb have the same shape. */
+	if ((ma->sz_rows != mb->sz_cols) || (ma->sz_cols != mb->sz_rows)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Work from a copy of ma if it shares storage with mb. */
+	bool alias = zsl_x86_overlaps(ma->data, m * n, mb->data, m * n);
+	zsl_real_t copy[alias ? (m * n) : 1];
+	const zsl_real_t *a = ma->data;
+	zsl_real_t *b = mb->data;
+	size_t i = 0;
+	size_t j;
+
+	if (alias) {
+		memcpy(copy, ma->data, (m * n) * sizeof(zsl_real_t));
+		a = copy;
+	}
+
+	/* Transpose in square blocks held in SSE registers: 4x4 for float,
+	 * 2x2 for double. */
+#if CONFIG_ZSL_SINGLE_PRECISION
+	for (; i + 4 <= m; i += 4) {
+		for (j = 0; j + 4 <= n; j += 4) {
+			__m128 r0 = _mm_loadu_ps(&a[(i * n) + j]);
+			__m128 r1 = _mm_loadu_ps(&a[((i + 1) * n) + j]);
+			__m128 r2 = _mm_loadu_ps(&a[((i + 2) * n) + j]);
+			__m128 r3 = _mm_loadu_ps(&a[((i + 3) * n) + j]);
+
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			_mm_storeu_ps(&b[(j * m) + i], r0);
+			_mm_storeu_ps(&b[((j + 1) * m) + i], r1);
+			_mm_storeu_ps(&b[((j + 2) * m) + i], r2);
+			_mm_storeu_ps(&b[((j + 3) * m) + i], r3);
+		}
+		for (; j < n; j++) {
+			for (size_t r = i; r < i + 4; r++) {
+				b[(j * m) + r] = a[(r * n) + j];
+			}
+		}
+	}
+#else
+	for (; i + 2 <= m; i += 2) {
+		for (j = 0; j + 2 <= n; j += 2) {
+			__m128d r0 = _mm_loadu_pd(&a[(i * n) + j]);
+			__m128d r1 = _mm_loadu_pd(&a[((i + 1) * n) + j]);
+
+			_mm_storeu_pd(&b[(j * m) + i], _mm_unpacklo_pd(r0, r1));
+			_mm_storeu_pd(&b[((j + 1) * m) + i],
+				      _mm_unpackhi_pd(r0, r1));
+		}
+		for (; j < n; j++) {
+			b[(j * m) + i] = a[(i * n) + j];
+			b[(j * m) + i + 1] = a[((i + 1) * n) + j];
+		}
+	}
+#endif
+
+	/* Remaining rows. */
+	for (; i < m; i++) {
+		for (j = 0; j < n; j++) {
+			b[(j * m) + i] = a[(i * n) + j];
+		}
+	}
+
+	return 0;
+}
+#define asm_mtx_trans 1
+#endif
+
+#endif /* CONFIG_ZSL_PLATFORM_OPT == 3 */
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_X86_MATRICES_H_ */
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised quaternion functions for zscilib using x86-64 SSE2 or AVX.
+ *
+ * This file contains the kernel of zsl_quat_mult_n, which multiplies
+ * ZSL_X86_W pairs of quaternions at once. The components of each quaternion
+ * are interleaved in memory, so each block is first transposed in registers
+ * to one register per component.
+ */
+
+#include <zsl/zsl.h>
+#include <zsl/asm/x86/asm_x86.h>
+#include <zsl/orientation/quaternions.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_X86_QUATERNIONS_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_X86_QUATERNIONS_H_
+
+#if CONFIG_ZSL_PLATFORM_OPT == 3
+
+/**
+ * @brief Loads the ZSL_X86_W quaternions at 'q' into one register per
+ *        component (r, i, j, k), transposing them in registers.
+ */
+static inline void
+zsl_x86_quat_load(const struct zsl_quat *q, zsl_x86_vreal_t *v)
+{
+	const zsl_real_t *p = q->idx;
+
+#if defined(__AVX__) && CONFIG_ZSL_SINGLE_PRECISION
+	/* Quaternions l and l + 4 share a register, one in each 128-bit
+	 * lane, and each lane is transposed on its own. */
+	__m256 a0 = _mm256_insertf128_ps(
+		_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 16), 1);
+	__m256 a1 = _mm256_insertf128_ps(
+		_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 20), 1);
+	__m256 a2 = _mm256_insertf128_ps(
+		_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 24), 1);
+	__m256 a3 = _mm256_insertf128_ps(
+		_mm256_castps128_ps256(_mm_loadu_ps(p + 12)), _mm_loadu_ps(p + 28), 1);
+	__m256 t0 = _mm256_unpacklo_ps(a0, a1);
+	__m256 t1 = _mm256_unpackhi_ps(a0, a1);
+	__m256 t2 = _mm256_unpacklo_ps(a2, a3);
+	__m256 t3 = _mm256_unpackhi_ps(a2, a3);
+
+	v[0] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+	v[1] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+	v[2] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+	v[3] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+#elif defined(__AVX__)
+	/* Quaternions l and l + 2 share a register, one in each 128-bit
+	 * lane, and are split as for SSE2 below. */
+	__m256d ri0 = _mm256_insertf128_pd(
+		_mm256_castpd128_pd256(_mm_loadu_pd(p)), _mm_loadu_pd(p + 8), 1);
+	__m256d jk0 = _mm256_insertf128_pd(
+		_mm256_castpd128_pd256(_mm_loadu_pd(p + 2)), _mm_loadu_pd(p + 10), 1);
+	__m256d ri1 = _mm256_insertf128_pd(
+		_mm256_castpd128_pd256(_mm_loadu_pd(p + 4)), _mm_loadu_pd(p + 12), 1);
+	__m256d jk1 = _mm256_insertf128_pd(
+		_mm256_castpd128_pd256(_mm_loadu_pd(p + 6)), _mm_loadu_pd(p + 14), 1);
+
+	v[0] = _mm256_unpacklo_pd(ri0, ri1);
+	v[1] = _mm256_unpackhi_pd(ri0, ri1);
+	v[2] = _mm256_unpacklo_pd(jk0, jk1);
+	v[3] = _mm256_unpackhi_pd(jk0, jk1);
+#elif CONFIG_ZSL_SINGLE_PRECISION
+	v[0] = _mm_loadu_ps(p);
+	v[1] = _mm_loadu_ps(p + 4);
+	v[2] = _mm_loadu_ps(p + 8);
+	v[3] = _mm_loadu_ps(p + 12);
+	_MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+#else
+	/* Each quaternion is split over two registers, (r, i) and (j, k). */
+	__m128d ri0 = _mm_loadu_pd(p);
+	__m128d jk0 = _mm_loadu_pd(p + 2);
+	__m128d ri1 = _mm_loadu_pd(p + 4);
+	__m128d jk1 = _mm_loadu_pd(p + 6);
+
+	v[0] = _mm_unpacklo_pd(ri0, ri1);
+	v[1] = _mm_unpackhi_pd(ri0, ri1);
+	v[2] = _mm_unpacklo_pd(jk0, jk1);
+	v[3] = _mm_unpackhi_pd(jk0, jk1);
+#endif
+}
+
+/**
+ * @brief Stores the components in 'v', as loaded by zsl_x86_quat_load, to
+ *        the ZSL_X86_W quaternions at 'q'.
+ */
+static inline void
+zsl_x86_quat_store(struct zsl_quat *q, const zsl_x86_vreal_t *v)
+{
+	zsl_real_t *p = q->idx;
+
+#if defined(__AVX__) && CONFIG_ZSL_SINGLE_PRECISION
+	__m256 t0 = _mm256_unpacklo_ps(v[0], v[1]);
+	__m256 t1 = _mm256_unpackhi_ps(v[0], v[1]);
+	__m256 t2 = _mm256_unpacklo_ps(v[2], v[3]);
+	__m256 t3 = _mm256_unpackhi_ps(v[2], v[3]);
+	__m256 a0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 a1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+	__m256 a2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 a3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+	_mm_storeu_ps(p, _mm256_castps256_ps128(a0));
+	_mm_storeu_ps(p + 4, _mm256_castps256_ps128(a1));
+	_mm_storeu_ps(p + 8, _mm256_castps256_ps128(a2));
+	_mm_storeu_ps(p + 12, _mm256_castps256_ps128(a3));
+	_mm_storeu_ps(p + 16, _mm256_extractf128_ps(a0, 1));
+	_mm_storeu_ps(p + 20, _mm256_extractf128_ps(a1, 1));
+	_mm_storeu_ps(p + 24, _mm256_extractf128_ps(a2, 1));
+	_mm_storeu_ps(p + 28, _mm256_extractf128_ps(a3, 1));
+#elif defined(__AVX__)
+	__m256d ri0 = _mm256_unpacklo_pd(v[0], v[1]);
+	__m256d ri1 = _mm256_unpackhi_pd(v[0], v[1]);
+	__m256d jk0 = _mm256_unpacklo_pd(v[2], v[3]);
+	__m256d jk1 = _mm256_unpackhi_pd(v[2], v[3]);
+
+	_mm_storeu_pd(p, _mm256_castpd256_pd128(ri0));
+	_mm_storeu_pd(p + 2, _mm256_castpd256_pd128(jk0));
+	_mm_storeu_pd(p + 4, _mm256_castpd256_pd128(ri1));
+	_mm_storeu_pd(p + 6, _mm256_castpd256_pd128(jk1));
+	_mm_storeu_pd(p + 8, _mm256_extractf128_pd(ri0, 1));
+	_mm_storeu_pd(p + 10, _mm256_extractf128_pd(jk0, 1));
+	_mm_storeu_pd(p + 12, _mm256_extractf128_pd(ri1, 1));
+	_mm_storeu_pd(p + 14, _mm256_extractf128_pd(jk1, 1));
+#elif CONFIG_ZSL_SINGLE_PRECISION
+	__m128 a0 = v[0], a1 = v[1], a2 = v[2], a3 = v[3];
+
+	_MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+	_mm_storeu_ps(p, a0);
+	_mm_storeu_ps(p + 4, a1);
+	_mm_storeu_ps(p + 8, a2);
+	_mm_storeu_ps(p + 12, a3);
+#else
+	_mm_storeu_pd(p, _mm_unpacklo_pd(v[0], v[1]));
+	_mm_storeu_pd(p + 2, _mm_unpacklo_pd(v[2], v[3]));
+	_mm_storeu_pd(p + 4, _mm_unpackhi_pd(v[0], v[1]));
+	_mm_storeu_pd(p + 6, _mm_unpackhi_pd(v[2], v[3]));
+#endif
+}
+
+/**
+ * @brief Sets qm[l] to qa[l] * qb[l] for l = 0 to ZSL_X86_W - 1. 'qm' may be
+ *        the same array as 'qa' or 'qb'.
+ */
+static inline void
+zsl_x86_quat_mult(const struct zsl_quat *qa, const struct zsl_quat *qb,
+		  struct zsl_quat *qm)
+{
+	zsl_x86_vreal_t a[4], b[4], m[4];
+
+	zsl_x86_quat_load(qa, a);
+	zsl_x86_quat_load(qb, b);
+
+	m[0] = ZSL_X86_MUL(a[0], b[0]);
+	m[0] = ZSL_X86_SUB(m[0], ZSL_X86_MUL(a[1], b[1]));
+	m[0] = ZSL_X86_SUB(m[0], ZSL_X86_MUL(a[2], b[2]));
+	m[0] = ZSL_X86_SUB(m[0], ZSL_X86_MUL(a[3], b[3]));
+	m[1] = ZSL_X86_MUL(a[0], b[1]);
+	m[1] = ZSL_X86_FMADD(a[1], b[0], m[1]);
+	m[1] = ZSL_X86_FMADD(a[2], b[3], m[1]);
+	m[1] = ZSL_X86_SUB(m[1], ZSL_X86_MUL(a[3], b[2]));
+	m[2] = ZSL_X86_MUL(a[0], b[2]);
+	m[2] = ZSL_X86_SUB(m[2], ZSL_X86_MUL(a[1], b[3]));
+	m[2] = ZSL_X86_FMADD(a[2], b[0], m[2]);
+	m[2] = ZSL_X86_FMADD(a[3], b[1], m[2]);
+	m[3] = ZSL_X86_MUL(a[0], b[3]);
+	m[3] = ZSL_X86_FMADD(a[1], b[2], m[3]);
+	m[3] = ZSL_X86_SUB(m[3], ZSL_X86_MUL(a[2], b[1]));
+	m[3] = ZSL_X86_FMADD(a[3], b[0], m[3]);
+
+	zsl_x86_quat_store(qm, m);
+}
+
+#endif /* CONFIG_ZSL_PLATFORM_OPT == 3 */
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_X86_QUATERNIONS_H_ */
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2019-2020 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Optimised vector functions for zscilib using x86-64 SSE2 or AVX.
+ *
+ * This file contains optimised vector functions for x86-64 SSE2 or AVX.
+ */
+
+#include <zsl/zsl.h>
+#include <zsl/asm/x86/asm_x86.h>
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ASM_X86_VECTORS_H_
+#define ZEPHYR_INCLUDE_ZSL_ASM_X86_VECTORS_H_
+
+#if CONFIG_ZSL_PLATFORM_OPT == 3
+
+/**
+ * @brief Returns the sum of v[i] * w[i] over 'n' values.
+ */
+static inline zsl_real_t
+zsl_x86_dot(const zsl_real_t *v, const zsl_real_t *w, size_t n)
+{
+	zsl_x86_vreal_t acc0 = ZSL_X86_ZERO();
+	zsl_x86_vreal_t acc1 = ZSL_X86_ZERO();
+	zsl_real_t res;
+	size_t i = 0;
+
+	/* Two accumulators hide the latency of the add (or FMA). */
+	for (; i + (2 * ZSL_X86_W) <= n; i += 2 * ZSL_X86_W) {
+		acc0 = ZSL_X86_FMADD(ZSL_X86_LOAD(&v[i]), ZSL_X86_LOAD(&w[i]),
+				     acc0);
+		acc1 = ZSL_X86_FMADD(ZSL_X86_LOAD(&v[i + ZSL_X86_W]),
+				     ZSL_X86_LOAD(&w[i + ZSL_X86_W]), acc1);
+	}
+	for (; i + ZSL_X86_W <= n; i += ZSL_X86_W) {
+		acc0 = ZSL_X86_FMADD(ZSL_X86_LOAD(&v[i]), ZSL_X86_LOAD(&w[i]),
+				     acc0);
+	}
+
+	res = zsl_x86_hsum(ZSL_X86_ADD(acc0, acc1));
+	for (; i < n; i++) {
+		res += v[i] * w[i];
+	}
+
+	return res;
+}
+
+#if !asm_vec_add
+int zsl_vec_add(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
+{
+	size_t i = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (; i + ZSL_X86_W <= v->sz; i += ZSL_X86_W) {
+		ZSL_X86_STORE(&x->data[i], ZSL_X86_ADD(ZSL_X86_LOAD(&v->data[i]),
+						       ZSL_X86_LOAD(&w->data[i])));
+	}
+	for (; i < v->sz; i++) {
+		x->data[i] = v->data[i] + w->data[i];
+	}
+
+	return 0;
+}
+#define asm_vec_add 1
+#endif
+
+#if !asm_vec_sub
+int zsl_vec_sub(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
+{
+	size_t i = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (; i + ZSL_X86_W <= v->sz; i += ZSL_X86_W) {
+		ZSL_X86_STORE(&x->data[i], ZSL_X86_SUB(ZSL_X86_LOAD(&v->data[i]),
+						       ZSL_X86_LOAD(&w->data[i])));
+	}
+	for (; i < v->sz; i++) {
+		x->data[i] = v->data[i] - w->data[i];
+	}
+
+	return 0;
+}
+#define asm_vec_sub 1
+#endif
+
+#if !asm_vec_scalar_add
+int zsl_vec_scalar_add(struct zsl_vec *v, zsl_real_t s)
+{
+	zsl_x86_vreal_t vs = ZSL_X86_SET1(s);
+	size_t i = 0;
+
+	for (; i + ZSL_X86_W <= v->sz; i += ZSL_X86_W) {
+		ZSL_X86_STORE(&v->data[i],
+			      ZSL_X86_ADD(ZSL_X86_LOAD(&v->data[i]), vs));
+	}
+	for (; i < v->sz; i++) {
+		v->data[i] += s;
+	}
+
+	return 0;
+}
+#define asm_vec_scalar_add 1
+#endif
+
+#if !asm_vec_scalar_mult
+int zsl_vec_scalar_mult(struct zsl_vec *v, zsl_real_t s)
+{
+	zsl_x86_vreal_t vs = ZSL_X86_SET1(s);
+	size_t i = 0;
+
+	for (; i + ZSL_X86_W <= v->sz; i += ZSL_X86_W) {
+		ZSL_X86_STORE(&v->data[i],
+			      ZSL_X86_MUL(ZSL_X86_LOAD(&v->data[i]), vs));
+	}
+	for (; i < v->sz; i++) {
+		v->data[i] *= s;
+	}
+
+	return 0;
+}
+#define asm_vec_scalar_mult 1
+#endif
+
+#if !asm_vec_scalar_div
+int zsl_vec_scalar_div(struct zsl_vec *v, zsl_real_t s)
+{
+	zsl_x86_vreal_t vs = ZSL_X86_SET1(s);
+	size_t i = 0;
+
+	/* Avoid divide by zero errors. */
+	if (s == 0) {
+		return -EINVAL;
+	}
+
+	for (; i + ZSL_X86_W <= v->sz; i += ZSL_X86_W) {
+		ZSL_X86_STORE(&v->data[i],
+			      ZSL_X86_DIV(ZSL_X86_LOAD(&v->data[i]), vs));
+	}
+	for (; i < v->sz; i++) {
+		v->data[i] /= s;
+	}
+
+	return 0;
+}
+#define asm_vec_scalar_div 1
+#endif
+
+#if !asm_vec_dot
+int zsl_vec_dot(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *d)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	*d = zsl_x86_dot(v->data, w->data, v->sz);
+
+	return 0;
+}
+#define asm_vec_dot 1
+#endif
+
+#if !asm_vec_norm
+zsl_real_t zsl_vec_norm(struct zsl_vec *v)
+{
+	if (v == NULL) {
+		return 0;
+	}
+
+	return ZSL_SQRT(zsl_x86_dot(v->data, v->data, v->sz));
+}
+#define asm_vec_norm 1
+#endif
+
+#endif /* CONFIG_ZSL_PLATFORM_OPT == 3 */
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ASM_X86_VECTORS_H_ */
@@ -714,7 +714,7 @@ int zsl_clr_conv_cct_xyz(struct zsl_clr_cct *cct, enum zsl_clr_obs obs,
  * @brief Converts a CIE 1960 (u, v) pair to a CIE 1960 CCT and Duv
  *        pair using the specified conversion algorithm.
  *
- * @param method    The algoorithm to use for the conversion.
+ * @param method    The algorithm to use for the conversion.
  * @param uv        Pointer to input CIE 1960 (u, v) pair.
  * @param cct       Pointer to output zsl_clr_cct.
  *
@@ -723,6 +723,26 @@ int zsl_clr_conv_cct_xyz(struct zsl_clr_cct *cct, enum zsl_clr_obs obs,
 int zsl_clr_conv_uv60_cct(enum zsl_clr_uv_cct_method method,
 			  struct zsl_clr_uv60 *uv, struct zsl_clr_cct *cct);
 
+/**
+ * @brief Converts an array of 'n' CIE 1960 (u, v) pairs to CIE 1960 CCT and
+ *        Duv pairs using the specified conversion algorithm.
+ *
+ * The result for each pair is the same as with zsl_clr_conv_uv60_cct, but
+ * the algorithm is only selected once for the whole array. Pairs that can't
+ * be converted have their invalid flags set, and the remaining pairs are
+ * still converted.
+ *
+ * @param method    The algorithm to use for the conversion.
+ * @param n         The number of (u, v) pairs to convert.
+ * @param uv        Pointer to the array of 'n' input CIE 1960 (u, v) pairs.
+ * @param cct       Pointer to the array of 'n' output zsl_clr_cct values.
+ *
+ * @return 0 on success, or the error code of the last pair that couldn't be
+ *         converted.
+ */
+int zsl_clr_conv_uv60_cct_n(enum zsl_clr_uv_cct_method method, size_t n,
+			    struct zsl_clr_uv60 *uv, struct zsl_clr_cct *cct);
+
 /**
  * @brief Converts a CIE 1931 XYZ tristimulus to an 8-bit RGBA value
  *        using the supplied XYZ to RGB color space correlation matrix.
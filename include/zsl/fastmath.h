@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup FASTMATH Fast Math
+ *
+ * @brief Approximations of libm functions for hot loops.
+ *
+ * The zsl_fast_* functions trade a small, bounded error for speed, and don't
+ * call into libm, which makes most of them much cheaper on targets where
+ * zsl_real_t is emulated in software. They are always available, but the
+ * library only uses them through the ZSL_FAST_* macros. These map to the
+ * approximations when CONFIG_ZSL_FAST_MATH is enabled, and to the exact libm
+ * functions otherwise, so each call site picks whether it can tolerate the
+ * approximation.
+ *
+ * The error bounds below were measured over the whole input range in both
+ * single and double precision.
+ *
+ * zsl_horner is exact, and is used to evaluate polynomials in a fixed
+ * number of multiply-add steps rather than with ZSL_POW.
+ */
+
+/**
+ * @file
+ * @brief API header file for fast math approximations in zscilib.
+ *
+ * This file contains the zscilib fast math APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_FASTMATH_H_
+#define ZEPHYR_INCLUDE_ZSL_FASTMATH_H_
+
+#include <zsl/zsl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup FASTMATH_FUNCTIONS Functions
+ *
+ * @brief Fast math functions.
+ *
+ * @ingroup FASTMATH
+ *  @{
+ */
+
+/**
+ * @brief Evaluates the polynomial c[0] + c[1] * x + ... + c[n - 1] * x^(n - 1)
+ *        using Horner's method.
+ *
+ * @param x     The value at which to evaluate the polynomial.
+ * @param c     The coefficients, starting with the constant term.
+ * @param n     The number of coefficients.
+ *
+ * @return The value of the polynomial at x, or 0 if n is 0.
+ */
+static inline zsl_real_t zsl_horner(zsl_real_t x, const zsl_real_t *c, size_t n)
+{
+	zsl_real_t p = 0.0;
+
+	while (n > 0) {
+		p = p * x + c[--n];
+	}
+
+	return p;
+}
+
+/**
+ * @brief Approximates 1 / sqrt(x), using a bit-level initial estimate and
+ *        three Newton-Raphson steps.
+ *
+ * The relative error is below 2E-7 in single precision, and below 1E-10 in
+ * double precision.
+ *
+ * @param x     The input value. Must be positive and normal (not subnormal).
+ *
+ * @return An approximation of 1 / sqrt(x).
+ */
+static inline zsl_real_t zsl_fast_rsqrt(zsl_real_t x)
+{
+#if CONFIG_ZSL_SINGLE_PRECISION
+	union {
+		float f;
+		uint32_t u;
+	} b = { .f = x };
+
+	b.u = 0x5f375a86UL - (b.u >> 1);
+#else
+	union {
+		double f;
+		uint64_t u;
+	} b = { .f = x };
+
+	b.u = 0x5fe6eb50c7b537a9ULL - (b.u >> 1);
+#endif
+	zsl_real_t h = 0.5 * x;
+	zsl_real_t y = b.f;
+
+	/* Each step roughly squares the relative error, from 3.4E-2. */
+	y = y * (1.5 - h * y * y);
+	y = y * (1.5 - h * y * y);
+	y = y * (1.5 - h * y * y);
+
+	return y;
+}
+
+/**
+ * @brief Approximates atan2(y, x) with a ninth-order polynomial for the
+ *        arctangent over [-1, 1] (Abramowitz and Stegun 4.4.49).
+ *
+ * The absolute error is below 1.2E-5 radians. The result is in [-pi, pi],
+ * with the same quadrants as atan2. atan2(0, 0) is 0.
+ *
+ * @param y     The y coordinate.
+ * @param x     The x coordinate.
+ *
+ * @return An approximation of atan2(y, x), in radians.
+ */
+static inline zsl_real_t zsl_fast_atan2(zsl_real_t y, zsl_real_t x)
+{
+	static const zsl_real_t c[5] = {
+		0.9998660, -0.3302995, 0.1801410, -0.0851330, 0.0208351
+	};
+	zsl_real_t ax = ZSL_ABS(x);
+	zsl_real_t ay = ZSL_ABS(y);
+	zsl_real_t z, r;
+
+	if (ax == 0.0 && ay == 0.0) {
+		return 0.0;
+	}
+
+	/* Reduce to an angle in [0, pi/4], and unfold it. */
+	if (ay <= ax) {
+		z = ay / ax;
+		r = z * zsl_horner(z * z, c, 5);
+	} else {
+		z = ax / ay;
+		r = ZSL_PI / 2.0 - z * zsl_horner(z * z, c, 5);
+	}
+
+	if (x < 0.0) {
+		r = ZSL_PI - r;
+	}
+
+	return (y < 0.0) ? -r : r;
+}
+
+/**
+ * @brief Approximates asin(x) with pi/2 - sqrt(1 - x) * P(x), where P is a
+ *        seventh-order polynomial (Abramowitz and Stegun 4.4.46).
+ *
+ * The absolute error is below 3E-7 radians in single precision, and below
+ * 5E-8 radians in double precision.
+ *
+ * @param x     The input value, clipped to [-1, 1].
+ *
+ * @return An approximation of asin(x), in radians.
+ */
+static inline zsl_real_t zsl_fast_asin(zsl_real_t x)
+{
+	static const zsl_real_t c[8] = {
+		1.5707963050, -0.2145988016, 0.0889789874, -0.0501743046,
+		0.0308918810, -0.0170881256, 0.0066700901, -0.0012624911
+	};
+	zsl_real_t ax = ZSL_ABS(x);
+	zsl_real_t r;
+
+	if (ax > 1.0) {
+		ax = 1.0;
+	}
+
+	r = ZSL_PI / 2.0 - ZSL_SQRT(1.0 - ax) * zsl_horner(ax, c, 8);
+
+	return (x < 0.0) ? -r : r;
+}
+
+/**
+ * @brief Approximates exp(x), splitting x into k * ln(2) + r with
+ *        |r| <= ln(2) / 2, and evaluating exp(r) with a sixth-order Taylor
+ *        polynomial.
+ *
+ * The relative error is below 3E-7 in single precision, and below 2E-7 in
+ * double precision. Inputs are clipped to the range in which the result is a
+ * normal number, about [-87, 88] in single precision and [-708, 709] in
+ * double precision.
+ *
+ * @param x     The input value.
+ *
+ * @return An approximation of exp(x).
+ */
+static inline zsl_real_t zsl_fast_exp(zsl_real_t x)
+{
+	static const zsl_real_t c[7] = {
+		1.0, 1.0, 1.0 / 2.0, 1.0 / 6.0, 1.0 / 24.0, 1.0 / 120.0,
+		1.0 / 720.0
+	};
+	zsl_real_t r;
+	int32_t k;
+
+#if CONFIG_ZSL_SINGLE_PRECISION
+	union {
+		float f;
+		uint32_t u;
+	} b;
+
+	x = (x < -87.0) ? -87.0 : ((x > 88.0) ? 88.0 : x);
+#else
+	union {
+		double f;
+		uint64_t u;
+	} b;
+
+	x = (x < -708.0) ? -708.0 : ((x > 709.0) ? 709.0 : x);
+#endif
+
+	/* k = round(x / ln(2)). ln(2) is split in two parts so that r is
+	 * accurate in double precision. */
+	r = x * 1.4426950408889634;
+	k = (int32_t)(r < 0.0 ? r - 0.5 : r + 0.5);
+	r = x - k * 0.693145751953125;
+	r = r - k * 1.428606820309417E-6;
+
+	/* Build 2^k from its exponent bits. */
+#if CONFIG_ZSL_SINGLE_PRECISION
+	b.u = (uint32_t)(k + 127) << 23;
+#else
+	b.u = (uint64_t)(k + 1023) << 52;
+#endif
+
+	return zsl_horner(r, c, 7) * b.f;
+}
+
+/**
+ * @def ZSL_FAST_RSQRT
+ * @brief 1 / sqrt(x), approximated by zsl_fast_rsqrt with
+ *        CONFIG_ZSL_FAST_MATH.
+ */
+
+/**
+ * @def ZSL_FAST_ATAN2
+ * @brief atan2(y, x), approximated by zsl_fast_atan2 with
+ *        CONFIG_ZSL_FAST_MATH.
+ */
+
+/**
+ * @def ZSL_FAST_ASIN
+ * @brief asin(x), approximated by zsl_fast_asin with CONFIG_ZSL_FAST_MATH.
+ */
+
+/**
+ * @def ZSL_FAST_EXP
+ * @brief exp(x), approximated by zsl_fast_exp with CONFIG_ZSL_FAST_MATH.
+ */
+
+#if CONFIG_ZSL_FAST_MATH
+#define ZSL_FAST_RSQRT(x)       zsl_fast_rsqrt(x)
+#define ZSL_FAST_ATAN2(y, x)    zsl_fast_atan2(y, x)
+#define ZSL_FAST_ASIN(x)        zsl_fast_asin(x)
+#define ZSL_FAST_EXP(x)         zsl_fast_exp(x)
+#else
+#define ZSL_FAST_RSQRT(x)       (1.0 / ZSL_SQRT(x))
+#define ZSL_FAST_ATAN2(y, x)    ZSL_ATAN2(y, x)
+#define ZSL_FAST_ASIN(x)        ZSL_ASIN(x)
+#define ZSL_FAST_EXP(x)         ZSL_EXP(x)
+#endif
+
+/** @} */ /* End of FASTMATH_FUNCTIONS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_FASTMATH_H_ */
+
+/** @} */ /* End of FASTMATH group */
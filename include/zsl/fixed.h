@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup FIXED Fixed Point
+ *
+ * @brief Q15 and Q31 fixed-point numbers and vectors.
+ *
+ * These functions provide an integer-only alternative to zsl_real_t for
+ * targets without an FPU, where software floating point is many times
+ * slower. They are enabled with CONFIG_ZSL_FIXED.
+ *
+ * Q15 and Q31 values are signed fractions in [-1, 1), stored in 16 and 32-bit
+ * integers with 15 and 31 fractional bits. All the arithmetic saturates to
+ * the representable range rather than wrapping around, so 1.0 is represented
+ * as ZSL_Q31_MAX, 1 - 2^-31.
+ *
+ * Angles are stored as Q31 "binary angles", where -1.0 is -pi and the range
+ * wraps around at +/-pi, and the trigonometric functions use CORDIC
+ * iterations with a small table of constants.
+ *
+ * The orientation/fixed.h and orientation/fusion/fixed.h headers build on
+ * this with quaternions and the Madgwick, Mahony and complementary filters.
+ */
+
+/**
+ * @file
+ * @brief API header file for fixed-point numbers in zscilib.
+ *
+ * This file contains the zscilib Q15/Q31 APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_FIXED_H_
+#define ZEPHYR_INCLUDE_ZSL_FIXED_H_
+
+#include <zsl/zsl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup FIXED_STRUCTS Structs, Enums and Macros
+ *
+ * @brief Various structs, enums and macros related to fixed-point numbers.
+ *
+ * @ingroup FIXED
+ *  @{ */
+
+/** @brief Q15 fixed-point value: 15 fractional bits, range [-1, 1). */
+typedef int16_t zsl_q15_t;
+
+/** @brief Q31 fixed-point value: 31 fractional bits, range [-1, 1). */
+typedef int32_t zsl_q31_t;
+
+#define ZSL_Q15_MAX    INT16_MAX
+#define ZSL_Q15_MIN    INT16_MIN
+#define ZSL_Q31_MAX    INT32_MAX
+#define ZSL_Q31_MIN    INT32_MIN
+
+/**
+ * Number of fractional bits in angular velocities, in radians per second,
+ * which use the Q5.26 format (range +/-32 rad/s) to fit typical gyroscopes.
+ */
+#define ZSL_FIX_GYRO_FRAC (26)
+
+/** Converts the constant 'x' to a fixed-point value with 'n' fractional bits,
+ *  rounding to nearest. */
+#define ZSL_QN(x, n) \
+	((int32_t)((x) * (double)(1LL << (n)) + ((x) >= 0 ? 0.5 : -0.5)))
+
+/** Converts the constant 'x' to Q15, saturating outside [-1, 1). */
+#define ZSL_Q15(x)							\
+	((zsl_q15_t)((x) * 32768.0 >= 32767.0 ? ZSL_Q15_MAX :		\
+		     (x) <= -1.0 ? ZSL_Q15_MIN : ZSL_QN(x, 15)))
+
+/** Converts the constant 'x' to Q31, saturating outside [-1, 1). */
+#define ZSL_Q31(x)							\
+	((zsl_q31_t)((x) * 2147483648.0 >= 2147483647.0 ? ZSL_Q31_MAX : \
+		     (x) <= -1.0 ? ZSL_Q31_MIN : ZSL_QN(x, 31)))
+
+/** Converts the constant angle 'x', in degrees, to a Q31 binary angle. */
+#define ZSL_Q31_DEG(x) ZSL_Q31((x) / 180.0)
+
+/** Converts the constant angular velocity 'x', in rad/s, to Q5.26. */
+#define ZSL_Q_GYRO(x) ZSL_QN(x, ZSL_FIX_GYRO_FRAC)
+
+/** @brief Represents a vector of Q31 values. */
+struct zsl_vec_q31 {
+	/** The number of elements in the vector. */
+	size_t sz;
+	/** The array of Q31 values assigned to the vector. */
+	zsl_q31_t *data;
+};
+
+/** Macro to declare a Q31 vector of size `n`.
+ *
+ * Be sure to also call 'zsl_vec_q31_init' on the vector after this macro.
+ */
+#define ZSL_VECTOR_Q31_DEF(name, n)   \
+	zsl_q31_t name ## _vec[n];    \
+	struct zsl_vec_q31 name = {   \
+		.sz = n,	      \
+		.data = name ## _vec  \
+	}
+
+/** @} */ /* End of FIXED_STRUCTS group */
+
+/**
+ * @addtogroup FIXED_ARITH Arithmetic
+ *
+ * @brief Saturating Q15/Q31 arithmetic.
+ *
+ * @ingroup FIXED
+ *  @{ */
+
+/** @brief Saturates 'x' to the Q15 range. */
+static inline zsl_q15_t zsl_q15_sat(int32_t x)
+{
+	return x > ZSL_Q15_MAX ? ZSL_Q15_MAX :
+	       x < ZSL_Q15_MIN ? ZSL_Q15_MIN : (zsl_q15_t)x;
+}
+
+/** @brief Saturates 'x' to the Q31 range. */
+static inline zsl_q31_t zsl_q31_sat(int64_t x)
+{
+	return x > ZSL_Q31_MAX ? ZSL_Q31_MAX :
+	       x < ZSL_Q31_MIN ? ZSL_Q31_MIN : (zsl_q31_t)x;
+}
+
+/** @brief Returns a + b, saturated. */
+static inline zsl_q15_t zsl_q15_add(zsl_q15_t a, zsl_q15_t b)
+{
+	return zsl_q15_sat((int32_t)a + b);
+}
+
+/** @brief Returns a - b, saturated. */
+static inline zsl_q15_t zsl_q15_sub(zsl_q15_t a, zsl_q15_t b)
+{
+	return zsl_q15_sat((int32_t)a - b);
+}
+
+/** @brief Returns a * b, rounded to nearest and saturated. */
+static inline zsl_q15_t zsl_q15_mul(zsl_q15_t a, zsl_q15_t b)
+{
+	return zsl_q15_sat(((int32_t)a * b + (1 << 14)) >> 15);
+}
+
+/** @brief Returns a + b, saturated. */
+static inline zsl_q31_t zsl_q31_add(zsl_q31_t a, zsl_q31_t b)
+{
+	return zsl_q31_sat((int64_t)a + b);
+}
+
+/** @brief Returns a - b, saturated. */
+static inline zsl_q31_t zsl_q31_sub(zsl_q31_t a, zsl_q31_t b)
+{
+	return zsl_q31_sat((int64_t)a - b);
+}
+
+/** @brief Returns a * b, rounded to nearest and saturated. */
+static inline zsl_q31_t zsl_q31_mul(zsl_q31_t a, zsl_q31_t b)
+{
+	return zsl_q31_sat(((int64_t)a * b + (1LL << 30)) >> 31);
+}
+
+/** @brief Converts 'x' from Q15 to Q31. This is exact. */
+static inline zsl_q31_t zsl_q15_to_q31(zsl_q15_t x)
+{
+	return (zsl_q31_t)x * (1 << 16);
+}
+
+/** @brief Converts 'x' from Q31 to Q15, rounded to nearest and saturated. */
+static inline zsl_q15_t zsl_q31_to_q15(zsl_q31_t x)
+{
+	return zsl_q15_sat((int32_t)(((int64_t)x + (1 << 15)) >> 16));
+}
+
+/** @brief Converts 'x' to Q31, saturating outside [-1, 1). */
+static inline zsl_q31_t zsl_q31_from_real(zsl_real_t x)
+{
+	return x >= 1.0 ? ZSL_Q31_MAX : x <= -1.0 ? ZSL_Q31_MIN :
+	       zsl_q31_sat((int64_t)ZSL_ROUND(x * 2147483648.0));
+}
+
+/** @brief Converts the Q31 value 'x' to a real number. */
+static inline zsl_real_t zsl_q31_to_real(zsl_q31_t x)
+{
+	return (zsl_real_t)x / 2147483648.0;
+}
+
+/**
+ * @brief Returns a / b, saturated to [-1, 1). Division by zero saturates
+ *        according to the sign of 'a', or returns zero if 'a' is zero.
+ */
+zsl_q31_t zsl_q31_div(zsl_q31_t a, zsl_q31_t b);
+
+/**
+ * @brief Returns the square root of 'x', or zero if 'x' is negative.
+ */
+zsl_q31_t zsl_q31_sqrt(zsl_q31_t x);
+
+/**
+ * @brief Returns the integer square root of 'x', rounded down.
+ *
+ * This is the building block for norms of fixed-point values in other
+ * formats: the root of a value with 2n fractional bits has n fractional bits.
+ */
+uint32_t zsl_fix_sqrt_u64(uint64_t x);
+
+/** @} */ /* End of FIXED_ARITH group */
+
+/**
+ * @addtogroup FIXED_TRIG Trigonometry
+ *
+ * @brief CORDIC trigonometry on Q31 binary angles.
+ *
+ * @ingroup FIXED
+ *  @{ */
+
+/**
+ * @brief Computes the sine and cosine of the binary angle 'a'.
+ *
+ * @param a     Angle, as a fraction of pi: -1.0 is -pi and ZSL_Q31_MAX is
+ *              just under pi.
+ * @param s     The sine of 'a'. May be NULL.
+ * @param c     The cosine of 'a'. May be NULL.
+ */
+void zsl_q31_sin_cos(zsl_q31_t a, zsl_q31_t *s, zsl_q31_t *c);
+
+/**
+ * @brief Returns the angle of the point (x, y), as a binary angle in
+ *        [-pi, pi). The result is zero if both 'x' and 'y' are zero.
+ *
+ * Only the ratio of 'y' to 'x' matters, so they can be in any common
+ * fixed-point format.
+ */
+zsl_q31_t zsl_q31_atan2(zsl_q31_t y, zsl_q31_t x);
+
+/** @} */ /* End of FIXED_TRIG group */
+
+/**
+ * @addtogroup FIXED_VEC Vectors
+ *
+ * @brief Q31 vector functions, following the zsl_vec API.
+ *
+ * @ingroup FIXED
+ *  @{ */
+
+/**
+ * Initialises vector 'v' with zero values.
+ *
+ * @param v         Pointer to the zsl_vec_q31 to initialise/clear.
+ *
+ * @return 0 on success, and non-zero error code on failure
+ */
+int zsl_vec_q31_init(struct zsl_vec_q31 *v);
+
+/**
+ * @brief Converts the Q15 values in 'a', such as raw 16-bit sensor samples,
+ *        to vector 'v'.
+ *
+ * @param v     The output vector.
+ * @param a     Array of v->sz Q15 values.
+ *
+ * @return 0 on success, and non-zero error code on failure
+ */
+int zsl_vec_q31_from_q15(struct zsl_vec_q31 *v, const zsl_q15_t *a);
+
+/**
+ * @brief Adds corresponding vector elements in 'v' and 'w', saturating, and
+ *        assigns the results to 'x'.
+ *
+ * @param v     The first vector.
+ * @param w     The second vector.
+ * @param x     The output vector.
+ *
+ * @return 0 on success, -EINVAL if the vectors aren't of the same size.
+ */
+int zsl_vec_q31_add(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    struct zsl_vec_q31 *x);
+
+/**
+ * @brief Subtracts corresponding vector elements in 'v' and 'w' (v - w),
+ *        saturating, and assigns the results to 'x'.
+ *
+ * @param v     The first vector.
+ * @param w     The second vector.
+ * @param x     The output vector.
+ *
+ * @return 0 on success, -EINVAL if the vectors aren't of the same size.
+ */
+int zsl_vec_q31_sub(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    struct zsl_vec_q31 *x);
+
+/**
+ * @brief Multiplies all elements in vector 'v' by scalar value 's'.
+ *
+ * @param v     The vector to use, overwritten with the results.
+ * @param s     The scalar multiplication factor.
+ *
+ * @return 0 on success.
+ */
+int zsl_vec_q31_scalar_mult(struct zsl_vec_q31 *v, zsl_q31_t s);
+
+/**
+ * @brief Computes the dot product of vectors 'v' and 'w', saturated to
+ *        [-1, 1).
+ *
+ * @param v     The first vector.
+ * @param w     The second vector.
+ * @param d     The dot product.
+ *
+ * @return 0 on success, -EINVAL if the vectors aren't of the same size.
+ */
+int zsl_vec_q31_dot(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    zsl_q31_t *d);
+
+/**
+ * @brief Calculates the norm or absolute value of vector 'v', saturated to
+ *        ZSL_Q31_MAX.
+ *
+ * @param v     The vector to calculate the norm of.
+ *
+ * @return The norm of vector 'v'.
+ */
+zsl_q31_t zsl_vec_q31_norm(struct zsl_vec_q31 *v);
+
+/**
+ * @brief Converts vector 'v' to its unit form.
+ *
+ * The norm is computed after scaling 'v' so that its largest element uses
+ * the full Q31 range, so this works for vectors of any magnitude, including
+ * ones too small or too large for zsl_vec_q31_norm. As with zsl_vec_to_unit,
+ * a zero vector becomes (1, 0, ...).
+ *
+ * @param v     The vector to convert, overwritten with the results.
+ *
+ * @return 0 on success.
+ */
+int zsl_vec_q31_to_unit(struct zsl_vec_q31 *v);
+
+/**
+ * @brief Normalises the v->sz 64-bit values in 'x' into the unit vector 'v'.
+ *
+ * 'x' can use any fixed-point format, as long as it's the same for all the
+ * values. This lets intermediate results that don't fit in Q31, such as sums
+ * of products, be normalised without first losing their low bits. As with
+ * zsl_vec_q31_to_unit, a zero vector becomes (1, 0, ...).
+ *
+ * @param v     The output vector.
+ * @param x     Array of v->sz values.
+ *
+ * @return 0 on success.
+ */
+int zsl_vec_q31_unit_from_i64(struct zsl_vec_q31 *v, const int64_t *x);
+
+/**
+ * @brief Computes the cross product of the tridimensional vectors 'v' and
+ *        'w', saturating, and assigns the result to 'c'.
+ *
+ * @param v     The first vector.
+ * @param w     The second vector.
+ * @param c     The output vector.
+ *
+ * @return 0 on success, -EINVAL if any of the vectors isn't of size 3.
+ */
+int zsl_vec_q31_cross(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		      struct zsl_vec_q31 *c);
+
+/** @} */ /* End of FIXED_VEC group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_FIXED_H_ */
+
+/** @} */ /* End of FIXED group */
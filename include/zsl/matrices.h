@@ -41,6 +41,20 @@ extern "C" {
 #define EEIGENSIZE   (100)
 /** Error: Occurs when the input matrix has complex eigenvalues. */
 #define ECOMPLEXVAL  (101)
+/** Error: The input matrix is singular (or not positive definite). */
+#define ESINGULAR    (102)
+/** Error: An iterative method didn't converge in the allowed iterations. */
+#define ECONVERGE    (103)
+
+/**
+ * The largest symmetric matrix size for which @ref zsl_mtx_eigen_sym uses
+ * Jacobi rotations, rather than a tridiagonal reduction and the QL algorithm.
+ */
+#ifdef CONFIG_ZSL_MTX_SYM_JACOBI_MAX_SZ
+#define ZSL_MTX_SYM_JACOBI_MAX_SZ CONFIG_ZSL_MTX_SYM_JACOBI_MAX_SZ
+#else
+#define ZSL_MTX_SYM_JACOBI_MAX_SZ (2U)
+#endif
 
 /** @brief Represents a m x n matrix, with data stored in row-major order. */
 struct zsl_mtx {
@@ -66,6 +80,50 @@ struct zsl_mtx {
 		.data = name ## _mtx	\
 	}
 
+/**
+ * @brief A caller-supplied scratch arena. Decompositions such as
+ *        @ref zsl_mtx_svd_ws take their temporary matrices from it instead
+ *        of the stack, by bumping 'used', and hand them back before
+ *        returning.
+ */
+struct zsl_ws {
+	/** Scratch storage. */
+	zsl_real_t *data;
+	/** The capacity of 'data', in zsl_real_t elements. */
+	size_t sz;
+	/** The number of elements currently allocated. */
+	size_t used;
+	/** The largest value reached by 'used' (high-water mark). */
+	size_t peak;
+};
+
+/**
+ * Macro to declare a workspace of at least 'bytes' bytes on the stack, for
+ * example with a size returned by 'zsl_mtx_ws_bytes'.
+ */
+#define ZSL_WS_DEF(name, bytes)						\
+	zsl_real_t name ## _ws[((bytes) + sizeof(zsl_real_t) - 1) /	\
+			       sizeof(zsl_real_t)];			\
+	struct zsl_ws name = {						\
+		.data = name ## _ws,					\
+		.sz = sizeof(name ## _ws) / sizeof(zsl_real_t),		\
+		.used = 0,						\
+		.peak = 0						\
+	}
+
+/** @brief Decompositions that can be run from a 'struct zsl_ws'. */
+typedef enum zsl_mtx_ws_op {
+	ZSL_MTX_WS_QRD,                         /**< zsl_mtx_qrd_ws */
+	ZSL_MTX_WS_QRD_ITER,                    /**< zsl_mtx_qrd_iter_ws */
+	ZSL_MTX_WS_EIGENVALUES,                 /**< zsl_mtx_eigenvalues_ws */
+	ZSL_MTX_WS_EIGENVALUES_FRANCIS,         /**< zsl_mtx_eigenvalues_francis_ws */
+	ZSL_MTX_WS_EIGENVECTORS,                /**< zsl_mtx_eigenvectors_ws */
+	ZSL_MTX_WS_EIGEN_SYM,                   /**< zsl_mtx_eigen_sym_ws */
+	ZSL_MTX_WS_SVD,                         /**< zsl_mtx_svd_ws */
+	ZSL_MTX_WS_SVD_THIN,                    /**< zsl_mtx_svd_thin_ws */
+	ZSL_MTX_WS_PINV,                        /**< zsl_mtx_pinv_tol_ws */
+} zsl_mtx_ws_op_t;
+
 /** @} */ /* End of MTX_STRUCTS group */
 
 /**
@@ -243,6 +301,56 @@ int zsl_mtx_from_arr(struct zsl_mtx *m, zsl_real_t *a);
  */
 int zsl_mtx_copy(struct zsl_mtx *mdest, struct zsl_mtx *msrc);
 
+/**
+ * @brief Initialises workspace 'ws' to use the memory at 'buf'.
+ *
+ * @param ws    The workspace to initialise.
+ * @param buf   The scratch memory to use.
+ * @param bytes The size of 'buf', in bytes.
+ *
+ * @return 0 on success, and non-zero error code on failure
+ */
+int zsl_ws_init(struct zsl_ws *ws, zsl_real_t *buf, size_t bytes);
+
+/**
+ * @brief Allocates a rows x cols matrix 'm' from workspace 'ws'.
+ *
+ * Allocations are released by setting 'ws->used' back to a value saved
+ * beforehand, or to zero to release everything.
+ *
+ * @param ws    The workspace to allocate from.
+ * @param m     The matrix to assign the allocated memory to.
+ * @param rows  The number of rows in 'm'.
+ * @param cols  The number of columns in 'm'.
+ *
+ * @return 0 on success, or -ENOMEM if 'ws' doesn't have enough room.
+ */
+int zsl_ws_mtx(struct zsl_ws *ws, struct zsl_mtx *m, size_t rows, size_t cols);
+
+/**
+ * @brief Allocates a vector 'v' of 'sz' elements from workspace 'ws'.
+ *
+ * @param ws    The workspace to allocate from.
+ * @param v     The vector to assign the allocated memory to.
+ * @param sz    The number of elements in 'v'.
+ *
+ * @return 0 on success, or -ENOMEM if 'ws' doesn't have enough room.
+ */
+int zsl_ws_vec(struct zsl_ws *ws, struct zsl_vec *v, size_t sz);
+
+/**
+ * @brief Returns the worst-case workspace size, in bytes, that decomposition
+ *        'op' needs for a rows x cols input matrix. Square-only operations
+ *        ignore 'cols'.
+ *
+ * @param op    The decomposition to query.
+ * @param rows  The number of rows in the input matrix.
+ * @param cols  The number of columns in the input matrix.
+ *
+ * @return The required workspace size in bytes.
+ */
+size_t zsl_mtx_ws_bytes(zsl_mtx_ws_op_t op, size_t rows, size_t cols);
+
 /** @} */ /* End of MTX_INIT group */
 
 /**
@@ -496,7 +604,8 @@ int zsl_mtx_sub_d(struct zsl_mtx *ma, struct zsl_mtx *mb);
  * @brief Multiplies matrix 'ma' by 'mb', assigning the output to 'mc'.
  *        Matrices 'ma' and 'mb' must be compatibly shaped, meaning that
  *        'ma' must have the same numbers of columns as there are rows
- *        in 'mb'.
+ *        in 'mb'. This is equivalent to calling @ref zsl_mtx_gemm with
+ *        alpha = 1.0 and beta = 0.0, and 'mc' may alias either input.
  *
  * @param ma    Pointer to the first input zsl_mtx.
  * @param mb    Pointer to the second input zsl_mtx.
@@ -507,6 +616,31 @@ int zsl_mtx_sub_d(struct zsl_mtx *ma, struct zsl_mtx *mb);
  */
 int zsl_mtx_mult(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc);
 
+/**
+ * @brief General matrix multiply, computing mc = alpha * op(ma) * op(mb) +
+ *        beta * mc, where op(x) is either 'x' or its transpose. op(ma) must
+ *        have the same number of columns as there are rows in op(mb), and
+ *        'mc' must have the rows of op(ma) and the columns of op(mb).
+ *
+ * The product is computed in cache-sized blocks of 4x4 register tiles,
+ * walking the inputs in place. A temporary copy of an input is only taken
+ * when it shares storage with 'mc'.
+ *
+ * @param ta    If true, use the transpose of 'ma'.
+ * @param tb    If true, use the transpose of 'mb'.
+ * @param alpha Scale factor applied to op(ma) * op(mb).
+ * @param ma    Pointer to the first input zsl_mtx.
+ * @param mb    Pointer to the second input zsl_mtx.
+ * @param beta  Scale factor applied to the initial contents of 'mc'. If 0.0,
+ *              the initial contents of 'mc' are ignored.
+ * @param mc    Pointer to the input/output zsl_mtx.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if the input
+ *          matrices are not compatibly shaped.
+ */
+int zsl_mtx_gemm(bool ta, bool tb, zsl_real_t alpha, struct zsl_mtx *ma,
+		 struct zsl_mtx *mb, zsl_real_t beta, struct zsl_mtx *mc);
+
 /**
  * @brief Multiplies matrix 'ma' by 'mb', assigning the output to 'ma'.
  *        Matrices 'ma' and 'mb' must be compatibly shaped, meaning that
@@ -672,6 +806,9 @@ int zsl_mtx_deter_3x3(struct zsl_mtx *m, zsl_real_t *d);
 /**
  * @brief Calculates the determinant of the input square matrix 'm'.
  *
+ * Matrices larger than 3x3 are first factorised with @ref zsl_mtx_lu, so the
+ * cost of this function grows with the cube of the matrix size.
+ *
  * @param m     The input square matrix to use.
  * @param d     The determinant of square matrix m.
  *
@@ -680,6 +817,31 @@ int zsl_mtx_deter_3x3(struct zsl_mtx *m, zsl_real_t *d);
  */
 int zsl_mtx_deter(struct zsl_mtx *m, zsl_real_t *d);
 
+/**
+ * @brief Calculates the LU decomposition of the input square matrix 'm', using
+ *        Gaussian elimination with partial (row) pivoting.
+ *
+ * The decomposition takes the form P * m = L * U, where P is a permutation
+ * matrix, L is a lower triangular matrix with a unit diagonal and U is an
+ * upper triangular matrix. Both L and U are stored in 'lu': U on and above
+ * the diagonal, and L below the diagonal (its unit diagonal is implied).
+ *
+ * If the input matrix is singular, the decomposition still completes, but
+ * one or more of the diagonal elements of U will be zero.
+ *
+ * @param m     The input square matrix to use.
+ * @param lu    The output square matrix where L and U will be stored. This
+ *              can be the same matrix as 'm', in which case 'm' will be
+ *              overwritten.
+ * @param p     Pointer to an array of at least m->sz_rows elements, where the
+ *              row interchanges will be stored: at step k, row k was swapped
+ *              with row p[k]. The same array can be reused between calls.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'm' isn't a
+ *          square matrix or 'lu' doesn't have the same shape as 'm'.
+ */
+int zsl_mtx_lu(struct zsl_mtx *m, struct zsl_mtx *lu, size_t *p);
+
 /**
  * @brief Given the element (i,j) in matrix 'm', this function performs
  *        gaussian elimination by adding row 'i' to the other rows until
@@ -798,7 +960,12 @@ int zsl_mtx_norm_elem_d(struct zsl_mtx *m, struct zsl_mtx *mi,
 int zsl_mtx_inv_3x3(struct zsl_mtx *m, struct zsl_mtx *mi);
 
 /**
- * @brief Calculates the inverse of square matrix 'm'.
+ * @brief Calculates the inverse of square matrix 'm'. If 'm' is singular, an
+ *        identity matrix will be returned via 'mi'.
+ *
+ * Matrices other than 3x3 are inverted using the LU decomposition of 'm' (see
+ * @ref zsl_mtx_lu). If you only need the product of the inverse and another
+ * matrix or vector, @ref zsl_mtx_solve is both faster and more accurate.
  *
  * @param m     The input square matrix to use.
  * @param mi    The output inverse square matrix.
@@ -808,6 +975,48 @@ int zsl_mtx_inv_3x3(struct zsl_mtx *m, struct zsl_mtx *mi);
  */
 int zsl_mtx_inv(struct zsl_mtx *m, struct zsl_mtx *mi);
 
+/**
+ * @brief Solves the linear system a * x = b for 'x', where 'a' is a square
+ *        matrix, using the LU decomposition of 'a' (see @ref zsl_mtx_lu).
+ *
+ * 'b' may have several columns, in which case every column of 'x' is the
+ * solution for the same column of 'b'. The inverse of 'a' is never formed.
+ *
+ * A matrix is considered singular when one of the pivots of the
+ * decomposition is not greater than n * ZSL_EPSILON times the largest
+ * absolute value in 'a'.
+ *
+ * @param a     The input nxn square matrix.
+ * @param b     The input nxk right-hand side matrix.
+ * @param x     The output nxk solution matrix. This can be the same matrix as
+ *              'b', in which case 'b' will be overwritten.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices are
+ *          not compatibly shaped, or -ESINGULAR if 'a' is singular.
+ */
+int zsl_mtx_solve(struct zsl_mtx *a, struct zsl_mtx *b, struct zsl_mtx *x);
+
+/**
+ * @brief Solves the linear system a * x = b for 'x', where 'a' is a symmetric
+ *        positive definite matrix, using the Cholesky decomposition of 'a'
+ *        (see @ref zsl_mtx_cholesky).
+ *
+ * This takes roughly half the work of @ref zsl_mtx_solve, and is intended for
+ * covariance and normal-equation matrices. 'b' may have several columns, in
+ * which case every column of 'x' is the solution for the same column of 'b'.
+ * The inverse of 'a' is never formed.
+ *
+ * @param a     The input nxn symmetric positive definite matrix.
+ * @param b     The input nxk right-hand side matrix.
+ * @param x     The output nxk solution matrix. This can be the same matrix as
+ *              'b', in which case 'b' will be overwritten.
+ *
+ * @return  0 if everything executed correctly, -EINVAL if the matrices are
+ *          not compatibly shaped or 'a' isn't symmetric, or -ESINGULAR if 'a'
+ *          is singular or not positive definite.
+ */
+int zsl_mtx_solve_spd(struct zsl_mtx *a, struct zsl_mtx *b, struct zsl_mtx *x);
+
 /**
  * @brief Calculates the Cholesky decomposition of a symmetric square matrix
  *        using the Cholesky–Crout algorithm.
@@ -875,6 +1084,86 @@ int zsl_mtx_householder(struct zsl_mtx *m, struct zsl_mtx *h, bool hessenberg);
 int zsl_mtx_qrd(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
 		bool hessenberg);
 
+/**
+ * @brief Same as @ref zsl_mtx_qrd, but takes temporary storage from
+ *        workspace 'ws' instead of the stack.
+ *
+ * @param m     Pointer to the input square matrix.
+ * @param q     Pointer to the output orthoogonal square matrix.
+ * @param r     Pointer to the output upper triangular square matrix or
+ *              hessenberg matrix if set to true.
+ * @param hessenberg Sets the matrix to hessenberg format if 'true'.
+ * @param ws    Workspace with at least zsl_mtx_ws_bytes(ZSL_MTX_WS_QRD, ...)
+ *              bytes available.
+ *
+ * @return  0 if everything executed correctly, or -ENOMEM if 'ws' is too
+ *          small.
+ */
+int zsl_mtx_qrd_ws(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
+		   bool hessenberg, struct zsl_ws *ws);
+
+/**
+ * @brief Computes the QR decomposition of 'm', or its Hessenberg form if
+ *        'hessenberg' is true, in compact form, without building Q or any
+ *        of the Householder matrices.
+ *
+ * On return, the upper triangle of 'qr' holds R (or the upper Hessenberg
+ * part holds the Hessenberg matrix). Column j below the diagonal (or below
+ * the subdiagonal) holds v[1..] of the Householder vector v of reflector
+ * H(j) = I - tau[j] * v * v^T, where v[0] = 1 is implied. Then
+ * Q = H(0) * H(1) * ... * H(k - 1), and m = Q * R, or m = Q * H * Q^T in
+ * Hessenberg mode.
+ *
+ * There are k = min(rows - 1, cols) reflectors, or k = rows - 2 in
+ * Hessenberg mode. Each is applied to the remaining columns as a rank-1
+ * update, so this takes O(rows * cols^2) operations, and no temporary
+ * matrices. Q can be formed with @ref zsl_mtx_qrd_form_q, or applied with
+ * @ref zsl_mtx_qrd_apply_qt.
+ *
+ * @param m     Pointer to the input matrix. Must be square in Hessenberg
+ *              mode.
+ * @param qr    Pointer to the output matrix, the same size as 'm'. May be 'm'.
+ * @param tau   Pointer to the output reflector factors, with at least k
+ *              elements. Any elements past k are set to 0.
+ * @param hessenberg Computes the Hessenberg form if 'true'.
+ *
+ * @return  0 if everything executed correctly, otherwise an appropriate
+ *          error code.
+ */
+int zsl_mtx_qrd_compact(struct zsl_mtx *m, struct zsl_mtx *qr,
+			struct zsl_vec *tau, bool hessenberg);
+
+/**
+ * @brief Forms the orthogonal matrix Q from the compact form computed by
+ *        @ref zsl_mtx_qrd_compact.
+ *
+ * @param qr    Pointer to the compact form.
+ * @param tau   Pointer to the reflector factors.
+ * @param hessenberg Must match the value used for 'zsl_mtx_qrd_compact'.
+ * @param q     Pointer to the output square matrix, with as many rows as
+ *              'qr'.
+ *
+ * @return  0 if everything executed correctly, otherwise an appropriate
+ *          error code.
+ */
+int zsl_mtx_qrd_form_q(struct zsl_mtx *qr, struct zsl_vec *tau,
+		       bool hessenberg, struct zsl_mtx *q);
+
+/**
+ * @brief Replaces 'b' with Q^T * b, where Q is given by the compact form
+ *        computed by @ref zsl_mtx_qrd_compact, without forming Q.
+ *
+ * @param qr    Pointer to the compact form.
+ * @param tau   Pointer to the reflector factors.
+ * @param hessenberg Must match the value used for 'zsl_mtx_qrd_compact'.
+ * @param b     Pointer to the matrix to update, with as many rows as 'qr'.
+ *
+ * @return  0 if everything executed correctly, otherwise an appropriate
+ *          error code.
+ */
+int zsl_mtx_qrd_apply_qt(struct zsl_mtx *qr, struct zsl_vec *tau,
+			 bool hessenberg, struct zsl_mtx *b);
+
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
 /**
  * @brief Computes recursively the QR decompisition method to put the input
@@ -890,6 +1179,24 @@ int zsl_mtx_qrd(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
  *          error code.
  */
 int zsl_mtx_qrd_iter(struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter);
+
+/**
+ * @brief Same as @ref zsl_mtx_qrd_iter, but takes temporary storage from
+ *        workspace 'ws' instead of the stack.
+ *
+ * @param m     The input square matrix to use when performing the QR
+ *              decomposition.
+ * @param mout  The output upper triangular square matrix where the results
+ *              should be stored.
+ * @param iter  The number of times that 'zsl_mtx_qrd' should be called.
+ * @param ws    Workspace with at least
+ *              zsl_mtx_ws_bytes(ZSL_MTX_WS_QRD_ITER, ...) bytes available.
+ *
+ * @return  0 if everything executed correctly, or -ENOMEM if 'ws' is too
+ *          small.
+ */
+int zsl_mtx_qrd_iter_ws(struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter,
+			struct zsl_ws *ws);
 #endif
 
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
@@ -913,8 +1220,133 @@ int zsl_mtx_qrd_iter(struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter);
  *          numbers were detected in the output eigenvalues.
  */
 int zsl_mtx_eigenvalues(struct zsl_mtx *m, struct zsl_vec *v, size_t iter);
+
+/**
+ * @brief Same as @ref zsl_mtx_eigenvalues, but takes temporary storage from
+ *        workspace 'ws' instead of the stack.
+ *
+ * @param m     The input square matrix to use.
+ * @param v     The placeholder for the output vector where the real eigenvalues
+ *              should be stored.
+ * @param iter  The number of times that 'zsl_mtx_qrd' should be called
+ *              during the QR decomposition phase.
+ * @param ws    Workspace with at least
+ *              zsl_mtx_ws_bytes(ZSL_MTX_WS_EIGENVALUES, ...) bytes available.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too
+ *          small, or -ECOMPLEXVAL if complex eigenvalues were detected.
+ */
+int zsl_mtx_eigenvalues_ws(struct zsl_mtx *m, struct zsl_vec *v, size_t iter,
+			   struct zsl_ws *ws);
 #endif
 
+/**
+ * @brief Calculates all eigenvalues of the square matrix 'm', including
+ *        complex-conjugate pairs, using the Francis double-shift QR algorithm.
+ *
+ * The matrix is balanced and reduced to Hessenberg form, then each QR step
+ * is applied implicitly with two shifts chosen from the trailing 2x2 block.
+ * Eigenvalues are split off from the bottom of the matrix as soon as the
+ * subdiagonal element above them becomes negligible, and later steps only
+ * work on the part that hasn't converged yet. This usually needs two or
+ * three steps per eigenvalue, instead of the fixed and often large number of
+ * full QR iterations used by @ref zsl_mtx_eigenvalues.
+ *
+ * Complex eigenvalues are returned as consecutive pairs a + bi, a - bi, with
+ * b > 0. The eigenvalues aren't sorted.
+ *
+ * @param m         The input square matrix to use.
+ * @param re        The output vector for the real part of each eigenvalue,
+ *                  with at least as many elements as 'm' has rows.
+ * @param im        The output vector for the imaginary part of each
+ *                  eigenvalue, with at least as many elements as 'm' has
+ *                  rows. Zero for real eigenvalues.
+ * @param tol       The relative size below which a subdiagonal element is
+ *                  treated as zero, compared to the sum of its two diagonal
+ *                  neighbours. 0.0 to use ZSL_EPSILON, for full precision.
+ * @param max_iter  The maximum number of double-shift QR steps to perform.
+ *                  30 * n is enough for almost any matrix.
+ * @param iter      If not NULL, set to the number of double-shift QR steps
+ *                  that were performed.
+ *
+ * @return  0 if everything executed correctly, -ECONVERGE if 'max_iter'
+ *          steps weren't enough (the contents of 're' and 'im' are then
+ *          only partially valid), or another negative error code.
+ */
+int zsl_mtx_eigenvalues_francis(struct zsl_mtx *m, struct zsl_vec *re,
+				struct zsl_vec *im, zsl_real_t tol,
+				size_t max_iter, size_t *iter);
+
+/**
+ * @brief Same as @ref zsl_mtx_eigenvalues_francis, but takes temporary
+ *        storage from workspace 'ws' instead of the stack.
+ *
+ * @param m         The input square matrix to use.
+ * @param re        The output vector for the real parts.
+ * @param im        The output vector for the imaginary parts.
+ * @param tol       Relative deflation tolerance, or 0.0 for ZSL_EPSILON.
+ * @param max_iter  The maximum number of double-shift QR steps to perform.
+ * @param iter      If not NULL, set to the number of steps performed.
+ * @param ws        Workspace with at least
+ *                  zsl_mtx_ws_bytes(ZSL_MTX_WS_EIGENVALUES_FRANCIS, ...)
+ *                  bytes available.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too
+ *          small, or -ECONVERGE if 'max_iter' steps weren't enough.
+ */
+int zsl_mtx_eigenvalues_francis_ws(struct zsl_mtx *m, struct zsl_vec *re,
+				   struct zsl_vec *im, zsl_real_t tol,
+				   size_t max_iter, size_t *iter,
+				   struct zsl_ws *ws);
+
+/**
+ * @brief Calculates the eigenvalues and orthonormal eigenvectors of the
+ *        symmetric matrix 'm', such as a covariance matrix or the normal
+ *        matrix A^T * A.
+ *
+ * Matrices up to ZSL_MTX_SYM_JACOBI_MAX_SZ rows are diagonalised with cyclic
+ * Jacobi rotations, which find small eigenvalues with a better relative
+ * accuracy. Larger matrices are reduced to tridiagonal form with Householder
+ * reflections, and then diagonalised with the implicit QL algorithm, which
+ * takes far fewer operations. Unlike @ref zsl_mtx_eigenvectors,
+ * both methods give every eigenvector directly, including for repeated
+ * eigenvalues, and need no iteration count.
+ *
+ * The eigenvalues are sorted in decreasing order, and column i of 'mev' is
+ * the unit eigenvector for eigenvalue i. The sign of each eigenvector is
+ * chosen so that its largest element is positive.
+ *
+ * @param m     The input square matrix to use. It must be symmetric, which
+ *              isn't checked, and only one of its triangles is read.
+ * @param v     The output vector for the eigenvalues, with at least as many
+ *              elements as 'm' has rows.
+ * @param mev   The output square matrix for the eigenvectors, as columns.
+ *              May be the same matrix as 'm'. NULL if only the eigenvalues
+ *              are needed, which is faster.
+ *
+ * @return  0 if everything executed correctly, -ECONVERGE in the unlikely
+ *          case that the iterations don't converge, or another negative
+ *          error code.
+ */
+int zsl_mtx_eigen_sym(struct zsl_mtx *m, struct zsl_vec *v,
+		      struct zsl_mtx *mev);
+
+/**
+ * @brief Same as @ref zsl_mtx_eigen_sym, but takes temporary storage from
+ *        workspace 'ws' instead of the stack.
+ *
+ * @param m     The input symmetric square matrix to use.
+ * @param v     The output vector for the eigenvalues.
+ * @param mev   The output square matrix for the eigenvectors, or NULL.
+ * @param ws    Workspace with at least
+ *              zsl_mtx_ws_bytes(ZSL_MTX_WS_EIGEN_SYM, ...) bytes available.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too
+ *          small, or -ECONVERGE if the iterations don't converge.
+ */
+int zsl_mtx_eigen_sym_ws(struct zsl_mtx *m, struct zsl_vec *v,
+			 struct zsl_mtx *mev, struct zsl_ws *ws);
+
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
 /**
  * @brief Calcualtes the set of eigenvectors for input matrix 'm', using the
@@ -940,6 +1372,28 @@ int zsl_mtx_eigenvalues(struct zsl_mtx *m, struct zsl_vec *v, size_t iter);
  */
 int zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
 			 bool orthonormal);
+
+/**
+ * @brief Same as @ref zsl_mtx_eigenvectors, but takes temporary storage from
+ *        workspace 'ws' instead of the stack.
+ *
+ * @param m             The input square matrix to use.
+ * @param mev           The placeholder for the output square matrix where the
+ *                      eigenvectors should be stored as column vectors.
+ * @param iter          The number of times that 'zsl_mtx_qrd' should be called.
+ *                      during the QR decomposition phase.
+ * @param orthonormal   If set to true, the output matrix 'mev' will be
+ *                      orthonormalised.
+ * @param ws            Workspace with at least
+ *                      zsl_mtx_ws_bytes(ZSL_MTX_WS_EIGENVECTORS, ...) bytes
+ *                      available.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too
+ *          small, or -EEIGENSIZE if fewer eigenvectors than columns in 'm'
+ *          were found.
+ */
+int zsl_mtx_eigenvectors_ws(struct zsl_mtx *m, struct zsl_mtx *mev,
+			    size_t iter, bool orthonormal, struct zsl_ws *ws);
 #endif
 
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
@@ -947,6 +1401,10 @@ int zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
  * @brief Performs singular value decomposition, converting input matrix 'm'
  *        into matrices 'u', 'e', and 'v'.
  *
+ * This works through the eigenvectors of m^T * m and m * m^T, which squares
+ * the condition number of 'm'. @ref zsl_mtx_svd_thin is faster and more
+ * accurate when the thin factors are enough.
+ *
  * @param m     The input mxn matrix to use.
  * @param u     The placeholder for the output mxm matrix u.
  * @param e     The placeholder for the output mxn matrix sigma.
@@ -959,23 +1417,143 @@ int zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
  */
 int zsl_mtx_svd(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
 		struct zsl_mtx *v, size_t iter);
+
+/**
+ * @brief Same as @ref zsl_mtx_svd, but takes temporary storage from
+ *        workspace 'ws' instead of the stack. This allows large
+ *        decompositions to run from a statically reserved buffer.
+ *
+ * @param m     The input mxn matrix to use.
+ * @param u     The placeholder for the output mxm matrix u.
+ * @param e     The placeholder for the output mxn matrix sigma.
+ * @param v     The placeholder for the output nxn matrix v.
+ * @param iter  The number of times that 'zsl_mtx_qrd' should be called.
+ *              during the QR decomposition phase.
+ * @param ws    Workspace with at least zsl_mtx_ws_bytes(ZSL_MTX_WS_SVD, ...)
+ *              bytes available.
+ *
+ * @return  0 if everything executed correctly, or -ENOMEM if 'ws' is too
+ *          small.
+ */
+int zsl_mtx_svd_ws(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
+		   struct zsl_mtx *v, size_t iter, struct zsl_ws *ws);
 #endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * @brief Computes the thin (or economy) singular value decomposition
+ *        m = u * diag(s) * v^T of the r x c matrix 'm', where k = min(r, c).
+ *
+ * A^T * A is never formed. Instead, 'm' (or its transpose, if it is wide) is
+ * first reduced to a k x k triangular matrix with Householder QR, whose
+ * columns are then made orthogonal with one-sided Jacobi rotations. This
+ * keeps the full accuracy of the input, rather than squaring its condition
+ * number, and for tall matrices most of the work is the single QR pass.
+ *
+ * The singular values are sorted in decreasing order. The columns of 'u'
+ * and 'v' are orthonormal. Columns of 'u' for zero singular values are
+ * chosen to complete the orthonormal set.
+ *
+ * @param m     The input r x c matrix to use.
+ * @param u     The output r x k matrix of left singular vectors.
+ * @param s     The output vector of k singular values.
+ * @param v     The output c x k matrix of right singular vectors.
+ *
+ * @return  0 if everything executed correctly, -ECONVERGE in the unlikely
+ *          case that the Jacobi sweeps don't converge, or another negative
+ *          error code.
+ */
+int zsl_mtx_svd_thin(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_vec *s,
+		     struct zsl_mtx *v);
+
+/**
+ * @brief Same as @ref zsl_mtx_svd_thin, but takes temporary storage from
+ *        workspace 'ws' instead of the stack. The workspace needed is
+ *        O(r * c), not O(max(r, c)^2).
+ *
+ * @param m     The input r x c matrix to use.
+ * @param u     The output r x k matrix of left singular vectors.
+ * @param s     The output vector of k singular values.
+ * @param v     The output c x k matrix of right singular vectors.
+ * @param ws    Workspace with at least
+ *              zsl_mtx_ws_bytes(ZSL_MTX_WS_SVD_THIN, ...) bytes available.
+ *
+ * @return  0 if everything executed correctly, -ENOMEM if 'ws' is too
+ *          small, or -ECONVERGE if the Jacobi sweeps don't converge.
+ */
+int zsl_mtx_svd_thin_ws(struct zsl_mtx *m, struct zsl_mtx *u,
+			struct zsl_vec *s, struct zsl_mtx *v,
+			struct zsl_ws *ws);
+
 /**
  * @brief   Performs the pseudo-inverse (aka pinv or Moore-Penrose inverse)
  *          on input matrix 'm'.
  *
+ * This is @ref zsl_mtx_pinv_tol with the default tolerance.
+ *
  * @param m     The input mxn matrix to use.
  * @param pinv  The placeholder for the output pseudo inverse nxm matrix.
- * @param iter  The number of times that 'zsl_mtx_qrd' should be called.
- *              during the QR decomposition phase.
+ * @param iter  Unused. The pseudo-inverse is now based on
+ *              @ref zsl_mtx_svd_thin, which needs no iteration count.
  *
  * @return  0 if everything executed correctly, otherwise an appropriate
  *          error code.
  */
 int zsl_mtx_pinv(struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter);
-#endif
+
+/**
+ * @brief Same as @ref zsl_mtx_pinv, but takes temporary storage from
+ *        workspace 'ws' instead of the stack.
+ *
+ * @param m     The input mxn matrix to use.
+ * @param pinv  The placeholder for the output pseudo inverse nxm matrix.
+ * @param iter  Unused.
+ * @param ws    Workspace with at least zsl_mtx_ws_bytes(ZSL_MTX_WS_PINV, ...)
+ *              bytes available.
+ *
+ * @return  0 if everything executed correctly, or -ENOMEM if 'ws' is too
+ *          small.
+ */
+int zsl_mtx_pinv_ws(struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter,
+		    struct zsl_ws *ws);
+
+/**
+ * @brief Computes the pseudo-inverse of 'm' from its thin SVD, treating
+ *        singular values below 'tol' times the largest one as zero.
+ *
+ * Dropping these singular values, rather than inverting them, keeps noise in
+ * nearly rank-deficient inputs (such as sensor arrays with nearly collinear
+ * channels) from being amplified in least-squares solutions.
+ *
+ * @param m     The input mxn matrix to use.
+ * @param pinv  The placeholder for the output pseudo inverse nxm matrix.
+ * @param tol   The relative rank tolerance. 0.0 to use max(m, n) *
+ *              ZSL_EPSILON, which only drops singular values that are zero
+ *              to working precision.
+ * @param rank  If not NULL, set to the number of singular values kept, which
+ *              is the numerical rank of 'm'.
+ *
+ * @return  0 if everything executed correctly, otherwise an appropriate
+ *          error code.
+ */
+int zsl_mtx_pinv_tol(struct zsl_mtx *m, struct zsl_mtx *pinv, zsl_real_t tol,
+		     size_t *rank);
+
+/**
+ * @brief Same as @ref zsl_mtx_pinv_tol, but takes temporary storage from
+ *        workspace 'ws' instead of the stack.
+ *
+ * @param m     The input mxn matrix to use.
+ * @param pinv  The placeholder for the output pseudo inverse nxm matrix.
+ * @param tol   The relative rank tolerance, or 0.0 for the default.
+ * @param rank  If not NULL, set to the numerical rank of 'm'.
+ * @param ws    Workspace with at least zsl_mtx_ws_bytes(ZSL_MTX_WS_PINV, ...)
+ *              bytes available.
+ *
+ * @return  0 if everything executed correctly, or -ENOMEM if 'ws' is too
+ *          small.
+ */
+int zsl_mtx_pinv_tol_ws(struct zsl_mtx *m, struct zsl_mtx *pinv,
+			zsl_real_t tol, size_t *rank, struct zsl_ws *ws);
 
 /** @} */ /* End of MTX_TRANSFORMATIONS group */
 
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup QUAT_FIXED Fixed-Point Quaternions
+ *
+ * @brief Q31 quaternions, for orientation on targets without an FPU.
+ *
+ * These follow the zsl_quat functions of the same name. Each component is a
+ * Q31 value, so only quaternions whose components are in [-1, 1), such as
+ * unit quaternions, can be represented. Results that fall outside this range
+ * saturate. Angular velocities use the Q5.26 format of ZSL_FIX_GYRO_FRAC.
+ *
+ * @ingroup ORIENTATION
+ *  @{
+ */
+
+/**
+ * @file
+ * @brief API header file for fixed-point quaternions in zscilib.
+ *
+ * This file contains the zscilib Q31 quaternion APIs
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_ORIENTATION_FIXED_H_
+#define ZEPHYR_INCLUDE_ZSL_ORIENTATION_FIXED_H_
+
+#include <zsl/zsl.h>
+#include <zsl/fixed.h>
+#include <zsl/orientation/quaternions.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Represents a quaternion with Q31 components. */
+struct zsl_quat_q31 {
+	zsl_q31_t r;    /**< @brief The real component. */
+	zsl_q31_t i;    /**< @brief The first imaginary component. */
+	zsl_q31_t j;    /**< @brief The second imaginary component. */
+	zsl_q31_t k;    /**< @brief The third imaginary component. */
+};
+
+/**
+ * @brief Converts the quaternion 'q' to Q31, saturating components outside
+ *        [-1, 1).
+ *
+ * @param q     The input quaternion.
+ * @param qq    The Q31 output quaternion.
+ *
+ * @return 0 on success.
+ */
+int zsl_quat_q31_from_quat(struct zsl_quat *q, struct zsl_quat_q31 *qq);
+
+/**
+ * @brief Converts the Q31 quaternion 'qq' to a zsl_quat.
+ *
+ * @param qq    The Q31 input quaternion.
+ * @param q     The output quaternion.
+ *
+ * @return 0 on success.
+ */
+int zsl_quat_q31_to_quat(struct zsl_quat_q31 *qq, struct zsl_quat *q);
+
+/**
+ * @brief Calculates the magnitude of 'q', saturated to ZSL_Q31_MAX.
+ *
+ * @param q     The source quaternion.
+ *
+ * @return The magnitude of 'q'.
+ */
+zsl_q31_t zsl_quat_q31_magn(struct zsl_quat_q31 *q);
+
+/**
+ * @brief Converts 'q' to a unit quaternion. As with zsl_quat_to_unit, a zero
+ *        quaternion stays zero.
+ *
+ * @param q     The source quaternion.
+ * @param qn    The normalised output quaternion. May be the same as 'q'.
+ *
+ * @return 0 on success.
+ */
+int zsl_quat_q31_to_unit(struct zsl_quat_q31 *q, struct zsl_quat_q31 *qn);
+
+/**
+ * @brief Multiplies 'qa' by 'qb', saturating.
+ *
+ * @param qa    The first input quaternion.
+ * @param qb    The second input quaternion.
+ * @param qm    The output quaternion. May be the same as 'qa' or 'qb'.
+ *
+ * @return 0 on success.
+ */
+int zsl_quat_q31_mult(struct zsl_quat_q31 *qa, struct zsl_quat_q31 *qb,
+		      struct zsl_quat_q31 *qm);
+
+/**
+ * @brief Calculates the conjugate of 'q', which is also its inverse for unit
+ *        quaternions.
+ *
+ * @param q     The input quaternion.
+ * @param qc    The output quaternion. May be the same as 'q'.
+ *
+ * @return 0 on success.
+ */
+int zsl_quat_q31_conj(struct zsl_quat_q31 *q, struct zsl_quat_q31 *qc);
+
+/**
+ * @brief Linear interpolation (LERP) between the unit forms of 'qa' and
+ *        'qb', normalised.
+ *
+ * @param qa    The first input quaternion (t = 0).
+ * @param qb    The second input quaternion (t = 1).
+ * @param t     Interpolation factor. Must be between 0.0 and 1.0.
+ * @param qi    The interpolated output quaternion.
+ *
+ * @return 0 on success, -EINVAL if 't' is negative.
+ */
+int zsl_quat_q31_lerp(struct zsl_quat_q31 *qa, struct zsl_quat_q31 *qb,
+		      zsl_q31_t t, struct zsl_quat_q31 *qi);
+
+/**
+ * @brief Updates an orientation quaternion with the angular velocity 'w'
+ *        over the time 't', as zsl_quat_from_ang_vel does.
+ *
+ * @param w     Tridimensional angular velocity vector, in radians per second,
+ *              in Q5.26 format.
+ * @param qin   The starting orientation quaternion of the body.
+ * @param t     Time between qin and qout orientations, in seconds.
+ * @param qout  The estimated orientation after a time t elapses.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if the time is
+ *         negative or the angular velocity vector dimension is not 3.
+ */
+int zsl_quat_q31_from_ang_vel(struct zsl_vec_q31 *w, struct zsl_quat_q31 *qin,
+			      zsl_q31_t t, struct zsl_quat_q31 *qout);
+
+/**
+ * @brief Converts Euler angles (roll, pitch, yaw), in Q31 binary angles, to a
+ *        unit quaternion, as zsl_quat_from_euler does.
+ *
+ * @param x     Roll, the rotation about the x axis.
+ * @param y     Pitch, the rotation about the y axis.
+ * @param z     Yaw, the rotation about the z axis.
+ * @param q     The output quaternion.
+ *
+ * @return 0 on success.
+ */
+int zsl_quat_q31_from_euler(zsl_q31_t x, zsl_q31_t y, zsl_q31_t z,
+			    struct zsl_quat_q31 *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_ORIENTATION_FIXED_H_ */
+
+/** @} */ /* End of QUAT_FIXED group */
@@ -32,6 +32,8 @@
 extern "C" {
 #endif
 
+struct zsl_fus_batch;
+
 /* Source:
  * https://res.mdpi.com/sensors/sensors-15-19302/article_deploy/sensors-15-19302.pdf
  */
@@ -70,6 +72,18 @@ struct zsl_fus_aqua_cfg {
 	 *        magnetometer in the Dq_mag vector. Typically set to 0.9.
 	 */
 	zsl_real_t e_m;
+
+	/**
+	 * @brief Sample frequency in Hz. Set by @ref zsl_fus_aqua_init and
+	 *        used by this filter instance only.
+	 */
+	uint32_t freq;
+
+	/**
+	 * @brief Whether the first sample since @ref zsl_fus_aqua_init has
+	 *        been fed. Cleared by init.
+	 */
+	bool initialised;
 };
 
 /**
@@ -104,6 +118,27 @@ int zsl_fus_aqua_feed(struct zsl_vec *a, struct zsl_vec *m,
 		      struct zsl_vec *g, zsl_real_t *incl, struct zsl_quat *q,
 		      void *cfg);
 
+/**
+ * @brief Feeds a batch of recorded samples to the AQUA sensor fusion algorithm.
+ *
+ * Equivalent to calling @ref zsl_fus_aqua_feed for each sample in turn, but
+ * the config is only validated once. If the batch has time steps, each
+ * sample is integrated over its own time step.
+ *
+ * @param batch Pointer to the samples to process.
+ * @param q     Pointer to the current orientation, updated to the
+ *              orientation after the last sample.
+ * @param q_out Pointer to an array of batch->n quaternions receiving the
+ *              orientation after each sample, or NULL.
+ * @param cfg   Pointer to the config struct for this algorithm.
+ *
+ * @return int  0 if everything executed correctly, otherwise an appropriate
+ *              negative error code.
+ */
+int zsl_fus_aqua_feed_batch(const struct zsl_fus_batch *batch,
+			    struct zsl_quat *q, struct zsl_quat *q_out,
+			    void *cfg);
+
 /**
  * @brief Default error handler for the AQUA sensor fusion driver.
  *
@@ -32,6 +32,90 @@
 extern "C" {
 #endif
 
+/**
+ * The maximum number of Levenberg–Marquardt iterations run by
+ * @ref zsl_fus_cal_magn in each of its fitting stages.
+ */
+#ifdef CONFIG_ZSL_FUS_CAL_MAGN_MAX_ITER
+#define ZSL_FUS_CAL_MAGN_MAX_ITER CONFIG_ZSL_FUS_CAL_MAGN_MAX_ITER
+#else
+#define ZSL_FUS_CAL_MAGN_MAX_ITER (100U)
+#endif
+
+/**
+ * The relative change in the squared residual sum, or in the fitted
+ * parameters, below which @ref zsl_fus_cal_magn considers a fit converged.
+ */
+#ifndef ZSL_FUS_CAL_MAGN_TOL
+#define ZSL_FUS_CAL_MAGN_TOL (1E-12)
+#endif
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * @brief Streaming accumulator for magnetometer soft and hard iron
+ *        calibration.
+ *
+ * Holds the sufficient statistics of the least squares quadric fit used by
+ * @ref zsl_fus_cal_magn_fast, so its size doesn't depend on the number of
+ * samples pushed, and samples don't need to be kept in memory. Older samples
+ * can be progressively forgotten, allowing the calibration to follow slow
+ * changes such as temperature drift.
+ */
+struct zsl_fus_cal_magn_acc {
+	/**
+	 * @brief The upper triangle of XtX, row by row, where each row of X
+	 *        holds the quadric terms of one sample.
+	 */
+	zsl_real_t xtx[45];
+	/**
+	 * @brief The column sums of X.
+	 */
+	zsl_real_t xty[9];
+	/**
+	 * @brief Module of the magnetic field of the Earth, in micro Tesla.
+	 *        Samples are divided by this value before being accumulated.
+	 */
+	zsl_real_t me;
+	/**
+	 * @brief Forgetting factor, in (0, 1]. The statistics are multiplied by
+	 *        this value before each new sample is added.
+	 */
+	zsl_real_t ff;
+	/**
+	 * @brief The number of samples pushed so far.
+	 */
+	size_t n;
+};
+#endif
+
+/**
+ * @brief Streaming estimator of the bias of a gyroscope at rest.
+ *
+ * The first sample seeds the estimate, and must be taken at rest. After it,
+ * samples that deviate from the current estimate by more than a threshold
+ * are considered to be taken while the sensor is moving, and are ignored.
+ */
+struct zsl_fus_cal_gyro_acc {
+	/**
+	 * @brief The current bias estimate, in the units of the samples.
+	 */
+	zsl_real_t bias[3];
+	/**
+	 * @brief Weight of each new sample once the startup phase is over,
+	 *        in (0, 1].
+	 */
+	zsl_real_t alpha;
+	/**
+	 * @brief Largest distance from the current bias estimate at which a
+	 *        sample is considered to be taken at rest.
+	 */
+	zsl_real_t thresh;
+	/**
+	 * @brief The number of samples used so far.
+	 */
+	size_t n;
+};
+
 /**
  * @brief Rotates accel/mag/gyro data using a given rotation matrix.
  *
@@ -65,12 +149,22 @@ int zsl_fus_cal_rot_axis_angle(struct zsl_vec *v, struct zsl_vec *a,
  *        ('b') errors in the magnetometer data, using the Levenberg–Marquardt
  *        algorithm and spherical and ellipsoid fitting.
  *
+ * A sphere is first fitted to the samples, starting from the centre and mean
+ * half-range of their bounding box. Its centre and radius are then used as
+ * the starting point of the ellipsoid fitting, which minimises the sum of
+ * (|K(H + b)| - R)^2 over all samples H.
+ *
+ * Each iteration accumulates the normal equations in a single pass over the
+ * samples, so the cost is linear in N. Each stage stops once the relative
+ * improvement drops below ZSL_FUS_CAL_MAGN_TOL, or after
+ * ZSL_FUS_CAL_MAGN_MAX_ITER iterations.
+ *
  * Source: https://journals.sagepub.com/doi/full/10.1177/0020294019890627
  *
  * @param m     Pointer to the input Nx3 matrix, whose rows consist of
  *              distinct magnetometer data samples.
- * @param l     Damping parameter used to control the iterative process.
- *              Typically set to 1.
+ * @param l     Initial damping parameter used to control the iterative
+ *              process. Typically set to 1.
  * @param mu    Control parameter used to increase or decrease lambda each
  *              step. Must be larger than one. Typically set to 10.
  * @param K     Pointer to the output soft iron error 3x3 symmetric matrix.
@@ -122,6 +216,120 @@ int zsl_fus_cal_magn_fast(struct zsl_mtx *m, zsl_real_t *me, struct zsl_mtx *K,
 			  struct zsl_vec *b);
 #endif
 
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * @brief Initialises a streaming magnetometer calibration accumulator,
+ *        discarding any previous samples.
+ *
+ * @param acc   The accumulator to initialise.
+ * @param me    Module of the magnetic field of the Earth at the current
+ *              location and date, in micro Tesla (see
+ *              @ref zsl_fus_cal_magn_fast). If no value is known, provide
+ *              NULL and an approximation of 50 uT will be used.
+ * @param ff    Forgetting factor, in (0, 1]. Use 1.0 to weigh all samples
+ *              equally. Smaller values make the calibration follow changes
+ *              faster, with an effective memory of about 1 / (1 - ff)
+ *              samples.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if 'me' isn't
+ *         positive or 'ff' is out of range.
+ */
+int zsl_fus_cal_magn_acc_init(struct zsl_fus_cal_magn_acc *acc,
+			      zsl_real_t *me, zsl_real_t ff);
+#endif
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * @brief Adds magnetometer sample 'h' to accumulator 'acc'.
+ *
+ * This only updates the statistics of the fit, in constant time. Call
+ * @ref zsl_fus_cal_magn_acc_solve to obtain the current calibration, after
+ * every sample or as often as required.
+ *
+ * @param acc   The accumulator to update.
+ * @param h     The tridimensional magnetometer sample.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if 'h' isn't
+ *         tridimensional.
+ */
+int zsl_fus_cal_magn_acc_push(struct zsl_fus_cal_magn_acc *acc,
+			      struct zsl_vec *h);
+#endif
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * @brief Calculates the soft iron ('K') and the hard iron ('b') errors from
+ *        the samples pushed to 'acc', which can be passed straight to
+ *        @ref zsl_fus_cal_corr_vec.
+ *
+ * 'K' is symmetric, so the corrected samples aren't rotated, and scaled so
+ * that corrected samples have a magnitude of 'me'. The cost of this function
+ * doesn't depend on the number of samples pushed.
+ *
+ * @param acc   The accumulator to use.
+ * @param K     Pointer to the output soft iron error 3x3 symmetric matrix.
+ * @param b     Pointer to the output hard iron error tridimensional vector.
+ *
+ * @return 0 if everything executed normally, -EINVAL if the dimensions of
+ *         'K' or 'b' are invalid or fewer than nine samples have been
+ *         pushed, or -ESINGULAR if the samples don't describe an ellipsoid,
+ *         for example because they only cover a plane.
+ */
+int zsl_fus_cal_magn_acc_solve(struct zsl_fus_cal_magn_acc *acc,
+			       struct zsl_mtx *K, struct zsl_vec *b);
+#endif
+
+/**
+ * @brief Initialises a streaming gyroscope bias estimator, discarding any
+ *        previous samples.
+ *
+ * The first 1 / 'alpha' samples at rest are averaged with equal weights,
+ * after which each new sample at rest has a weight of 'alpha'.
+ *
+ * @param acc     The estimator to initialise.
+ * @param alpha   Weight of each new sample, in (0, 1].
+ * @param thresh  Largest distance from the current bias estimate, in the
+ *                units of the samples, at which a sample is considered to
+ *                be taken at rest. Must be positive.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if 'alpha' or
+ *         'thresh' are out of range.
+ */
+int zsl_fus_cal_gyro_acc_init(struct zsl_fus_cal_gyro_acc *acc,
+			      zsl_real_t alpha, zsl_real_t thresh);
+
+/**
+ * @brief Adds gyroscope sample 'g' to estimator 'acc', if it was taken at
+ *        rest.
+ *
+ * The first sample is always used, whatever its distance from zero, so that
+ * a bias larger than the threshold can be estimated. It must be taken while
+ * the sensor is at rest, or the estimator must be initialised again.
+ *
+ * @param acc   The estimator to update.
+ * @param g     The tridimensional gyroscope sample.
+ *
+ * @return 0 if the sample was used, -EAGAIN if it was ignored because the
+ *         sensor is moving, or -EINVAL if 'g' isn't tridimensional.
+ */
+int zsl_fus_cal_gyro_acc_push(struct zsl_fus_cal_gyro_acc *acc,
+			      struct zsl_vec *g);
+
+/**
+ * @brief Returns the offset that removes the estimated bias from gyroscope
+ *        samples, for use with @ref zsl_fus_cal_corr_vec and an identity
+ *        'K', or to add to the samples directly.
+ *
+ * @param acc   The estimator to use.
+ * @param b     Pointer to the output tridimensional vector, which is the
+ *              negated bias estimate.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if 'b' isn't
+ *         tridimensional or no samples at rest have been pushed.
+ */
+int zsl_fus_cal_gyro_acc_bias(struct zsl_fus_cal_gyro_acc *acc,
+			      struct zsl_vec *b);
+
 /**
  * @brief Corrects the supplied scalar number by adding another number ('b')
  *        and multiplying the sum by a scalar 'k'.
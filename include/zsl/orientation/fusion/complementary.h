@@ -33,6 +33,8 @@
 extern "C" {
 #endif
 
+struct zsl_fus_batch;
+
 /* Source: https://ahrs.readthedocs.io/en/latest/filters/complementary.html */
 
 /**
@@ -48,6 +50,12 @@ struct zsl_fus_comp_cfg {
 	 *        alpha should be closer to 1.
 	 */
 	zsl_real_t alpha;
+
+	/**
+	 * @brief Sample frequency in Hz. Set by @ref zsl_fus_comp_init and
+	 *        used by this filter instance only.
+	 */
+	uint32_t freq;
 };
 
 /**
@@ -78,6 +86,27 @@ int zsl_fus_comp_feed(struct zsl_vec *a, struct zsl_vec *m,
 		      struct zsl_vec *g, zsl_real_t *incl, struct zsl_quat *q,
 		      void *cfg);
 
+/**
+ * @brief Feeds a batch of recorded samples to the complementary sensor fusion algorithm.
+ *
+ * Equivalent to calling @ref zsl_fus_comp_feed for each sample in turn, but
+ * the config is only validated once. If the batch has time steps, each
+ * sample is integrated over its own time step.
+ *
+ * @param batch Pointer to the samples to process.
+ * @param q     Pointer to the current orientation, updated to the
+ *              orientation after the last sample.
+ * @param q_out Pointer to an array of batch->n quaternions receiving the
+ *              orientation after each sample, or NULL.
+ * @param cfg   Pointer to the config struct for this algorithm.
+ *
+ * @return int  0 if everything executed correctly, otherwise an appropriate
+ *              negative error code.
+ */
+int zsl_fus_comp_feed_batch(const struct zsl_fus_batch *batch,
+			    struct zsl_quat *q, struct zsl_quat *q_out,
+			    void *cfg);
+
 /**
  * @brief Default error handler for the complementary sensor fusion driver.
  *
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup FUSION_ALG_FIXED Fixed Point
+ *
+ * @brief Q31 versions of the Madgwick, Mahony and complementary filters.
+ *
+ * These follow the floating-point filters step by step, using only integer
+ * arithmetic, for targets without an FPU. Orientations are Q31 quaternions,
+ * and angular velocities are in rad/s in Q5.26 format (ZSL_FIX_GYRO_FRAC).
+ * Only the direction of the accelerometer and magnetometer samples is used,
+ * so they can be in any Q31 scale, such as raw 16-bit samples converted with
+ * zsl_vec_q31_from_q15. Filter gains are Q31 values, and must be less than
+ * 1.0.
+ *
+ * The filters are enabled with CONFIG_ZSL_FIXED. They don't use the
+ * zsl_fus_drv interface, whose callbacks take floating-point arguments.
+ *
+ * @ingroup FUSION_ALGORITHMS
+ *  @{
+ */
+
+/**
+ * @file
+ * @brief Fixed-point sensor fusion algorithms.
+ *
+ * This file implements Q31 versions of the Madgwick, Mahony and
+ * complementary sensor fusion algorithms.
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZSL_FUSION_FIXED_H_
+#define ZEPHYR_INCLUDE_ZSL_FUSION_FIXED_H_
+
+#include <zsl/zsl.h>
+#include <zsl/fixed.h>
+#include <zsl/orientation/fixed.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Config settings for the Q31 Madgwick filter.
+ */
+struct zsl_fus_madg_q31_cfg {
+	/**
+	 * @brief The filter gain beta, as for zsl_fus_madg_cfg. Must be
+	 *        positive or zero.
+	 */
+	zsl_q31_t beta;
+
+	/**
+	 * @brief Sample frequency in Hz. Set by @ref zsl_fus_madg_q31_init.
+	 */
+	uint32_t freq;
+};
+
+/**
+ * @brief Config settings for the Q31 Mahony filter.
+ */
+struct zsl_fus_mahn_q31_cfg {
+	/**
+	 * @brief Proportional filter gain constant. Must be positive or zero.
+	 */
+	zsl_q31_t kp;
+
+	/**
+	 * @brief Integral filter gain constant. Must be positive or zero.
+	 */
+	zsl_q31_t ki;
+
+	/**
+	 * @brief Integral limit for the integrator to avoid windup, in the same
+	 *        Q5.26 format as the integral feedback. Must be positive.
+	 */
+	int32_t integral_limit;
+
+	/**
+	 * @brief Integral feedback vector, in Q5.26, which is updated every
+	 *        iteration. Its initial value must be (0, 0, 0).
+	 */
+	struct zsl_vec_q31 intfb;
+
+	/**
+	 * @brief Sample frequency in Hz. Set by @ref zsl_fus_mahn_q31_init.
+	 */
+	uint32_t freq;
+};
+
+/**
+ * @brief Config settings for the Q31 complementary filter.
+ */
+struct zsl_fus_comp_q31_cfg {
+	/**
+	 * @brief Weight of the accelerometer and magnetometer estimate, as for
+	 *        zsl_fus_comp_cfg. Must be positive or zero.
+	 */
+	zsl_q31_t alpha;
+
+	/**
+	 * @brief Sample frequency in Hz. Set by @ref zsl_fus_comp_q31_init.
+	 */
+	uint32_t freq;
+};
+
+/**
+ * @brief Sets the sample frequency (in Hz) for the Q31 Madgwick filter.
+ *
+ * @param freq   Sampling frequency in Hz.
+ * @param cfg    Config struct for this filter.
+ *
+ * @return int   0 if everything executed correctly, otherwise an appropriate
+ *               negative error code.
+ */
+int zsl_fus_madg_q31_init(uint32_t freq, struct zsl_fus_madg_q31_cfg *cfg);
+
+/**
+ * @brief Madgwick sensor fuion algorithm implementation, in Q31.
+ *
+ * @param a     Input accelerometer vector (3 samples required). NULL if none.
+ * @param m     Input magnetometer vector (3 samples required). NULL if none.
+ * @param g     Input gyroscope vector, in Q5.26 rad/s (3 samples required).
+ * @param incl  Input magnetic inclination, as a binary angle. NULL for none.
+ * @param q     Pointer to the output @ref zsl_quat_q31.
+ * @param cfg   Config struct for this filter.
+ *
+ * @return int  0 if everything executed correctly, otherwise an appropriate
+ *              negative error code.
+ */
+int zsl_fus_madg_q31_feed(struct zsl_vec_q31 *a, struct zsl_vec_q31 *m,
+			  struct zsl_vec_q31 *g, zsl_q31_t *incl,
+			  struct zsl_quat_q31 *q,
+			  struct zsl_fus_madg_q31_cfg *cfg);
+
+/**
+ * @brief Sets the sample frequency (in Hz) for the Q31 Mahony filter.
+ *
+ * @param freq   Sampling frequency in Hz.
+ * @param cfg    Config struct for this filter.
+ *
+ * @return int   0 if everything executed correctly, otherwise an appropriate
+ *               negative error code.
+ */
+int zsl_fus_mahn_q31_init(uint32_t freq, struct zsl_fus_mahn_q31_cfg *cfg);
+
+/**
+ * @brief Mahony sensor fuion algorithm implementation, in Q31.
+ *
+ * @param a     Input accelerometer vector (3 samples required). NULL if none.
+ * @param m     Input magnetometer vector (3 samples required). NULL if none.
+ * @param g     Input gyroscope vector, in Q5.26 rad/s (3 samples required).
+ * @param incl  Input magnetic inclination, as a binary angle. NULL for none.
+ * @param q     Pointer to the output @ref zsl_quat_q31.
+ * @param cfg   Config struct for this filter.
+ *
+ * @return int  0 if everything executed correctly, otherwise an appropriate
+ *              negative error code.
+ */
+int zsl_fus_mahn_q31_feed(struct zsl_vec_q31 *a, struct zsl_vec_q31 *m,
+			  struct zsl_vec_q31 *g, zsl_q31_t *incl,
+			  struct zsl_quat_q31 *q,
+			  struct zsl_fus_mahn_q31_cfg *cfg);
+
+/**
+ * @brief Sets the sample frequency (in Hz) for the Q31 complementary filter.
+ *
+ * @param freq   Sampling frequency in Hz.
+ * @param cfg    Config struct for this filter.
+ *
+ * @return int   0 if everything executed correctly, otherwise an appropriate
+ *               negative error code.
+ */
+int zsl_fus_comp_q31_init(uint32_t freq, struct zsl_fus_comp_q31_cfg *cfg);
+
+/**
+ * @brief Complementary sensor fuion algorithm implementation, in Q31.
+ *
+ * @param a     Input accelerometer vector (3 samples required). NULL if none.
+ * @param m     Input magnetometer vector (3 samples required). NULL if none.
+ * @param g     Input gyroscope vector, in Q5.26 rad/s (3 samples required).
+ * @param q     Pointer to the output @ref zsl_quat_q31.
+ * @param cfg   Config struct for this filter.
+ *
+ * @return int  0 if everything executed correctly, otherwise an appropriate
+ *              negative error code.
+ */
+int zsl_fus_comp_q31_feed(struct zsl_vec_q31 *a, struct zsl_vec_q31 *m,
+			  struct zsl_vec_q31 *g, struct zsl_quat_q31 *q,
+			  struct zsl_fus_comp_q31_cfg *cfg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZSL_FUSION_FIXED_H_ */
+
+/** @} */ /* End of algorithms group */
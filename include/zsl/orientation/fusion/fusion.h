@@ -47,6 +47,119 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Memory layout of the sensor data in a @ref zsl_fus_batch.
+ */
+enum zsl_fus_batch_layout {
+	/**
+	 * @brief Array of structures: the XYZ values of each sample are
+	 *        stored together, as x0 y0 z0 x1 y1 z1 ...
+	 */
+	ZSL_FUS_BATCH_AOS = 0,
+
+	/**
+	 * @brief Structure of arrays: each axis is stored as a contiguous
+	 *        array of n values, as x0 x1 ... y0 y1 ... z0 z1 ...
+	 */
+	ZSL_FUS_BATCH_SOA = 1,
+};
+
+/**
+ * @brief A block of recorded sensor samples, to be fed to a fusion algorithm
+ *        in a single call.
+ */
+struct zsl_fus_batch {
+	/**
+	 * @brief Number of samples in the batch.
+	 */
+	size_t n;
+
+	/**
+	 * @brief Layout of the accel, mag and gyro buffers.
+	 */
+	enum zsl_fus_batch_layout layout;
+
+	/**
+	 * @brief 3 * n accelerometer values. NULL for none.
+	 */
+	const zsl_real_t *accel;
+
+	/**
+	 * @brief 3 * n magnetometer values. NULL for none.
+	 */
+	const zsl_real_t *mag;
+
+	/**
+	 * @brief 3 * n gyroscope values. NULL for none.
+	 */
+	const zsl_real_t *gyro;
+
+	/**
+	 * @brief n positive time steps, in seconds, each since the previous
+	 *        sample. NULL to use the fixed sample period set at init.
+	 *
+	 * Time steps, rather than absolute timestamps, keep their resolution
+	 * in single precision however long the recording is.
+	 */
+	const zsl_real_t *dt;
+
+	/**
+	 * @brief Earth's magnetic field inclination angle, in degrees. NULL
+	 *        for none.
+	 */
+	zsl_real_t *incl;
+};
+
+/**
+ * @brief Tridimensional samples from several sensors taken at the same time,
+ *        with each axis stored as an array of one value per sensor.
+ *
+ * Used by the multi-instance feed functions, such as
+ * @ref zsl_fus_madg_feed_multi, which update one filter per sensor.
+ */
+struct zsl_fus_vec_soa {
+	/**
+	 * @brief X values, one per sensor.
+	 */
+	zsl_real_t *x;
+
+	/**
+	 * @brief Y values, one per sensor.
+	 */
+	zsl_real_t *y;
+
+	/**
+	 * @brief Z values, one per sensor.
+	 */
+	zsl_real_t *z;
+};
+
+/**
+ * @brief The orientations of several filters, with each quaternion
+ *        component stored as an array of one value per filter.
+ */
+struct zsl_fus_quat_soa {
+	/**
+	 * @brief Real components, one per filter.
+	 */
+	zsl_real_t *r;
+
+	/**
+	 * @brief First imaginary components, one per filter.
+	 */
+	zsl_real_t *i;
+
+	/**
+	 * @brief Second imaginary components, one per filter.
+	 */
+	zsl_real_t *j;
+
+	/**
+	 * @brief Third imaginary components, one per filter.
+	 */
+	zsl_real_t *k;
+};
+
 /**
  * @typedef zsl_fus_init_cb_t
  * @brief Init callback prototype for sensor fusion implementations.
@@ -85,6 +198,28 @@ typedef int (*zsl_fus_feed_cb_t)(struct zsl_vec *accel,
 				 struct zsl_vec *mag, struct zsl_vec *gyro,
 				 zsl_real_t *incl, struct zsl_quat *q, void *cfg);
 
+/**
+ * @typedef zsl_fus_feed_batch_cb_t
+ * @brief Batch update callback prototype for sensor fusion implementations.
+ *
+ * Feeds every sample in 'batch' to the filter, in order, as a sequence of
+ * calls to the feed callback would, but without the per-sample dispatch and
+ * config validation.
+ *
+ * @param batch     Pointer to the samples to process.
+ * @param q         Pointer to the current orientation, which is updated to
+ *                  the orientation after the last sample.
+ * @param q_out     Pointer to an array of batch->n quaternions, which
+ *                  receives the orientation after each sample. NULL if
+ *                  only the final orientation is needed.
+ * @param cfg       Pointer to the config struct for this algorithm.
+ *
+ * @return 0 on success, negative error code on failure
+ */
+typedef int (*zsl_fus_feed_batch_cb_t)(const struct zsl_fus_batch *batch,
+				       struct zsl_quat *q,
+				       struct zsl_quat *q_out, void *cfg);
+
 /**
  * @typedef zsl_fus_error_cb_t
  * @brief Callback prototype when a fusion algorithm fails to properly feed.
@@ -107,6 +242,14 @@ struct zsl_fus_drv {
 	 */
 	zsl_fus_feed_cb_t feed_handler;
 
+	/**
+	 * @brief Callback to fire when feeding a batch of samples to the
+	 *        driver. NULL if the driver has no native batch support,
+	 *        in which case @ref zsl_fus_feed_batch calls feed_handler
+	 *        once per sample.
+	 */
+	zsl_fus_feed_batch_cb_t feed_batch_handler;
+
 	/**
 	 * @brief Callback to fire when the 'feed' command fails.
 	 */
@@ -116,10 +259,62 @@ struct zsl_fus_drv {
 	 * @brief Config settings for the driver. The exact struct or
 	 *        value(s) defined here are driver-specific and defined
 	 *        by the implementing module.
+	 *
+	 * The config struct also holds the runtime state of the filter, such
+	 * as the sample frequency set by init_handler. Drivers keep no
+	 * global state, so several instances can run concurrently (for
+	 * example one per IMU, each on its own thread) as long as each
+	 * instance has its own config struct.
 	 */
 	void *config;
 };
 
+/**
+ * @brief Feeds a batch of recorded samples to a fusion driver.
+ *
+ * Uses the driver's feed_batch_handler if it has one, and otherwise calls
+ * its feed_handler once per sample. In both cases the driver's
+ * error_handler, if any, is called if a sample can't be processed.
+ *
+ * @param drv       Pointer to the initialised fusion driver.
+ * @param batch     Pointer to the samples to process.
+ * @param q         Pointer to the current orientation, which is updated to
+ *                  the orientation after the last sample.
+ * @param q_out     Pointer to an array of batch->n quaternions, which
+ *                  receives the orientation after each sample. NULL if
+ *                  only the final orientation is needed.
+ *
+ * @return 0 on success, -EINVAL if a sample or time step is invalid,
+ *         -ENOSYS if 'batch' has time steps and the driver has no native
+ *         batch support, or the error returned by the driver.
+ */
+int zsl_fus_feed_batch(struct zsl_fus_drv *drv,
+		       const struct zsl_fus_batch *batch, struct zsl_quat *q,
+		       struct zsl_quat *q_out);
+
+/**
+ * @brief Copies sample 'i' of 'batch' into 'a', 'm' and 'g', and returns
+ *        its time step. Used by the batch implementations of the drivers.
+ *
+ * @param batch     Pointer to the batch to read from.
+ * @param i         Index of the sample, from 0 to batch->n - 1.
+ * @param freq      Sample frequency set at init, in Hz. Used when the batch
+ *                  has no time steps.
+ * @param a         Output accelerometer vector (3 samples), or NULL. Left
+ *                  unchanged if the batch has no accelerometer data.
+ * @param m         Output magnetometer vector (3 samples), or NULL. Left
+ *                  unchanged if the batch has no magnetometer data.
+ * @param g         Output gyroscope vector (3 samples), or NULL. Left
+ *                  unchanged if the batch has no gyroscope data.
+ * @param dt        Output time step since the previous sample, in seconds.
+ *
+ * @return 0 on success, -EINVAL if the time step of the sample isn't
+ *         positive.
+ */
+int zsl_fus_batch_get(const struct zsl_fus_batch *batch, size_t i,
+		      uint32_t freq, struct zsl_vec *a, struct zsl_vec *m,
+		      struct zsl_vec *g, zsl_real_t *dt);
+
 #ifdef __cplusplus
 }
 #endif
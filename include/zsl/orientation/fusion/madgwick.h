@@ -32,6 +32,10 @@
 extern "C" {
 #endif
 
+struct zsl_fus_batch;
+struct zsl_fus_vec_soa;
+struct zsl_fus_quat_soa;
+
 /* Source: https://www.x-io.co.uk/res/doc/madgwick_internal_report.pdf */
 
 /**
@@ -43,6 +47,12 @@ struct zsl_fus_madg_cfg {
 	 *        divergence rate of the gyroscope.
 	 */
 	zsl_real_t beta;
+
+	/**
+	 * @brief Sample frequency in Hz. Set by @ref zsl_fus_madg_init and
+	 *        used by this filter instance only.
+	 */
+	uint32_t freq;
 };
 
 /**
@@ -73,6 +83,56 @@ int zsl_fus_madg_feed(struct zsl_vec *a, struct zsl_vec *m,
 		      struct zsl_vec *g, zsl_real_t *incl, struct zsl_quat *q,
 		      void *cfg);
 
+/**
+ * @brief Feeds a batch of recorded samples to the Madgwick sensor fusion algorithm.
+ *
+ * Equivalent to calling @ref zsl_fus_madg_feed for each sample in turn, but
+ * the config is only validated once. If the batch has time steps, each
+ * sample is integrated over its own time step.
+ *
+ * @param batch Pointer to the samples to process.
+ * @param q     Pointer to the current orientation, updated to the
+ *              orientation after the last sample.
+ * @param q_out Pointer to an array of batch->n quaternions receiving the
+ *              orientation after each sample, or NULL.
+ * @param cfg   Pointer to the config struct for this algorithm.
+ *
+ * @return int  0 if everything executed correctly, otherwise an appropriate
+ *              negative error code.
+ */
+int zsl_fus_madg_feed_batch(const struct zsl_fus_batch *batch,
+			    struct zsl_quat *q, struct zsl_quat *q_out,
+			    void *cfg);
+
+/**
+ * @brief Feeds one sample from each of 'n' sensors to 'n' Madgwick filters
+ *        sharing the same config, updating all of them in lockstep.
+ *
+ * Equivalent to calling @ref zsl_fus_madg_feed once per sensor, with the
+ * same results within rounding, except that the input samples are not
+ * normalised in place. The data is stored as a structure of arrays, so that
+ * several filters can be updated at once with SIMD instructions when
+ * CONFIG_ZSL_PLATFORM_OPT selects a backend that supports it.
+ *
+ * @param n     Number of sensors and filters.
+ * @param a     Input accelerometer samples. NULL if none.
+ * @param m     Input magnetometer samples. NULL if none.
+ * @param g     Input gyroscope samples.
+ * @param incl  Input magnetic inclination, in degrees, shared by all the
+ *              sensors. NULL for none.
+ * @param q     The orientation of each filter, updated in place.
+ * @param cfg   Pointer to the config struct shared by all the filters.
+ *
+ * @return int  0 if everything executed correctly, or -EINVAL if the config
+ *              is invalid, 'g' is NULL or one of the quaternions is zero, in
+ *              which case no filter is updated.
+ */
+int zsl_fus_madg_feed_multi(size_t n, const struct zsl_fus_vec_soa *a,
+			    const struct zsl_fus_vec_soa *m,
+			    const struct zsl_fus_vec_soa *g, zsl_real_t *incl,
+			    struct zsl_fus_quat_soa *q,
+			    struct zsl_fus_madg_cfg *cfg);
+
 /**
  * @brief Default error handler for the Madgwick sensor fusion driver.
  *
@@ -32,6 +32,8 @@
 extern "C" {
 #endif
 
+struct zsl_fus_batch;
+
 /* Source: https://hal.inria.fr/hal-01922922/document */
 
 /**
@@ -63,6 +65,27 @@ int zsl_fus_saam_feed(struct zsl_vec *a, struct zsl_vec *m,
 		      struct zsl_vec *g, zsl_real_t *incl, struct zsl_quat *q,
 		      void *cfg);
 
+/**
+ * @brief Feeds a batch of recorded samples to the SAAM sensor fusion algorithm.
+ *
+ * Equivalent to calling @ref zsl_fus_saam_feed for each sample in turn, but
+ * without the per-sample call overhead. SAAM has no time dependency, so
+ * the time steps are only checked to be positive.
+ *
+ * @param batch Pointer to the samples to process.
+ * @param q     Pointer to the current orientation, updated to the
+ *              orientation after the last sample.
+ * @param q_out Pointer to an array of batch->n quaternions receiving the
+ *              orientation after each sample, or NULL.
+ * @param cfg   Pointer to the config struct for this algorithm.
+ *
+ * @return int  0 if everything executed correctly, otherwise an appropriate
+ *              negative error code.
+ */
+int zsl_fus_saam_feed_batch(const struct zsl_fus_batch *batch,
+			    struct zsl_quat *q, struct zsl_quat *q_out,
+			    void *cfg);
+
 /**
  * @brief Default error handler for the SAAM sensor fusion driver.
  *
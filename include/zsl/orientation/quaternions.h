@@ -427,6 +427,9 @@ int zsl_quat_from_ang_mom(struct zsl_vec *l, struct zsl_quat *qin,
  * @brief Converts a unit quaternion to it's equivalent Euler angle. Euler
  *        values expressed in radians.
  *
+ * With CONFIG_ZSL_FAST_MATH, the angles are computed with zsl_fast_asin and
+ * zsl_fast_atan2, and can be off by up to 1.2E-5 radians.
+ *
  * @param q     Pointer to the unit quaternion to convert.
  * @param e     Pointer to the Euler angle placeholder. Expressed in radians.
  *
@@ -491,6 +494,80 @@ int zsl_quat_to_axis_angle(struct zsl_quat *q, struct zsl_vec *a,
 int zsl_quat_from_axis_angle(struct zsl_vec *a, zsl_real_t *b,
 			     struct zsl_quat *q);
 
+/**
+ * @brief Multiplies each quaternion in 'qa' by the matching one in 'qb', as
+ *        zsl_quat_mult does, for arrays of 'n' quaternions.
+ *
+ * With CONFIG_ZSL_PLATFORM_OPT=3, several quaternions are multiplied at once
+ * using SSE2 or AVX.
+ *
+ * @param n     The number of quaternions in each array.
+ * @param qa    The first array of input quaternions.
+ * @param qb    The second array of input quaternions.
+ * @param qm    The output array. May be the same array as 'qa' or 'qb', but
+ *              must not otherwise overlap them.
+ *
+ * @return 0 if everything executed normally, or a negative error code.
+ */
+int zsl_quat_mult_n(size_t n, struct zsl_quat *qa, struct zsl_quat *qb,
+		    struct zsl_quat *qm);
+
+/**
+ * @brief Rotates 'n' points using the quaternion qa, as zsl_quat_rot does for
+ *        the pure quaternion (0, x, y, z) of each point.
+ *
+ * The points are read from and written to strided arrays, so they can be
+ * part of larger records, such as a point cloud with a colour or intensity
+ * after each (x, y, z). The rotation matrix of qa is computed once for all
+ * the points.
+ *
+ * @param n         The number of points.
+ * @param qa        The rotation quaternion, normalised before use.
+ * @param v         The (x, y, z) components of the first input point.
+ * @param v_stride  The distance between points in 'v', in zsl_real_t values.
+ *                  3 for an array of (x, y, z) triplets.
+ * @param vr        The (x, y, z) components of the first output point. May
+ *                  be the same as 'v', with the same stride, to rotate the
+ *                  points in place.
+ * @param vr_stride The distance between points in 'vr', in zsl_real_t values.
+ *
+ * @return 0 if everything executed normally, or -EINVAL if either stride is
+ *         less than 3.
+ */
+int zsl_quat_rot_n(size_t n, struct zsl_quat *qa, const zsl_real_t *v,
+		   size_t v_stride, zsl_real_t *vr, size_t vr_stride);
+
+/**
+ * @brief Spherical linear interpolation (SLERP) between each quaternion in
+ *        'qa' and the matching one in 'qb', as zsl_quat_slerp does.
+ *
+ * @param n     The number of quaternions in each array.
+ * @param qa    The array of starting quaternions.
+ * @param qb    The array of target quaternions.
+ * @param t     The interpolation factor (0.0..1.0)
+ * @param qi    The array of interpolated quaternions.
+ *
+ * @return 0 if everything executed normally, or a negative error code if the
+ *         interpolation factor is not between 0 and 1. If any of the pairs
+ *         can't be interpolated (qa = -qb), the others are still processed
+ *         and a negative error code is returned. The output for those pairs
+ *         is left unchanged.
+ */
+int zsl_quat_slerp_n(size_t n, struct zsl_quat *qa, struct zsl_quat *qb,
+		     zsl_real_t t, struct zsl_quat *qi);
+
+/**
+ * @brief Converts an array of 'n' unit quaternions to Euler angles, as
+ *        zsl_quat_to_euler does.
+ *
+ * @param n     The number of quaternions.
+ * @param q     The array of unit quaternions to convert.
+ * @param e     The array of Euler angles. Expressed in radians.
+ *
+ * @return 0 if everything executed normally, or a negative error code.
+ */
+int zsl_quat_to_euler_n(size_t n, struct zsl_quat *q, struct zsl_euler *e);
+
 /**
  * @brief Print the supplied quaternion using printf in a human-readable manner.
  *
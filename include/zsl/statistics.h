@@ -47,6 +47,130 @@ struct zsl_sta_linreg {
 	zsl_real_t correlation;
 };
 
+/**
+ * @brief Streaming accumulator for the mean and variance of a single
+ *        variable, updated one sample at a time with Welford's algorithm.
+ *
+ * Uses O(1) memory regardless of the number of samples, and avoids the
+ * cancellation of the naive sum-of-squares approach. Two accumulators can be
+ * merged, for example to combine partial results from several threads.
+ */
+struct zsl_sta_acc {
+	/**
+	 * @brief The number of samples pushed so far.
+	 */
+	size_t n;
+	/**
+	 * @brief The running mean.
+	 */
+	zsl_real_t mean;
+	/**
+	 * @brief The running sum of squared deviations from the mean.
+	 */
+	zsl_real_t m2;
+};
+
+/**
+ * @brief Streaming accumulator for paired (x, y) samples, tracking the
+ *        means, variances and co-moment needed for the covariance and simple
+ *        linear regression.
+ */
+struct zsl_sta_acc_xy {
+	/**
+	 * @brief The number of sample pairs pushed so far.
+	 */
+	size_t n;
+	/**
+	 * @brief The running mean of x.
+	 */
+	zsl_real_t mean_x;
+	/**
+	 * @brief The running mean of y.
+	 */
+	zsl_real_t mean_y;
+	/**
+	 * @brief The running sum of squared deviations of x.
+	 */
+	zsl_real_t m2_x;
+	/**
+	 * @brief The running sum of squared deviations of y.
+	 */
+	zsl_real_t m2_y;
+	/**
+	 * @brief The running sum of the products of the deviations of x and y.
+	 */
+	zsl_real_t c_xy;
+};
+
+/** The number of values held in each level of a quantile sketch. */
+#ifdef CONFIG_ZSL_STA_QSKETCH_K
+#define ZSL_STA_QSKETCH_K CONFIG_ZSL_STA_QSKETCH_K
+#else
+#define ZSL_STA_QSKETCH_K (32U)
+#endif
+
+/** The number of levels in a quantile sketch. */
+#ifdef CONFIG_ZSL_STA_QSKETCH_LEVELS
+#define ZSL_STA_QSKETCH_LEVELS CONFIG_ZSL_STA_QSKETCH_LEVELS
+#else
+#define ZSL_STA_QSKETCH_LEVELS (8U)
+#endif
+
+/**
+ * @brief Fixed-size sketch for approximate percentiles of an unbounded
+ *        stream of values.
+ *
+ * The sketch is a hierarchy of compactors. New values go into level 0, and
+ * values in level h carry a weight of 2^(h + shift). When a level holds
+ * ZSL_STA_QSKETCH_K values, it is sorted and every other value is promoted
+ * to the next level, alternating between the odd and even values so that
+ * errors tend to cancel. When the top level fills, every level is halved in
+ * place and 'shift' is incremented, after which new values are sampled with
+ * a probability of 2^-shift so that the size stays fixed.
+ *
+ * The size is fixed at ZSL_STA_QSKETCH_K * ZSL_STA_QSKETCH_LEVELS values
+ * plus a few counters, regardless of how many values are inserted (2 KB in
+ * double precision with the defaults).
+ *
+ * Error bounds: results are exact, and identical to @ref zsl_sta_percentile,
+ * until ZSL_STA_QSKETCH_K values have been inserted. Until the top level
+ * first fills, after about K * 2^(LEVELS - 1) values (4096 with the
+ * defaults), each compaction moves the rank of any value by at most the
+ * weight of the compacted level. The rank of the returned value is then
+ * within n * H / K of the requested rank, where n is the number of values
+ * and H the number of levels in use. This is a worst-case bound. With the
+ * defaults, typical rank errors are 1-2% of n, and rarely above 5%. Beyond
+ * that point, sampling adds a random rank error with a standard deviation
+ * of roughly n / sqrt(4 * K * 2^(LEVELS - 1)), which is under 1% of n with
+ * the defaults.
+ */
+struct zsl_sta_qsketch {
+	/**
+	 * @brief The values in each level.
+	 */
+	zsl_real_t data[ZSL_STA_QSKETCH_LEVELS][ZSL_STA_QSKETCH_K];
+	/**
+	 * @brief The number of values in each level.
+	 */
+	uint16_t count[ZSL_STA_QSKETCH_LEVELS];
+	/**
+	 * @brief The offset (0 or 1) of the next compaction of each level.
+	 */
+	uint8_t offset[ZSL_STA_QSKETCH_LEVELS];
+	/**
+	 * @brief The number of times all levels have been halved in place.
+	 */
+	uint8_t shift;
+	/**
+	 * @brief The state of the generator used to sample new values.
+	 */
+	uint32_t seed;
+	/**
+	 * @brief The number of values inserted so far.
+	 */
+	size_t n;
+};
+
 /**
  * @brief Computes the arithmetic mean (average) of a vector.
  *
@@ -136,6 +260,23 @@ int zsl_sta_demean(struct zsl_vec *v, struct zsl_vec *w);
  */
 int zsl_sta_percentile(struct zsl_vec *v, zsl_real_t p, zsl_real_t *val);
 
+/**
+ * @brief Computes the given percentile of a vector, permuting the input
+ *        vector instead of working on a copy.
+ *
+ * Uses a selection algorithm instead of a full sort, taking O(n) time on
+ * average. The values in 'v' are reordered, but not necessarily sorted.
+ *
+ * @param v    The input vector, which is permuted.
+ * @param p    The percentile to be calculated.
+ * @param val  The output value.
+ *
+ * @return  0 if everything executed correctly, otherwise an appropriate
+ *          error code.
+ */
+int zsl_sta_percentile_inplace(struct zsl_vec *v, zsl_real_t p,
+			       zsl_real_t *val);
+
 /**
  * @brief Computes the median of a vector (the value separating the higher half
  *        from the lower half of a data sample).
@@ -148,6 +289,18 @@ int zsl_sta_percentile(struct zsl_vec *v, zsl_real_t p, zsl_real_t *val);
  */
 int zsl_sta_median(struct zsl_vec *v, zsl_real_t *m);
 
+/**
+ * @brief Computes the median of a vector, permuting the input vector instead
+ *        of working on a copy.
+ *
+ * @param v  The vector to use, which is permuted.
+ * @param m  The median of the components of v.
+ *
+ * @return  0 if everything executed correctly, otherwise an appropriate
+ *          error code.
+ */
+int zsl_sta_median_inplace(struct zsl_vec *v, zsl_real_t *m);
+
 /**
  * @brief Computes the weighted median of a data vector (v) and a weight
  *        vector (w).
@@ -177,6 +330,23 @@ int zsl_sta_weighted_median(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *m)
 int zsl_sta_quart(struct zsl_vec *v, zsl_real_t *q1, zsl_real_t *q2,
 		  zsl_real_t *q3);
 
+/**
+ * @brief Calculates the first, second and third quartiles of a vector v,
+ *        permuting the input vector instead of working on a copy.
+ *
+ * All three quartiles are found in a single selection pass over 'v'.
+ *
+ * @param v   The vector to use, which is permuted.
+ * @param q1  The first quartile of v.
+ * @param q2  The second quartile of v, also the median of v.
+ * @param q3  The third quartile of v.
+ *
+ * @return  0 if everything executed correctly, otherwise an appropriate
+ *          error code.
+ */
+int zsl_sta_quart_inplace(struct zsl_vec *v, zsl_real_t *q1, zsl_real_t *q2,
+			  zsl_real_t *q3);
+
 /**
  * @brief Calculates the numeric difference between the third and the first
  *        quartiles of a vector v.
@@ -328,12 +498,15 @@ int zsl_sta_covar_mtx(struct zsl_mtx *m, struct zsl_mtx *mc);
 int zsl_sta_linear_reg(struct zsl_vec *x, struct zsl_vec *y,
 		       struct zsl_sta_linreg *c);
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 /**
  * @brief Calculates the coefficients (vector 'b') of the multiple linear
  *        regression of the x_i values (columns of the matrix 'x') and the y
  *        values.
  *
+ * The least-squares problem is solved with a QR decomposition, built one row
+ * at a time with Givens rotations, so the memory used grows with the square
+ * of the number of coefficients, but not with the number of rows.
+ *
  * @param x   Matrix, whose columns are the different x_i datasets.
  * @param y   The second input dataset, corresponding to the y-axis.
  * @param b   Pointer to the calculated multiple linear regression coefficients.
@@ -341,18 +514,22 @@ int zsl_sta_linear_reg(struct zsl_vec *x, struct zsl_vec *y,
  *            reffered to as R squared).
  *
  * @return 0 on success, and -EINVAL if dimensions of the input vectors and
- *         matrix don't match.
+ *         matrix don't match, or if the columns of 'x' aren't linearly
+ *         independent.
  */
 int zsl_sta_mult_linear_reg(struct zsl_mtx *x, struct zsl_vec *y,
 			    struct zsl_vec *b, zsl_real_t *r);
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 /**
  * @brief Calculates the coefficients (vector 'b') of the weighted multiple
  *        linear regression of the x_i values (columns of the matrix 'x'), the y
  *        values and the weights in the vector 'w'.
  *
+ * Each row is weighted by 1 / w_i, so 'w' can hold the variance of each
+ * sample. The weights are applied by scaling the rows, as for
+ * @ref zsl_sta_mult_linear_reg, and 'w' is left unchanged. The coefficient of
+ * determination is that of the unweighted residuals.
+ *
  * @param x   Matrix, whose columns are the different x_i datasets.
  * @param y   The second input dataset, corresponding to the y-axis.
  * @param w   The weights to use in the weighted least squares.
@@ -362,13 +539,12 @@ int zsl_sta_mult_linear_reg(struct zsl_mtx *x, struct zsl_vec *y,
  *            reffered to as R squared).
  *
  * @return 0 on success, and -EINVAL if dimensions of the input vectors and
- *         matrix don't match.
+ *         matrix don't match, if a weight is below 1E-6, or if the columns of
+ *         'x' aren't linearly independent.
  */
 int zsl_sta_weighted_mult_linear_reg(struct zsl_mtx *x, struct zsl_vec *y,
 				     struct zsl_vec *w, struct zsl_vec *b, zsl_real_t *r);
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 /**
  * @brief This function uses the least squares fitting method to compute the
  *        coefficients of a quadric surface given a set of tridimensional
@@ -380,14 +556,18 @@ int zsl_sta_weighted_mult_linear_reg(struct zsl_mtx *x, struct zsl_vec *y,
  * set of points (x,y,z) and returns the coeffitiens (A, B, C, D, E, F, G, H, I)
  * of the quadric surface that best fit the given points.
  *
+ * The fit is solved with the same row-by-row QR decomposition as
+ * @ref zsl_sta_mult_linear_reg, so it doesn't allocate any memory that
+ * depends on the number of points.
+ *
  * @param m   Matrix, whose rows are the (x, y, z) points.
  * @param b   Pointer to the calculated coefficients of the quadric.
  *
  * @return 0 on success, and -EINVAL if dimension of the input vectors isn't 9
- *         and the input matrix isn't a Nx3 matrix.
+ *         and the input matrix isn't a Nx3 matrix, or if the points don't
+ *         determine a single quadric.
  */
 int zsl_sta_quad_fit(struct zsl_mtx *m, struct zsl_vec *b);
-#endif
 
 /**
  * @brief Calculates the absolute error given a value and its expected value.
@@ -427,6 +607,182 @@ int zsl_sta_rel_err(zsl_real_t *val, zsl_real_t *exp_val, zsl_real_t *err);
  */
 int zsl_sta_sta_err(struct zsl_vec *v, zsl_real_t *err);
 
+/**
+ * @brief Clears accumulator 'acc', discarding all samples.
+ *
+ * @param acc   The accumulator to reset.
+ *
+ * @return  0 if everything executed correctly.
+ */
+int zsl_sta_acc_reset(struct zsl_sta_acc *acc);
+
+/**
+ * @brief Adds sample 'x' to accumulator 'acc'.
+ *
+ * @param acc   The accumulator to update.
+ * @param x     The new sample.
+ *
+ * @return  0 if everything executed correctly.
+ */
+int zsl_sta_acc_push(struct zsl_sta_acc *acc, zsl_real_t x);
+
+/**
+ * @brief Merges the samples of accumulator 'b' into accumulator 'a', as if
+ *        every sample pushed to 'b' had also been pushed to 'a'.
+ *
+ * @param a     The accumulator to update.
+ * @param b     The accumulator to merge into 'a', which is left unchanged.
+ *
+ * @return  0 if everything executed correctly.
+ */
+int zsl_sta_acc_merge(struct zsl_sta_acc *a, struct zsl_sta_acc *b);
+
+/**
+ * @brief Returns the arithmetic mean of the samples in 'acc'.
+ *
+ * @param acc   The accumulator to use.
+ * @param m     The mean of the samples.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if no samples have
+ *          been pushed.
+ */
+int zsl_sta_acc_mean(struct zsl_sta_acc *acc, zsl_real_t *m);
+
+/**
+ * @brief Returns the sample variance of the samples in 'acc', as computed by
+ *        @ref zsl_sta_var.
+ *
+ * @param acc   The accumulator to use.
+ * @param var   The sample variance.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if fewer than two
+ *          samples have been pushed.
+ */
+int zsl_sta_acc_var(struct zsl_sta_acc *acc, zsl_real_t *var);
+
+/**
+ * @brief Returns the sample standard deviation of the samples in 'acc'.
+ *
+ * @param acc   The accumulator to use.
+ * @param s     The sample standard deviation.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if fewer than two
+ *          samples have been pushed.
+ */
+int zsl_sta_acc_std_dev(struct zsl_sta_acc *acc, zsl_real_t *s);
+
+/**
+ * @brief Clears accumulator 'acc', discarding all sample pairs.
+ *
+ * @param acc   The accumulator to reset.
+ *
+ * @return  0 if everything executed correctly.
+ */
+int zsl_sta_acc_xy_reset(struct zsl_sta_acc_xy *acc);
+
+/**
+ * @brief Adds the sample pair (x, y) to accumulator 'acc'.
+ *
+ * @param acc   The accumulator to update.
+ * @param x     The new x sample.
+ * @param y     The new y sample.
+ *
+ * @return  0 if everything executed correctly.
+ */
+int zsl_sta_acc_xy_push(struct zsl_sta_acc_xy *acc, zsl_real_t x,
+			zsl_real_t y);
+
+/**
+ * @brief Merges the sample pairs of accumulator 'b' into accumulator 'a'.
+ *
+ * @param a     The accumulator to update.
+ * @param b     The accumulator to merge into 'a', which is left unchanged.
+ *
+ * @return  0 if everything executed correctly.
+ */
+int zsl_sta_acc_xy_merge(struct zsl_sta_acc_xy *a, struct zsl_sta_acc_xy *b);
+
+/**
+ * @brief Returns the sample covariance of the x and y samples in 'acc', as
+ *        computed by @ref zsl_sta_covar.
+ *
+ * @param acc   The accumulator to use.
+ * @param c     The sample covariance.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if fewer than two
+ *          sample pairs have been pushed.
+ */
+int zsl_sta_acc_xy_covar(struct zsl_sta_acc_xy *acc, zsl_real_t *c);
+
+/**
+ * @brief Calculates the slope, intercept and correlation coefficient of the
+ *        linear regression of the sample pairs in 'acc', as computed by
+ *        @ref zsl_sta_linear_reg.
+ *
+ * If all y samples are equal, the fit is a horizontal line and the
+ * correlation coefficient is set to 0.
+ *
+ * @param acc   The accumulator to use.
+ * @param c     Pointer to the calculated linear regression coefficients.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if fewer than two
+ *          sample pairs have been pushed, or all x samples are equal.
+ */
+int zsl_sta_acc_xy_linear_reg(struct zsl_sta_acc_xy *acc,
+			      struct zsl_sta_linreg *c);
+
+/**
+ * @brief Clears quantile sketch 'sk', discarding all values.
+ *
+ * @param sk    The sketch to reset.
+ *
+ * @return  0 if everything executed correctly.
+ */
+int zsl_sta_qsketch_reset(struct zsl_sta_qsketch *sk);
+
+/**
+ * @brief Adds value 'x' to quantile sketch 'sk'.
+ *
+ * Takes O(1) amortised time, plus an occasional sort of one level.
+ *
+ * @param sk    The sketch to update.
+ * @param x     The new value.
+ *
+ * @return  0 if everything executed correctly.
+ */
+int zsl_sta_qsketch_insert(struct zsl_sta_qsketch *sk, zsl_real_t x);
+
+/**
+ * @brief Merges the values summarised by quantile sketch 'b' into sketch
+ *        'a', for example to combine sketches built by separate threads.
+ *
+ * The error bound of the result is the sum of the bounds of both sketches
+ * plus the compactions done while merging.
+ *
+ * @param a     The sketch to update.
+ * @param b     The sketch to merge into 'a', which is left unchanged.
+ *
+ * @return  0 if everything executed correctly.
+ */
+int zsl_sta_qsketch_merge(struct zsl_sta_qsketch *a, struct zsl_sta_qsketch *b);
+
+/**
+ * @brief Estimates the given percentile of the values in quantile sketch
+ *        'sk', using the same definition as @ref zsl_sta_percentile.
+ *
+ * The values within each level may be reordered, which doesn't change the
+ * state of the sketch.
+ *
+ * @param sk    The sketch to use.
+ * @param p     The percentile to be calculated.
+ * @param val   The output value.
+ *
+ * @return  0 if everything executed correctly, or -EINVAL if 'p' isn't
+ *          between 0 and 100 or the sketch is empty.
+ */
+int zsl_sta_qsketch_percentile(struct zsl_sta_qsketch *sk, zsl_real_t p,
+			       zsl_real_t *val);
+
 #ifdef __cplusplus
 }
 #endif
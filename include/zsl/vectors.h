@@ -395,16 +395,39 @@ bool zsl_vec_is_nonneg(struct zsl_vec *v);
 int zsl_vec_contains(struct zsl_vec *v, zsl_real_t val, zsl_real_t eps);
 
 /**
- * @brief Sorts the values in vector v from smallest to largest using quicksort,
+ * @brief Sorts the values in vector v from smallest to largest using introsort,
  *        and assigns the sorted output to vector w.
  *
+ * Runs in O(n log n) time in the worst case. Repeated values are kept. 'v'
+ * and 'w' may be the same vector, in which case the sort is done in place.
+ *
  * @param v     The unsorted, input vector.
- * @param w     The sorted, output vector.
+ * @param w     The sorted, output vector, with the same size as 'v'.
  *
  * @return 0 if everything executed properly, otherwise a negative error code.
  */
 int zsl_vec_sort(struct zsl_vec *v, struct zsl_vec *w);
 
+/**
+ * @brief Finds one or more order statistics of vector v, by partially
+ *        sorting v in place.
+ *
+ * On return, v->data[k[i]] holds the value that a full sort would place at
+ * index k[i], and is also assigned to val[i]. The remaining values of 'v'
+ * are permuted, but not necessarily sorted. All 'n' ranks are found in a
+ * single partitioning pass, in O(v->sz) time on average. Copy 'v' first if
+ * its order must be preserved.
+ *
+ * @param v     The input vector, which is permuted.
+ * @param k     'n' zero-based ranks, in ascending order.
+ * @param n     The number of ranks in 'k'.
+ * @param val   Array of 'n' values where the order statistics are stored.
+ *
+ * @return 0 if everything executed properly, or -EINVAL if a rank is out of
+ *         range or the ranks aren't ascending.
+ */
+int zsl_vec_select(struct zsl_vec *v, size_t *k, size_t n, zsl_real_t *val);
+
 /** @} */ /* End of VEC_COMPARE group */
 
 /**
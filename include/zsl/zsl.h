@@ -15,6 +15,7 @@
 #define ZEPHYR_INCLUDE_ZSL_H_
 
 #include <math.h>
+#include <float.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -52,7 +53,7 @@ typedef double zsl_real_t;
 #endif
 
 /* Map math functions based on single or double precision. */
-/* TODO: Add an option for fast approximations of trig operations. */
+/* Faster approximations of some of these are in zsl/fastmath.h. */
 #if CONFIG_ZSL_SINGLE_PRECISION
 #define ZSL_CEIL       ceilf
 #define ZSL_FLOOR      floorf
@@ -105,6 +106,13 @@ typedef double zsl_real_t;
 #define ZSL_EXPM1      expm1
 #endif
 
+/* Machine epsilon based on single or double precision. */
+#if CONFIG_ZSL_SINGLE_PRECISION
+#define ZSL_EPSILON    FLT_EPSILON
+#else
+#define ZSL_EPSILON    DBL_EPSILON
+#endif
+
 
 /* TODO: Define common errors like shape mismatch, etc. */
 
@@ -4,15 +4,178 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
 #include <zsl/zsl.h>
+#include <zsl/fastmath.h>
 #include <zsl/vectors.h>
+#include <zsl/matrices.h>
+#include <zsl/statistics.h>
+#include <zsl/orientation/fusion/fusion.h>
+#include <zsl/orientation/fusion/calibration.h>
+#include <zsl/colorimetry.h>
+#if CONFIG_ZSL_FIXED
+#include <zsl/orientation/fusion/fixed.h>
+#endif
 #include <zsl/instrumentation.h>
 
 /** The number of times to execute the code under test. */
 #define BENCH_LOOPS (10000U)
 
+/** The number of times to execute the nxn matrix code under test. */
+#define BENCH_MTX_LOOPS (10U)
+
+/** The smallest nxn matrix size used in matrix benchmarks. */
+#define BENCH_MTX_MIN_SZ (4U)
+
+/** The largest nxn matrix size used in matrix benchmarks. */
+#define BENCH_MTX_MAX_SZ (32U)
+
+/**
+ * The largest nxn matrix size to run through the cofactor expansion
+ * determinant, which grows with n! and quickly becomes impractical.
+ */
+#define BENCH_DETER_COFACTOR_MAX_SZ (8U)
+
+/**
+ * The largest nxn matrix size used in the matrix multiplication benchmark.
+ * The operands are statically allocated, so this is limited on devices with
+ * little SRAM (such as qemu_cortex_m3).
+ */
+#if defined(CONFIG_SRAM_SIZE) && (CONFIG_SRAM_SIZE < 192)
+#define BENCH_MULT_MAX_SZ (32U)
+#else
+#define BENCH_MULT_MAX_SZ (64U)
+#endif
+
+static zsl_real_t bench_mult_a[BENCH_MULT_MAX_SZ * BENCH_MULT_MAX_SZ];
+static zsl_real_t bench_mult_b[BENCH_MULT_MAX_SZ * BENCH_MULT_MAX_SZ];
+static zsl_real_t bench_mult_c[BENCH_MULT_MAX_SZ * BENCH_MULT_MAX_SZ];
+
+/**
+ * The largest nxn matrix size used in the QR decomposition benchmark, limited
+ * on devices with little SRAM as for the multiplication benchmark.
+ */
+#if defined(CONFIG_SRAM_SIZE) && (CONFIG_SRAM_SIZE < 192)
+#define BENCH_QRD_MAX_SZ (32U)
+#elif defined(CONFIG_SRAM_SIZE) && (CONFIG_SRAM_SIZE < 2048)
+#define BENCH_QRD_MAX_SZ (64U)
+#else
+#define BENCH_QRD_MAX_SZ (128U)
+#endif
+
+/**
+ * The largest nxn matrix size to run through the dense Householder reference,
+ * which is O(n^4) and needs three more nxn buffers.
+ */
+#if BENCH_QRD_MAX_SZ < 64
+#define BENCH_QRD_DENSE_MAX_SZ BENCH_QRD_MAX_SZ
+#else
+#define BENCH_QRD_DENSE_MAX_SZ (64U)
+#endif
+
+static zsl_real_t bench_qrd_m[BENCH_QRD_MAX_SZ * BENCH_QRD_MAX_SZ];
+static zsl_real_t bench_qrd_q[BENCH_QRD_MAX_SZ * BENCH_QRD_MAX_SZ];
+static zsl_real_t bench_qrd_r[BENCH_QRD_MAX_SZ * BENCH_QRD_MAX_SZ];
+static zsl_real_t bench_qrd_tau[BENCH_QRD_MAX_SZ];
+static zsl_real_t bench_qrd_h[BENCH_QRD_DENSE_MAX_SZ * BENCH_QRD_DENSE_MAX_SZ];
+static zsl_real_t bench_qrd_qt[BENCH_QRD_DENSE_MAX_SZ * BENCH_QRD_DENSE_MAX_SZ];
+static zsl_real_t bench_qrd_t[BENCH_QRD_DENSE_MAX_SZ * BENCH_QRD_DENSE_MAX_SZ];
+
+/** The largest nxn matrix size used in the eigenvalue benchmark. */
+#define BENCH_EIG_MAX_SZ (16U)
+
+/**
+ * The largest number of iterations tried with the fixed-iteration
+ * zsl_mtx_eigenvalues, while looking for the count that matches the
+ * accuracy of zsl_mtx_eigenvalues_francis.
+ */
+#define BENCH_EIG_MAX_ITER (4096U)
+
+/** The largest nxn matrix size used in the symmetric eigensolver benchmark. */
+#define BENCH_EIG_SYM_MAX_SZ (32U)
+
+/** The number of QR iterations given to zsl_mtx_eigenvectors. */
+#define BENCH_EIG_VEC_ITER (500U)
+
+/**
+ * The shape of the tall matrix used in the SVD and pseudo-inverse benchmark,
+ * a sensor array least-squares problem. The matrices and workspace are
+ * statically allocated, so fewer rows are used on devices with little SRAM.
+ */
+#if defined(CONFIG_SRAM_SIZE) && (CONFIG_SRAM_SIZE < 192)
+#define BENCH_SVD_ROWS (50U)
+#else
+#define BENCH_SVD_ROWS (200U)
+#endif
+#define BENCH_SVD_COLS (20U)
+
+/** The largest nxn matrix size to run through zsl_mtx_svd for reference. */
+#define BENCH_SVD_FULL_MAX_SZ (16U)
+
+static zsl_real_t bench_svd_m[BENCH_SVD_ROWS * BENCH_SVD_COLS];
+static zsl_real_t bench_svd_u[BENCH_SVD_ROWS * BENCH_SVD_COLS];
+static zsl_real_t bench_svd_v[BENCH_SVD_COLS * BENCH_SVD_COLS];
+static zsl_real_t bench_svd_s[BENCH_SVD_COLS];
+static zsl_real_t bench_svd_p[BENCH_SVD_ROWS * BENCH_SVD_COLS];
+static zsl_real_t bench_svd_ws[(2 * BENCH_SVD_ROWS * BENCH_SVD_COLS) +
+			       (BENCH_SVD_COLS * BENCH_SVD_COLS) +
+			       (2 * BENCH_SVD_COLS) + (2 * BENCH_SVD_ROWS)];
+
+/**
+ * The number of rows used in the least-squares benchmark. The data is
+ * statically allocated, so fewer rows are used on devices with little SRAM.
+ */
+#if defined(CONFIG_SRAM_SIZE) && (CONFIG_SRAM_SIZE < 192)
+#define BENCH_LS_ROWS (1000U)
+#else
+#define BENCH_LS_ROWS (10000U)
+#endif
+
+static zsl_real_t bench_ls_x[BENCH_LS_ROWS * 3];
+static zsl_real_t bench_ls_y[BENCH_LS_ROWS];
+static zsl_real_t bench_ls_w[BENCH_LS_ROWS];
+
+/** The number of times to execute the vector sort code under test. */
+#define BENCH_SORT_LOOPS (10U)
+
+/**
+ * The largest vector length used in the sort benchmark. As with the matrix
+ * multiplication benchmark, this is limited on devices with little SRAM.
+ */
+#if defined(CONFIG_SRAM_SIZE) && (CONFIG_SRAM_SIZE < 192)
+#define BENCH_SORT_MAX_SZ (256U)
+#elif defined(CONFIG_SRAM_SIZE) && (CONFIG_SRAM_SIZE < 2048)
+#define BENCH_SORT_MAX_SZ (4096U)
+#else
+#define BENCH_SORT_MAX_SZ (65536U)
+#endif
+
+static zsl_real_t bench_sort_v[BENCH_SORT_MAX_SZ];
+static zsl_real_t bench_sort_w[BENCH_SORT_MAX_SZ];
+
+/** The smallest number of samples used in the magnetometer calibration
+ * benchmark. */
+#define BENCH_CAL_MIN_SZ (50U)
+
+/**
+ * The largest number of samples used in the magnetometer calibration
+ * benchmark. The reference implementation is quadratic in the number of
+ * samples, so this is kept small.
+ */
+#define BENCH_CAL_MAX_SZ (400U)
+
+static zsl_real_t bench_cal_m[BENCH_CAL_MAX_SZ * 3];
+
+/** The number of (u, v) points used in the CCT benchmark. */
+#define BENCH_CCT_SZ (256U)
+
+static struct zsl_clr_uv60 bench_cct_uv[BENCH_CCT_SZ];
+static struct zsl_clr_uv60 bench_cct_shuf[BENCH_CCT_SZ];
+static struct zsl_clr_cct bench_cct_out[BENCH_CCT_SZ];
+
 void print_settings(void)
 {
 	printk("BOARD:                       %s\n", CONFIG_BOARD);
@@ -72,6 +235,1636 @@ void test_vec_add(void)
 	printk("zsl_vec_add (avg): %u ns\n", instr_total / BENCH_LOOPS);
 }
 
+/**
+ * Fills matrix 'm' with deterministic, well-conditioned pseudo-random values,
+ * so that results are comparable between runs and platforms.
+ */
+static void bench_mtx_fill(struct zsl_mtx *m)
+{
+	uint32_t seed = 0x2545F491;
+
+	for (size_t i = 0; i < m->sz_rows * m->sz_cols; i++) {
+		seed = seed * 1664525U + 1013904223U;
+		m->data[i] = (zsl_real_t)(seed >> 8) / (zsl_real_t)(1U << 24) - 0.5;
+	}
+
+	/* Make the matrix diagonally dominant. */
+	for (size_t i = 0; i < m->sz_rows && i < m->sz_cols; i++) {
+		m->data[(i * m->sz_cols) + i] += (zsl_real_t)m->sz_cols;
+	}
+}
+
+/**
+ * Reference determinant using recursive cofactor expansion along row 0, as
+ * previously used by zsl_mtx_deter for matrices larger than 3x3.
+ */
+static zsl_real_t bench_deter_cofactor(struct zsl_mtx *m)
+{
+	zsl_real_t d = 0.0;
+	zsl_real_t sign = 1.0;
+
+	if (m->sz_rows <= 3) {
+		zsl_mtx_deter(m, &d);
+		return d;
+	}
+
+	ZSL_MATRIX_DEF(mr, (m->sz_rows - 1), (m->sz_rows - 1));
+
+	for (size_t g = 0; g < m->sz_cols; g++) {
+		zsl_mtx_reduce(m, &mr, 0, g);
+		d += sign * m->data[g] * bench_deter_cofactor(&mr);
+		sign = -sign;
+	}
+
+	return d;
+}
+
+void test_mtx_deter(void)
+{
+	uint32_t instr;
+	zsl_real_t d;
+
+	printk("zsl_mtx_deter (avg):\n");
+
+	for (size_t n = BENCH_MTX_MIN_SZ; n <= BENCH_MTX_MAX_SZ; n++) {
+		ZSL_MATRIX_DEF(m, n, n);
+		bench_mtx_fill(&m);
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			zsl_mtx_deter(&m, &d);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %2u x %2u  lu:       %10u ns\n", (uint32_t)n,
+		       (uint32_t)n, instr / BENCH_MTX_LOOPS);
+
+		if (n > BENCH_DETER_COFACTOR_MAX_SZ) {
+			continue;
+		}
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			d = bench_deter_cofactor(&m);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %2u x %2u  cofactor: %10u ns\n", (uint32_t)n,
+		       (uint32_t)n, instr / BENCH_MTX_LOOPS);
+	}
+}
+
+/**
+ * Reference product using the i-j-k loop previously used by zsl_mtx_mult,
+ * which walks 'mb' with a column stride. The operand copies that kernel
+ * also made are omitted, so this slightly flatters the old code.
+ */
+static void bench_mult_naive(struct zsl_mtx *ma, struct zsl_mtx *mb,
+			     struct zsl_mtx *mc)
+{
+	for (size_t i = 0; i < ma->sz_rows; i++) {
+		for (size_t j = 0; j < mb->sz_cols; j++) {
+			mc->data[j + i * mb->sz_cols] = 0;
+			for (size_t k = 0; k < ma->sz_cols; k++) {
+				mc->data[j + i * mb->sz_cols] +=
+					ma->data[k + i * ma->sz_cols] *
+					mb->data[j + k * mb->sz_cols];
+			}
+		}
+	}
+}
+
+void test_mtx_mult(void)
+{
+	uint32_t instr;
+
+	printk("zsl_mtx_mult (avg):\n");
+
+	for (size_t n = 8; n <= BENCH_MULT_MAX_SZ; n *= 2) {
+		struct zsl_mtx ma = { .sz_rows = n, .sz_cols = n,
+				      .data = bench_mult_a };
+		struct zsl_mtx mb = { .sz_rows = n, .sz_cols = n,
+				      .data = bench_mult_b };
+		struct zsl_mtx mc = { .sz_rows = n, .sz_cols = n,
+				      .data = bench_mult_c };
+
+		bench_mtx_fill(&ma);
+		bench_mtx_fill(&mb);
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			zsl_mtx_mult(&ma, &mb, &mc);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %2u x %2u  gemm:     %10u ns\n", (uint32_t)n,
+		       (uint32_t)n, instr / BENCH_MTX_LOOPS);
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			zsl_mtx_gemm(true, false, 1.0, &ma, &mb, 0.0, &mc);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %2u x %2u  gemm (at): %9u ns\n", (uint32_t)n,
+		       (uint32_t)n, instr / BENCH_MTX_LOOPS);
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			bench_mult_naive(&ma, &mb, &mc);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %2u x %2u  naive:    %10u ns\n", (uint32_t)n,
+		       (uint32_t)n, instr / BENCH_MTX_LOOPS);
+	}
+}
+
+/**
+ * Reference QR decomposition using the dense reflectors previously built by
+ * zsl_mtx_qrd: each step forms the full n x n matrix H = I - 2 * v * v^T,
+ * and applies it to R and Q^T with two matrix products.
+ */
+static void bench_qrd_dense(struct zsl_mtx *m, struct zsl_mtx *q,
+			    struct zsl_mtx *r)
+{
+	size_t n = m->sz_rows;
+	struct zsl_mtx h = { .sz_rows = n, .sz_cols = n, .data = bench_qrd_h };
+	struct zsl_mtx qt = { .sz_rows = n, .sz_cols = n,
+			      .data = bench_qrd_qt };
+	struct zsl_mtx t = { .sz_rows = n, .sz_cols = n, .data = bench_qrd_t };
+	zsl_real_t v[n];
+
+	zsl_mtx_copy(r, m);
+	zsl_mtx_init(&qt, zsl_mtx_entry_fn_identity);
+
+	for (size_t j = 0; j + 1 < n; j++) {
+		zsl_real_t norm = 0.0;
+
+		for (size_t i = j; i < n; i++) {
+			v[i] = r->data[(i * n) + j];
+			norm += v[i] * v[i];
+		}
+		norm = ZSL_SQRT(norm);
+		v[j] += (v[j] < 0.0) ? -norm : norm;
+
+		norm = 0.0;
+		for (size_t i = j; i < n; i++) {
+			norm += v[i] * v[i];
+		}
+		if (norm == 0.0) {
+			continue;
+		}
+		norm = ZSL_SQRT(norm);
+
+		zsl_mtx_init(&h, zsl_mtx_entry_fn_identity);
+		for (size_t i = j; i < n; i++) {
+			for (size_t k = j; k < n; k++) {
+				h.data[(i * n) + k] -= 2.0 * v[i] * v[k] /
+						       (norm * norm);
+			}
+		}
+
+		zsl_mtx_mult(&h, r, &t);
+		zsl_mtx_copy(r, &t);
+		zsl_mtx_mult(&h, &qt, &t);
+		zsl_mtx_copy(&qt, &t);
+	}
+
+	zsl_mtx_trans(&qt, q);
+}
+
+void test_mtx_qrd(void)
+{
+	uint32_t instr;
+
+	printk("zsl_mtx_qrd (avg):\n");
+
+	for (size_t n = 8; n <= BENCH_QRD_MAX_SZ; n *= 2) {
+		struct zsl_mtx m = { .sz_rows = n, .sz_cols = n,
+				     .data = bench_qrd_m };
+		struct zsl_mtx q = { .sz_rows = n, .sz_cols = n,
+				     .data = bench_qrd_q };
+		struct zsl_mtx r = { .sz_rows = n, .sz_cols = n,
+				     .data = bench_qrd_r };
+		struct zsl_vec tau = { .sz = n - 1, .data = bench_qrd_tau };
+
+		bench_mtx_fill(&m);
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			zsl_mtx_qrd(&m, &q, &r, false);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %3u x %3u  qrd:       %10u ns\n", (uint32_t)n,
+		       (uint32_t)n, instr / BENCH_MTX_LOOPS);
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			zsl_mtx_qrd_compact(&m, &r, &tau, false);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %3u x %3u  compact:   %10u ns\n", (uint32_t)n,
+		       (uint32_t)n, instr / BENCH_MTX_LOOPS);
+
+		if (n > BENCH_QRD_DENSE_MAX_SZ) {
+			continue;
+		}
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			bench_qrd_dense(&m, &q, &r);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %3u x %3u  dense:     %10u ns\n", (uint32_t)n,
+		       (uint32_t)n, instr / BENCH_MTX_LOOPS);
+	}
+}
+
+/**
+ * Fills the square matrix 'm' with a symmetric matrix whose eigenvalues are
+ * spread out roughly between 0 and n - 1, so that they are all real and
+ * can be compared between the two eigenvalue methods.
+ */
+static void bench_eig_fill(struct zsl_mtx *m)
+{
+	size_t n = m->sz_rows;
+
+	bench_mtx_fill(m);
+	for (size_t i = 0; i < n; i++) {
+		m->data[(i * n) + i] = (zsl_real_t)i;
+		for (size_t j = 0; j < i; j++) {
+			m->data[(j * n) + i] = m->data[(i * n) + j];
+		}
+	}
+}
+
+void test_mtx_eigenvalues(void)
+{
+	uint32_t instr;
+	size_t iter;
+
+	printk("zsl_mtx_eigenvalues (avg):\n");
+
+	for (size_t n = 4; n <= BENCH_EIG_MAX_SZ; n *= 2) {
+		ZSL_MATRIX_DEF(m, n, n);
+		ZSL_VECTOR_DEF(re, n);
+		ZSL_VECTOR_DEF(im, n);
+
+		bench_eig_fill(&m);
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			zsl_mtx_eigenvalues_francis(&m, &re, &im, 0.0, 30 * n,
+						    &iter);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %2u x %2u  francis (%4u iter): %10u ns\n",
+		       (uint32_t)n, (uint32_t)n, (uint32_t)iter,
+		       instr / BENCH_MTX_LOOPS);
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+		ZSL_VECTOR_DEF(v, n);
+		zsl_real_t err = 0.0;
+
+		/* Find the number of fixed iterations needed to reach the same
+		 * eigenvalues, to within 1E-6. */
+		zsl_vec_sort(&re, &re);
+		for (iter = 16; iter <= BENCH_EIG_MAX_ITER; iter *= 2) {
+			zsl_mtx_eigenvalues(&m, &v, iter);
+			zsl_vec_sort(&v, &v);
+			err = 0.0;
+			for (size_t i = 0; i < n; i++) {
+				err = ZSL_MAX(err, ZSL_ABS(v.data[i] -
+							   re.data[i]));
+			}
+			if (err < 1E-6) {
+				break;
+			}
+		}
+
+		if (iter > BENCH_EIG_MAX_ITER) {
+			printk("  %2u x %2u  fixed: no match in %u iter "
+			       "(error %e)\n", (uint32_t)n, (uint32_t)n,
+			       BENCH_EIG_MAX_ITER, (double)err);
+			continue;
+		}
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			zsl_mtx_eigenvalues(&m, &v, iter);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %2u x %2u  fixed   (%4u iter): %10u ns\n",
+		       (uint32_t)n, (uint32_t)n, (uint32_t)iter,
+		       instr / BENCH_MTX_LOOPS);
+#endif
+	}
+}
+
+/**
+ * Returns the largest residual |m * x - r * x| over the columns x of 'mev',
+ * where r is the Rayleigh quotient of x, and sets 'orth' to the largest
+ * element of mev^T * mev - I.
+ */
+static zsl_real_t bench_eig_err(struct zsl_mtx *m, struct zsl_mtx *mev,
+				zsl_real_t *orth)
+{
+	size_t n = m->sz_rows;
+	zsl_real_t res = 0.0;
+	zsl_real_t mx[n];
+	zsl_real_t r, xx, e;
+
+	*orth = 0.0;
+	for (size_t j = 0; j < mev->sz_cols; j++) {
+		r = 0.0;
+		xx = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			mx[i] = 0.0;
+			for (size_t k = 0; k < n; k++) {
+				mx[i] += m->data[(i * n) + k] *
+					 mev->data[(k * mev->sz_cols) + j];
+			}
+			r += mx[i] * mev->data[(i * mev->sz_cols) + j];
+			xx += mev->data[(i * mev->sz_cols) + j] *
+			      mev->data[(i * mev->sz_cols) + j];
+		}
+		r /= xx;
+
+		e = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			mx[i] -= r * mev->data[(i * mev->sz_cols) + j];
+			e += mx[i] * mx[i];
+		}
+		res = ZSL_MAX(res, ZSL_SQRT(e / xx));
+
+		for (size_t k = 0; k < mev->sz_cols; k++) {
+			e = 0.0;
+			for (size_t i = 0; i < n; i++) {
+				e += mev->data[(i * mev->sz_cols) + j] *
+				     mev->data[(i * mev->sz_cols) + k];
+			}
+			*orth = ZSL_MAX(*orth, ZSL_ABS(e - (j == k ? 1.0 :
+								0.0)));
+		}
+	}
+
+	return res;
+}
+
+void test_mtx_eigen_sym(void)
+{
+	uint32_t instr;
+	zsl_real_t res, orth;
+
+	printk("zsl_mtx_eigen_sym (avg):\n");
+
+	for (size_t n = 4; n <= BENCH_EIG_SYM_MAX_SZ; n *= 2) {
+		ZSL_MATRIX_DEF(m, n, n);
+		ZSL_MATRIX_DEF(mev, n, n);
+		ZSL_VECTOR_DEF(v, n);
+
+		bench_eig_fill(&m);
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			zsl_mtx_eigen_sym(&m, &v, &mev);
+		}
+		ZSL_INSTR_STOP(instr);
+		res = bench_eig_err(&m, &mev, &orth);
+		printk("  %2u x %2u  vectors:      %10u ns, residual %e, "
+		       "orthogonality %e\n", (uint32_t)n, (uint32_t)n,
+		       instr / BENCH_MTX_LOOPS, (double)res, (double)orth);
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			zsl_mtx_eigen_sym(&m, &v, NULL);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %2u x %2u  values:       %10u ns\n", (uint32_t)n,
+		       (uint32_t)n, instr / BENCH_MTX_LOOPS);
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+		/* The general eigenvector routine needs far more memory, so it
+		 * is only compared for the smaller sizes. */
+		if (n > BENCH_EIG_MAX_SZ) {
+			continue;
+		}
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			mev.sz_cols = n;
+			zsl_mtx_eigenvectors(&m, &mev, BENCH_EIG_VEC_ITER,
+					     true);
+		}
+		ZSL_INSTR_STOP(instr);
+		res = bench_eig_err(&m, &mev, &orth);
+		printk("  %2u x %2u  eigenvectors: %10u ns, residual %e, "
+		       "orthogonality %e (%u of %u vectors)\n", (uint32_t)n,
+		       (uint32_t)n, instr / BENCH_MTX_LOOPS, (double)res,
+		       (double)orth, (uint32_t)mev.sz_cols, (uint32_t)n);
+#endif
+	}
+}
+
+/**
+ * Returns the largest element of m - u * diag(s) * v^T, using the first k
+ * columns of 'u' and 'v'. The singular values are 'inc' apart in 's'.
+ */
+static zsl_real_t bench_svd_err(struct zsl_mtx *m, struct zsl_mtx *u,
+				const zsl_real_t *s, size_t inc,
+				struct zsl_mtx *v, size_t k)
+{
+	zsl_real_t err = 0.0;
+	zsl_real_t x;
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		for (size_t j = 0; j < m->sz_cols; j++) {
+			x = m->data[(i * m->sz_cols) + j];
+			for (size_t l = 0; l < k; l++) {
+				x -= u->data[(i * u->sz_cols) + l] * s[l * inc] *
+				     v->data[(j * v->sz_cols) + l];
+			}
+			err = ZSL_MAX(err, ZSL_ABS(x));
+		}
+	}
+
+	return err;
+}
+
+void test_mtx_svd(void)
+{
+	uint32_t instr;
+	size_t rank;
+	struct zsl_ws ws;
+	static const size_t shape[3][2] = {
+		{ 8, 8 }, { 16, 16 }, { BENCH_SVD_ROWS, BENCH_SVD_COLS }
+	};
+
+	printk("zsl_mtx_svd_thin (avg):\n");
+
+	zsl_ws_init(&ws, bench_svd_ws, sizeof(bench_svd_ws));
+
+	for (size_t g = 0; g < 3; g++) {
+		size_t r = shape[g][0];
+		size_t c = shape[g][1];
+		struct zsl_mtx m = { .sz_rows = r, .sz_cols = c,
+				     .data = bench_svd_m };
+		struct zsl_mtx u = { .sz_rows = r, .sz_cols = c,
+				     .data = bench_svd_u };
+		struct zsl_mtx v = { .sz_rows = c, .sz_cols = c,
+				     .data = bench_svd_v };
+		struct zsl_vec sv = { .sz = c, .data = bench_svd_s };
+		struct zsl_mtx p = { .sz_rows = c, .sz_cols = r,
+				     .data = bench_svd_p };
+
+		bench_mtx_fill(&m);
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			zsl_mtx_svd_thin_ws(&m, &u, &sv, &v, &ws);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %3u x %2u  svd_thin:    %10u ns, error %e\n",
+		       (uint32_t)r, (uint32_t)c, instr / BENCH_MTX_LOOPS,
+		       (double)bench_svd_err(&m, &u, sv.data, 1, &v, c));
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			zsl_mtx_pinv_tol_ws(&m, &p, 0.0, &rank, &ws);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %3u x %2u  pinv_tol:    %10u ns (rank %u)\n",
+		       (uint32_t)r, (uint32_t)c, instr / BENCH_MTX_LOOPS,
+		       (uint32_t)rank);
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+		/* The previous SVD needs O(n^2) temporaries for each of its
+		 * two eigenvector problems, so it is only run on the small
+		 * square matrices. */
+		if ((r != c) || (r > BENCH_SVD_FULL_MAX_SZ)) {
+			continue;
+		}
+
+		ZSL_MATRIX_DEF(uf, r, r);
+		ZSL_MATRIX_DEF(ef, r, c);
+		ZSL_MATRIX_DEF(vf, c, c);
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+			zsl_mtx_svd(&m, &uf, &ef, &vf, 150);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %3u x %2u  svd (150):   %10u ns, error %e\n",
+		       (uint32_t)r, (uint32_t)c, instr / BENCH_MTX_LOOPS,
+		       (double)bench_svd_err(&m, &uf, ef.data, c + 1, &vf, c));
+#endif
+	}
+}
+
+/**
+ * Reference least-squares fit through the normal equations X^T X b = X^T y,
+ * accumulated row by row, as zsl_sta_mult_linear_reg previously solved it.
+ */
+static int bench_ls_normal(struct zsl_mtx *x, struct zsl_vec *y,
+			   struct zsl_vec *b)
+{
+	size_t p = x->sz_cols + 1;
+	zsl_real_t row[p];
+
+	ZSL_MATRIX_DEF(xtx, p, p);
+	ZSL_MATRIX_DEF(xty, p, 1);
+	ZSL_MATRIX_DEF(bm, p, 1);
+
+	zsl_mtx_init(&xtx, NULL);
+	zsl_mtx_init(&xty, NULL);
+
+	for (size_t i = 0; i < x->sz_rows; i++) {
+		row[0] = 1.0;
+		for (size_t j = 1; j < p; j++) {
+			row[j] = x->data[(i * x->sz_cols) + j - 1];
+		}
+		for (size_t j = 0; j < p; j++) {
+			for (size_t k = 0; k < p; k++) {
+				xtx.data[(j * p) + k] += row[j] * row[k];
+			}
+			xty.data[j] += row[j] * y->data[i];
+		}
+	}
+
+	int rc = zsl_mtx_solve_spd(&xtx, &xty, &bm);
+
+	zsl_vec_from_arr(b, bm.data);
+
+	return rc;
+}
+
+/** Returns the largest difference between 'b' and the 'n' values in 'e'. */
+static zsl_real_t bench_ls_err(struct zsl_vec *b, const zsl_real_t *e,
+			       size_t n)
+{
+	zsl_real_t err = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		err = ZSL_MAX(err, ZSL_ABS(b->data[i] - e[i]));
+	}
+
+	return err;
+}
+
+void test_sta_lstsq(void)
+{
+	uint32_t instr;
+	int rc;
+	zsl_real_t r, t;
+	struct zsl_mtx x = { .sz_rows = BENCH_LS_ROWS, .sz_cols = 3,
+			     .data = bench_ls_x };
+	struct zsl_vec y = { .sz = BENCH_LS_ROWS, .data = bench_ls_y };
+	struct zsl_vec w = { .sz = BENCH_LS_ROWS, .data = bench_ls_w };
+
+	/* y = 1 + 2 t - 0.05 t^2 + 0.5 sin(i), for t in [10, 20]. The t and
+	 * t^2 columns are close to collinear with the intercept. */
+	static const zsl_real_t be[4] = { 1.0, 2.0, -0.05, 0.5 };
+
+	/* The sphere of radius 2 centred on (1, 0, -1). */
+	static const zsl_real_t qe[9] = {
+		0.5, 0.5, 0.5, 0.0, 0.0, 0.0, -0.5, 0.0, 0.5
+	};
+
+	ZSL_VECTOR_DEF(b, 4);
+	ZSL_VECTOR_DEF(q, 9);
+
+	printk("zsl_sta_mult_linear_reg (avg):\n");
+
+	for (size_t i = 0; i < BENCH_LS_ROWS; i++) {
+		t = 10.0 + 10.0 * (zsl_real_t)i / (zsl_real_t)BENCH_LS_ROWS;
+		bench_ls_x[i * 3] = t;
+		bench_ls_x[i * 3 + 1] = t * t;
+		bench_ls_x[i * 3 + 2] = ZSL_SIN((zsl_real_t)i);
+		bench_ls_y[i] = be[0] + be[1] * t + be[2] * t * t +
+				be[3] * bench_ls_x[i * 3 + 2];
+		bench_ls_w[i] = 1.0 + (zsl_real_t)(i % 5);
+	}
+
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+		rc = zsl_sta_mult_linear_reg(&x, &y, &b, &r);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  %5u x 3  qr:       %10u ns, rc %d, coef. error %e\n",
+	       BENCH_LS_ROWS, instr / BENCH_MTX_LOOPS, rc,
+	       (double)bench_ls_err(&b, be, 4));
+
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+		rc = zsl_sta_weighted_mult_linear_reg(&x, &y, &w, &b, &r);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  %5u x 3  weighted: %10u ns, rc %d, coef. error %e\n",
+	       BENCH_LS_ROWS, instr / BENCH_MTX_LOOPS, rc,
+	       (double)bench_ls_err(&b, be, 4));
+
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+		rc = bench_ls_normal(&x, &y, &b);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  %5u x 3  normal:   %10u ns, rc %d, coef. error %e\n",
+	       BENCH_LS_ROWS, instr / BENCH_MTX_LOOPS, rc,
+	       (double)bench_ls_err(&b, be, 4));
+
+	printk("zsl_sta_quad_fit (avg):\n");
+
+	for (size_t i = 0; i < BENCH_LS_ROWS; i++) {
+		t = ZSL_PI * ((zsl_real_t)i / (zsl_real_t)BENCH_LS_ROWS - 0.5);
+		bench_ls_x[i * 3] = 1.0 + 2.0 * ZSL_COS(t) *
+				    ZSL_COS((zsl_real_t)i);
+		bench_ls_x[i * 3 + 1] = 2.0 * ZSL_COS(t) *
+					ZSL_SIN((zsl_real_t)i);
+		bench_ls_x[i * 3 + 2] = -1.0 + 2.0 * ZSL_SIN(t);
+	}
+
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_MTX_LOOPS; i++) {
+		rc = zsl_sta_quad_fit(&x, &q);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  %5u points:       %10u ns, rc %d, coef. error %e\n",
+	       BENCH_LS_ROWS, instr / BENCH_MTX_LOOPS, rc,
+	       (double)bench_ls_err(&q, qe, 9));
+}
+
+static int bench_sort_cmp(const void *a, const void *b)
+{
+	zsl_real_t x = *(const zsl_real_t *)a;
+	zsl_real_t y = *(const zsl_real_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+void test_vec_sort(void)
+{
+	uint32_t instr;
+	uint32_t seed = 0x2545F491;
+
+	printk("zsl_vec_sort (avg):\n");
+
+	/* Random values with some repeats, as seen in sensor sample windows. */
+	for (size_t i = 0; i < BENCH_SORT_MAX_SZ; i++) {
+		seed = seed * 1664525U + 1013904223U;
+		bench_sort_v[i] = (zsl_real_t)(seed >> 16) / 16.0;
+	}
+
+	for (size_t n = 16; n <= BENCH_SORT_MAX_SZ; n *= 4) {
+		struct zsl_vec v = { .sz = n, .data = bench_sort_v };
+		struct zsl_vec w = { .sz = n, .data = bench_sort_w };
+
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_SORT_LOOPS; i++) {
+			zsl_vec_sort(&v, &w);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %5u  random:   %10u ns\n", (uint32_t)n,
+		       instr / BENCH_SORT_LOOPS);
+
+		/* 'w' is now sorted, so this times the presorted case. */
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_SORT_LOOPS; i++) {
+			zsl_vec_sort(&w, &w);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %5u  sorted:   %10u ns\n", (uint32_t)n,
+		       instr / BENCH_SORT_LOOPS);
+
+		/* Reference: the C library's qsort on the same input. */
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_SORT_LOOPS; i++) {
+			memcpy(bench_sort_w, bench_sort_v, n * sizeof(zsl_real_t));
+			qsort(bench_sort_w, n, sizeof(zsl_real_t), bench_sort_cmp);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %5u  qsort:    %10u ns\n", (uint32_t)n,
+		       instr / BENCH_SORT_LOOPS);
+	}
+}
+
+/**
+ * Reference EKF update using the generic zsl_mtx functions, as previously
+ * done by zsl_fus_kalm_feed. It takes the state after the filter has been
+ * seeded, and no magnetic inclination.
+ */
+static int bench_kalm_generic(struct zsl_vec *g, struct zsl_vec *a,
+			      struct zsl_vec *m, struct zsl_fus_kalm_cfg *cfg,
+			      struct zsl_quat *q)
+{
+	int rc;
+	zsl_real_t if2 = 1.0 / (2.0 * cfg->freq);
+	struct zsl_mtx *P = &cfg->P;
+
+	/* Prediction: P = F * P * Ft + Q. */
+	ZSL_MATRIX_DEF(F, 4, 4);
+	ZSL_MATRIX_DEF(Ft, 4, 4);
+	zsl_real_t F_data[16] = {
+		1.0, -if2 * g->data[0], -if2 * g->data[1], -if2 * g->data[2],
+		if2 * g->data[0], 1.0, if2 * g->data[2], -if2 * g->data[1],
+		if2 * g->data[1], -if2 * g->data[2], 1.0, if2 * g->data[0],
+		if2 * g->data[2], if2 * g->data[1], -if2 * g->data[0], 1.0,
+	};
+	zsl_mtx_from_arr(&F, F_data);
+	zsl_mtx_trans(&F, &Ft);
+
+	ZSL_MATRIX_DEF(W, 4, 3);
+	ZSL_MATRIX_DEF(Wt, 3, 4);
+	zsl_real_t W_data[12] = {
+		-q->i, -q->j, -q->k,
+		q->r, -q->k,  q->j,
+		q->k,  q->r, -q->i,
+		-q->j,  q->i,  q->r
+	};
+	zsl_mtx_from_arr(&W, W_data);
+	zsl_mtx_trans(&W, &Wt);
+
+	ZSL_MATRIX_DEF(Q, 4, 4);
+	zsl_mtx_mult(&W, &Wt, &Q);
+	zsl_mtx_scalar_mult_d(&Q, cfg->var_g * if2 * if2);
+
+	ZSL_MATRIX_DEF(FP, 4, 4);
+	zsl_mtx_mult(&F, P, &FP);
+	zsl_mtx_mult(&FP, &Ft, P);
+	zsl_mtx_add_d(P, &Q);
+
+	zsl_quat_from_ang_vel(g, q, 1.0 / cfg->freq, q);
+
+	/* Correction. */
+	zsl_vec_to_unit(a);
+	zsl_vec_to_unit(m);
+
+	ZSL_MATRIX_DEF(z, 6, 1);
+	z.data[0] = a->data[0];
+	z.data[1] = a->data[1];
+	z.data[2] = a->data[2];
+	z.data[3] = m->data[0];
+	z.data[4] = m->data[1];
+	z.data[5] = m->data[2];
+
+	struct zsl_quat qm = {
+		.r = 0.0, .i = m->data[0], .j = m->data[1], .k = m->data[2]
+	};
+	struct zsl_quat gv = { .r = 0.0, .i = 0.0, .j = 0.0, .k = -1.0 };
+	struct zsl_quat mg = { .r = 0.0, .i = 0.0, .j = 0.0, .k = 0.0 };
+	struct zsl_quat hq;
+
+	zsl_quat_rot(q, &qm, &hq);
+	mg.i = ZSL_SQRT(hq.i * hq.i + hq.j * hq.j);
+	mg.k = hq.k;
+	zsl_quat_to_unit_d(&mg);
+
+	ZSL_MATRIX_DEF(h, 6, 1);
+	struct zsl_quat a2;
+	struct zsl_quat m2;
+
+	zsl_quat_rot(q, &gv, &a2);
+	zsl_quat_rot(q, &mg, &m2);
+	h.data[0] = 2.0 * a2.i;
+	h.data[1] = 2.0 * a2.j;
+	h.data[2] = 2.0 * a2.k;
+	h.data[3] = 2.0 * m2.i;
+	h.data[4] = 2.0 * m2.j;
+	h.data[5] = 2.0 * m2.k;
+
+	ZSL_MATRIX_DEF(H, 6, 4);
+	ZSL_MATRIX_DEF(Ht, 4, 6);
+	zsl_real_t H_data[24] = {
+		q->j, -q->k, q->r, -q->i,
+		-q->i, -q->r, -q->k, -q->j,
+		0.0, 2.0 * q->i, 2.0 * q->j, 0.0,
+		-mg.k * q->j, mg.k * q->k, -2.0 * mg.i * q->j - mg.k * q->r,
+		-2.0 * mg.i * q->k + mg.k * q->i,
+		-mg.i * q->k + mg.k * q->i,  mg.i * q->j + mg.k * q->r,
+		mg.i * q->i + mg.k * q->k, -mg.i * q->r + mg.k * q->j,
+		mg.i * q->j, mg.i * q->k - 2.0 * mg.k * q->i,
+		mg.i * q->r - 2.0 * mg.k * q->j, mg.i * q->i
+	};
+	zsl_mtx_from_arr(&H, H_data);
+	zsl_mtx_scalar_mult_d(&H, 2.0);
+	zsl_mtx_trans(&H, &Ht);
+
+	ZSL_MATRIX_DEF(R, 6, 6);
+	zsl_mtx_init(&R, zsl_mtx_entry_fn_identity);
+	for (size_t i = 0; i < 6; i++) {
+		zsl_mtx_set(&R, i, i, (i < 3) ? cfg->var_a : cfg->var_m);
+	}
+
+	ZSL_MATRIX_DEF(v, 6, 1);
+	ZSL_MATRIX_DEF(S, 6, 6);
+	ZSL_MATRIX_DEF(K, 4, 6);
+	zsl_mtx_sub(&z, &h, &v);
+
+	ZSL_MATRIX_DEF(HP, 6, 4);
+	ZSL_MATRIX_DEF(HPHt, 6, 6);
+	zsl_mtx_mult(&H, P, &HP);
+	zsl_mtx_mult(&HP, &Ht, &HPHt);
+	zsl_mtx_add(&HPHt, &R, &S);
+
+	ZSL_MATRIX_DEF(PHt, 4, 6);
+	ZSL_MATRIX_DEF(PHtt, 6, 4);
+	ZSL_MATRIX_DEF(Kt, 6, 4);
+	zsl_mtx_mult(P, &Ht, &PHt);
+	zsl_mtx_trans(&PHt, &PHtt);
+	rc = zsl_mtx_solve(&S, &PHtt, &Kt);
+	if (rc) {
+		return rc;
+	}
+	zsl_mtx_trans(&Kt, &K);
+
+	ZSL_MATRIX_DEF(idx, 4, 4);
+	ZSL_MATRIX_DEF(KH, 4, 4);
+	zsl_mtx_init(&idx, zsl_mtx_entry_fn_identity);
+	zsl_mtx_mult(&K, &H, &KH);
+	zsl_mtx_sub_d(&idx, &KH);
+	zsl_mtx_mult(&idx, P, P);
+
+	ZSL_MATRIX_DEF(Kv, 4, 1);
+	zsl_mtx_mult(&K, &v, &Kv);
+	q->r += Kv.data[0];
+	q->i += Kv.data[1];
+	q->j += Kv.data[2];
+	q->k += Kv.data[3];
+	zsl_quat_to_unit_d(q);
+
+	return 0;
+}
+
+/**
+ * Sets 'a', 'm' and 'g' to the i'th sample of a synthetic recording of a
+ * slowly rotating sensor.
+ */
+static void bench_kalm_sample(uint32_t i, struct zsl_vec *a, struct zsl_vec *m,
+			      struct zsl_vec *g)
+{
+	zsl_real_t t = (zsl_real_t)(i % 1000) / 1000.0;
+
+	a->data[0] = 0.01 + 0.05 * t;
+	a->data[1] = -1.01;
+	a->data[2] = -0.02 - 0.05 * t;
+	m->data[0] = -66.0 + 4.0 * t;
+	m->data[1] = -98.0;
+	m->data[2] = -43.0 - 4.0 * t;
+	g->data[0] = 0.09;
+	g->data[1] = -0.28 + 0.1 * t;
+	g->data[2] = -0.07;
+}
+
+void test_fus_kalman(void)
+{
+	uint32_t instr;
+	zsl_real_t P_data[16];
+	zsl_real_t P_ref_data[16];
+	struct zsl_quat q = { .r = 1.0, .i = 0.0, .j = 0.0, .k = 0.0 };
+	struct zsl_quat q_ref;
+	struct zsl_fus_kalm_cfg cfg = {
+		.var_g = 0.001,
+		.var_a = 0.307,
+		.var_m = 0.2,
+		.P = { .sz_rows = 4, .sz_cols = 4, .data = P_data },
+	};
+	struct zsl_fus_kalm_cfg cfg_ref;
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+
+	printk("zsl_fus_kalm_feed (avg per sample):\n");
+
+	/* Seed the filter with the first sample, then start both
+	 * implementations from the same state. */
+	zsl_fus_kalm_init(1000, &cfg);
+	bench_kalm_sample(0, &a, &m, &g);
+	zsl_fus_kalm_feed(&a, &m, &g, NULL, &q, &cfg);
+	q_ref = q;
+	cfg_ref = cfg;
+	cfg_ref.P.data = P_ref_data;
+	memcpy(P_ref_data, P_data, sizeof(P_data));
+
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 1; i <= BENCH_LOOPS; i++) {
+		bench_kalm_sample(i, &a, &m, &g);
+		zsl_fus_kalm_feed(&a, &m, &g, NULL, &q, &cfg);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  fixed-size: %8u ns\n", instr / BENCH_LOOPS);
+
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 1; i <= BENCH_LOOPS; i++) {
+		bench_kalm_sample(i, &a, &m, &g);
+		bench_kalm_generic(&g, &a, &m, &cfg_ref, &q_ref);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  generic:    %8u ns\n", instr / BENCH_LOOPS);
+
+	printk("  |q - q_ref| after run: %e\n",
+	       (double)ZSL_MAX(ZSL_MAX(ZSL_ABS(q.r - q_ref.r),
+				       ZSL_ABS(q.i - q_ref.i)),
+			       ZSL_MAX(ZSL_ABS(q.j - q_ref.j),
+				       ZSL_ABS(q.k - q_ref.k))));
+}
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+static zsl_real_t bench_cal_f_elli(struct zsl_vec *H, zsl_real_t *g)
+{
+	zsl_real_t u[3] = { H->data[0] + g[6], H->data[1] + g[7],
+			    H->data[2] + g[8] };
+	zsl_real_t v[3] = { g[0] * u[0] + g[1] * u[1] + g[2] * u[2],
+			    g[1] * u[0] + g[3] * u[1] + g[4] * u[2],
+			    g[2] * u[0] + g[4] * u[1] + g[5] * u[2] };
+
+	return ZSL_SQRT(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+/**
+ * Reference magnetometer calibration, as previously done by zsl_fus_cal_magn.
+ * Every sample takes one damped step, whose Jacobian is rebuilt from all the
+ * samples and inverted with zsl_mtx_inv, so it is quadratic in N.
+ */
+static void bench_cal_magn_quadratic(struct zsl_mtx *m, zsl_real_t l,
+				     zsl_real_t mu, struct zsl_mtx *K,
+				     struct zsl_vec *b)
+{
+	zsl_real_t l_copy = l;
+	zsl_real_t mean = 0.0;
+
+	ZSL_VECTOR_DEF(v, m->sz_rows);
+	ZSL_VECTOR_DEF(w, m->sz_rows);
+
+	for (size_t i = 0; i < 3; i++) {
+		zsl_mtx_get_col(m, i, v.data);
+		zsl_vec_sort(&v, &w);
+		b->data[i] = -(w.data[m->sz_rows - 1] + w.data[0]) / 2.0;
+		mean += (w.data[m->sz_rows - 1] - w.data[0]) / 2.0;
+	}
+
+	zsl_real_t R = mean / 3.0;
+
+	ZSL_VECTOR_DEF(H, 3);
+	ZSL_VECTOR_DEF(Hb, 3);
+	ZSL_MATRIX_DEF(J, 1, 4);
+	ZSL_MATRIX_DEF(Jt, 4, 1);
+	ZSL_MATRIX_DEF(JtJ, 4, 4);
+	ZSL_MATRIX_DEF(idx, 4, 4);
+	ZSL_MATRIX_DEF(t, 4, 1);
+	zsl_real_t f, S = 0.0, S2;
+
+	zsl_mtx_init(&idx, zsl_mtx_entry_fn_identity);
+
+	for (size_t j = 0; j < m->sz_rows; j++) {
+		zsl_mtx_init(&J, NULL);
+		for (size_t i = 0; i < m->sz_rows; i++) {
+			zsl_mtx_get_row(m, i, H.data);
+			zsl_vec_add(&H, b, &Hb);
+			f = zsl_vec_norm(&Hb);
+			J.data[0] += 1.0;
+			J.data[1] += -(H.data[0] - b->data[0]) / f;
+			J.data[2] += -(H.data[1] - b->data[1]) / f;
+			J.data[3] += -(H.data[2] - b->data[2]) / f;
+		}
+
+		zsl_mtx_trans(&J, &Jt);
+		zsl_mtx_get_row(m, j, H.data);
+		zsl_vec_add(&H, b, &Hb);
+		f = zsl_vec_norm(&Hb);
+		zsl_mtx_mult(&Jt, &J, &JtJ);
+		for (size_t i = 0; i < 4; i++) {
+			idx.data[i * 5] = l * JtJ.data[i * 5];
+		}
+		zsl_mtx_add_d(&JtJ, &idx);
+		zsl_mtx_inv(&JtJ, &idx);
+		zsl_mtx_mult(&idx, &Jt, &t);
+		zsl_mtx_scalar_mult_d(&t, -(R - f));
+
+		R += t.data[0];
+		for (size_t i = 0; i < 3; i++) {
+			b->data[i] += t.data[i + 1];
+		}
+
+		if (j < (m->sz_rows - 1)) {
+			zsl_mtx_get_row(m, j + 1, H.data);
+			zsl_vec_add(&H, b, &Hb);
+			f = zsl_vec_norm(&Hb);
+			S2 = (S * j + (R - f) * (R - f)) / (zsl_real_t)(j + 1);
+			l = (S2 < S) ? l / mu : l * mu;
+			S = S2;
+		}
+	}
+
+	l = l_copy;
+	S = 0.0;
+
+	zsl_real_t g[9] = { 1.0, 0.0, 0.0, 1.0, 0.0, 1.0,
+			    b->data[0], b->data[1], b->data[2] };
+
+	ZSL_MATRIX_DEF(N, 1, 9);
+	ZSL_MATRIX_DEF(Nt, 9, 1);
+	ZSL_MATRIX_DEF(NtN, 9, 9);
+	ZSL_MATRIX_DEF(idxN, 9, 9);
+	ZSL_MATRIX_DEF(tN, 9, 1);
+	zsl_real_t A, B, C, x, y, z;
+
+	zsl_mtx_init(&idxN, zsl_mtx_entry_fn_identity);
+
+	for (size_t j = 0; j < m->sz_rows; j++) {
+		zsl_mtx_init(&N, NULL);
+		for (size_t i = 0; i < m->sz_rows; i++) {
+			zsl_mtx_get_row(m, i, H.data);
+			f = bench_cal_f_elli(&H, g);
+			x = H.data[0] + b->data[0];
+			y = H.data[1] + b->data[1];
+			z = H.data[2] + b->data[2];
+			A = g[0] * x + g[1] * y + g[2] * z;
+			B = g[1] * x + g[3] * y + g[4] * z;
+			C = g[2] * x + g[4] * y + g[5] * z;
+			N.data[0] += -x * A / f;
+			N.data[1] += -y * B / f;
+			N.data[2] += -z * C / f;
+			N.data[3] += -(y * A + x * B) / f;
+			N.data[4] += -(z * A + x * C) / f;
+			N.data[5] += -(z * B + y * C) / f;
+			N.data[6] += -A / f;
+			N.data[7] += -B / f;
+			N.data[8] += -C / f;
+		}
+
+		zsl_mtx_trans(&N, &Nt);
+		zsl_mtx_get_row(m, j, H.data);
+		f = bench_cal_f_elli(&H, g);
+		zsl_mtx_mult(&Nt, &N, &NtN);
+		for (size_t i = 0; i < 9; i++) {
+			idxN.data[i * 10] = l * NtN.data[i * 10];
+		}
+		zsl_mtx_add_d(&NtN, &idxN);
+		zsl_mtx_inv(&NtN, &idxN);
+		zsl_mtx_mult(&idxN, &Nt, &tN);
+		zsl_mtx_scalar_mult_d(&tN, -(R - f));
+
+		for (size_t i = 0; i < 9; i++) {
+			g[i] += tN.data[i];
+		}
+
+		if (j < (m->sz_rows - 1)) {
+			zsl_mtx_get_row(m, j + 1, H.data);
+			f = bench_cal_f_elli(&H, g);
+			S2 = (S * j + (R - f) * (R - f)) / (zsl_real_t)(j + 1);
+			l = (S2 < S) ? l / mu : l * mu;
+			S = S2;
+		}
+	}
+
+	K->data[0] = g[0];
+	K->data[1] = K->data[3] = g[1];
+	K->data[2] = K->data[6] = g[2];
+	K->data[4] = g[3];
+	K->data[5] = K->data[7] = g[4];
+	K->data[8] = g[5];
+	for (size_t i = 0; i < 3; i++) {
+		b->data[i] = g[i + 6];
+	}
+}
+
+/**
+ * Fills 'm' with samples spread over the ellipsoid of a magnetometer with
+ * known soft and hard iron errors, plus a little deterministic noise.
+ */
+static void bench_cal_fill(struct zsl_mtx *m)
+{
+	zsl_real_t ki[9] = {
+		0.84, -0.09, 0.04,
+		-0.09, 1.12, -0.08,
+		0.04, -0.08, 0.92
+	};
+	zsl_real_t bt[3] = { -12.5, 4.2, 30.1 };
+	zsl_real_t u[3], z, r, phi;
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		/* Spiral over the unit sphere, scaled to 50 uT. */
+		z = 1.0 - (2.0 * i + 1.0) / m->sz_rows;
+		r = ZSL_SQRT(1.0 - z * z);
+		phi = 2.39996322972865332 * i;
+		u[0] = 50.0 * r * ZSL_COS(phi);
+		u[1] = 50.0 * r * ZSL_SIN(phi);
+		u[2] = 50.0 * z;
+
+		for (size_t j = 0; j < 3; j++) {
+			m->data[i * 3 + j] = ki[j * 3] * u[0] +
+					     ki[j * 3 + 1] * u[1] +
+					     ki[j * 3 + 2] * u[2] - bt[j] +
+					     0.01 * ((int)((i * 7 + j * 3) % 11) - 5);
+		}
+	}
+}
+
+/**
+ * Returns the RMS relative deviation of the corrected sample magnitudes from
+ * their mean, which is zero for a perfect calibration.
+ */
+static zsl_real_t bench_cal_spread(struct zsl_mtx *m, struct zsl_mtx *K,
+				   struct zsl_vec *b)
+{
+	zsl_real_t sum = 0.0, sum2 = 0.0, n, mean;
+
+	ZSL_VECTOR_DEF(h, 3);
+	ZSL_VECTOR_DEF(c, 3);
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		zsl_mtx_get_row(m, i, h.data);
+		zsl_fus_cal_corr_vec(&h, K, b, &c);
+		n = zsl_vec_norm(&c);
+		sum += n;
+		sum2 += n * n;
+	}
+
+	mean = sum / m->sz_rows;
+
+	return ZSL_SQRT(ZSL_MAX(sum2 / m->sz_rows - mean * mean, 0.0)) / mean;
+}
+#endif
+
+void test_fus_cal_magn(void)
+{
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+	uint32_t instr;
+	zsl_real_t l = 1.0, mu = 10.0;
+
+	ZSL_MATRIX_DEF(K, 3, 3);
+	ZSL_VECTOR_DEF(b, 3);
+
+	printk("zsl_fus_cal_magn (total, rms magnitude spread):\n");
+
+	for (size_t n = BENCH_CAL_MIN_SZ; n <= BENCH_CAL_MAX_SZ; n *= 2) {
+		struct zsl_mtx m = { .sz_rows = n, .sz_cols = 3,
+				     .data = bench_cal_m };
+
+		bench_cal_fill(&m);
+
+		ZSL_INSTR_START(instr);
+		zsl_fus_cal_magn(&m, &l, &mu, &K, &b);
+		ZSL_INSTR_STOP(instr);
+		printk("  %4u samples:  linear:    %10u ns  %e\n", (uint32_t)n,
+		       instr, (double)bench_cal_spread(&m, &K, &b));
+
+		ZSL_INSTR_START(instr);
+		bench_cal_magn_quadratic(&m, l, mu, &K, &b);
+		ZSL_INSTR_STOP(instr);
+		printk("                quadratic: %10u ns  %e\n", instr,
+		       (double)bench_cal_spread(&m, &K, &b));
+	}
+#endif
+}
+
+/** Keeps the compiler from discarding results that are never read. */
+static volatile zsl_real_t bench_fast_sink;
+
+/**
+ * Returns the input of call 'i' out of BENCH_LOOPS, sweeping [lo, hi].
+ */
+static inline zsl_real_t bench_fast_x(uint32_t i, zsl_real_t lo, zsl_real_t hi)
+{
+	return lo + (hi - lo) * (zsl_real_t)i / (zsl_real_t)(BENCH_LOOPS - 1);
+}
+
+void test_fast_math(void)
+{
+	uint32_t instr;
+	zsl_real_t x, y, acc, err;
+
+	printk("Fast math (avg per call, max error):\n");
+
+	/* 1 / sqrt(x) over [1E-3, 1E3], relative error. */
+	acc = 0.0;
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		acc += 1.0 / ZSL_SQRT(bench_fast_x(i, 1E-3, 1E3));
+	}
+	ZSL_INSTR_STOP(instr);
+	bench_fast_sink = acc;
+	printk("  1/sqrt libm:    %8u ns\n", instr / BENCH_LOOPS);
+
+	acc = 0.0;
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		acc += zsl_fast_rsqrt(bench_fast_x(i, 1E-3, 1E3));
+	}
+	ZSL_INSTR_STOP(instr);
+	bench_fast_sink = acc;
+
+	err = 0.0;
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		x = bench_fast_x(i, 1E-3, 1E3);
+		y = zsl_fast_rsqrt(x) * ZSL_SQRT(x);
+		err = ZSL_MAX(err, ZSL_ABS(y - 1.0));
+	}
+	printk("  rsqrt fast:     %8u ns  %e (rel)\n", instr / BENCH_LOOPS,
+	       (double)err);
+
+	/* atan2(y, x) around the unit circle, absolute error. */
+	acc = 0.0;
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		x = bench_fast_x(i, -ZSL_PI, ZSL_PI);
+		acc += ZSL_ATAN2(ZSL_SIN(x), ZSL_COS(x));
+	}
+	ZSL_INSTR_STOP(instr);
+	bench_fast_sink = acc;
+	printk("  atan2 libm:     %8u ns (with sin and cos)\n",
+	       instr / BENCH_LOOPS);
+
+	acc = 0.0;
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		x = bench_fast_x(i, -ZSL_PI, ZSL_PI);
+		acc += zsl_fast_atan2(ZSL_SIN(x), ZSL_COS(x));
+	}
+	ZSL_INSTR_STOP(instr);
+	bench_fast_sink = acc;
+
+	err = 0.0;
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		x = bench_fast_x(i, -ZSL_PI, ZSL_PI);
+		y = zsl_fast_atan2(ZSL_SIN(x), ZSL_COS(x)) -
+		    ZSL_ATAN2(ZSL_SIN(x), ZSL_COS(x));
+		err = ZSL_MAX(err, ZSL_ABS(y));
+	}
+	printk("  atan2 fast:     %8u ns  %e rad (with sin and cos)\n",
+	       instr / BENCH_LOOPS, (double)err);
+
+	/* asin(x) over [-1, 1], absolute error. */
+	acc = 0.0;
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		acc += ZSL_ASIN(bench_fast_x(i, -1.0, 1.0));
+	}
+	ZSL_INSTR_STOP(instr);
+	bench_fast_sink = acc;
+	printk("  asin libm:      %8u ns\n", instr / BENCH_LOOPS);
+
+	acc = 0.0;
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		acc += zsl_fast_asin(bench_fast_x(i, -1.0, 1.0));
+	}
+	ZSL_INSTR_STOP(instr);
+	bench_fast_sink = acc;
+
+	err = 0.0;
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		x = bench_fast_x(i, -1.0, 1.0);
+		err = ZSL_MAX(err, ZSL_ABS(zsl_fast_asin(x) - ZSL_ASIN(x)));
+	}
+	printk("  asin fast:      %8u ns  %e rad\n", instr / BENCH_LOOPS,
+	       (double)err);
+
+	/* exp(x) over [-20, 20], relative error. */
+	acc = 0.0;
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		acc += ZSL_EXP(bench_fast_x(i, -20.0, 20.0));
+	}
+	ZSL_INSTR_STOP(instr);
+	bench_fast_sink = acc;
+	printk("  exp libm:       %8u ns\n", instr / BENCH_LOOPS);
+
+	acc = 0.0;
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		acc += zsl_fast_exp(bench_fast_x(i, -20.0, 20.0));
+	}
+	ZSL_INSTR_STOP(instr);
+	bench_fast_sink = acc;
+
+	err = 0.0;
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		x = bench_fast_x(i, -20.0, 20.0);
+		y = zsl_fast_exp(x) / ZSL_EXP(x);
+		err = ZSL_MAX(err, ZSL_ABS(y - 1.0));
+	}
+	printk("  exp fast:       %8u ns  %e (rel)\n", instr / BENCH_LOOPS,
+	       (double)err);
+}
+
+/** Ohno (2011) coefficients, as used by zsl_clr_conv_uv60_cct. */
+static const zsl_real_t bench_cct_k[7][7] = {
+	{ -1.77348E-01, 1.115559E+00, -1.5008606E+00, 9.750013E-01,
+	  -3.307009E-01, 5.6061400E-02, -3.7146000E-03 },
+	{ 5.308409E-04, 2.1595434E-03, -4.3534788E-03, 3.6196568E-03,
+	  -1.589747E-03, 3.5700160E-04, -3.2325500E-05 },
+	{ -8.58308927E-01, 1.964980251E+00, -1.873907584E+00, 9.53570888E-01,
+	  -2.73172022E-01, 4.17781315E-02, -2.6653835E-03 },
+	{ -2.3275027E+02, 1.49284136E+03, -2.7966888E+03, 2.51170136E+03,
+	  -1.1785121E+03, 2.7183365E+02, -2.3524950E+01 },
+	{ -5.926850606E+08, 1.34488160614E+09, -1.27141290956E+09,
+	  6.40976356945E+08, -1.81749963507E+08, 2.7482732935E+07,
+	  -1.731364909E+06 },
+	{ -2.3758158E+06, 3.89561742E+06, -2.65299138E+06, 9.60532935E+05,
+	  -1.9500061E+05, 2.10468274E+04, -9.4353083E+02 },
+	{ 2.8151771E+06, -4.11436958E+06, 2.48526954E+06, -7.93406005E+05,
+	  1.4101538E+05, -1.321007E+04, 5.0857956E+02 }
+};
+
+/**
+ * Evaluates a row of bench_cct_k with a ZSL_POW call per term, as previously
+ * done by zsl_clr_conv_uv60_cct.
+ */
+static zsl_real_t bench_cct_pow(zsl_real_t x, const zsl_real_t *k)
+{
+	return k[6] * ZSL_POW(x, 6) + k[5] * ZSL_POW(x, 5) +
+	       k[4] * ZSL_POW(x, 4) + k[3] * ZSL_POW(x, 3) +
+	       k[2] * ZSL_POW(x, 2) + k[1] * x + k[0];
+}
+
+/**
+ * Reference Ohno (2011) CCT and Duv, as previously computed by
+ * zsl_clr_conv_uv60_cct.
+ */
+static void bench_cct_ohno2011_pow(struct zsl_clr_uv60 *uv,
+				   struct zsl_clr_cct *cct)
+{
+	zsl_real_t l_fp, l_bb, a, t1, t2, dt_c1, dt_c2, c;
+
+	l_fp = ZSL_SQRT((uv->uv60_u - 0.292) * (uv->uv60_u - 0.292) +
+			(uv->uv60_v - 0.24) * (uv->uv60_v - 0.24));
+	a = ZSL_ATAN((uv->uv60_v - 0.24) / (uv->uv60_u - 0.292));
+	a = a >= 0.0 ? a : a + ZSL_PI;
+	l_bb = bench_cct_pow(a, bench_cct_k[0]);
+	cct->duv = l_fp - l_bb;
+
+	if (a < 2.54) {
+		t1 = 1 / bench_cct_pow(a, bench_cct_k[1]);
+		dt_c1 = bench_cct_pow(a, bench_cct_k[3]) *
+			(l_bb + 0.01) / l_fp * cct->duv / 0.01;
+	} else {
+		t1 = 1 / bench_cct_pow(a, bench_cct_k[2]);
+		dt_c1 = bench_cct_pow(a, bench_cct_k[4]) *
+			(l_bb + 0.01) / l_fp * cct->duv / 0.01;
+	}
+
+	t2 = t1 - dt_c1;
+	c = ZSL_LOG10(t2);
+
+	if (cct->duv >= 0.0) {
+		dt_c2 = bench_cct_pow(c, bench_cct_k[5]);
+	} else {
+		dt_c2 = bench_cct_pow(c, bench_cct_k[6]) *
+			ZSL_POW(cct->duv / 0.03, 2);
+	}
+
+	cct->cct = t2 - dt_c2;
+}
+
+/**
+ * Fills bench_cct_uv with points from 2000 K to 10000 K, with a Duv from
+ * -0.02 to 0.02.
+ */
+static void bench_cct_fill(void)
+{
+	struct zsl_clr_cct cct;
+	struct zsl_clr_xyy xyy;
+
+	memset(bench_cct_uv, 0, sizeof bench_cct_uv);
+	for (uint32_t i = 0; i < BENCH_CCT_SZ; i++) {
+		memset(&cct, 0, sizeof cct);
+		cct.cct = 2000.0 + 8000.0 * i / (BENCH_CCT_SZ - 1);
+		cct.duv = -0.02 + 0.04 * ((i * 7) % 16) / 15.0;
+		zsl_clr_conv_cct_xyy(&cct, ZSL_CLR_OBS_2_DEG, &xyy);
+		zsl_clr_conv_xyy_uv60(&xyy, &bench_cct_uv[i]);
+	}
+}
+
+void test_clr_cct(void)
+{
+	uint32_t instr;
+	zsl_real_t err = 0.0;
+	struct zsl_clr_cct ref;
+	const char *name[3] = { "mccamy", "ohno2011", "ohno2014" };
+	enum zsl_clr_uv_cct_method method[3] = {
+		ZSL_CLR_UV_CCT_METHOD_MCCAMY,
+		ZSL_CLR_UV_CCT_METHOD_OHNO2011,
+		ZSL_CLR_UV_CCT_METHOD_OHNO2014
+	};
+
+	printk("zsl_clr_conv_uv60_cct (avg per point, %u points):\n",
+	       BENCH_CCT_SZ);
+
+	bench_cct_fill();
+
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_CCT_SZ; i++) {
+		bench_cct_ohno2011_pow(&bench_cct_uv[i], &bench_cct_out[i]);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  ohno2011 pow:   %8u ns\n", instr / BENCH_CCT_SZ);
+
+	for (size_t m = 0; m < 3; m++) {
+		ZSL_INSTR_START(instr);
+		for (uint32_t i = 0; i < BENCH_CCT_SZ; i++) {
+			zsl_clr_conv_uv60_cct(method[m], &bench_cct_uv[i],
+					      &bench_cct_out[i]);
+		}
+		ZSL_INSTR_STOP(instr);
+		printk("  %-9s each:  %8u ns\n", name[m],
+		       instr / BENCH_CCT_SZ);
+
+		ZSL_INSTR_START(instr);
+		zsl_clr_conv_uv60_cct_n(method[m], BENCH_CCT_SZ, bench_cct_uv,
+					bench_cct_out);
+		ZSL_INSTR_STOP(instr);
+		printk("  %-9s _n:    %8u ns\n", name[m],
+		       instr / BENCH_CCT_SZ);
+	}
+
+	/* Ohno (2014) starts its table search from the previous match, which
+	 * helps when successive points are close, as above. Scramble them. */
+	for (uint32_t i = 0; i < BENCH_CCT_SZ; i++) {
+		bench_cct_shuf[i] = bench_cct_uv[(i * 97) % BENCH_CCT_SZ];
+	}
+	ZSL_INSTR_START(instr);
+	zsl_clr_conv_uv60_cct_n(ZSL_CLR_UV_CCT_METHOD_OHNO2014, BENCH_CCT_SZ,
+				bench_cct_shuf, bench_cct_out);
+	ZSL_INSTR_STOP(instr);
+	printk("  ohno2014  _n scrambled: %8u ns\n", instr / BENCH_CCT_SZ);
+
+	/* Check that the Horner form matches the previous results. */
+	zsl_clr_conv_uv60_cct_n(ZSL_CLR_UV_CCT_METHOD_OHNO2011, BENCH_CCT_SZ,
+				bench_cct_uv, bench_cct_out);
+	for (uint32_t i = 0; i < BENCH_CCT_SZ; i++) {
+		bench_cct_ohno2011_pow(&bench_cct_uv[i], &ref);
+		err = ZSL_MAX(err, ZSL_ABS(ref.cct - bench_cct_out[i].cct));
+	}
+	printk("  ohno2011 horner vs pow: %e K (max)\n", (double)err);
+}
+
+#if CONFIG_ZSL_FIXED
+/**
+ * Converts the sample from bench_kalm_sample to Q31. The accelerometer and
+ * magnetometer are scaled to fit, which doesn't change their direction.
+ */
+static void bench_fix_sample(struct zsl_vec *a, struct zsl_vec *m,
+			     struct zsl_vec *g, struct zsl_vec_q31 *aq,
+			     struct zsl_vec_q31 *mq, struct zsl_vec_q31 *gq)
+{
+	for (size_t i = 0; i < 3; i++) {
+		aq->data[i] = zsl_q31_from_real(a->data[i] / 2.0);
+		mq->data[i] = zsl_q31_from_real(m->data[i] / 128.0);
+		gq->data[i] = (zsl_q31_t)ZSL_ROUND(g->data[i] *
+						   (1 << ZSL_FIX_GYRO_FRAC));
+	}
+}
+
+/**
+ * Returns the angle, in degrees, of the rotation between 'q' and 'qq'.
+ */
+static zsl_real_t bench_fix_err(struct zsl_quat *q, struct zsl_quat_q31 *qq)
+{
+	struct zsl_quat qf;
+	zsl_real_t d;
+
+	zsl_quat_q31_to_quat(qq, &qf);
+	d = ZSL_ABS(q->r * qf.r + q->i * qf.i + q->j * qf.j + q->k * qf.k);
+
+	return 2.0 * ZSL_ACOS(ZSL_MIN(d, 1.0)) * ZSL_RAD_TO_DEG;
+}
+
+void test_fus_fixed(void)
+{
+	uint32_t instr;
+	zsl_real_t err;
+	struct zsl_quat q;
+	struct zsl_quat_q31 qq;
+	zsl_real_t intfb[3];
+	zsl_q31_t intfbq[3];
+	struct zsl_fus_madg_cfg madg_cfg = { .beta = 0.174 };
+	struct zsl_fus_madg_q31_cfg madg_cfgq = { .beta = ZSL_Q31(0.174) };
+	struct zsl_fus_mahn_cfg mahn_cfg = {
+		.kp = 0.6, .ki = 0.2, .integral_limit = 0.1,
+		.intfb = { .sz = 3, .data = intfb },
+	};
+	struct zsl_fus_mahn_q31_cfg mahn_cfgq = {
+		.kp = ZSL_Q31(0.6), .ki = ZSL_Q31(0.2),
+		.integral_limit = ZSL_Q_GYRO(0.1),
+		.intfb = { .sz = 3, .data = intfbq },
+	};
+	struct zsl_fus_comp_cfg comp_cfg = { .alpha = 0.02 };
+	struct zsl_fus_comp_q31_cfg comp_cfgq = { .alpha = ZSL_Q31(0.02) };
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+	ZSL_VECTOR_Q31_DEF(aq, 3);
+	ZSL_VECTOR_Q31_DEF(mq, 3);
+	ZSL_VECTOR_Q31_DEF(gq, 3);
+
+	printk("Q31 fusion filters (avg per sample, max error vs float):\n");
+
+	zsl_fus_madg_init(1000, &madg_cfg);
+	zsl_fus_madg_q31_init(1000, &madg_cfgq);
+	zsl_fus_mahn_init(1000, &mahn_cfg);
+	zsl_fus_mahn_q31_init(1000, &mahn_cfgq);
+	zsl_fus_comp_init(1000, &comp_cfg);
+	zsl_fus_comp_q31_init(1000, &comp_cfgq);
+
+	/* Time each implementation on its own... */
+	zsl_quat_init(&q, ZSL_QUAT_TYPE_IDENTITY);
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		bench_kalm_sample(i, &a, &m, &g);
+		zsl_fus_madg_feed(&a, &m, &g, NULL, &q, &madg_cfg);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  madgwick float: %8u ns\n", instr / BENCH_LOOPS);
+
+	zsl_quat_q31_from_quat(&q, &qq);
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		bench_kalm_sample(i, &a, &m, &g);
+		bench_fix_sample(&a, &m, &g, &aq, &mq, &gq);
+		zsl_fus_madg_q31_feed(&aq, &mq, &gq, NULL, &qq, &madg_cfgq);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  madgwick Q31:   %8u ns\n", instr / BENCH_LOOPS);
+
+	/* ... then compare them step by step from the same state. */
+	zsl_quat_init(&q, ZSL_QUAT_TYPE_IDENTITY);
+	zsl_quat_q31_from_quat(&q, &qq);
+	err = 0.0;
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		bench_kalm_sample(i, &a, &m, &g);
+		bench_fix_sample(&a, &m, &g, &aq, &mq, &gq);
+		zsl_fus_madg_q31_feed(&aq, &mq, &gq, NULL, &qq, &madg_cfgq);
+		zsl_fus_madg_feed(&a, &m, &g, NULL, &q, &madg_cfg);
+		err = ZSL_MAX(err, bench_fix_err(&q, &qq));
+	}
+	printk("  madgwick error: %e deg\n", (double)err);
+
+	memset(intfb, 0, sizeof(intfb));
+	zsl_quat_init(&q, ZSL_QUAT_TYPE_IDENTITY);
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		bench_kalm_sample(i, &a, &m, &g);
+		zsl_fus_mahn_feed(&a, &m, &g, NULL, &q, &mahn_cfg);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  mahony float:   %8u ns\n", instr / BENCH_LOOPS);
+
+	memset(intfbq, 0, sizeof(intfbq));
+	zsl_quat_q31_from_quat(&q, &qq);
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		bench_kalm_sample(i, &a, &m, &g);
+		bench_fix_sample(&a, &m, &g, &aq, &mq, &gq);
+		zsl_fus_mahn_q31_feed(&aq, &mq, &gq, NULL, &qq, &mahn_cfgq);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  mahony Q31:     %8u ns\n", instr / BENCH_LOOPS);
+
+	memset(intfb, 0, sizeof(intfb));
+	memset(intfbq, 0, sizeof(intfbq));
+	zsl_quat_init(&q, ZSL_QUAT_TYPE_IDENTITY);
+	zsl_quat_q31_from_quat(&q, &qq);
+	err = 0.0;
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		bench_kalm_sample(i, &a, &m, &g);
+		bench_fix_sample(&a, &m, &g, &aq, &mq, &gq);
+		zsl_fus_mahn_q31_feed(&aq, &mq, &gq, NULL, &qq, &mahn_cfgq);
+		zsl_fus_mahn_feed(&a, &m, &g, NULL, &q, &mahn_cfg);
+		err = ZSL_MAX(err, bench_fix_err(&q, &qq));
+	}
+	printk("  mahony error:   %e deg\n", (double)err);
+
+	zsl_quat_init(&q, ZSL_QUAT_TYPE_IDENTITY);
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		bench_kalm_sample(i, &a, &m, &g);
+		zsl_fus_comp_feed(&a, &m, &g, NULL, &q, &comp_cfg);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  comp float:     %8u ns\n", instr / BENCH_LOOPS);
+
+	zsl_quat_q31_from_quat(&q, &qq);
+	ZSL_INSTR_START(instr);
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		bench_kalm_sample(i, &a, &m, &g);
+		bench_fix_sample(&a, &m, &g, &aq, &mq, &gq);
+		zsl_fus_comp_q31_feed(&aq, &mq, &gq, &qq, &comp_cfgq);
+	}
+	ZSL_INSTR_STOP(instr);
+	printk("  comp Q31:       %8u ns\n", instr / BENCH_LOOPS);
+
+	zsl_quat_init(&q, ZSL_QUAT_TYPE_IDENTITY);
+	zsl_quat_q31_from_quat(&q, &qq);
+	err = 0.0;
+	for (uint32_t i = 0; i < BENCH_LOOPS; i++) {
+		bench_kalm_sample(i, &a, &m, &g);
+		bench_fix_sample(&a, &m, &g, &aq, &mq, &gq);
+		zsl_fus_comp_q31_feed(&aq, &mq, &gq, &qq, &comp_cfgq);
+		zsl_fus_comp_feed(&a, &m, &g, NULL, &q, &comp_cfg);
+		err = ZSL_MAX(err, bench_fix_err(&q, &qq));
+	}
+	printk("  comp error:     %e deg\n", (double)err);
+}
+#endif
+
 void main(void)
 {
 	printk("zscilib benchmark\n\n");
@@ -79,6 +1872,21 @@ void main(void)
 
 	while (1) {
 		test_vec_add();
+		test_mtx_deter();
+		test_mtx_mult();
+		test_mtx_qrd();
+		test_mtx_eigenvalues();
+		test_mtx_eigen_sym();
+		test_mtx_svd();
+		test_sta_lstsq();
+		test_vec_sort();
+		test_fus_kalman();
+		test_fus_cal_magn();
+		test_fast_math();
+		test_clr_cct();
+#if CONFIG_ZSL_FIXED
+		test_fus_fixed();
+#endif
 		k_sleep(K_FOREVER);
 	}
 }
@@ -20,6 +20,7 @@ static struct zsl_fus_madg_cfg madg_cfg = {
 static struct zsl_fus_drv madgwick_drv = {
 	.init_handler = zsl_fus_madg_init,
 	.feed_handler = zsl_fus_madg_feed,
+	.feed_batch_handler = zsl_fus_madg_feed_batch,
 	.error_handler = zsl_fus_madg_error,
 	.config = &madg_cfg,
 };
@@ -39,6 +40,7 @@ static struct zsl_fus_mahn_cfg mahn_cfg = {
 static struct zsl_fus_drv mahony_drv = {
 	.init_handler = zsl_fus_mahn_init,
 	.feed_handler = zsl_fus_mahn_feed,
+	.feed_batch_handler = zsl_fus_mahn_feed_batch,
 	.error_handler = zsl_fus_mahn_error,
 	.config = &mahn_cfg,
 };
@@ -47,6 +49,7 @@ static struct zsl_fus_drv mahony_drv = {
 static struct zsl_fus_drv saam_drv = {
 	.init_handler = zsl_fus_saam_init,
 	.feed_handler = zsl_fus_saam_feed,
+	.feed_batch_handler = zsl_fus_saam_feed_batch,
 	.error_handler = zsl_fus_saam_error,
 };
 
@@ -61,6 +64,7 @@ static struct zsl_fus_aqua_cfg aqua_cfg = {
 static struct zsl_fus_drv aqua_drv = {
 	.init_handler = zsl_fus_aqua_init,
 	.feed_handler = zsl_fus_aqua_feed,
+	.feed_batch_handler = zsl_fus_aqua_feed_batch,
 	.error_handler = zsl_fus_aqua_error,
 	.config = &aqua_cfg,
 };
@@ -73,6 +77,7 @@ static struct zsl_fus_comp_cfg comp_cfg = {
 static struct zsl_fus_drv comp_drv = {
 	.init_handler = zsl_fus_comp_init,
 	.feed_handler = zsl_fus_comp_feed,
+	.feed_batch_handler = zsl_fus_comp_feed_batch,
 	.error_handler = zsl_fus_comp_error,
 	.config = &comp_cfg,
 };
@@ -99,6 +104,7 @@ static struct zsl_fus_kalm_cfg kalm_cfg = {
 static struct zsl_fus_drv kalm_drv = {
 	.init_handler = zsl_fus_kalm_init,
 	.feed_handler = zsl_fus_kalm_feed,
+	.feed_batch_handler = zsl_fus_kalm_feed_batch,
 	.error_handler = zsl_fus_kalm_error,
 	.config = &kalm_cfg,
 };
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zsl/zsl.h>
+#include <zsl/orientation/orientation.h>
+#include <zsl/instrumentation.h>
+#include "data.h"
+
+/** The number of times the recording is replayed for each measurement. */
+#define REPLAY_PASSES (20U)
+
+/** The sample rate of the recording, in Hz. */
+#define REPLAY_FREQ (100U)
+
+static zsl_real_t acc_soa[DATA_SAMPLES * 3];
+static zsl_real_t mag_soa[DATA_SAMPLES * 3];
+static zsl_real_t gyr_soa[DATA_SAMPLES * 3];
+static zsl_real_t dt[DATA_SAMPLES];
+
+static struct zsl_fus_madg_cfg madg_cfg = {
+	.beta = 0.174,
+};
+
+static zsl_real_t mahn_intfb[3];
+static struct zsl_fus_mahn_cfg mahn_cfg = {
+	.kp = 0.235,
+	.ki = 0.02,
+	.integral_limit = 10000.0,
+	.intfb = {
+		.sz = 3,
+		.data = mahn_intfb,
+	},
+};
+
+static struct zsl_fus_aqua_cfg aqua_cfg = {
+	.alpha = 0.7,
+	.beta = 0.7,
+	.e_a = 0.9,
+	.e_m = 0.9,
+};
+
+static struct zsl_fus_comp_cfg comp_cfg = {
+	.alpha = 0.0001,
+};
+
+static zsl_real_t kalm_P[16];
+static struct zsl_fus_kalm_cfg kalm_cfg = {
+	.var_g = 0.001,
+	.var_a = 0.307,
+	.var_m = 0.2,
+	.P = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = kalm_P,
+	},
+};
+
+static struct {
+	const char *name;
+	struct zsl_fus_drv drv;
+} filters[] = {
+	{ "Madgwick", { .init_handler = zsl_fus_madg_init,
+			.feed_handler = zsl_fus_madg_feed,
+			.feed_batch_handler = zsl_fus_madg_feed_batch,
+			.error_handler = zsl_fus_madg_error,
+			.config = &madg_cfg } },
+	{ "Mahony", { .init_handler = zsl_fus_mahn_init,
+		      .feed_handler = zsl_fus_mahn_feed,
+		      .feed_batch_handler = zsl_fus_mahn_feed_batch,
+		      .error_handler = zsl_fus_mahn_error,
+		      .config = &mahn_cfg } },
+	{ "SAAM", { .init_handler = zsl_fus_saam_init,
+		    .feed_handler = zsl_fus_saam_feed,
+		    .feed_batch_handler = zsl_fus_saam_feed_batch,
+		    .error_handler = zsl_fus_saam_error } },
+	{ "AQUA", { .init_handler = zsl_fus_aqua_init,
+		    .feed_handler = zsl_fus_aqua_feed,
+		    .feed_batch_handler = zsl_fus_aqua_feed_batch,
+		    .error_handler = zsl_fus_aqua_error,
+		    .config = &aqua_cfg } },
+	{ "Complementary", { .init_handler = zsl_fus_comp_init,
+			     .feed_handler = zsl_fus_comp_feed,
+			     .feed_batch_handler = zsl_fus_comp_feed_batch,
+			     .error_handler = zsl_fus_comp_error,
+			     .config = &comp_cfg } },
+	{ "Kalman", { .init_handler = zsl_fus_kalm_init,
+		      .feed_handler = zsl_fus_kalm_feed,
+		      .feed_batch_handler = zsl_fus_kalm_feed_batch,
+		      .error_handler = zsl_fus_kalm_error,
+		      .config = &kalm_cfg } },
+};
+
+/**
+ * Copies the Nx3 recording in 'm' to 'soa', with each axis stored as a
+ * separate array of N values.
+ */
+static void to_soa(struct zsl_mtx *m, zsl_real_t *soa)
+{
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			soa[j * m->sz_rows + i] = m->data[i * 3 + j];
+		}
+	}
+}
+
+/**
+ * Restarts the filter, so that every measurement processes the same data
+ * from the same initial state.
+ */
+static void reset(struct zsl_fus_drv *drv, struct zsl_quat *q)
+{
+	zsl_vec_init(&mahn_cfg.intfb);
+	aqua_cfg.alpha = 0.7;
+	zsl_quat_init(q, ZSL_QUAT_TYPE_IDENTITY);
+	drv->init_handler(REPLAY_FREQ, drv->config);
+}
+
+static void print_rate(const char *name, uint64_t ns, struct zsl_quat *q)
+{
+	uint64_t n = (uint64_t)DATA_SAMPLES * REPLAY_PASSES;
+
+	printf("  %-12s %10u samples/s  (q = %+.4f %+.4f %+.4f %+.4f)\n", name,
+	       ns ? (uint32_t)((n * 1000000000ULL) / ns) : 0,
+	       (double)q->r, (double)q->i, (double)q->j, (double)q->k);
+}
+
+static void replay_feed(struct zsl_fus_drv *drv)
+{
+	struct zsl_quat q;
+	uint64_t total = 0;
+	uint32_t ns;
+
+	ZSL_VECTOR_DEF(av, 3);
+	ZSL_VECTOR_DEF(mv, 3);
+	ZSL_VECTOR_DEF(gv, 3);
+
+	reset(drv, &q);
+	for (uint32_t p = 0; p < REPLAY_PASSES; p++) {
+		ZSL_INSTR_START(ns);
+		for (size_t i = 0; i < DATA_SAMPLES; i++) {
+			zsl_mtx_get_row(&zsl_fus_data_acc, i, av.data);
+			zsl_mtx_get_row(&zsl_fus_data_mag, i, mv.data);
+			zsl_mtx_get_row(&zsl_fus_data_gyr, i, gv.data);
+			drv->feed_handler(&av, &mv, &gv, NULL, &q, drv->config);
+		}
+		ZSL_INSTR_STOP(ns);
+		total += ns;
+	}
+
+	print_rate("feed", total, &q);
+}
+
+static void replay_batch(const char *name, struct zsl_fus_drv *drv,
+			 struct zsl_fus_batch *batch)
+{
+	struct zsl_quat q;
+	uint64_t total = 0;
+	uint32_t ns;
+	int rc = 0;
+
+	reset(drv, &q);
+	for (uint32_t p = 0; p < REPLAY_PASSES; p++) {
+		ZSL_INSTR_START(ns);
+		rc |= zsl_fus_feed_batch(drv, batch, &q, NULL);
+		ZSL_INSTR_STOP(ns);
+		total += ns;
+	}
+
+	if (rc) {
+		printf("  %-12s failed (%d)\n", name, rc);
+		return;
+	}
+
+	print_rate(name, total, &q);
+}
+
+void main(void)
+{
+	struct zsl_fus_batch aos = {
+		.n = DATA_SAMPLES,
+		.layout = ZSL_FUS_BATCH_AOS,
+		.accel = zsl_fus_data_acc.data,
+		.mag = zsl_fus_data_mag.data,
+		.gyro = zsl_fus_data_gyr.data,
+		.dt = dt,
+	};
+
+	struct zsl_fus_batch soa = {
+		.n = DATA_SAMPLES,
+		.layout = ZSL_FUS_BATCH_SOA,
+		.accel = acc_soa,
+		.mag = mag_soa,
+		.gyro = gyr_soa,
+		.dt = dt,
+	};
+
+	printf("Orientation replay benchmark\n");
+	printf("----------------------------\n\n");
+	printf("%u samples at %u Hz, replayed %u times\n\n",
+	       (uint32_t)DATA_SAMPLES, REPLAY_FREQ, REPLAY_PASSES);
+
+	to_soa(&zsl_fus_data_acc, acc_soa);
+	to_soa(&zsl_fus_data_mag, mag_soa);
+	to_soa(&zsl_fus_data_gyr, gyr_soa);
+	for (size_t i = 0; i < DATA_SAMPLES; i++) {
+		dt[i] = 1.0 / REPLAY_FREQ;
+	}
+
+	for (size_t f = 0; f < sizeof(filters) / sizeof(filters[0]); f++) {
+		struct zsl_fus_drv *drv = &filters[f].drv;
+
+		printf("%s:\n", filters[f].name);
+		replay_feed(drv);
+		replay_batch("batch (aos)", drv, &aos);
+		replay_batch("batch (soa)", drv, &soa);
+	}
+}
@@ -0,0 +1,494 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend (KTOWN)
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include "zsl/matrices.h"
+#include "zsl/vectors.h"
+#include "zsl/orientation/quaternions.h"
+#include "zsl/orientation/fusion/fusion.h"
+
+#ifndef CONFIG_ZSL_PLATFORM_OPT
+#define CONFIG_ZSL_PLATFORM_OPT 0
+#endif
+
+/** The minimum total time to spend on each measurement, in ns. */
+#define BENCH_MIN_NS (20000000ULL)
+
+/** The largest vector length used in the benchmarks. */
+#define BENCH_VEC_MAX_SZ (4096U)
+
+/** The largest nxn matrix size used in the benchmarks. */
+#define BENCH_MTX_MAX_SZ (128U)
+
+/* Largest number of IMUs fed to the fusion filters at once. */
+#define BENCH_FUS_MAX_N (128U)
+
+/* Number of updates from the initial state covered by the fusion checksums. */
+#define BENCH_FUS_CHECK (100U)
+
+static zsl_real_t va_data[BENCH_VEC_MAX_SZ];
+static zsl_real_t vb_data[BENCH_VEC_MAX_SZ];
+static zsl_real_t vc_data[BENCH_VEC_MAX_SZ];
+
+static zsl_real_t ma_data[BENCH_MTX_MAX_SZ * BENCH_MTX_MAX_SZ];
+static zsl_real_t mb_data[BENCH_MTX_MAX_SZ * BENCH_MTX_MAX_SZ];
+static zsl_real_t mc_data[BENCH_MTX_MAX_SZ * BENCH_MTX_MAX_SZ];
+
+/* Largest number of quaternions or points in the batch quaternion benchmarks. */
+#define BENCH_QUAT_MAX_N (4096U)
+
+/* Stride of the point cloud, with an intensity value after each point. */
+#define BENCH_QUAT_STRIDE (4U)
+
+static struct zsl_quat quat_a[BENCH_QUAT_MAX_N];
+static struct zsl_quat quat_b[BENCH_QUAT_MAX_N];
+static struct zsl_quat quat_c[BENCH_QUAT_MAX_N];
+static struct zsl_euler quat_e[BENCH_QUAT_MAX_N];
+static zsl_real_t quat_pts[BENCH_QUAT_MAX_N * BENCH_QUAT_STRIDE];
+static zsl_real_t quat_pts_out[BENCH_QUAT_MAX_N * BENCH_QUAT_STRIDE];
+
+/* Samples and state of each IMU, stored as one array per axis. */
+static zsl_real_t fus_a[BENCH_FUS_MAX_N * 3];
+static zsl_real_t fus_m[BENCH_FUS_MAX_N * 3];
+static zsl_real_t fus_g[BENCH_FUS_MAX_N * 3];
+static zsl_real_t fus_q[BENCH_FUS_MAX_N * 4];
+static zsl_real_t fus_fb[BENCH_FUS_MAX_N * 3];
+
+static struct zsl_fus_madg_cfg madg_cfg = { .beta = 0.174 };
+static struct zsl_fus_mahn_cfg mahn_cfg = {
+	.kp = 0.235,
+	.ki = 0.02,
+	.integral_limit = 10000.0,
+	.intfb = { .sz = 3 },
+};
+
+/* Keeps the compiler from discarding results that are never read. */
+static volatile zsl_real_t sink;
+
+static uint64_t
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Fills 'n' values at 'd' with deterministic pseudo-random values in
+ * [-0.5, 0.5), so that results are comparable between builds.
+ */
+static void
+fill(zsl_real_t *d, size_t n, uint32_t seed)
+{
+	for (size_t i = 0; i < n; i++) {
+		seed = seed * 1664525U + 1013904223U;
+		d[i] = (zsl_real_t)(seed >> 8) / (zsl_real_t)(1U << 24) - 0.5;
+	}
+}
+
+static zsl_real_t
+checksum(const zsl_real_t *d, size_t n)
+{
+	zsl_real_t sum = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		sum += d[i] * (zsl_real_t)((i % 7) + 1);
+	}
+
+	return sum;
+}
+
+/**
+ * Runs 'op' on size 'sz' until at least BENCH_MIN_NS have elapsed, and
+ * prints the average time per call along with a checksum of 'out'.
+ */
+static void
+run(const char *name, size_t sz, void (*op)(size_t), const zsl_real_t *out,
+    size_t out_sz)
+{
+	uint64_t start;
+	uint64_t elapsed;
+	uint64_t loops = 0;
+
+	start = now_ns();
+	do {
+		op(sz);
+		loops++;
+		elapsed = now_ns() - start;
+	} while (elapsed < BENCH_MIN_NS);
+
+	printf("%-20s %5zu %12.1f ns  (check %+.6e)\n", name, sz,
+	       (double)elapsed / (double)loops,
+	       (double)checksum(out, out_sz));
+}
+
+static void
+op_vec_add(size_t n)
+{
+	struct zsl_vec va = { .sz = n, .data = va_data };
+	struct zsl_vec vb = { .sz = n, .data = vb_data };
+	struct zsl_vec vc = { .sz = n, .data = vc_data };
+
+	zsl_vec_add(&va, &vb, &vc);
+}
+
+static void
+op_vec_sub(size_t n)
+{
+	struct zsl_vec va = { .sz = n, .data = va_data };
+	struct zsl_vec vb = { .sz = n, .data = vb_data };
+	struct zsl_vec vc = { .sz = n, .data = vc_data };
+
+	zsl_vec_sub(&va, &vb, &vc);
+}
+
+static void
+op_vec_scalar_mult(size_t n)
+{
+	struct zsl_vec vc = { .sz = n, .data = vc_data };
+
+	zsl_vec_scalar_mult(&vc, 1.0);
+}
+
+static void
+op_vec_dot(size_t n)
+{
+	struct zsl_vec va = { .sz = n, .data = va_data };
+	struct zsl_vec vb = { .sz = n, .data = vb_data };
+	zsl_real_t d;
+
+	zsl_vec_dot(&va, &vb, &d);
+	vc_data[0] = d;
+	sink = d;
+}
+
+static void
+op_vec_norm(size_t n)
+{
+	struct zsl_vec va = { .sz = n, .data = va_data };
+
+	vc_data[0] = zsl_vec_norm(&va);
+	sink = vc_data[0];
+}
+
+static void
+op_mtx_add(size_t n)
+{
+	struct zsl_mtx ma = { .sz_rows = n, .sz_cols = n, .data = ma_data };
+	struct zsl_mtx mb = { .sz_rows = n, .sz_cols = n, .data = mb_data };
+	struct zsl_mtx mc = { .sz_rows = n, .sz_cols = n, .data = mc_data };
+
+	zsl_mtx_add(&ma, &mb, &mc);
+}
+
+static void
+op_mtx_mult(size_t n)
+{
+	struct zsl_mtx ma = { .sz_rows = n, .sz_cols = n, .data = ma_data };
+	struct zsl_mtx mb = { .sz_rows = n, .sz_cols = n, .data = mb_data };
+	struct zsl_mtx mc = { .sz_rows = n, .sz_cols = n, .data = mc_data };
+
+	zsl_mtx_mult(&ma, &mb, &mc);
+}
+
+static void
+op_mtx_trans(size_t n)
+{
+	struct zsl_mtx ma = { .sz_rows = n, .sz_cols = n, .data = ma_data };
+	struct zsl_mtx mc = { .sz_rows = n, .sz_cols = n, .data = mc_data };
+
+	zsl_mtx_trans(&ma, &mc);
+}
+
+static void
+op_quat_mult(size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		zsl_quat_mult(&quat_a[i], &quat_b[i], &quat_c[i]);
+	}
+}
+
+static void
+op_quat_mult_n(size_t n)
+{
+	zsl_quat_mult_n(n, quat_a, quat_b, quat_c);
+}
+
+static void
+op_quat_rot(size_t n)
+{
+	struct zsl_quat p, pr;
+
+	p.r = 0.0;
+	for (size_t i = 0; i < n; i++) {
+		p.i = quat_pts[i * BENCH_QUAT_STRIDE];
+		p.j = quat_pts[i * BENCH_QUAT_STRIDE + 1];
+		p.k = quat_pts[i * BENCH_QUAT_STRIDE + 2];
+		zsl_quat_rot(&quat_a[0], &p, &pr);
+		quat_pts_out[i * BENCH_QUAT_STRIDE] = pr.i;
+		quat_pts_out[i * BENCH_QUAT_STRIDE + 1] = pr.j;
+		quat_pts_out[i * BENCH_QUAT_STRIDE + 2] = pr.k;
+	}
+}
+
+static void
+op_quat_rot_n(size_t n)
+{
+	zsl_quat_rot_n(n, &quat_a[0], quat_pts, BENCH_QUAT_STRIDE, quat_pts_out,
+		       BENCH_QUAT_STRIDE);
+}
+
+static void
+op_quat_slerp(size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		zsl_quat_slerp(&quat_a[i], &quat_b[i], 0.3, &quat_c[i]);
+	}
+}
+
+static void
+op_quat_slerp_n(size_t n)
+{
+	zsl_quat_slerp_n(n, quat_a, quat_b, 0.3, quat_c);
+}
+
+static void
+op_quat_to_euler(size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		zsl_quat_to_euler(&quat_a[i], &quat_e[i]);
+	}
+}
+
+static void
+op_quat_to_euler_n(size_t n)
+{
+	zsl_quat_to_euler_n(n, quat_a, quat_e);
+}
+
+/**
+ * Sets the IMUs to a level orientation, with a reading of the earth's
+ * gravity and magnetic field plus some noise, and a slow rotation.
+ */
+static void
+fus_reset(void)
+{
+	size_t n = BENCH_FUS_MAX_N;
+
+	fill(fus_a, n * 3, 0x2545F491);
+	fill(fus_m, n * 3, 0x9E3779B9);
+	fill(fus_g, n * 3, 0x85EBCA6B);
+	for (size_t i = 0; i < n; i++) {
+		fus_a[2 * n + i] -= 9.8;
+		fus_m[i] += 20.0;
+		fus_m[2 * n + i] -= 40.0;
+		fus_q[i] = 1.0;
+		fus_q[n + i] = fus_q[2 * n + i] = fus_q[3 * n + i] = 0.0;
+	}
+	memset(fus_fb, 0, sizeof(fus_fb));
+}
+
+/**
+ * Runs 'op' for 'n' IMUs like run, and prints the throughput as the number
+ * of filter updates (filters x samples) per second. The checksum is taken
+ * after BENCH_FUS_CHECK updates from the initial state, so that it can be
+ * compared between the single and multi-filter functions.
+ */
+static void
+run_fus(const char *name, size_t n, void (*op)(size_t))
+{
+	uint64_t start;
+	uint64_t elapsed;
+	uint64_t loops = 0;
+
+	fus_reset();
+	start = now_ns();
+	do {
+		op(n);
+		loops++;
+		elapsed = now_ns() - start;
+	} while (elapsed < BENCH_MIN_NS);
+
+	fus_reset();
+	for (size_t i = 0; i < BENCH_FUS_CHECK; i++) {
+		op(n);
+	}
+
+	printf("%-20s %5zu %12.1f ns  %8.2f M updates/s  (check %+.6e)\n",
+	       name, n, (double)elapsed / (double)loops,
+	       (double)(loops * n) * 1000.0 / (double)elapsed,
+	       (double)checksum(fus_q, n * 4));
+}
+
+/* Gathers the samples of IMU 'i' for one of the single-filter calls. */
+static void
+fus_get(size_t n, size_t i, struct zsl_vec *a, struct zsl_vec *m,
+	struct zsl_vec *g)
+{
+	for (size_t j = 0; j < 3; j++) {
+		a->data[j] = fus_a[j * n + i];
+		m->data[j] = fus_m[j * n + i];
+		g->data[j] = fus_g[j * n + i];
+	}
+}
+
+static void
+op_fus_madg_feed(size_t n)
+{
+	struct zsl_quat q;
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+
+	for (size_t i = 0; i < n; i++) {
+		fus_get(n, i, &a, &m, &g);
+		q.r = fus_q[i];
+		q.i = fus_q[n + i];
+		q.j = fus_q[2 * n + i];
+		q.k = fus_q[3 * n + i];
+		zsl_fus_madg_feed(&a, &m, &g, NULL, &q, &madg_cfg);
+		fus_q[i] = q.r;
+		fus_q[n + i] = q.i;
+		fus_q[2 * n + i] = q.j;
+		fus_q[3 * n + i] = q.k;
+	}
+}
+
+static void
+op_fus_madg_feed_multi(size_t n)
+{
+	struct zsl_fus_vec_soa a = { fus_a, fus_a + n, fus_a + 2 * n };
+	struct zsl_fus_vec_soa m = { fus_m, fus_m + n, fus_m + 2 * n };
+	struct zsl_fus_vec_soa g = { fus_g, fus_g + n, fus_g + 2 * n };
+	struct zsl_fus_quat_soa q = { fus_q, fus_q + n, fus_q + 2 * n,
+				      fus_q + 3 * n };
+
+	zsl_fus_madg_feed_multi(n, &a, &m, &g, NULL, &q, &madg_cfg);
+}
+
+static void
+op_fus_mahn_feed(size_t n)
+{
+	struct zsl_quat q;
+	zsl_real_t fb[3];
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+
+	mahn_cfg.intfb.data = fb;
+	for (size_t i = 0; i < n; i++) {
+		fus_get(n, i, &a, &m, &g);
+		q.r = fus_q[i];
+		q.i = fus_q[n + i];
+		q.j = fus_q[2 * n + i];
+		q.k = fus_q[3 * n + i];
+		for (size_t j = 0; j < 3; j++) {
+			fb[j] = fus_fb[j * n + i];
+		}
+		zsl_fus_mahn_feed(&a, &m, &g, NULL, &q, &mahn_cfg);
+		fus_q[i] = q.r;
+		fus_q[n + i] = q.i;
+		fus_q[2 * n + i] = q.j;
+		fus_q[3 * n + i] = q.k;
+		for (size_t j = 0; j < 3; j++) {
+			fus_fb[j * n + i] = fb[j];
+		}
+	}
+}
+
+static void
+op_fus_mahn_feed_multi(size_t n)
+{
+	struct zsl_fus_vec_soa a = { fus_a, fus_a + n, fus_a + 2 * n };
+	struct zsl_fus_vec_soa m = { fus_m, fus_m + n, fus_m + 2 * n };
+	struct zsl_fus_vec_soa g = { fus_g, fus_g + n, fus_g + 2 * n };
+	struct zsl_fus_vec_soa fb = { fus_fb, fus_fb + n, fus_fb + 2 * n };
+	struct zsl_fus_quat_soa q = { fus_q, fus_q + n, fus_q + 2 * n,
+				      fus_q + 3 * n };
+
+	zsl_fus_mahn_feed_multi(n, &a, &m, &g, NULL, &fb, &q, &mahn_cfg);
+}
+
+int
+main(void)
+{
+	printf("zscilib host benchmark\n\n");
+	printf("CONFIG_ZSL_PLATFORM_OPT:     %i\n", CONFIG_ZSL_PLATFORM_OPT);
+#if CONFIG_ZSL_SINGLE_PRECISION
+	printf("CONFIG_ZSL_SINGLE_PRECISION: True\n");
+#else
+	printf("CONFIG_ZSL_SINGLE_PRECISION: False\n");
+#endif
+#if defined(__AVX__) && defined(__FMA__)
+	printf("SIMD:                        AVX + FMA\n");
+#elif defined(__AVX__)
+	printf("SIMD:                        AVX\n");
+#else
+	printf("SIMD:                        SSE2\n");
+#endif
+	printf("\n");
+
+	fill(va_data, BENCH_VEC_MAX_SZ, 0x2545F491);
+	fill(vb_data, BENCH_VEC_MAX_SZ, 0x9E3779B9);
+	fill(ma_data, BENCH_MTX_MAX_SZ * BENCH_MTX_MAX_SZ, 0x2545F491);
+	fill(mb_data, BENCH_MTX_MAX_SZ * BENCH_MTX_MAX_SZ, 0x9E3779B9);
+
+	for (size_t n = 16; n <= BENCH_VEC_MAX_SZ; n *= 16) {
+		run("zsl_vec_add", n, op_vec_add, vc_data, n);
+		run("zsl_vec_sub", n, op_vec_sub, vc_data, n);
+		run("zsl_vec_scalar_mult", n, op_vec_scalar_mult, vc_data, n);
+		run("zsl_vec_dot", n, op_vec_dot, vc_data, 1);
+		run("zsl_vec_norm", n, op_vec_norm, vc_data, 1);
+	}
+
+	for (size_t n = 8; n <= BENCH_MTX_MAX_SZ; n *= 2) {
+		run("zsl_mtx_add", n, op_mtx_add, mc_data, n * n);
+		run("zsl_mtx_mult", n, op_mtx_mult, mc_data, n * n);
+		run("zsl_mtx_trans", n, op_mtx_trans, mc_data, n * n);
+	}
+
+	fill(quat_a[0].idx, BENCH_QUAT_MAX_N * 4, 0x2545F491);
+	fill(quat_b[0].idx, BENCH_QUAT_MAX_N * 4, 0x9E3779B9);
+	fill(quat_pts, BENCH_QUAT_MAX_N * BENCH_QUAT_STRIDE, 0x85EBCA6B);
+	for (size_t i = 0; i < BENCH_QUAT_MAX_N; i++) {
+		zsl_quat_to_unit_d(&quat_a[i]);
+		zsl_quat_to_unit_d(&quat_b[i]);
+	}
+
+	/* The checksums of each scalar loop and batch function match. */
+	for (size_t n = 16; n <= BENCH_QUAT_MAX_N; n *= 16) {
+		run("zsl_quat_mult", n, op_quat_mult, quat_c[0].idx, n * 4);
+		run("zsl_quat_mult_n", n, op_quat_mult_n, quat_c[0].idx, n * 4);
+		run("zsl_quat_rot", n, op_quat_rot, quat_pts_out,
+		    n * BENCH_QUAT_STRIDE);
+		run("zsl_quat_rot_n", n, op_quat_rot_n, quat_pts_out,
+		    n * BENCH_QUAT_STRIDE);
+		run("zsl_quat_slerp", n, op_quat_slerp, quat_c[0].idx, n * 4);
+		run("zsl_quat_slerp_n", n, op_quat_slerp_n, quat_c[0].idx, n * 4);
+		run("zsl_quat_to_euler", n, op_quat_to_euler, quat_e[0].idx, n * 3);
+		run("zsl_quat_to_euler_n", n, op_quat_to_euler_n, quat_e[0].idx,
+		    n * 3);
+	}
+
+	zsl_fus_madg_init(100, &madg_cfg);
+	zsl_fus_mahn_init(100, &mahn_cfg);
+	for (size_t n = 8; n <= BENCH_FUS_MAX_N; n *= 4) {
+		run_fus("zsl_fus_madg_feed", n, op_fus_madg_feed);
+		run_fus("zsl_fus_madg_multi", n, op_fus_madg_feed_multi);
+		run_fus("zsl_fus_mahn_feed", n, op_fus_mahn_feed);
+		run_fus("zsl_fus_mahn_multi", n, op_fus_mahn_feed_multi);
+	}
+
+	return 0;
+}
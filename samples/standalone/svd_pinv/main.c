@@ -12,6 +12,10 @@
 
 #define EPSILON 1e-4
 
+/* Scratch memory for zsl_mtx_pinv_ws, sized for an 18x3 input. Keeping it
+ * out of the stack lets the decomposition run with a small stack. */
+static zsl_real_t pinv_ws_buf[8192];
+
 int svd_test()
 {
 	size_t q = 18;
@@ -99,8 +103,17 @@ int pinv_test()
 	zsl_mtx_print(&mep);
 	printf("\n");
 
-	/* Calculate and display the pseudoinverse using 150 iterations. */
-	zsl_mtx_pinv(&mep, &pinv, 150);
+	/* Calculate and display the pseudoinverse using 150 iterations,
+	 * taking temporary storage from 'pinv_ws_buf'. */
+	struct zsl_ws ws;
+	size_t bytes = zsl_mtx_ws_bytes(ZSL_MTX_WS_PINV, q, p);
+
+	if (bytes > sizeof(pinv_ws_buf)) {
+		printf("Workspace too small: %zu bytes required\n", bytes);
+		return -ENOMEM;
+	}
+	zsl_ws_init(&ws, pinv_ws_buf, sizeof(pinv_ws_buf));
+	zsl_mtx_pinv_ws(&mep, &pinv, 150, &ws);
 	printf("PSEUDOINVERSE (3x18 MATRIX)\n");
 	printf("--------------------------\n");
 	zsl_mtx_print(&pinv);
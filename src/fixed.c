@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zsl/fixed.h>
+
+/* Number of CORDIC iterations, one per bit of a Q31 binary angle. */
+#define ZSL_FIX_CORDIC_N (31)
+
+/* atan(2^-i) / pi in Q31, for the CORDIC iterations. */
+static const int32_t zsl_fix_cordic_atan[ZSL_FIX_CORDIC_N] = {
+	536870912, 316933406, 167458907, 85004756,
+	42667331, 21354465, 10679838, 5340245,
+	2670163, 1335087, 667544, 333772,
+	166886, 83443, 41722, 20861,
+	10430, 5215, 2608, 1304,
+	652, 326, 163, 81,
+	41, 20, 10, 5,
+	3, 1, 1,
+};
+
+/* Inverse of the CORDIC gain, prod(1 / sqrt(1 + 2^-2i)), in Q30. */
+#define ZSL_FIX_CORDIC_K (652032874)
+
+zsl_q31_t zsl_q31_div(zsl_q31_t a, zsl_q31_t b)
+{
+	if (b == 0) {
+		return a > 0 ? ZSL_Q31_MAX : a < 0 ? ZSL_Q31_MIN : 0;
+	}
+
+	return zsl_q31_sat(((int64_t)a * (1LL << 31)) / b);
+}
+
+uint32_t zsl_fix_sqrt_u64(uint64_t x)
+{
+	uint64_t r = 0;
+	uint64_t b = 1ULL << 62;
+
+	/* Digit-by-digit method, two bits of 'x' per bit of the result. */
+	while (b > x) {
+		b >>= 2;
+	}
+
+	while (b != 0) {
+		if (x >= r + b) {
+			x -= r + b;
+			r = (r >> 1) + b;
+		} else {
+			r >>= 1;
+		}
+		b >>= 2;
+	}
+
+	return (uint32_t)r;
+}
+
+zsl_q31_t zsl_q31_sqrt(zsl_q31_t x)
+{
+	if (x <= 0) {
+		return 0;
+	}
+
+	/* sqrt(x * 2^31) * 2^31 = sqrt(x * 2^62). */
+	return (zsl_q31_t)zsl_fix_sqrt_u64((uint64_t)x << 31);
+}
+
+void zsl_q31_sin_cos(zsl_q31_t a, zsl_q31_t *s, zsl_q31_t *c)
+{
+	int32_t x = ZSL_FIX_CORDIC_K;
+	int32_t y = 0;
+	int32_t z = a;
+	int32_t t;
+	bool neg = false;
+
+	/* CORDIC converges for +/-pi/2, so rotate the other half by pi. */
+	if (z > (1 << 30) || z < -(1 << 30)) {
+		z = (int32_t)((uint32_t)z + 0x80000000U);
+		neg = true;
+	}
+
+	/* Rotate (K, 0) by z, with x and y in Q30 to leave room for the gain. */
+	for (int i = 0; i < ZSL_FIX_CORDIC_N; i++) {
+		t = x;
+		if (z >= 0) {
+			x -= y >> i;
+			y += t >> i;
+			z -= zsl_fix_cordic_atan[i];
+		} else {
+			x += y >> i;
+			y -= t >> i;
+			z += zsl_fix_cordic_atan[i];
+		}
+	}
+
+	if (neg) {
+		x = -x;
+		y = -y;
+	}
+
+	if (s != NULL) {
+		*s = zsl_q31_sat((int64_t)y * 2);
+	}
+	if (c != NULL) {
+		*c = zsl_q31_sat((int64_t)x * 2);
+	}
+}
+
+zsl_q31_t zsl_q31_atan2(zsl_q31_t y, zsl_q31_t x)
+{
+	int64_t xl = x;
+	int64_t yl = y;
+	int32_t xs, ys, t;
+	uint32_t z = 0;
+	uint64_t m;
+
+	if (x == 0 && y == 0) {
+		return 0;
+	}
+
+	/* Rotate the left half-plane by pi, so that CORDIC converges. */
+	if (xl < 0) {
+		xl = -xl;
+		yl = -yl;
+		z = 0x80000000U;
+	}
+
+	/* Scale the point so that its largest coordinate uses 29 bits, leaving
+	 * room for the CORDIC gain and the rotation. */
+	m = (uint64_t)xl | (uint64_t)(yl < 0 ? -yl : yl);
+	while (m >= (1ULL << 29)) {
+		m >>= 1;
+		xl >>= 1;
+		yl >>= 1;
+	}
+	while (m < (1ULL << 28)) {
+		m <<= 1;
+		xl *= 2;
+		yl *= 2;
+	}
+	xs = (int32_t)xl;
+	ys = (int32_t)yl;
+
+	/* Rotate the point onto the x axis, accumulating the angle. */
+	for (int i = 0; i < ZSL_FIX_CORDIC_N; i++) {
+		t = xs;
+		if (ys > 0) {
+			xs += ys >> i;
+			ys -= t >> i;
+			z += (uint32_t)zsl_fix_cordic_atan[i];
+		} else {
+			xs -= ys >> i;
+			ys += t >> i;
+			z -= (uint32_t)zsl_fix_cordic_atan[i];
+		}
+	}
+
+	return (zsl_q31_t)z;
+}
+
+int zsl_vec_q31_init(struct zsl_vec_q31 *v)
+{
+	memset(v->data, 0, v->sz * sizeof(zsl_q31_t));
+
+	return 0;
+}
+
+int zsl_vec_q31_from_q15(struct zsl_vec_q31 *v, const zsl_q15_t *a)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = zsl_q15_to_q31(a[i]);
+	}
+
+	return 0;
+}
+
+int zsl_vec_q31_add(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    struct zsl_vec_q31 *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v, w and x are equal length. */
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->data[i] = zsl_q31_add(v->data[i], w->data[i]);
+	}
+
+	return 0;
+}
+
+int zsl_vec_q31_sub(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    struct zsl_vec_q31 *x)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v, w and x are equal length. */
+	if ((v->sz != w->sz) || (v->sz != x->sz)) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x->data[i] = zsl_q31_sub(v->data[i], w->data[i]);
+	}
+
+	return 0;
+}
+
+int zsl_vec_q31_scalar_mult(struct zsl_vec_q31 *v, zsl_q31_t s)
+{
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = zsl_q31_mul(v->data[i], s);
+	}
+
+	return 0;
+}
+
+int zsl_vec_q31_dot(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		    zsl_q31_t *d)
+{
+	int64_t res = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if (v->sz != w->sz) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Each product is scaled to Q31 before the sum, so that the 64-bit sum
+	 * can't overflow. */
+	for (size_t i = 0; i < v->sz; i++) {
+		res += ((int64_t)v->data[i] * w->data[i]) >> 31;
+	}
+
+	*d = zsl_q31_sat(res);
+
+	return 0;
+}
+
+/**
+ * Computes the norm of 'v', scaled by 2^-s where 's' is the shift that makes
+ * the largest element use 31 bits, in Q31. Returns zero for a zero vector.
+ */
+static uint64_t zsl_vec_q31_norm_scaled(struct zsl_vec_q31 *v, int *s)
+{
+	uint64_t m = 0;
+	uint64_t sum = 0;
+	int64_t x;
+	int e = 0;
+
+	for (size_t i = 0; i < v->sz; i++) {
+		m |= (uint64_t)(v->data[i] < 0 ? -(int64_t)v->data[i] :
+				v->data[i]);
+	}
+
+	if (m == 0) {
+		*s = 0;
+		return 0;
+	}
+
+	/* Shift so that the largest element is in [2^30, 2^31). */
+	*s = 0;
+	while (m >= (1ULL << 31)) {
+		m >>= 1;
+		(*s)--;
+	}
+	while (m < (1ULL << 30)) {
+		m <<= 1;
+		(*s)++;
+	}
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x = *s >= 0 ? (int64_t)v->data[i] * (1LL << *s) :
+		    (int64_t)v->data[i] >> -*s;
+		sum += (uint64_t)((x * x) >> 31);
+	}
+
+	/* Keep sum * 2^31 within 64 bits for long vectors. */
+	while (sum >= (1ULL << 33)) {
+		sum >>= 2;
+		e++;
+	}
+
+	return (uint64_t)zsl_fix_sqrt_u64(sum << 31) << e;
+}
+
+zsl_q31_t zsl_vec_q31_norm(struct zsl_vec_q31 *v)
+{
+	int s;
+	uint64_t n = zsl_vec_q31_norm_scaled(v, &s);
+
+	n = s >= 0 ? n >> s : n << -s;
+
+	return n > ZSL_Q31_MAX ? ZSL_Q31_MAX : (zsl_q31_t)n;
+}
+
+int zsl_vec_q31_to_unit(struct zsl_vec_q31 *v)
+{
+	int s;
+	int64_t x;
+	uint64_t n = zsl_vec_q31_norm_scaled(v, &s);
+
+	/* On div by zero clear vector and return v[0] = 1.0. */
+	if (n == 0) {
+		zsl_vec_q31_init(v);
+		v->data[0] = ZSL_Q31_MAX;
+		return 0;
+	}
+
+	for (size_t i = 0; i < v->sz; i++) {
+		x = s >= 0 ? (int64_t)v->data[i] * (1LL << s) :
+		    (int64_t)v->data[i] >> -s;
+		v->data[i] = zsl_q31_sat((x * (1LL << 31)) / (int64_t)n);
+	}
+
+	return 0;
+}
+
+int zsl_vec_q31_unit_from_i64(struct zsl_vec_q31 *v, const int64_t *x)
+{
+	uint64_t m = 0;
+	int s = 0;
+
+	for (size_t i = 0; i < v->sz; i++) {
+		m |= (uint64_t)(x[i] < 0 ? -x[i] : x[i]);
+	}
+
+	/* Drop as few low bits as possible to fit the values in Q31. */
+	while (m >= (1ULL << 31)) {
+		m >>= 1;
+		s++;
+	}
+
+	for (size_t i = 0; i < v->sz; i++) {
+		v->data[i] = (zsl_q31_t)(x[i] >> s);
+	}
+
+	return zsl_vec_q31_to_unit(v);
+}
+
+int zsl_vec_q31_cross(struct zsl_vec_q31 *v, struct zsl_vec_q31 *w,
+		      struct zsl_vec_q31 *c)
+{
+	int64_t x[3];
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure this is a 3-vector. */
+	if ((v->sz != 3) || (w->sz != 3) || (c->sz != 3)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Use a temporary result, so that 'c' may be the same as 'v' or 'w'.
+	 * The products are halved so that their difference fits in 64 bits. */
+	x[0] = (((int64_t)v->data[1] * w->data[2]) >> 1) -
+	       (((int64_t)v->data[2] * w->data[1]) >> 1);
+	x[1] = (((int64_t)v->data[2] * w->data[0]) >> 1) -
+	       (((int64_t)v->data[0] * w->data[2]) >> 1);
+	x[2] = (((int64_t)v->data[0] * w->data[1]) >> 1) -
+	       (((int64_t)v->data[1] * w->data[0]) >> 1);
+
+	for (size_t i = 0; i < 3; i++) {
+		c->data[i] = zsl_q31_sat((x[i] + (1LL << 29)) >> 30);
+	}
+
+	return 0;
+}
@@ -7,10 +7,16 @@
 #include <errno.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <zsl/zsl.h>
 #include <zsl/matrices.h>
 
+/* Enable optimised x86-64 SSE2/AVX functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+#include <zsl/asm/x86/asm_x86_matrices.h>
+#endif
+
 /*
  * WARNING: Work in progress!
  *
@@ -371,11 +377,13 @@ zsl_mtx_binary_func(struct zsl_mtx *ma, struct zsl_mtx *mb,
 	return 0;
 }
 
+#if !asm_mtx_add
 int
 zsl_mtx_add(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
 {
 	return zsl_mtx_binary_op(ma, mb, mc, ZSL_MTX_BINARY_OP_ADD);
 }
+#endif
 
 int
 zsl_mtx_add_d(struct zsl_mtx *ma, struct zsl_mtx *mb)
@@ -430,33 +438,210 @@ zsl_mtx_sub_d(struct zsl_mtx *ma, struct zsl_mtx *mb)
 	return zsl_mtx_binary_op(ma, mb, ma, ZSL_MTX_BINARY_OP_SUB);
 }
 
+/*
+ * Register tile and cache block sizes used by zsl_mtx_gemm, in elements.
+ * A KC x NC panel of 'mb' is reused by every row of 'ma', so it should fit
+ * comfortably in the data cache (16 KB with the defaults in double
+ * precision). The tile size is fixed at 4x4, which keeps 16 accumulators
+ * in FPU registers on Cortex-M4F/M7 and most application cores.
+ */
+#ifndef ZSL_MTX_GEMM_KC
+#define ZSL_MTX_GEMM_KC (32U)
+#endif
+
+#ifndef ZSL_MTX_GEMM_NC
+#define ZSL_MTX_GEMM_NC (64U)
+#endif
+
+/**
+ * @brief Returns true if the data of 'ma' and 'mb' share any storage.
+ */
+static bool
+zsl_mtx_overlaps(struct zsl_mtx *ma, struct zsl_mtx *mb)
+{
+	uintptr_t a0 = (uintptr_t)ma->data;
+	uintptr_t a1 = (uintptr_t)(ma->data + (ma->sz_rows * ma->sz_cols));
+	uintptr_t b0 = (uintptr_t)mb->data;
+	uintptr_t b1 = (uintptr_t)(mb->data + (mb->sz_rows * mb->sz_cols));
+
+	return (a0 < b1) && (b0 < a1);
+}
+
+/**
+ * @brief Computes a 4x4 tile of c += alpha * a * b over 'kb' steps of the
+ *        inner dimension. 'a' advances by 'a_rs' per row and 'a_cs' per
+ *        inner step, 'b' by 'b_rs' per inner step and 'b_cs' per column.
+ */
+static void
+zsl_mtx_gemm_4x4(size_t kb, zsl_real_t alpha,
+		 const zsl_real_t *a, size_t a_rs, size_t a_cs,
+		 const zsl_real_t *b, size_t b_rs, size_t b_cs,
+		 zsl_real_t *c, size_t ldc)
+{
+	zsl_real_t a0, a1, a2, a3;
+	zsl_real_t b0, b1, b2, b3;
+	zsl_real_t c00 = 0.0, c01 = 0.0, c02 = 0.0, c03 = 0.0;
+	zsl_real_t c10 = 0.0, c11 = 0.0, c12 = 0.0, c13 = 0.0;
+	zsl_real_t c20 = 0.0, c21 = 0.0, c22 = 0.0, c23 = 0.0;
+	zsl_real_t c30 = 0.0, c31 = 0.0, c32 = 0.0, c33 = 0.0;
+
+	for (size_t p = 0; p < kb; p++) {
+		a0 = a[0];
+		a1 = a[a_rs];
+		a2 = a[2 * a_rs];
+		a3 = a[3 * a_rs];
+		b0 = b[0];
+		b1 = b[b_cs];
+		b2 = b[2 * b_cs];
+		b3 = b[3 * b_cs];
+
+		c00 += a0 * b0; c01 += a0 * b1; c02 += a0 * b2; c03 += a0 * b3;
+		c10 += a1 * b0; c11 += a1 * b1; c12 += a1 * b2; c13 += a1 * b3;
+		c20 += a2 * b0; c21 += a2 * b1; c22 += a2 * b2; c23 += a2 * b3;
+		c30 += a3 * b0; c31 += a3 * b1; c32 += a3 * b2; c33 += a3 * b3;
+
+		a += a_cs;
+		b += b_rs;
+	}
+
+	c[0] += alpha * c00; c[1] += alpha * c01;
+	c[2] += alpha * c02; c[3] += alpha * c03;
+	c += ldc;
+	c[0] += alpha * c10; c[1] += alpha * c11;
+	c[2] += alpha * c12; c[3] += alpha * c13;
+	c += ldc;
+	c[0] += alpha * c20; c[1] += alpha * c21;
+	c[2] += alpha * c22; c[3] += alpha * c23;
+	c += ldc;
+	c[0] += alpha * c30; c[1] += alpha * c31;
+	c[2] += alpha * c32; c[3] += alpha * c33;
+}
+
+/**
+ * @brief Computes a partial 'mr' x 'nr' tile at the right or bottom edge of
+ *        the output, using the same conventions as zsl_mtx_gemm_4x4.
+ */
+static void
+zsl_mtx_gemm_edge(size_t mr, size_t nr, size_t kb, zsl_real_t alpha,
+		  const zsl_real_t *a, size_t a_rs, size_t a_cs,
+		  const zsl_real_t *b, size_t b_rs, size_t b_cs,
+		  zsl_real_t *c, size_t ldc)
+{
+	zsl_real_t sum;
+
+	for (size_t i = 0; i < mr; i++) {
+		for (size_t j = 0; j < nr; j++) {
+			sum = 0.0;
+			for (size_t p = 0; p < kb; p++) {
+				sum += a[(i * a_rs) + (p * a_cs)] *
+				       b[(p * b_rs) + (j * b_cs)];
+			}
+			c[(i * ldc) + j] += alpha * sum;
+		}
+	}
+}
+
 int
-zsl_mtx_mult(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
+zsl_mtx_gemm(bool ta, bool tb, zsl_real_t alpha, struct zsl_mtx *ma,
+	     struct zsl_mtx *mb, zsl_real_t beta, struct zsl_mtx *mc)
 {
+	/* op(ma) is m x k, op(mb) is k x n. */
+	size_t m = ta ? ma->sz_cols : ma->sz_rows;
+	size_t k = ta ? ma->sz_rows : ma->sz_cols;
+	size_t n = tb ? mb->sz_rows : mb->sz_cols;
+
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Ensure that ma has the same number as columns as mb has rows. */
-	if (ma->sz_cols != mb->sz_rows) {
+	/* Ensure that op(ma) has the same number of columns as op(mb) has
+	 * rows. */
+	if ((tb ? mb->sz_cols : mb->sz_rows) != k) {
 		return -EINVAL;
 	}
 
-	/* Ensure that mc has ma rows and mb cols */
-	if ((mc->sz_rows != ma->sz_rows) || (mc->sz_cols != mb->sz_cols)) {
+	/* Ensure that mc has op(ma) rows and op(mb) cols. */
+	if ((mc->sz_rows != m) || (mc->sz_cols != n)) {
 		return -EINVAL;
 	}
 #endif
 
-	ZSL_MATRIX_DEF(ma_copy, ma->sz_rows, ma->sz_cols);
-	ZSL_MATRIX_DEF(mb_copy, mb->sz_rows, mb->sz_cols);
-	zsl_mtx_copy(&ma_copy, ma);
-	zsl_mtx_copy(&mb_copy, mb);
+	/* Element strides of op(ma) per row and per inner step, and of op(mb)
+	 * per inner step and per column. */
+	size_t a_rs = ta ? 1 : ma->sz_cols;
+	size_t a_cs = ta ? ma->sz_cols : 1;
+	size_t b_rs = tb ? 1 : mb->sz_cols;
+	size_t b_cs = tb ? mb->sz_cols : 1;
+
+	/* Only take a copy of an input that shares storage with the output,
+	 * since mc is written before all of the inputs have been read. */
+	bool a_alias = zsl_mtx_overlaps(ma, mc);
+	bool b_alias = zsl_mtx_overlaps(mb, mc);
+	bool b_is_a = (mb->data == ma->data) &&
+		      ((mb->sz_rows * mb->sz_cols) ==
+		       (ma->sz_rows * ma->sz_cols));
+	zsl_real_t a_copy[a_alias ? (ma->sz_rows * ma->sz_cols) : 1];
+	zsl_real_t b_copy[(b_alias && !b_is_a) ?
+			  (mb->sz_rows * mb->sz_cols) : 1];
+	const zsl_real_t *a = ma->data;
+	const zsl_real_t *b = mb->data;
+
+	if (a_alias) {
+		memcpy(a_copy, ma->data,
+		       (ma->sz_rows * ma->sz_cols) * sizeof(zsl_real_t));
+		a = a_copy;
+	}
+	if (b_alias) {
+		if (b_is_a) {
+			b = a;
+		} else {
+			memcpy(b_copy, mb->data,
+			       (mb->sz_rows * mb->sz_cols) * sizeof(zsl_real_t));
+			b = b_copy;
+		}
+	}
+
+	/* mc = beta * mc. A zero beta overwrites mc, even if it holds NaNs. */
+	if (beta == 0.0) {
+		memset(mc->data, 0, (m * n) * sizeof(zsl_real_t));
+	} else if (beta != 1.0) {
+		for (size_t i = 0; i < m * n; i++) {
+			mc->data[i] *= beta;
+		}
+	}
+
+	if (alpha == 0.0) {
+		return 0;
+	}
 
-	for (size_t i = 0; i < ma_copy.sz_rows; i++) {
-		for (size_t j = 0; j < mb_copy.sz_cols; j++) {
-			mc->data[j + i * mb_copy.sz_cols] = 0;
-			for (size_t k = 0; k < ma_copy.sz_cols; k++) {
-				mc->data[j + i * mb_copy.sz_cols] +=
-					ma_copy.data[k + i * ma_copy.sz_cols] *
-					mb_copy.data[j + k * mb_copy.sz_cols];
+	/* mc += alpha * op(ma) * op(mb), one KC x NC panel of op(mb) at a
+	 * time, in 4x4 register tiles. */
+	for (size_t k0 = 0; k0 < k; k0 += ZSL_MTX_GEMM_KC) {
+		size_t kb = (k - k0) < ZSL_MTX_GEMM_KC ?
+			    (k - k0) : ZSL_MTX_GEMM_KC;
+		for (size_t j0 = 0; j0 < n; j0 += ZSL_MTX_GEMM_NC) {
+			size_t j1 = (n - j0) < ZSL_MTX_GEMM_NC ?
+				    n : (j0 + ZSL_MTX_GEMM_NC);
+			for (size_t i = 0; i < m; i += 4) {
+				size_t mr = (m - i) < 4 ? (m - i) : 4;
+				for (size_t j = j0; j < j1; j += 4) {
+					size_t nr = (j1 - j) < 4 ? (j1 - j) : 4;
+					const zsl_real_t *at = a + (i * a_rs) +
+							       (k0 * a_cs);
+					const zsl_real_t *bt = b + (k0 * b_rs) +
+							       (j * b_cs);
+					zsl_real_t *ct = mc->data + (i * n) + j;
+
+					if ((mr == 4) && (nr == 4)) {
+						zsl_mtx_gemm_4x4(kb, alpha,
+								 at, a_rs, a_cs,
+								 bt, b_rs, b_cs,
+								 ct, n);
+					} else {
+						zsl_mtx_gemm_edge(mr, nr, kb,
+								  alpha,
+								  at, a_rs, a_cs,
+								  bt, b_rs, b_cs,
+								  ct, n);
+					}
+				}
 			}
 		}
 	}
@@ -464,6 +649,14 @@ zsl_mtx_mult(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
 	return 0;
 }
 
+#if !asm_mtx_mult
+int
+zsl_mtx_mult(struct zsl_mtx *ma, struct zsl_mtx *mb, struct zsl_mtx *mc)
+{
+	return zsl_mtx_gemm(false, false, 1.0, ma, mb, 0.0, mc);
+}
+#endif
+
 int
 zsl_mtx_mult_d(struct zsl_mtx *ma, struct zsl_mtx *mb)
 {
@@ -510,6 +703,7 @@ zsl_mtx_scalar_mult_row_d(struct zsl_mtx *m, size_t i, zsl_real_t s)
 	return 0;
 }
 
+#if !asm_mtx_trans
 int
 zsl_mtx_trans(struct zsl_mtx *ma, struct zsl_mtx *mb)
 {
@@ -529,6 +723,7 @@ zsl_mtx_trans(struct zsl_mtx *ma, struct zsl_mtx *mb)
 
 	return 0;
 }
+#endif
 
 int
 zsl_mtx_adjoint_3x3(struct zsl_mtx *m, struct zsl_mtx *ma)
@@ -788,37 +983,96 @@ zsl_mtx_deter(struct zsl_mtx *m, zsl_real_t *d)
 
 	/* Full calculation required for non 3x3 matrices. */
 	int rc;
-	zsl_real_t dtmp;
-	zsl_real_t cur;
-	zsl_real_t sign;
-	ZSL_MATRIX_DEF(mr, (m->sz_rows - 1), (m->sz_rows - 1));
+	size_t p[m->sz_rows];
+	ZSL_MATRIX_DEF(lu, m->sz_rows, m->sz_rows);
 
-	/* Clear determinant output before starting. */
-	*d = 0.0;
+	/* Factorise 'm' into P * m = L * U. */
+	rc = zsl_mtx_lu(m, &lu, p);
+	if (rc) {
+		return rc;
+	}
 
 	/*
-	 * Iterate across row 0, removing columns one by one.
-	 * Note that these calls are recursive until we reach a 3x3 matrix,
-	 * which will be calculated using the shortcut at the top of this
-	 * function.
+	 * Since L has a unit diagonal, the determinant is the product of the
+	 * diagonal elements in U, changing sign once for every row interchange
+	 * made while pivoting.
 	 */
-	for (size_t g = 0; g < m->sz_cols; g++) {
-		zsl_mtx_get(m, 0, g, &cur);     /* Get value at (0, g). */
-		zsl_mtx_init(&mr, NULL);        /* Clear mr. */
-		zsl_mtx_reduce(m, &mr, 0, g);   /* Remove row 0, column g. */
-		rc = zsl_mtx_deter(&mr, &dtmp); /* Calc. determinant of mr. */
-		sign = 1.0;
-		if (rc) {
-			return -EINVAL;
+	*d = 1.0;
+	for (size_t k = 0; k < lu.sz_rows; k++) {
+		*d *= lu.data[(k * lu.sz_cols) + k];
+		if (p[k] != k) {
+			*d = -*d;
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_lu(struct zsl_mtx *m, struct zsl_mtx *lu, size_t *p)
+{
+	size_t n = m->sz_rows;
+	size_t piv;
+	zsl_real_t max;
+	zsl_real_t x;
+	zsl_real_t *a;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'm' is square. */
+	if (m->sz_rows != m->sz_cols) {
+		return -EINVAL;
+	}
+
+	/* Make sure 'm' and 'lu' have the same shape. */
+	if ((m->sz_rows != lu->sz_rows) || (m->sz_cols != lu->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	/* The factorisation is done in place in 'lu'. */
+	if (lu != m) {
+		zsl_mtx_copy(lu, m);
+	}
+	a = lu->data;
+
+	for (size_t k = 0; k < n; k++) {
+		/* Find the largest absolute value on or below the diagonal in
+		 * column 'k', and use its row as the pivot row. */
+		piv = k;
+		max = ZSL_ABS(a[(k * n) + k]);
+		for (size_t i = k + 1; i < n; i++) {
+			x = ZSL_ABS(a[(i * n) + k]);
+			if (x > max) {
+				max = x;
+				piv = i;
+			}
+		}
+		p[k] = piv;
+
+		/* Swap rows 'k' and 'piv'. */
+		if (piv != k) {
+			for (size_t j = 0; j < n; j++) {
+				x = a[(k * n) + j];
+				a[(k * n) + j] = a[(piv * n) + j];
+				a[(piv * n) + j] = x;
+			}
 		}
 
-		/* Uneven elements are negative. */
-		if (g % 2 != 0) {
-			sign = -1.0;
+		/* If the whole column is zero, the matrix is singular and
+		 * there is nothing left to eliminate in this column. */
+		if (max == 0.0) {
+			continue;
 		}
 
-		/* Add current determinant to final output value. */
-		*d += dtmp * cur * sign;
+		/* Store the multipliers in the lower part of column 'k', and
+		 * update the trailing submatrix row by row. */
+		for (size_t i = k + 1; i < n; i++) {
+			a[(i * n) + k] /= a[(k * n) + k];
+			x = a[(i * n) + k];
+			for (size_t j = k + 1; j < n; j++) {
+				a[(i * n) + j] -= x * a[(k * n) + j];
+			}
+		}
 	}
 
 	return 0;
@@ -1079,11 +1333,78 @@ err:
 	return rc;
 }
 
+/**
+ * Returns the tolerance used to decide if a pivot of a decomposition of the
+ * square matrix 'm' is zero, relative to the largest absolute value in 'm'.
+ */
+static zsl_real_t
+zsl_mtx_pivot_tol(struct zsl_mtx *m)
+{
+	zsl_real_t max = 0.0;
+
+	for (size_t i = 0; i < m->sz_rows * m->sz_cols; i++) {
+		if (ZSL_ABS(m->data[i]) > max) {
+			max = ZSL_ABS(m->data[i]);
+		}
+	}
+
+	return (zsl_real_t)m->sz_rows * ZSL_EPSILON * max;
+}
+
+/**
+ * Solves a * x = b in place in 'x', given the LU decomposition of 'a' and its
+ * row interchanges 'p', as returned by zsl_mtx_lu.
+ */
+static void
+zsl_mtx_lu_subst(struct zsl_mtx *lu, size_t *p, struct zsl_mtx *x)
+{
+	size_t n = lu->sz_rows;
+	size_t k = x->sz_cols;
+	zsl_real_t *a = lu->data;
+	zsl_real_t *b = x->data;
+	zsl_real_t y;
+
+	/* Apply the row interchanges to the right-hand side. */
+	for (size_t i = 0; i < n; i++) {
+		if (p[i] != i) {
+			for (size_t c = 0; c < k; c++) {
+				y = b[(i * k) + c];
+				b[(i * k) + c] = b[(p[i] * k) + c];
+				b[(p[i] * k) + c] = y;
+			}
+		}
+	}
+
+	/* Forward substitution with the unit lower triangular L. */
+	for (size_t i = 1; i < n; i++) {
+		for (size_t j = 0; j < i; j++) {
+			y = a[(i * n) + j];
+			for (size_t c = 0; c < k; c++) {
+				b[(i * k) + c] -= y * b[(j * k) + c];
+			}
+		}
+	}
+
+	/* Back substitution with the upper triangular U. */
+	for (size_t i = n; i-- > 0;) {
+		for (size_t j = i + 1; j < n; j++) {
+			y = a[(i * n) + j];
+			for (size_t c = 0; c < k; c++) {
+				b[(i * k) + c] -= y * b[(j * k) + c];
+			}
+		}
+		y = a[(i * n) + i];
+		for (size_t c = 0; c < k; c++) {
+			b[(i * k) + c] /= y;
+		}
+	}
+}
+
 int
 zsl_mtx_inv(struct zsl_mtx *m, struct zsl_mtx *mi)
 {
 	int rc;
-	zsl_real_t d = 0.0;
+	zsl_real_t tol;
 
 	/* Shortcut for 3x3 matrices. */
 	if (m->sz_rows == 3) {
@@ -1105,9 +1426,12 @@ zsl_mtx_inv(struct zsl_mtx *m, struct zsl_mtx *mi)
 	}
 #endif
 
-	/* Make a copy of matrix m on the stack to avoid modifying it. */
-	ZSL_MATRIX_DEF(m_tmp, mi->sz_rows, mi->sz_cols);
-	rc = zsl_mtx_copy(&m_tmp, m);
+	/* Decompose 'm' on the stack to avoid modifying it. */
+	size_t p[m->sz_rows];
+	ZSL_MATRIX_DEF(lu, m->sz_rows, m->sz_cols);
+
+	tol = zsl_mtx_pivot_tol(m);
+	rc = zsl_mtx_lu(m, &lu, p);
 	if (rc) {
 		return -EINVAL;
 	}
@@ -1118,15 +1442,57 @@ zsl_mtx_inv(struct zsl_mtx *m, struct zsl_mtx *mi)
 		return -EINVAL;
 	}
 
-	/* Make sure the determinant of 'm' is not zero. */
-	zsl_mtx_deter(m, &d);
+	/* Make sure 'm' isn't singular, using the pivots in U. */
+	for (size_t k = 0; k < lu.sz_rows; k++) {
+		if (ZSL_ABS(lu.data[(k * lu.sz_cols) + k]) <= tol) {
+			return 0;
+		}
+	}
+
+	/* Solve m * mi = I, one column of the identity matrix at a time. */
+	zsl_mtx_lu_subst(&lu, p, mi);
 
-	if (d == 0) {
-		return 0;
+	return 0;
+}
+
+int
+zsl_mtx_solve(struct zsl_mtx *a, struct zsl_mtx *b, struct zsl_mtx *x)
+{
+	int rc;
+	zsl_real_t tol;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'a' is square and 'b' has the same number of rows. */
+	if ((a->sz_rows != a->sz_cols) || (b->sz_rows != a->sz_rows)) {
+		return -EINVAL;
+	}
+
+	/* Make sure 'b' and 'x' have the same shape. */
+	if ((x->sz_rows != b->sz_rows) || (x->sz_cols != b->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	size_t p[a->sz_rows];
+	ZSL_MATRIX_DEF(lu, a->sz_rows, a->sz_cols);
+
+	tol = zsl_mtx_pivot_tol(a);
+	rc = zsl_mtx_lu(a, &lu, p);
+	if (rc) {
+		return rc;
+	}
+
+	/* A zero pivot means that 'a' is singular. */
+	for (size_t k = 0; k < lu.sz_rows; k++) {
+		if (ZSL_ABS(lu.data[(k * lu.sz_cols) + k]) <= tol) {
+			return -ESINGULAR;
+		}
 	}
 
-	/* Use Gauss-Jordan elimination for nxn matrices. */
-	zsl_mtx_gauss_reduc(m, mi, &m_tmp);
+	if (x != b) {
+		zsl_mtx_copy(x, b);
+	}
+	zsl_mtx_lu_subst(&lu, p, x);
 
 	return 0;
 }
@@ -1188,14 +1554,88 @@ zsl_mtx_cholesky(struct zsl_mtx *m, struct zsl_mtx *l)
 	return 0;
 }
 
+int
+zsl_mtx_solve_spd(struct zsl_mtx *a, struct zsl_mtx *b, struct zsl_mtx *x)
+{
+	int rc;
+	size_t n = a->sz_rows;
+	size_t k = b->sz_cols;
+	zsl_real_t tol;
+	zsl_real_t y;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure 'a' is square and 'b' has the same number of rows. */
+	if ((a->sz_rows != a->sz_cols) || (b->sz_rows != a->sz_rows)) {
+		return -EINVAL;
+	}
+
+	/* Make sure 'b' and 'x' have the same shape. */
+	if ((x->sz_rows != b->sz_rows) || (x->sz_cols != b->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	ZSL_MATRIX_DEF(l, a->sz_rows, a->sz_cols);
+
+	/* Calculate the lower triangular matrix 'l', where a = l * lt. */
+	rc = zsl_mtx_cholesky(a, &l);
+	if (rc) {
+		return rc;
+	}
+
+	/* If any diagonal element of 'l' is zero (or NaN, when a square root
+	 * of a negative value was taken), 'a' isn't positive definite. */
+	tol = zsl_mtx_pivot_tol(a);
+	for (size_t i = 0; i < n; i++) {
+		y = l.data[(i * n) + i];
+		if (!(y * y > tol)) {
+			return -ESINGULAR;
+		}
+	}
+
+	if (x != b) {
+		zsl_mtx_copy(x, b);
+	}
+
+	/* Forward substitution with 'l'. */
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < i; j++) {
+			y = l.data[(i * n) + j];
+			for (size_t c = 0; c < k; c++) {
+				x->data[(i * k) + c] -= y * x->data[(j * k) + c];
+			}
+		}
+		y = l.data[(i * n) + i];
+		for (size_t c = 0; c < k; c++) {
+			x->data[(i * k) + c] /= y;
+		}
+	}
+
+	/* Back substitution with the transpose of 'l'. */
+	for (size_t i = n; i-- > 0;) {
+		for (size_t j = i + 1; j < n; j++) {
+			y = l.data[(j * n) + i];
+			for (size_t c = 0; c < k; c++) {
+				x->data[(i * k) + c] -= y * x->data[(j * k) + c];
+			}
+		}
+		y = l.data[(i * n) + i];
+		for (size_t c = 0; c < k; c++) {
+			x->data[(i * k) + c] /= y;
+		}
+	}
+
+	return 0;
+}
+
 int
 zsl_mtx_balance(struct zsl_mtx *m, struct zsl_mtx *mout)
 {
 	int rc;
 	bool done = false;
 	zsl_real_t sum;
-	zsl_real_t row, row2;
-	zsl_real_t col, col2;
+	zsl_real_t row = 0.0, row2;
+	zsl_real_t col = 0.0, col2;
 
 	/* Make sure we have square matrices. */
 	if ((m->sz_rows != m->sz_cols) || (mout->sz_rows != mout->sz_cols)) {
@@ -1269,297 +1709,1493 @@ err:
 	return rc;
 }
 
-int
-zsl_mtx_householder(struct zsl_mtx *m, struct zsl_mtx *h, bool hessenberg)
+/**
+ * @brief Takes 'n' elements from workspace 'ws'. The caller must already have
+ *        checked that 'ws' has enough room.
+ */
+static zsl_real_t *
+zsl_ws_take(struct zsl_ws *ws, size_t n)
 {
-	size_t size = m->sz_rows;
+	zsl_real_t *p = ws->data + ws->used;
 
-	if (hessenberg == true) {
-		size--;
+	ws->used += n;
+	if (ws->used > ws->peak) {
+		ws->peak = ws->used;
 	}
 
-	ZSL_VECTOR_DEF(v, size);
-	ZSL_VECTOR_DEF(v2, m->sz_rows);
-	ZSL_VECTOR_DEF(e1, size);
-
-	ZSL_MATRIX_DEF(mv, size, 1);
-	ZSL_MATRIX_DEF(mvt, 1, size);
-	ZSL_MATRIX_DEF(id, size, size);
-	ZSL_MATRIX_DEF(vvt, size, size);
-	ZSL_MATRIX_DEF(h2, size, size);
-
-	/* Create the e1 vector, i.e. the vector (1, 0, 0, ...). */
-	zsl_vec_init(&e1);
-	e1.data[0] = 1.0;
+	return p;
+}
 
-	/* Get the first column of the input matrix. */
-	zsl_mtx_get_col(m, 0, v2.data);
-	if (hessenberg == true) {
-		zsl_vec_get_subset(&v2, 1, size, &v);
-	} else {
-		zsl_vec_copy(&v, &v2);
+/* Declares an m x n matrix or n-vector backed by workspace 'ws'. */
+#define ZSL_WS_MATRIX_DEF(ws, name, m, n)				\
+	struct zsl_mtx name = {						\
+		.sz_rows = (m),						\
+		.sz_cols = (n),						\
+		.data = zsl_ws_take((ws), (m) * (n))			\
 	}
 
-	/* Change the 'sign' value according to the sign of the first
-	 * coefficient of the matrix. */
-	zsl_real_t sign = 1.0;
-
-	if (v.data[0] < 0) {
-		sign = -1.0;
+#define ZSL_WS_VECTOR_DEF(ws, name, n)					\
+	struct zsl_vec name = {						\
+		.sz = (n),						\
+		.data = zsl_ws_take((ws), (n))				\
 	}
 
-	/* Calculate the vector 'v' that will later be used to calculate the
-	 * Householder matrix. */
-	zsl_vec_scalar_mult(&e1, -sign * zsl_vec_norm(&v));
+/*
+ * Worst-case workspace, in zsl_real_t elements, for each decomposition
+ * below. Each count is the sum of the function's own temporaries and the
+ * largest nested call made while they are live.
+ */
+static size_t
+zsl_mtx_ws_qrd_sz(size_t r, size_t c)
+{
+	/* tau, v (r); w (max(r, c)). */
+	return (2 * r) + (r > c ? r : c);
+}
 
-	zsl_vec_add(&v, &e1, &v);
+static size_t
+zsl_mtx_ws_qrd_iter_sz(size_t n)
+{
+	/* q, r (n x n), plus zsl_mtx_qrd_ws. */
+	return (2 * n * n) + zsl_mtx_ws_qrd_sz(n, n);
+}
 
-	zsl_vec_scalar_div(&v, zsl_vec_norm(&v));
+static size_t
+zsl_mtx_ws_eigenvalues_sz(size_t n)
+{
+	/* mout, mtemp, mtemp2 (n x n), plus zsl_mtx_qrd_iter_ws. */
+	return (3 * n * n) + zsl_mtx_ws_qrd_iter_sz(n);
+}
 
-	/* Calculate the H householder matrix by doing:
-	 * H = IDENTITY - 2 * v * v^t. */
-	zsl_mtx_from_arr(&mv, v.data);
-	zsl_mtx_trans(&mv, &mvt);
-	zsl_mtx_mult(&mv, &mvt, &vvt);
-	zsl_mtx_init(&id, zsl_mtx_entry_fn_identity);
-	zsl_mtx_scalar_mult_d(&vvt, -2);
-	zsl_mtx_add(&id, &vvt, &h2);
+static size_t
+zsl_mtx_ws_eigenvalues_francis_sz(size_t n)
+{
+	/* h (n x n); tau, v, w (n). */
+	return (n * n) + (3 * n);
+}
 
-	/* If Hessenberg set to true, augment the output to the size of 'm'.
-	 * If Hessenberg set to false, this line of code will do nothing but
-	 * copy the matrix 'h2' into the output matrix 'h', */
-	zsl_mtx_augm_diag(&h2, h);
+static size_t
+zsl_mtx_ws_eigen_sym_sz(size_t n)
+{
+	/* a (n x n); b, t (n). */
+	return (n * n) + (2 * n);
+}
 
-	return 0;
+static size_t
+zsl_mtx_ws_eigenvectors_sz(size_t n)
+{
+	/* k, f, o (n); id, mi, mid, evec, evec2, mev2 (n x n), plus
+	 * zsl_mtx_eigenvalues_ws. */
+	return (3 * n) + (6 * n * n) + zsl_mtx_ws_eigenvalues_sz(n);
 }
 
-int
-zsl_mtx_qrd(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
-	    bool hessenberg)
+static size_t
+zsl_mtx_ws_svd_sz(size_t r, size_t c)
 {
-	ZSL_MATRIX_DEF(r2, m->sz_rows, m->sz_cols);
-	ZSL_MATRIX_DEF(hess, m->sz_rows, m->sz_cols);
-	ZSL_MATRIX_DEF(h, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(h2, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(qt, m->sz_rows, m->sz_rows);
+	size_t min = r < c ? r : c;
+	size_t max = r < c ? c : r;
 
-	zsl_mtx_init(&h, NULL);
-	zsl_mtx_init(&qt, zsl_mtx_entry_fn_identity);
-	zsl_mtx_copy(r, m);
+	/* aat, upri (r x r); ata (c x c); at (c x r); ui3, hu (r);
+	 * ui2 (c); ev (min), plus the largest zsl_mtx_eigenvectors_ws. */
+	return (2 * r * r) + (c * c) + (c * r) + (2 * r) + c + min +
+	       zsl_mtx_ws_eigenvectors_sz(max);
+}
 
-	for (size_t g = 0; g < (m->sz_rows - 1); g++) {
+static size_t
+zsl_mtx_ws_svd_thin_sz(size_t r, size_t c)
+{
+	size_t min = r < c ? r : c;
+	size_t max = r < c ? c : r;
 
-		/* Reduce the matrix by 'g' rows and columns each time. */
-		ZSL_MATRIX_DEF(mred, (m->sz_rows - g), (m->sz_cols - g));
-		ZSL_MATRIX_DEF(hred, (m->sz_rows - g), (m->sz_rows - g));
+	/* a (max x min); tau (min); hv, hw (max). */
+	return (max * min) + min + (2 * max);
+}
 
-		/* allocate the placeholder matrices for the reduction loop */
-		ZSL_MATRIX_DEF(place1, r->sz_rows, r->sz_cols);
-		ZSL_MATRIX_DEF(place2, r->sz_rows, r->sz_cols);
+static size_t
+zsl_mtx_ws_pinv_sz(size_t r, size_t c)
+{
+	size_t min = r < c ? r : c;
 
-		while(zsl_mtx_reduce_iter(r, &mred, &place1, &place2) != 0);
+	/* u (r x min); s (min); v (c x min), plus zsl_mtx_svd_thin_ws. */
+	return (r * min) + min + (c * min) + zsl_mtx_ws_svd_thin_sz(r, c);
+}
 
-		/* Calculate the reduced Householder matrix 'hred'. */
-		if (hessenberg == true) {
-			zsl_mtx_householder(&mred, &hred, true);
-		} else {
-			zsl_mtx_householder(&mred, &hred, false);
-		}
+int
+zsl_ws_init(struct zsl_ws *ws, zsl_real_t *buf, size_t bytes)
+{
+	ws->data = buf;
+	ws->sz = bytes / sizeof(zsl_real_t);
+	ws->used = 0;
+	ws->peak = 0;
 
-		/* Augment the Householder matrix to the input matrix size. */
-		zsl_mtx_augm_diag(&hred, &h);
-		zsl_mtx_mult(&h, r, &r2);
+	return 0;
+}
 
-		/* Multiply this Householder matrix by the previous ones,
-		 * stacked in 'qt'. */
-		zsl_mtx_mult(&h, &qt, &h2);
-		zsl_mtx_copy(&qt, &h2);
-		if (hessenberg == true) {
-			zsl_mtx_mult(&r2, &h, &hess);
-			zsl_mtx_copy(r, &hess);
-		} else {
-			zsl_mtx_copy(r, &r2);
-		}
+int
+zsl_ws_mtx(struct zsl_ws *ws, struct zsl_mtx *m, size_t rows, size_t cols)
+{
+	if ((ws->sz - ws->used) < (rows * cols)) {
+		return -ENOMEM;
 	}
 
-	/* Calculate the 'q' matrix by transposing 'qt'. */
-	zsl_mtx_trans(&qt, q);
+	m->sz_rows = rows;
+	m->sz_cols = cols;
+	m->data = zsl_ws_take(ws, rows * cols);
 
 	return 0;
 }
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
 int
-zsl_mtx_qrd_iter(struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter)
+zsl_ws_vec(struct zsl_ws *ws, struct zsl_vec *v, size_t sz)
 {
-	int rc;
-
-	ZSL_MATRIX_DEF(q, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(r, m->sz_rows, m->sz_rows);
-
-
-	/* Make a copy of 'm'. */
-	rc = zsl_mtx_copy(mout, m);
-	if (rc) {
-		return -EINVAL;
+	if ((ws->sz - ws->used) < sz) {
+		return -ENOMEM;
 	}
 
-	for (size_t g = 1; g <= iter; g++) {
-		/* Perform the QR decomposition. */
-		zsl_mtx_qrd(mout, &q, &r, false);
-
-		/* Multiply the results of the QR decomposition together but
-		 * changing its order. */
-		zsl_mtx_mult(&r, &q, mout);
-	}
+	v->sz = sz;
+	v->data = zsl_ws_take(ws, sz);
 
 	return 0;
 }
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
-int
-zsl_mtx_eigenvalues(struct zsl_mtx *m, struct zsl_vec *v, size_t iter)
+size_t
+zsl_mtx_ws_bytes(zsl_mtx_ws_op_t op, size_t rows, size_t cols)
 {
-	zsl_real_t diag;
-	zsl_real_t sdiag;
-	size_t real = 0;
+	size_t n = 0;
+
+	switch (op) {
+	case ZSL_MTX_WS_QRD:
+		n = zsl_mtx_ws_qrd_sz(rows, cols);
+		break;
+	case ZSL_MTX_WS_QRD_ITER:
+		n = zsl_mtx_ws_qrd_iter_sz(rows);
+		break;
+	case ZSL_MTX_WS_EIGENVALUES:
+		n = zsl_mtx_ws_eigenvalues_sz(rows);
+		break;
+	case ZSL_MTX_WS_EIGENVALUES_FRANCIS:
+		n = zsl_mtx_ws_eigenvalues_francis_sz(rows);
+		break;
+	case ZSL_MTX_WS_EIGEN_SYM:
+		n = zsl_mtx_ws_eigen_sym_sz(rows);
+		break;
+	case ZSL_MTX_WS_EIGENVECTORS:
+		n = zsl_mtx_ws_eigenvectors_sz(rows);
+		break;
+	case ZSL_MTX_WS_SVD:
+		n = zsl_mtx_ws_svd_sz(rows, cols);
+		break;
+	case ZSL_MTX_WS_SVD_THIN:
+		n = zsl_mtx_ws_svd_thin_sz(rows, cols);
+		break;
+	case ZSL_MTX_WS_PINV:
+		n = zsl_mtx_ws_pinv_sz(rows, cols);
+		break;
+	}
+
+	return n * sizeof(zsl_real_t);
+}
 
-	/* Epsilon is used to check 0 values in the subdiagonal, to determine
-	 * if any coimplekx values were found. Increasing the number of
-	 * iterations will move these values closer to 0, but when using
-	 * single-precision floats the numbers can still be quite large, so
-	 * we need to set a delta of +/- 0.001 in this case. */
+/**
+ * @brief Computes the Householder reflector H = I - tau * v * v^T that maps
+ *        the 'n' values at 'x', spaced 'inc' apart, to beta * e1. beta has
+ *        the magnitude of 'x' and the sign of x[0] (positive if x[0] is 0).
+ *        x[0] is replaced by beta, and x[1..n - 1] by v[1..n - 1], since v[0]
+ *        is always 1.
+ *
+ * @return tau, which is 0 (H = I, and 'x' is left as is) if x[1..n - 1] is
+ *         already zero, or negligible next to x[0].
+ */
+static zsl_real_t
+zsl_mtx_house_gen(zsl_real_t *x, size_t n, size_t inc)
+{
+	zsl_real_t scale = 0.0;
+	zsl_real_t sigma = 0.0;
+	zsl_real_t a, y, norm, v0;
 
-	zsl_real_t epsilon = 1E-6;
+	/* Work on x / max|x|, so that the sums of squares can't overflow or
+	 * lose precision to subnormals. v and tau don't depend on the scale. */
+	for (size_t i = 0; i < n; i++) {
+		scale = ZSL_MAX(scale, ZSL_ABS(x[i * inc]));
+	}
+	if (scale == 0.0) {
+		return 0.0;
+	}
 
-	ZSL_MATRIX_DEF(mout, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(mtemp, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(mtemp2, m->sz_rows, m->sz_rows);
+	for (size_t i = 1; i < n; i++) {
+		y = x[i * inc] / scale;
+		sigma += y * y;
+	}
 
-	/* Balance the matrix. */
+	/* With this sign of beta, v0 = x[0] - beta gets very small as x lines
+	 * up with e1, so leave columns that are reduced to within rounding. */
+	if (sigma <= ZSL_EPSILON * ZSL_EPSILON) {
+		return 0.0;
+	}
+
+	a = x[0] / scale;
+	norm = ZSL_SQRT(a * a + sigma);
+
+	/* v0 = a - beta, rearranged to avoid cancellation. */
+	if (a < 0.0) {
+		v0 = sigma / (norm - a);
+		x[0] = -norm * scale;
+		norm = -norm;
+	} else {
+		v0 = -sigma / (norm + a);
+		x[0] = norm * scale;
+	}
+
+	for (size_t i = 1; i < n; i++) {
+		x[i * inc] = (x[i * inc] / scale) / v0;
+	}
+
+	return -v0 / norm;
+}
+
+/**
+ * @brief Replaces the 'n' x 'nc' block of 'a' starting at row 'r0' and column
+ *        'c0' with H * block, where H = I - tau * v * v^T. 'v' holds 'n'
+ *        values, and 'w' is scratch space for 'nc' values.
+ */
+static void
+zsl_mtx_house_left(struct zsl_mtx *a, size_t r0, size_t c0, size_t n,
+		   size_t nc, const zsl_real_t *v, zsl_real_t tau,
+		   zsl_real_t *w)
+{
+	zsl_real_t *row;
+	zsl_real_t s;
+
+	if (tau == 0.0 || nc == 0) {
+		return;
+	}
+
+	/* w = block^T * v, accumulated one row at a time. */
+	row = &a->data[(r0 * a->sz_cols) + c0];
+	for (size_t j = 0; j < nc; j++) {
+		w[j] = v[0] * row[j];
+	}
+	for (size_t i = 1; i < n; i++) {
+		row = &a->data[((r0 + i) * a->sz_cols) + c0];
+		for (size_t j = 0; j < nc; j++) {
+			w[j] += v[i] * row[j];
+		}
+	}
+
+	/* block -= tau * v * w^T. */
+	for (size_t i = 0; i < n; i++) {
+		row = &a->data[((r0 + i) * a->sz_cols) + c0];
+		s = tau * v[i];
+		for (size_t j = 0; j < nc; j++) {
+			row[j] -= s * w[j];
+		}
+	}
+}
+
+/**
+ * @brief Replaces the 'nr' x 'n' block of 'a' starting at row 'r0' and column
+ *        'c0' with block * H, where H = I - tau * v * v^T. 'v' holds 'n'
+ *        values.
+ */
+static void
+zsl_mtx_house_right(struct zsl_mtx *a, size_t r0, size_t c0, size_t nr,
+		    size_t n, const zsl_real_t *v, zsl_real_t tau)
+{
+	zsl_real_t *row;
+	zsl_real_t s;
+
+	if (tau == 0.0) {
+		return;
+	}
+
+	for (size_t i = 0; i < nr; i++) {
+		row = &a->data[((r0 + i) * a->sz_cols) + c0];
+		s = 0.0;
+		for (size_t j = 0; j < n; j++) {
+			s += row[j] * v[j];
+		}
+		s *= tau;
+		for (size_t j = 0; j < n; j++) {
+			row[j] -= s * v[j];
+		}
+	}
+}
+
+/**
+ * @brief Returns the number of reflectors in the compact QR decomposition
+ *        (or Hessenberg reduction) of a 'rows' x 'cols' matrix.
+ */
+static size_t
+zsl_mtx_qrd_refl(size_t rows, size_t cols, bool hessenberg)
+{
+	if (hessenberg == true) {
+		return rows > 2 ? rows - 2 : 0;
+	}
+
+	if (rows == 0) {
+		return 0;
+	}
+
+	return (rows - 1) < cols ? (rows - 1) : cols;
+}
+
+/**
+ * @brief Copies reflector 'j' of the compact form 'qr' to 'v', and returns
+ *        its length. Reflector 'j' starts at row 'j + off'.
+ */
+static size_t
+zsl_mtx_qrd_refl_v(struct zsl_mtx *qr, size_t j, size_t off, zsl_real_t *v)
+{
+	size_t p = j + off;
+	size_t n = qr->sz_rows - p;
+
+	v[0] = 1.0;
+	for (size_t i = 1; i < n; i++) {
+		v[i] = qr->data[((p + i) * qr->sz_cols) + j];
+	}
+
+	return n;
+}
+
+/**
+ * @brief Computes the compact QR decomposition or Hessenberg reduction of
+ *        'qr' in place. 'v' and 'w' are scratch space for qr->sz_rows and
+ *        qr->sz_cols values.
+ */
+static void
+zsl_mtx_qrd_compact_v(struct zsl_mtx *qr, struct zsl_vec *tau, bool hessenberg,
+		      zsl_real_t *v, zsl_real_t *w)
+{
+	size_t off = hessenberg ? 1 : 0;
+	size_t k = zsl_mtx_qrd_refl(qr->sz_rows, qr->sz_cols, hessenberg);
+	size_t p, n;
+
+	for (size_t j = 0; j < k; j++) {
+		/* Zero column 'j' below row 'p', storing the reflector in the
+		 * zeroed part. */
+		p = j + off;
+		tau->data[j] = zsl_mtx_house_gen(
+			&qr->data[(p * qr->sz_cols) + j], qr->sz_rows - p,
+			qr->sz_cols);
+		n = zsl_mtx_qrd_refl_v(qr, j, off, v);
+
+		/* Apply it to the remaining columns, and in Hessenberg mode
+		 * from the right as well, to keep the eigenvalues. */
+		zsl_mtx_house_left(qr, p, j + 1, n, qr->sz_cols - j - 1, v,
+				   tau->data[j], w);
+		if (hessenberg == true) {
+			zsl_mtx_house_right(qr, 0, p, qr->sz_rows, n, v,
+					    tau->data[j]);
+		}
+	}
+
+	for (size_t j = k; j < tau->sz; j++) {
+		tau->data[j] = 0.0;
+	}
+}
+
+/**
+ * @brief Forms 'q' from the compact form in 'qr' and 'tau'. 'v' and 'w' are
+ *        scratch space for qr->sz_rows values each.
+ */
+static void
+zsl_mtx_qrd_form_q_v(struct zsl_mtx *qr, struct zsl_vec *tau, bool hessenberg,
+		     struct zsl_mtx *q, zsl_real_t *v, zsl_real_t *w)
+{
+	size_t off = hessenberg ? 1 : 0;
+	size_t k = zsl_mtx_qrd_refl(qr->sz_rows, qr->sz_cols, hessenberg);
+	size_t n;
+
+	/* Q = H(0) * ... * H(k - 1) * I, accumulated from the right, so that
+	 * each reflector only touches the trailing block of 'q' it affects. */
+	zsl_mtx_init(q, zsl_mtx_entry_fn_identity);
+	for (size_t j = k; j-- > 0;) {
+		n = zsl_mtx_qrd_refl_v(qr, j, off, v);
+		zsl_mtx_house_left(q, j + off, j + off, n, n, v, tau->data[j],
+				   w);
+	}
+}
+
+int
+zsl_mtx_householder(struct zsl_mtx *m, struct zsl_mtx *h, bool hessenberg)
+{
+	size_t diff = hessenberg ? 1 : 0;
+	size_t size = m->sz_rows - diff;
+	zsl_real_t v[m->sz_rows];
+	zsl_real_t tau;
+
+	zsl_mtx_init(h, zsl_mtx_entry_fn_identity);
+	if (size == 0) {
+		return 0;
+	}
+
+	/* Get the first column of the input matrix, skipping the first
+	 * row in hessenberg mode. */
+	for (size_t i = 0; i < size; i++) {
+		v[i] = m->data[(i + diff) * m->sz_cols];
+	}
+
+	tau = zsl_mtx_house_gen(v, size, 1);
+	v[0] = 1.0;
+
+	/* H = IDENTITY - tau * v * v^t. If Hessenberg is set to true, H is
+	 * augmented to the size of 'm' with ones on the first diagonal
+	 * entry. */
+	for (size_t i = 0; i < size; i++) {
+		for (size_t j = 0; j < size; j++) {
+			h->data[((i + diff) * h->sz_cols) + j + diff] =
+				(i == j ? 1.0 : 0.0) - tau * v[i] * v[j];
+		}
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_qrd_compact(struct zsl_mtx *m, struct zsl_mtx *qr, struct zsl_vec *tau,
+		    bool hessenberg)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((qr->sz_rows != m->sz_rows) || (qr->sz_cols != m->sz_cols) ||
+	    (tau->sz < zsl_mtx_qrd_refl(m->sz_rows, m->sz_cols, hessenberg))) {
+		return -EINVAL;
+	}
+	if ((hessenberg == true) && (m->sz_rows != m->sz_cols)) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_real_t v[m->sz_rows];
+	zsl_real_t w[m->sz_cols];
+
+	if (qr != m) {
+		zsl_mtx_copy(qr, m);
+	}
+	zsl_mtx_qrd_compact_v(qr, tau, hessenberg, v, w);
+
+	return 0;
+}
+
+int
+zsl_mtx_qrd_form_q(struct zsl_mtx *qr, struct zsl_vec *tau, bool hessenberg,
+		   struct zsl_mtx *q)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((q->sz_rows != qr->sz_rows) || (q->sz_cols != qr->sz_rows) ||
+	    (tau->sz < zsl_mtx_qrd_refl(qr->sz_rows, qr->sz_cols,
+					hessenberg))) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_real_t v[qr->sz_rows];
+	zsl_real_t w[qr->sz_rows];
+
+	zsl_mtx_qrd_form_q_v(qr, tau, hessenberg, q, v, w);
+
+	return 0;
+}
+
+int
+zsl_mtx_qrd_apply_qt(struct zsl_mtx *qr, struct zsl_vec *tau, bool hessenberg,
+		     struct zsl_mtx *b)
+{
+	size_t off = hessenberg ? 1 : 0;
+	size_t k = zsl_mtx_qrd_refl(qr->sz_rows, qr->sz_cols, hessenberg);
+	size_t n;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((b->sz_rows != qr->sz_rows) || (tau->sz < k)) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_real_t v[qr->sz_rows];
+	zsl_real_t w[b->sz_cols];
+
+	/* Q^T * b = H(k - 1) * ... * H(0) * b. */
+	for (size_t j = 0; j < k; j++) {
+		n = zsl_mtx_qrd_refl_v(qr, j, off, v);
+		zsl_mtx_house_left(b, j + off, 0, n, b->sz_cols, v,
+				   tau->data[j], w);
+	}
+
+	return 0;
+}
+
+int
+zsl_mtx_qrd_ws(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
+	       bool hessenberg, struct zsl_ws *ws)
+{
+	size_t mark = ws->used;
+	size_t off = hessenberg ? 1 : 0;
+
+	if ((ws->sz - ws->used) < zsl_mtx_ws_qrd_sz(m->sz_rows, m->sz_cols)) {
+		return -ENOMEM;
+	}
+
+	ZSL_WS_VECTOR_DEF(ws, tau, zsl_mtx_qrd_refl(m->sz_rows, m->sz_cols,
+						    hessenberg));
+	zsl_real_t *v = zsl_ws_take(ws, m->sz_rows);
+	zsl_real_t *w = zsl_ws_take(ws, m->sz_rows > m->sz_cols ?
+				    m->sz_rows : m->sz_cols);
+
+	/* Factorise 'm' in compact form in 'r', then form 'q' from the
+	 * reflectors stored below the diagonal (or subdiagonal) of 'r' before
+	 * clearing them. */
+	if (r != m) {
+		zsl_mtx_copy(r, m);
+	}
+	zsl_mtx_qrd_compact_v(r, &tau, hessenberg, v, w);
+	zsl_mtx_qrd_form_q_v(r, &tau, hessenberg, q, v, w);
+
+	for (size_t i = off + 1; i < r->sz_rows; i++) {
+		for (size_t j = 0; (j < i - off) && (j < r->sz_cols); j++) {
+			r->data[(i * r->sz_cols) + j] = 0.0;
+		}
+	}
+
+	ws->used = mark;
+
+	return 0;
+}
+
+int
+zsl_mtx_qrd(struct zsl_mtx *m, struct zsl_mtx *q, struct zsl_mtx *r,
+	    bool hessenberg)
+{
+	ZSL_WS_DEF(ws, zsl_mtx_ws_bytes(ZSL_MTX_WS_QRD, m->sz_rows,
+					m->sz_cols));
+
+	return zsl_mtx_qrd_ws(m, q, r, hessenberg, &ws);
+}
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+int
+zsl_mtx_qrd_iter_ws(struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter,
+		    struct zsl_ws *ws)
+{
+	int rc;
+	size_t mark = ws->used;
+
+	if ((ws->sz - ws->used) < zsl_mtx_ws_qrd_iter_sz(m->sz_rows)) {
+		return -ENOMEM;
+	}
+
+	ZSL_WS_MATRIX_DEF(ws, q, m->sz_rows, m->sz_rows);
+	ZSL_WS_MATRIX_DEF(ws, r, m->sz_rows, m->sz_rows);
+
+	/* Make a copy of 'm'. */
+	rc = zsl_mtx_copy(mout, m);
+	if (rc) {
+		ws->used = mark;
+		return -EINVAL;
+	}
+
+	for (size_t g = 1; g <= iter; g++) {
+		/* Perform the QR decomposition. */
+		zsl_mtx_qrd_ws(mout, &q, &r, false, ws);
+
+		/* Multiply the results of the QR decomposition together but
+		 * changing its order. */
+		zsl_mtx_mult(&r, &q, mout);
+	}
+
+	ws->used = mark;
+
+	return 0;
+}
+
+int
+zsl_mtx_qrd_iter(struct zsl_mtx *m, struct zsl_mtx *mout, size_t iter)
+{
+	ZSL_WS_DEF(ws, zsl_mtx_ws_bytes(ZSL_MTX_WS_QRD_ITER, m->sz_rows,
+					m->sz_cols));
+
+	return zsl_mtx_qrd_iter_ws(m, mout, iter, &ws);
+}
+#endif
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+int
+zsl_mtx_eigenvalues_ws(struct zsl_mtx *m, struct zsl_vec *v, size_t iter,
+		       struct zsl_ws *ws)
+{
+	zsl_real_t diag;
+	zsl_real_t sdiag;
+	size_t real = 0;
+	size_t mark = ws->used;
+
+	/* Epsilon is used to check 0 values in the subdiagonal, to determine
+	 * if any coimplekx values were found. Increasing the number of
+	 * iterations will move these values closer to 0, but when using
+	 * single-precision floats the numbers can still be quite large, so
+	 * we need to set a delta of +/- 0.001 in this case. */
+
+	zsl_real_t epsilon = 1E-6;
+
+	if ((ws->sz - ws->used) < zsl_mtx_ws_eigenvalues_sz(m->sz_rows)) {
+		return -ENOMEM;
+	}
+
+	ZSL_WS_MATRIX_DEF(ws, mout, m->sz_rows, m->sz_rows);
+	ZSL_WS_MATRIX_DEF(ws, mtemp, m->sz_rows, m->sz_rows);
+	ZSL_WS_MATRIX_DEF(ws, mtemp2, m->sz_rows, m->sz_rows);
+
+	/* Balance the matrix. */
 	zsl_mtx_balance(m, &mtemp);
 
-	/* Put the balanced matrix into hessenberg form. */
-	zsl_mtx_qrd(&mtemp, &mout, &mtemp2, true);
+	/* Put the balanced matrix into hessenberg form. */
+	zsl_mtx_qrd_ws(&mtemp, &mout, &mtemp2, true, ws);
+
+	/* Calculate the upper triangular matrix by using the recursive QR
+	 * decomposition method. */
+	zsl_mtx_qrd_iter_ws(&mtemp2, &mout, iter, ws);
+
+	zsl_vec_init(v);
+
+	/* If the matrix is symmetric, then it will always have real
+	 * eigenvalues, so treat this case appart. */
+	if (zsl_mtx_is_sym(m) == true) {
+		for (size_t g = 0; g < m->sz_rows; g++) {
+			zsl_mtx_get(&mout, g, g, &diag);
+			v->data[g] = diag;
+		}
+
+		ws->used = mark;
+		return 0;
+	}
+
+	/*
+	 * If any value just below the diagonal is non-zero, it means that the
+	 * numbers above and to the right of the non-zero value are a pair of
+	 * complex values, a complex number and its conjugate.
+	 *
+	 * SVD will always return real numbers so this can be ignored, but if
+	 * you are calculating eigenvalues outside the SVD method, you may
+	 * get complex numbers, which will be indicated with the return error
+	 * code '-ECOMPLEXVAL'.
+	 *
+	 * If the imput matrix has complex eigenvalues, then these will be
+	 * ignored and the output vector will not include them.
+	 *
+	 * NOTE: The real and imaginary parts of the complex numbers are not
+	 * available. This only checks if there are any complex eigenvalues and
+	 * returns an appropriate error code to alert the user that there are
+	 * non-real eigenvalues present.
+	 */
+
+	for (size_t g = 0; g < (m->sz_rows - 1); g++) {
+		/* Check if any element just below the diagonal isn't zero. */
+		zsl_mtx_get(&mout, g + 1, g, &sdiag);
+		if ((sdiag >= epsilon) || (sdiag <= -epsilon)) {
+			/* Skip two elements if the element below
+			 * is not zero. */
+			g++;
+		} else {
+			/* Get the diagonal element if the element below
+			 * is zero. */
+			zsl_mtx_get(&mout, g, g, &diag);
+			v->data[real] = diag;
+			real++;
+		}
+	}
+
+
+	/* Since it's not possible to check the coefficient below the last
+	 * diagonal element, then check the element to its left. */
+	zsl_mtx_get(&mout, (m->sz_rows - 1), (m->sz_rows - 2), &sdiag);
+	if ((sdiag >= epsilon) || (sdiag <= -epsilon)) {
+		/* Do nothing if the element to its left is not zero. */
+	} else {
+		/* Get the last diagonal element if the element to its left
+		 * is zero. */
+		zsl_mtx_get(&mout, (m->sz_rows - 1), (m->sz_rows - 1), &diag);
+		v->data[real] = diag;
+		real++;
+	}
+
+	/* If the number of real eigenvalues ('real' coefficient) is less than
+	 * the matrix dimensions, then there must be complex eigenvalues. */
+	ws->used = mark;
+
+	v->sz = real;
+	if (real != m->sz_rows) {
+		return -ECOMPLEXVAL;
+	}
+
+	/* Put the zeros to the end. */
+	zsl_vec_zte(v);
+
+	return 0;
+}
+
+int
+zsl_mtx_eigenvalues(struct zsl_mtx *m, struct zsl_vec *v, size_t iter)
+{
+	ZSL_WS_DEF(ws, zsl_mtx_ws_bytes(ZSL_MTX_WS_EIGENVALUES, m->sz_rows,
+					m->sz_cols));
+
+	return zsl_mtx_eigenvalues_ws(m, v, iter, &ws);
+}
+#endif
+
+/* Element (i, j) of the n x n matrix 'a' in zsl_mtx_hqr. */
+#define ZSL_HQR(i, j) a[((i) * n) + (j)]
+
+/**
+ * @brief Computes the eigenvalues of the n x n upper Hessenberg matrix 'a' in
+ *        place, with the Francis double-shift QR algorithm. The matrix is
+ *        split into independent blocks wherever a subdiagonal element drops
+ *        below 'tol' relative to its two diagonal neighbours, and each 1x1
+ *        or 2x2 block is read off as it is split from the bottom.
+ *
+ * @return 0 on success, or -ECONVERGE if more than 'max_iter' double-shift
+ *         steps were needed. 'iter' is set to the number of steps taken.
+ */
+static int
+zsl_mtx_hqr(zsl_real_t *a, size_t n, zsl_real_t *wr, zsl_real_t *wi,
+	    zsl_real_t tol, size_t max_iter, size_t *iter)
+{
+	size_t hi = n;
+	size_t its = 0;
+	size_t l, m, nn;
+	zsl_real_t anorm = 0.0;
+	zsl_real_t t = 0.0;
+	zsl_real_t p = 0.0, q = 0.0, r = 0.0;
+	zsl_real_t s, u, v, w, x, y, z;
+
+	*iter = 0;
+
+	/* Used in place of a zero diagonal when testing for deflation. */
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = (i > 0 ? i - 1 : 0); j < n; j++) {
+			anorm += ZSL_ABS(ZSL_HQR(i, j));
+		}
+	}
+
+	while (hi > 0) {
+		nn = hi - 1;
+
+		/* Look for a negligible subdiagonal element, which splits off
+		 * the active block [l, nn]. */
+		for (l = nn; l > 0; l--) {
+			s = ZSL_ABS(ZSL_HQR(l - 1, l - 1)) +
+			    ZSL_ABS(ZSL_HQR(l, l));
+			if (s == 0.0) {
+				s = anorm;
+			}
+			if (ZSL_ABS(ZSL_HQR(l, l - 1)) <= tol * s) {
+				ZSL_HQR(l, l - 1) = 0.0;
+				break;
+			}
+		}
+
+		x = ZSL_HQR(nn, nn);
+
+		/* One root found. */
+		if (l == nn) {
+			wr[nn] = x + t;
+			wi[nn] = 0.0;
+			hi -= 1;
+			its = 0;
+			continue;
+		}
+
+		y = ZSL_HQR(nn - 1, nn - 1);
+		w = ZSL_HQR(nn, nn - 1) * ZSL_HQR(nn - 1, nn);
+
+		/* Two roots found, either real or a complex-conjugate pair. */
+		if (l == nn - 1) {
+			p = 0.5 * (y - x);
+			q = p * p + w;
+			z = ZSL_SQRT(ZSL_ABS(q));
+			x += t;
+			if (q >= 0.0) {
+				z = p + (p < 0.0 ? -z : z);
+				wr[nn - 1] = wr[nn] = x + z;
+				if (z != 0.0) {
+					wr[nn] = x - w / z;
+				}
+				wi[nn - 1] = wi[nn] = 0.0;
+			} else {
+				wr[nn - 1] = wr[nn] = x + p;
+				wi[nn - 1] = z;
+				wi[nn] = -z;
+			}
+			hi -= 2;
+			its = 0;
+			continue;
+		}
+
+		if (*iter >= max_iter) {
+			return -ECONVERGE;
+		}
+
+		/* Exceptional shift, to break out of a rare stall. */
+		if ((its == 10) || (its == 20)) {
+			t += x;
+			for (size_t i = 0; i <= nn; i++) {
+				ZSL_HQR(i, i) -= x;
+			}
+			s = ZSL_ABS(ZSL_HQR(nn, nn - 1)) +
+			    ZSL_ABS(ZSL_HQR(nn - 1, nn - 2));
+			y = x = 0.75 * s;
+			w = -0.4375 * s * s;
+		}
+		its++;
+		(*iter)++;
+
+		/* Form the first column of the double-shift polynomial, and
+		 * look for two consecutive small subdiagonal elements to start
+		 * the bulge from. */
+		for (m = nn - 2;; m--) {
+			z = ZSL_HQR(m, m);
+			r = x - z;
+			s = y - z;
+			p = (r * s - w) / ZSL_HQR(m + 1, m) + ZSL_HQR(m, m + 1);
+			q = ZSL_HQR(m + 1, m + 1) - z - r - s;
+			r = ZSL_HQR(m + 2, m + 1);
+			s = ZSL_ABS(p) + ZSL_ABS(q) + ZSL_ABS(r);
+			p /= s;
+			q /= s;
+			r /= s;
+			if (m == l) {
+				break;
+			}
+			u = ZSL_ABS(ZSL_HQR(m, m - 1)) * (ZSL_ABS(q) + ZSL_ABS(r));
+			v = ZSL_ABS(p) * (ZSL_ABS(ZSL_HQR(m - 1, m - 1)) +
+					  ZSL_ABS(z) +
+					  ZSL_ABS(ZSL_HQR(m + 1, m + 1)));
+			if (u <= ZSL_EPSILON * v) {
+				break;
+			}
+		}
+
+		for (size_t i = m + 2; i <= nn; i++) {
+			ZSL_HQR(i, i - 2) = 0.0;
+			if (i != m + 2) {
+				ZSL_HQR(i, i - 3) = 0.0;
+			}
+		}
+
+		/* Chase the bulge down the active block with 3x3 reflectors. */
+		for (size_t k = m; k < nn; k++) {
+			if (k != m) {
+				p = ZSL_HQR(k, k - 1);
+				q = ZSL_HQR(k + 1, k - 1);
+				r = (k + 1 != nn) ? ZSL_HQR(k + 2, k - 1) : 0.0;
+				x = ZSL_ABS(p) + ZSL_ABS(q) + ZSL_ABS(r);
+				if (x == 0.0) {
+					continue;
+				}
+				p /= x;
+				q /= x;
+				r /= x;
+			}
+
+			s = ZSL_SQRT(p * p + q * q + r * r);
+			if (p < 0.0) {
+				s = -s;
+			}
+			if (s == 0.0) {
+				continue;
+			}
+
+			if (k == m) {
+				if (l != m) {
+					ZSL_HQR(k, k - 1) = -ZSL_HQR(k, k - 1);
+				}
+			} else {
+				ZSL_HQR(k, k - 1) = -s * x;
+			}
+
+			p += s;
+			x = p / s;
+			y = q / s;
+			z = r / s;
+			q /= p;
+			r /= p;
+
+			/* Row modification. */
+			for (size_t j = k; j <= nn; j++) {
+				p = ZSL_HQR(k, j) + q * ZSL_HQR(k + 1, j);
+				if (k + 1 != nn) {
+					p += r * ZSL_HQR(k + 2, j);
+					ZSL_HQR(k + 2, j) -= p * z;
+				}
+				ZSL_HQR(k + 1, j) -= p * y;
+				ZSL_HQR(k, j) -= p * x;
+			}
+
+			/* Column modification. */
+			for (size_t i = l; i <= (nn < k + 3 ? nn : k + 3); i++) {
+				p = x * ZSL_HQR(i, k) + y * ZSL_HQR(i, k + 1);
+				if (k + 1 != nn) {
+					p += z * ZSL_HQR(i, k + 2);
+					ZSL_HQR(i, k + 2) -= p * r;
+				}
+				ZSL_HQR(i, k + 1) -= p * q;
+				ZSL_HQR(i, k) -= p;
+			}
+		}
+	}
+
+	return 0;
+}
+
+#undef ZSL_HQR
+
+int
+zsl_mtx_eigenvalues_francis_ws(struct zsl_mtx *m, struct zsl_vec *re,
+			       struct zsl_vec *im, zsl_real_t tol,
+			       size_t max_iter, size_t *iter, struct zsl_ws *ws)
+{
+	int rc;
+	size_t n = m->sz_rows;
+	size_t used;
+	size_t mark = ws->used;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((m->sz_rows != m->sz_cols) || (re->sz < n) || (im->sz < n)) {
+		return -EINVAL;
+	}
+#endif
+
+	if ((ws->sz - ws->used) < zsl_mtx_ws_eigenvalues_francis_sz(n)) {
+		return -ENOMEM;
+	}
+
+	if (tol <= 0.0) {
+		tol = ZSL_EPSILON;
+	}
+
+	ZSL_WS_MATRIX_DEF(ws, h, n, n);
+	ZSL_WS_VECTOR_DEF(ws, tau, n);
+	ZSL_WS_VECTOR_DEF(ws, v, n);
+	ZSL_WS_VECTOR_DEF(ws, w, n);
+
+	/* Balance the matrix, and reduce it to Hessenberg form in place. The
+	 * reflectors stored below the subdiagonal aren't needed. */
+	zsl_mtx_balance(m, &h);
+	zsl_mtx_qrd_compact_v(&h, &tau, true, v.data, w.data);
+	for (size_t i = 2; i < n; i++) {
+		for (size_t j = 0; j < i - 1; j++) {
+			h.data[(i * n) + j] = 0.0;
+		}
+	}
+
+	rc = zsl_mtx_hqr(h.data, n, re->data, im->data, tol, max_iter,
+			 &used);
+	if (iter != NULL) {
+		*iter = used;
+	}
+
+	re->sz = n;
+	im->sz = n;
+	ws->used = mark;
+
+	return rc;
+}
+
+int
+zsl_mtx_eigenvalues_francis(struct zsl_mtx *m, struct zsl_vec *re,
+			    struct zsl_vec *im, zsl_real_t tol,
+			    size_t max_iter, size_t *iter)
+{
+	ZSL_WS_DEF(ws, zsl_mtx_ws_bytes(ZSL_MTX_WS_EIGENVALUES_FRANCIS,
+					m->sz_rows, m->sz_cols));
+
+	return zsl_mtx_eigenvalues_francis_ws(m, re, im, tol, max_iter, iter,
+					      &ws);
+}
+
+/* Element (i, j) of the n x n matrix 'a' in the symmetric solvers below. */
+#define ZSL_SYM(a, i, j) (a)[((i) * n) + (j)]
+
+/**
+ * @brief Rotates elements (i, j) and (k, l) of 'a' in a Jacobi step.
+ */
+static inline void
+zsl_mtx_sym_rot(zsl_real_t *a, size_t n, zsl_real_t s, zsl_real_t tau,
+		size_t i, size_t j, size_t k, size_t l)
+{
+	zsl_real_t g = ZSL_SYM(a, i, j);
+	zsl_real_t h = ZSL_SYM(a, k, l);
+
+	ZSL_SYM(a, i, j) = g - s * (h + g * tau);
+	ZSL_SYM(a, k, l) = h + s * (g - h * tau);
+}
+
+/**
+ * @brief Diagonalises the n x n symmetric matrix 'a' with cyclic Jacobi
+ *        rotations, reading and destroying its upper triangle. The
+ *        eigenvalues are written to 'd', and the eigenvectors to the columns
+ *        of 'z' if it isn't NULL. 'b' and 't' are scratch space for n values
+ *        each.
+ *
+ * @return 0 on success, or -ECONVERGE if 50 sweeps weren't enough.
+ */
+static int
+zsl_mtx_sym_jacobi(zsl_real_t *a, size_t n, zsl_real_t *d, zsl_real_t *z,
+		   zsl_real_t *b, zsl_real_t *t)
+{
+	zsl_real_t sm, thresh, g, h, theta, tn, c, s, tau;
+
+	for (size_t i = 0; i < n; i++) {
+		b[i] = d[i] = ZSL_SYM(a, i, i);
+		t[i] = 0.0;
+		if (z != NULL) {
+			for (size_t j = 0; j < n; j++) {
+				ZSL_SYM(z, i, j) = (i == j) ? 1.0 : 0.0;
+			}
+		}
+	}
+
+	for (size_t sweep = 1; sweep <= 50; sweep++) {
+		sm = 0.0;
+		for (size_t p = 0; p + 1 < n; p++) {
+			for (size_t q = p + 1; q < n; q++) {
+				sm += ZSL_ABS(ZSL_SYM(a, p, q));
+			}
+		}
+
+		/* Converged to machine precision. */
+		if (sm == 0.0) {
+			return 0;
+		}
+
+		/* Only rotate large elements in the first three sweeps. */
+		thresh = (sweep < 4) ? 0.2 * sm / (zsl_real_t)(n * n) : 0.0;
+
+		for (size_t p = 0; p + 1 < n; p++) {
+			for (size_t q = p + 1; q < n; q++) {
+				g = 100.0 * ZSL_ABS(ZSL_SYM(a, p, q));
+
+				/* Drop elements too small to change either
+				 * diagonal element. */
+				if ((sweep > 4) &&
+				    (ZSL_ABS(d[p]) + g == ZSL_ABS(d[p])) &&
+				    (ZSL_ABS(d[q]) + g == ZSL_ABS(d[q]))) {
+					ZSL_SYM(a, p, q) = 0.0;
+					continue;
+				}
+				if (ZSL_ABS(ZSL_SYM(a, p, q)) <= thresh) {
+					continue;
+				}
+
+				/* tn = tan(theta) of the rotation zeroing
+				 * a(p, q), taking the smaller root. */
+				h = d[q] - d[p];
+				if (ZSL_ABS(h) + g == ZSL_ABS(h)) {
+					tn = ZSL_SYM(a, p, q) / h;
+				} else {
+					theta = 0.5 * h / ZSL_SYM(a, p, q);
+					tn = 1.0 / (ZSL_ABS(theta) +
+						    ZSL_SQRT(1.0 + theta * theta));
+					if (theta < 0.0) {
+						tn = -tn;
+					}
+				}
+				c = 1.0 / ZSL_SQRT(1.0 + tn * tn);
+				s = tn * c;
+				tau = s / (1.0 + c);
+				h = tn * ZSL_SYM(a, p, q);
+				t[p] -= h;
+				t[q] += h;
+				d[p] -= h;
+				d[q] += h;
+				ZSL_SYM(a, p, q) = 0.0;
+
+				for (size_t j = 0; j < p; j++) {
+					zsl_mtx_sym_rot(a, n, s, tau, j, p, j, q);
+				}
+				for (size_t j = p + 1; j < q; j++) {
+					zsl_mtx_sym_rot(a, n, s, tau, p, j, j, q);
+				}
+				for (size_t j = q + 1; j < n; j++) {
+					zsl_mtx_sym_rot(a, n, s, tau, p, j, q, j);
+				}
+				if (z != NULL) {
+					for (size_t j = 0; j < n; j++) {
+						zsl_mtx_sym_rot(z, n, s, tau, j, p,
+								j, q);
+					}
+				}
+			}
+		}
+
+		/* Refresh 'd' from the accumulated updates, to limit
+		 * rounding errors. */
+		for (size_t i = 0; i < n; i++) {
+			b[i] += t[i];
+			d[i] = b[i];
+			t[i] = 0.0;
+		}
+	}
+
+	return -ECONVERGE;
+}
+
+/**
+ * @brief Reduces the n x n symmetric matrix 'z' to tridiagonal form with
+ *        Householder reflections, reading its lower triangle. The diagonal
+ *        is written to 'd' and the subdiagonal to e[1..n - 1]. If 'vec' is
+ *        true, 'z' is replaced by the orthogonal matrix of the reduction.
+ */
+static void
+zsl_mtx_sym_tridiag(zsl_real_t *z, size_t n, zsl_real_t *d, zsl_real_t *e,
+		    bool vec)
+{
+	zsl_real_t scale, h, hh, f, g;
+
+	if (n == 0) {
+		return;
+	}
+
+	for (size_t i = n - 1; i > 0; i--) {
+		size_t l = i - 1;
+
+		h = 0.0;
+		if (l > 0) {
+			scale = 0.0;
+			for (size_t k = 0; k < i; k++) {
+				scale += ZSL_ABS(ZSL_SYM(z, i, k));
+			}
+
+			if (scale == 0.0) {
+				/* Row 'i' is already reduced. */
+				e[i] = ZSL_SYM(z, i, l);
+			} else {
+				for (size_t k = 0; k < i; k++) {
+					ZSL_SYM(z, i, k) /= scale;
+					h += ZSL_SYM(z, i, k) *
+					     ZSL_SYM(z, i, k);
+				}
+				f = ZSL_SYM(z, i, l);
+				g = (f >= 0.0) ? -ZSL_SQRT(h) : ZSL_SQRT(h);
+				e[i] = scale * g;
+				h -= f * g;
+				ZSL_SYM(z, i, l) = f - g;
+
+				/* p = A * u / h, stored in e[0..i - 1]. */
+				f = 0.0;
+				for (size_t j = 0; j < i; j++) {
+					if (vec) {
+						ZSL_SYM(z, j, i) =
+							ZSL_SYM(z, i, j) / h;
+					}
+					g = 0.0;
+					for (size_t k = 0; k <= j; k++) {
+						g += ZSL_SYM(z, j, k) *
+						     ZSL_SYM(z, i, k);
+					}
+					for (size_t k = j + 1; k < i; k++) {
+						g += ZSL_SYM(z, k, j) *
+						     ZSL_SYM(z, i, k);
+					}
+					e[j] = g / h;
+					f += e[j] * ZSL_SYM(z, i, j);
+				}
+
+				/* A = A - u * q^T - q * u^T, with
+				 * q = p - (u^T * p / 2h) * u. */
+				hh = f / (h + h);
+				for (size_t j = 0; j < i; j++) {
+					f = ZSL_SYM(z, i, j);
+					e[j] = g = e[j] - hh * f;
+					for (size_t k = 0; k <= j; k++) {
+						ZSL_SYM(z, j, k) -=
+							(f * e[k] +
+							 g * ZSL_SYM(z, i, k));
+					}
+				}
+			}
+		} else {
+			e[i] = ZSL_SYM(z, i, l);
+		}
+		d[i] = h;
+	}
+
+	d[0] = 0.0;
+	e[0] = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		if (vec) {
+			/* Accumulate the transformations, using the vectors
+			 * stored in the rows and columns of 'z' above. */
+			if (d[i] != 0.0) {
+				for (size_t j = 0; j < i; j++) {
+					g = 0.0;
+					for (size_t k = 0; k < i; k++) {
+						g += ZSL_SYM(z, i, k) *
+						     ZSL_SYM(z, k, j);
+					}
+					for (size_t k = 0; k < i; k++) {
+						ZSL_SYM(z, k, j) -=
+							g * ZSL_SYM(z, k, i);
+					}
+				}
+			}
+			d[i] = ZSL_SYM(z, i, i);
+			ZSL_SYM(z, i, i) = 1.0;
+			for (size_t j = 0; j < i; j++) {
+				ZSL_SYM(z, j, i) = 0.0;
+				ZSL_SYM(z, i, j) = 0.0;
+			}
+		} else {
+			d[i] = ZSL_SYM(z, i, i);
+		}
+	}
+}
+
+/**
+ * @brief Computes the eigenvalues of the n x n symmetric tridiagonal matrix
+ *        with diagonal 'd' and subdiagonal e[1..n - 1] with the implicit QL
+ *        algorithm, overwriting 'd' with them. If 'z' isn't NULL, its
+ *        columns are rotated along, turning the output of
+ *        zsl_mtx_sym_tridiag into the eigenvectors.
+ *
+ * @return 0 on success, or -ECONVERGE if an eigenvalue needed more than 30
+ *         iterations.
+ */
+static int
+zsl_mtx_sym_ql(zsl_real_t *d, zsl_real_t *e, size_t n, zsl_real_t *z)
+{
+	size_t m, iter;
+	zsl_real_t dd, g, r, s, c, p, f, b;
+	bool split;
+
+	for (size_t i = 1; i < n; i++) {
+		e[i - 1] = e[i];
+	}
+	if (n > 0) {
+		e[n - 1] = 0.0;
+	}
+
+	for (size_t l = 0; l < n; l++) {
+		iter = 0;
+		do {
+			/* Look for a negligible subdiagonal element, which
+			 * splits off the block [l, m]. */
+			for (m = l; m + 1 < n; m++) {
+				dd = ZSL_ABS(d[m]) + ZSL_ABS(d[m + 1]);
+				if (ZSL_ABS(e[m]) <= ZSL_EPSILON * dd) {
+					break;
+				}
+			}
+			if (m == l) {
+				break;
+			}
 
-	/* Calculate the upper triangular matrix by using the recursive QR
-	 * decomposition method. */
-	zsl_mtx_qrd_iter(&mtemp2, &mout, iter);
+			if (iter++ == 30) {
+				return -ECONVERGE;
+			}
 
-	zsl_vec_init(v);
+			/* Wilkinson shift from the leading 2x2 block. */
+			g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+			r = ZSL_SQRT(g * g + 1.0);
+			g = d[m] - d[l] + e[l] / (g + (g < 0.0 ? -r : r));
+			s = c = 1.0;
+			p = 0.0;
+			split = false;
+
+			/* Chase the bulge up with plane rotations. */
+			for (size_t i = m; i-- > l;) {
+				f = s * e[i];
+				b = c * e[i];
+				r = ZSL_SQRT(f * f + g * g);
+				e[i + 1] = r;
+				if (r == 0.0) {
+					/* Recover from underflow. */
+					d[i + 1] -= p;
+					e[m] = 0.0;
+					split = true;
+					break;
+				}
+				s = f / r;
+				c = g / r;
+				g = d[i + 1] - p;
+				r = (d[i] - g) * s + 2.0 * c * b;
+				p = s * r;
+				d[i + 1] = g + p;
+				g = c * r - b;
+
+				if (z != NULL) {
+					for (size_t k = 0; k < n; k++) {
+						f = ZSL_SYM(z, k, i + 1);
+						ZSL_SYM(z, k, i + 1) =
+							s * ZSL_SYM(z, k, i) +
+							c * f;
+						ZSL_SYM(z, k, i) =
+							c * ZSL_SYM(z, k, i) -
+							s * f;
+					}
+				}
+			}
+			if (split) {
+				continue;
+			}
+			d[l] -= p;
+			e[l] = g;
+			e[m] = 0.0;
+		} while (true);
+	}
 
-	/* If the matrix is symmetric, then it will always have real
-	 * eigenvalues, so treat this case appart. */
-	if (zsl_mtx_is_sym(m) == true) {
-		for (size_t g = 0; g < m->sz_rows; g++) {
-			zsl_mtx_get(&mout, g, g, &diag);
-			v->data[g] = diag;
-		}
+	return 0;
+}
 
-		return 0;
-	}
+#undef ZSL_SYM
 
-	/*
-	 * If any value just below the diagonal is non-zero, it means that the
-	 * numbers above and to the right of the non-zero value are a pair of
-	 * complex values, a complex number and its conjugate.
-	 *
-	 * SVD will always return real numbers so this can be ignored, but if
-	 * you are calculating eigenvalues outside the SVD method, you may
-	 * get complex numbers, which will be indicated with the return error
-	 * code '-ECOMPLEXVAL'.
-	 *
-	 * If the imput matrix has complex eigenvalues, then these will be
-	 * ignored and the output vector will not include them.
-	 *
-	 * NOTE: The real and imaginary parts of the complex numbers are not
-	 * available. This only checks if there are any complex eigenvalues and
-	 * returns an appropriate error code to alert the user that there are
-	 * non-real eigenvalues present.
-	 */
+int
+zsl_mtx_eigen_sym_ws(struct zsl_mtx *m, struct zsl_vec *v, struct zsl_mtx *mev,
+		     struct zsl_ws *ws)
+{
+	int rc;
+	size_t n = m->sz_rows;
+	size_t mark = ws->used;
+	size_t k;
+	zsl_real_t x;
+	zsl_real_t *z;
 
-	for (size_t g = 0; g < (m->sz_rows - 1); g++) {
-		/* Check if any element just below the diagonal isn't zero. */
-		zsl_mtx_get(&mout, g + 1, g, &sdiag);
-		if ((sdiag >= epsilon) || (sdiag <= -epsilon)) {
-			/* Skip two elements if the element below
-			 * is not zero. */
-			g++;
-		} else {
-			/* Get the diagonal element if the element below
-			 * is zero. */
-			zsl_mtx_get(&mout, g, g, &diag);
-			v->data[real] = diag;
-			real++;
-		}
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((m->sz_rows != m->sz_cols) || (v->sz < n)) {
+		return -EINVAL;
+	}
+	if ((mev != NULL) && ((mev->sz_rows != n) || (mev->sz_cols != n))) {
+		return -EINVAL;
 	}
+#endif
 
+	if ((ws->sz - ws->used) < zsl_mtx_ws_eigen_sym_sz(n)) {
+		return -ENOMEM;
+	}
 
-	/* Since it's not possible to check the coefficient below the last
-	 * diagonal element, then check the element to its left. */
-	zsl_mtx_get(&mout, (m->sz_rows - 1), (m->sz_rows - 2), &sdiag);
-	if ((sdiag >= epsilon) || (sdiag <= -epsilon)) {
-		/* Do nothing if the element to its left is not zero. */
+	ZSL_WS_MATRIX_DEF(ws, a, n, n);
+	ZSL_WS_VECTOR_DEF(ws, b, n);
+	ZSL_WS_VECTOR_DEF(ws, t, n);
+
+	z = (mev != NULL) ? mev->data : NULL;
+
+	if (n <= ZSL_MTX_SYM_JACOBI_MAX_SZ) {
+		zsl_mtx_copy(&a, m);
+		rc = zsl_mtx_sym_jacobi(a.data, n, v->data, z, b.data, t.data);
 	} else {
-		/* Get the last diagonal element if the element to its left
-		 * is zero. */
-		zsl_mtx_get(&mout, (m->sz_rows - 1), (m->sz_rows - 1), &diag);
-		v->data[real] = diag;
-		real++;
+		/* Reduce in 'mev' if the vectors are wanted, so that the
+		 * reduction's transformations end up there. */
+		if (z == NULL) {
+			zsl_mtx_copy(&a, m);
+			z = a.data;
+		} else if (mev->data != m->data) {
+			zsl_mtx_copy(mev, m);
+		}
+		zsl_mtx_sym_tridiag(z, n, v->data, b.data, mev != NULL);
+		rc = zsl_mtx_sym_ql(v->data, b.data, n,
+				    (mev != NULL) ? z : NULL);
 	}
 
-	/* If the number of real eigenvalues ('real' coefficient) is less than
-	 * the matrix dimensions, then there must be complex eigenvalues. */
-	v->sz = real;
-	if (real != m->sz_rows) {
-		return -ECOMPLEXVAL;
+	ws->used = mark;
+	v->sz = n;
+	if (rc) {
+		return rc;
 	}
 
-	/* Put the zeros to the end. */
-	zsl_vec_zte(v);
+	/* Sort by decreasing eigenvalue, moving the vectors along. */
+	for (size_t i = 0; i + 1 < n; i++) {
+		k = i;
+		for (size_t j = i + 1; j < n; j++) {
+			if (v->data[j] > v->data[k]) {
+				k = j;
+			}
+		}
+		if (k == i) {
+			continue;
+		}
+		x = v->data[i];
+		v->data[i] = v->data[k];
+		v->data[k] = x;
+		if (mev != NULL) {
+			for (size_t r = 0; r < n; r++) {
+				x = mev->data[(r * n) + i];
+				mev->data[(r * n) + i] = mev->data[(r * n) + k];
+				mev->data[(r * n) + k] = x;
+			}
+		}
+	}
+
+	/* Give each eigenvector a positive largest element, so that the
+	 * output doesn't flip sign between calls with similar inputs. */
+	if (mev != NULL) {
+		for (size_t j = 0; j < n; j++) {
+			k = 0;
+			for (size_t r = 1; r < n; r++) {
+				if (ZSL_ABS(mev->data[(r * n) + j]) >
+				    ZSL_ABS(mev->data[(k * n) + j])) {
+					k = r;
+				}
+			}
+			if (mev->data[(k * n) + j] < 0.0) {
+				for (size_t r = 0; r < n; r++) {
+					mev->data[(r * n) + j] =
+						-mev->data[(r * n) + j];
+				}
+			}
+		}
+	}
 
 	return 0;
 }
-#endif
+
+int
+zsl_mtx_eigen_sym(struct zsl_mtx *m, struct zsl_vec *v, struct zsl_mtx *mev)
+{
+	ZSL_WS_DEF(ws, zsl_mtx_ws_bytes(ZSL_MTX_WS_EIGEN_SYM, m->sz_rows,
+					m->sz_cols));
+
+	return zsl_mtx_eigen_sym_ws(m, v, mev, &ws);
+}
 
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
 int
-zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
-		     bool orthonormal)
+zsl_mtx_eigenvectors_ws(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
+			bool orthonormal, struct zsl_ws *ws)
 {
 	size_t b = 0;           /* Total number of eigenvectors. */
 	size_t e_vals = 0;      /* Number of unique eigenvalues. */
 	size_t count = 0;       /* Number of eigenvectors for an eigenvalue. */
 	size_t ga = 0;
+	size_t mark = ws->used;
 
 	zsl_real_t epsilon = 1E-6;
 	zsl_real_t x;
 
+	if ((ws->sz - ws->used) < zsl_mtx_ws_eigenvectors_sz(m->sz_rows)) {
+		return -ENOMEM;
+	}
+
 	/* The vector where all eigenvalues will be stored. */
-	ZSL_VECTOR_DEF(k, m->sz_rows);
+	ZSL_WS_VECTOR_DEF(ws, k, m->sz_rows);
 	/* Temp vector to store column data. */
-	ZSL_VECTOR_DEF(f, m->sz_rows);
+	ZSL_WS_VECTOR_DEF(ws, f, m->sz_rows);
 	/* The vector where all UNIQUE eigenvalues will be stored. */
-	ZSL_VECTOR_DEF(o, m->sz_rows);
+	ZSL_WS_VECTOR_DEF(ws, o, m->sz_rows);
 	/* Temporary mxm identity matrix placeholder. */
-	ZSL_MATRIX_DEF(id, m->sz_rows, m->sz_rows);
+	ZSL_WS_MATRIX_DEF(ws, id, m->sz_rows, m->sz_rows);
 	/* 'm' minus the eigenvalues * the identity matrix (id). */
-	ZSL_MATRIX_DEF(mi, m->sz_rows, m->sz_rows);
+	ZSL_WS_MATRIX_DEF(ws, mi, m->sz_rows, m->sz_rows);
 	/* Placeholder for zsl_mtx_gauss_reduc calls (required param). */
-	ZSL_MATRIX_DEF(mid, m->sz_rows, m->sz_rows);
+	ZSL_WS_MATRIX_DEF(ws, mid, m->sz_rows, m->sz_rows);
 	/* Matrix containing all column eigenvectors for an eigenvalue. */
-	ZSL_MATRIX_DEF(evec, m->sz_rows, m->sz_rows);
+	ZSL_WS_MATRIX_DEF(ws, evec, m->sz_rows, m->sz_rows);
 	/* Matrix containing all column eigenvectors for an eigenvalue.
 	* Two matrices are required for the Gramm-Schmidt operation. */
-	ZSL_MATRIX_DEF(evec2, m->sz_rows, m->sz_rows);
+	ZSL_WS_MATRIX_DEF(ws, evec2, m->sz_rows, m->sz_rows);
 	/* Matrix containing all column eigenvectors. */
-	ZSL_MATRIX_DEF(mev2, m->sz_rows, m->sz_rows);
+	ZSL_WS_MATRIX_DEF(ws, mev2, m->sz_rows, m->sz_rows);
 
 	/* TODO: Check that we have a SQUARE matrix, etc. */
 	zsl_mtx_init(&mev2, NULL);
 	zsl_vec_init(&o);
-	zsl_mtx_eigenvalues(m, &k, iter);
+	zsl_mtx_eigenvalues_ws(m, &k, iter, ws);
 
 	/* Copy every non-zero eigenvalue ONCE in the 'o' vector to get rid of
 	 * repeated values. */
@@ -1659,6 +3295,8 @@ zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
 		zsl_mtx_set_col(mev, s, f.data);
 	}
 
+	ws->used = mark;
+
 	/* Checks if the number of eigenvectors is the same as the shape of
 	 * the input matrix. If the number of eigenvectors is less than
 	 * the number of columns in the input matrix 'm', this will be
@@ -1669,26 +3307,40 @@ zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
 
 	return 0;
 }
+
+int
+zsl_mtx_eigenvectors(struct zsl_mtx *m, struct zsl_mtx *mev, size_t iter,
+		     bool orthonormal)
+{
+	ZSL_WS_DEF(ws, zsl_mtx_ws_bytes(ZSL_MTX_WS_EIGENVECTORS, m->sz_rows,
+					m->sz_cols));
+
+	return zsl_mtx_eigenvectors_ws(m, mev, iter, orthonormal, &ws);
+}
 #endif
 
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
 int
-zsl_mtx_svd(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
-	    struct zsl_mtx *v, size_t iter)
+zsl_mtx_svd_ws(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
+	       struct zsl_mtx *v, size_t iter, struct zsl_ws *ws)
 {
-	ZSL_MATRIX_DEF(aat, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(upri, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(ata, m->sz_cols, m->sz_cols);
-	ZSL_MATRIX_DEF(at, m->sz_cols, m->sz_rows);
-	ZSL_VECTOR_DEF(ui, m->sz_rows);
-	ZSL_MATRIX_DEF(ui2, m->sz_cols, 1);
-	ZSL_MATRIX_DEF(ui3, m->sz_rows, 1);
-	ZSL_VECTOR_DEF(hu, m->sz_rows);
-
 	zsl_real_t d;
 	size_t pu = 0;
 	size_t min = m->sz_cols;
 	zsl_real_t epsilon = 1E-6;
+	size_t mark = ws->used;
+
+	if ((ws->sz - ws->used) < zsl_mtx_ws_svd_sz(m->sz_rows, m->sz_cols)) {
+		return -ENOMEM;
+	}
+
+	ZSL_WS_MATRIX_DEF(ws, aat, m->sz_rows, m->sz_rows);
+	ZSL_WS_MATRIX_DEF(ws, upri, m->sz_rows, m->sz_rows);
+	ZSL_WS_MATRIX_DEF(ws, ata, m->sz_cols, m->sz_cols);
+	ZSL_WS_MATRIX_DEF(ws, at, m->sz_cols, m->sz_rows);
+	ZSL_WS_MATRIX_DEF(ws, ui2, m->sz_cols, 1);
+	ZSL_WS_MATRIX_DEF(ws, ui3, m->sz_rows, 1);
+	ZSL_WS_VECTOR_DEF(ws, hu, m->sz_rows);
 
 	zsl_mtx_trans(m, &at);
 
@@ -1705,11 +3357,11 @@ zsl_mtx_svd(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
 	/* Calculate the eigenvalues of the square matrix 'm' times 'm'
 	 * transposed or the square matrix 'm' transposed times 'm', whichever
 	 * is smaller in dimensions. */
-	ZSL_VECTOR_DEF(ev, min);
+	ZSL_WS_VECTOR_DEF(ws, ev, min);
 	if (min < m->sz_cols) {
-		zsl_mtx_eigenvalues(&aat, &ev, iter);
+		zsl_mtx_eigenvalues_ws(&aat, &ev, iter, ws);
 	} else {
-		zsl_mtx_eigenvalues(&ata, &ev, iter);
+		zsl_mtx_eigenvalues_ws(&ata, &ev, iter, ws);
 	}
 
 	/* Place the square root of these eigenvalues in the diagonal entries
@@ -1721,10 +3373,9 @@ zsl_mtx_svd(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
 
 	/* Calculate the eigenvectors of 'm' times 'm' transposed and set them
 	 * as the columns of the 'v' matrix. */
-	zsl_mtx_eigenvectors(&ata, v, iter, true);
+	zsl_mtx_eigenvectors_ws(&ata, v, iter, true, ws);
 	for (size_t i = 0; i < min; i++) {
-		zsl_mtx_get_col(v, i, ui.data);
-		zsl_mtx_from_arr(&ui2, ui.data);
+		zsl_mtx_get_col(v, i, ui2.data);
 		zsl_mtx_get(e, i, i, &d);
 
 		/* Calculate the column vectors of 'u' by dividing these
@@ -1735,73 +3386,373 @@ zsl_mtx_svd(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
 			pu++;
 		} else {
 			zsl_mtx_scalar_mult_d(&ui3, (1 / d));
-			zsl_vec_from_arr(&ui, ui3.data);
-			zsl_mtx_set_col(u, i, ui.data);
+			zsl_mtx_set_col(u, i, ui3.data);
 		}
 	}
 
 	/* Expand the columns of 'u' into an orthonormal basis if there are
 	 * zero eigenvalues or if the number of columns in 'm' is less than the
 	 * number of rows. */
-	zsl_mtx_eigenvectors(&aat, &upri, iter, true);
+	zsl_mtx_eigenvectors_ws(&aat, &upri, iter, true, ws);
 	for (size_t f = min - pu; f < m->sz_rows; f++) {
 		zsl_mtx_get_col(&upri, f, hu.data);
 		zsl_mtx_set_col(u, f, hu.data);
 	}
 
+	ws->used = mark;
+
 	return 0;
 }
+
+int
+zsl_mtx_svd(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_mtx *e,
+	    struct zsl_mtx *v, size_t iter)
+{
+	ZSL_WS_DEF(ws, zsl_mtx_ws_bytes(ZSL_MTX_WS_SVD, m->sz_rows,
+					m->sz_cols));
+
+	return zsl_mtx_svd_ws(m, u, e, v, iter, &ws);
+}
 #endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * @brief Orthogonalises the columns of the k x k matrix 'g' with one-sided
+ *        Jacobi rotations, applying the same rotations to the k x k matrix
+ *        'v', which must start as the identity.
+ *
+ * @return 0 on success, or -ECONVERGE if 30 sweeps weren't enough.
+ */
+static int
+zsl_mtx_svd_jacobi(zsl_real_t *g, zsl_real_t *v, size_t k)
+{
+	zsl_real_t tol = ZSL_EPSILON * (zsl_real_t)k;
+	zsl_real_t alpha, beta, gamma, zeta, t, c, s, x, y;
+	bool rotated;
+
+	for (size_t sweep = 0; sweep < 30; sweep++) {
+		rotated = false;
+
+		for (size_t p = 0; p + 1 < k; p++) {
+			for (size_t q = p + 1; q < k; q++) {
+				alpha = 0.0;
+				beta = 0.0;
+				gamma = 0.0;
+				for (size_t i = 0; i < k; i++) {
+					x = g[(i * k) + p];
+					y = g[(i * k) + q];
+					alpha += x * x;
+					beta += y * y;
+					gamma += x * y;
+				}
+
+				/* Skip pairs that are already orthogonal to
+				 * working precision. */
+				if (ZSL_ABS(gamma) <=
+				    tol * ZSL_SQRT(alpha * beta)) {
+					continue;
+				}
+				rotated = true;
+
+				/* The rotation that zeroes the off-diagonal
+				 * element of the pair's 2x2 Gram matrix. */
+				zeta = (beta - alpha) / (2.0 * gamma);
+				t = 1.0 / (ZSL_ABS(zeta) +
+					   ZSL_SQRT(1.0 + zeta * zeta));
+				if (zeta < 0.0) {
+					t = -t;
+				}
+				c = 1.0 / ZSL_SQRT(1.0 + t * t);
+				s = c * t;
+
+				for (size_t i = 0; i < k; i++) {
+					x = g[(i * k) + p];
+					y = g[(i * k) + q];
+					g[(i * k) + p] = c * x - s * y;
+					g[(i * k) + q] = s * x + c * y;
+
+					x = v[(i * k) + p];
+					y = v[(i * k) + q];
+					v[(i * k) + p] = c * x - s * y;
+					v[(i * k) + q] = s * x + c * y;
+				}
+			}
+		}
+
+		if (!rotated) {
+			return 0;
+		}
+	}
+
+	return -ECONVERGE;
+}
+
+/**
+ * @brief Turns the columns of the k x k matrix 'g', orthogonalised by
+ *        zsl_mtx_svd_jacobi, into singular values 's' and unit left singular
+ *        vectors, sorted by decreasing singular value along with the columns
+ *        of 'v'. Columns with a zero singular value are replaced by unit
+ *        vectors orthogonal to the others.
+ */
+static void
+zsl_mtx_svd_finish(zsl_real_t *g, zsl_real_t *v, zsl_real_t *s, size_t k)
+{
+	size_t b;
+	zsl_real_t x, d;
+
+	for (size_t j = 0; j < k; j++) {
+		x = 0.0;
+		for (size_t i = 0; i < k; i++) {
+			x += g[(i * k) + j] * g[(i * k) + j];
+		}
+		s[j] = ZSL_SQRT(x);
+	}
+
+	/* Sort by decreasing singular value. */
+	for (size_t j = 0; j + 1 < k; j++) {
+		b = j;
+		for (size_t i = j + 1; i < k; i++) {
+			if (s[i] > s[b]) {
+				b = i;
+			}
+		}
+		if (b == j) {
+			continue;
+		}
+		x = s[j];
+		s[j] = s[b];
+		s[b] = x;
+		for (size_t i = 0; i < k; i++) {
+			x = g[(i * k) + j];
+			g[(i * k) + j] = g[(i * k) + b];
+			g[(i * k) + b] = x;
+			x = v[(i * k) + j];
+			v[(i * k) + j] = v[(i * k) + b];
+			v[(i * k) + b] = x;
+		}
+	}
+
+	for (size_t j = 0; j < k; j++) {
+		if (s[j] > 0.0) {
+			for (size_t i = 0; i < k; i++) {
+				g[(i * k) + j] /= s[j];
+			}
+			continue;
+		}
+
+		/* Complete the basis: take the first unit vector e_b that
+		 * keeps a reasonable part of its length after being made
+		 * orthogonal (twice, for accuracy) to columns 0..j - 1. */
+		for (b = 0; b < k; b++) {
+			for (size_t i = 0; i < k; i++) {
+				g[(i * k) + j] = (i == b) ? 1.0 : 0.0;
+			}
+			for (size_t pass = 0; pass < 2; pass++) {
+				for (size_t l = 0; l < j; l++) {
+					d = 0.0;
+					for (size_t i = 0; i < k; i++) {
+						d += g[(i * k) + l] *
+						     g[(i * k) + j];
+					}
+					for (size_t i = 0; i < k; i++) {
+						g[(i * k) + j] -=
+							d * g[(i * k) + l];
+					}
+				}
+			}
+			x = 0.0;
+			for (size_t i = 0; i < k; i++) {
+				x += g[(i * k) + j] * g[(i * k) + j];
+			}
+			if (x > 0.25) {
+				break;
+			}
+		}
+		x = ZSL_SQRT(x);
+		for (size_t i = 0; i < k; i++) {
+			g[(i * k) + j] /= x;
+		}
+	}
+}
+
 int
-zsl_mtx_pinv(struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter)
+zsl_mtx_svd_thin_ws(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_vec *s,
+		    struct zsl_mtx *v, struct zsl_ws *ws)
+{
+	int rc;
+	bool tall = (m->sz_rows >= m->sz_cols);
+	size_t r = tall ? m->sz_rows : m->sz_cols;
+	size_t k = tall ? m->sz_cols : m->sz_rows;
+	size_t nrefl = zsl_mtx_qrd_refl(r, k, false);
+	size_t mark = ws->used;
+	size_t n;
+	struct zsl_mtx *l;
+	struct zsl_mtx *rt;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((u->sz_rows != m->sz_rows) || (u->sz_cols != k) ||
+	    (v->sz_rows != m->sz_cols) || (v->sz_cols != k) || (s->sz < k)) {
+		return -EINVAL;
+	}
+#endif
+
+	if ((ws->sz - ws->used) < zsl_mtx_ws_svd_thin_sz(m->sz_rows,
+							 m->sz_cols)) {
+		return -ENOMEM;
+	}
+
+	/* Work on A, or on A^T if it is wide, so that the working matrix 'a'
+	 * is r x k with r >= k. The SVD of A^T is V * S * U^T, so the roles of
+	 * 'u' and 'v' are swapped in that case: 'l' gets the r x k left
+	 * singular vectors of 'a', and 'rt' the k x k right ones. */
+	ZSL_WS_MATRIX_DEF(ws, a, r, k);
+	ZSL_WS_VECTOR_DEF(ws, tau, k);
+	ZSL_WS_VECTOR_DEF(ws, hv, r);
+	ZSL_WS_VECTOR_DEF(ws, hw, r);
+
+	if (tall) {
+		zsl_mtx_copy(&a, m);
+		l = u;
+		rt = v;
+	} else {
+		zsl_mtx_trans(m, &a);
+		l = v;
+		rt = u;
+	}
+
+	/* a = Q * R. Only the k x k factor R goes through the Jacobi sweeps,
+	 * which makes them independent of the number of rows, and starting
+	 * from a triangular matrix speeds up their convergence. */
+	zsl_mtx_qrd_compact_v(&a, &tau, false, hv.data, hw.data);
+
+	/* The top k rows of 'l' hold R, and its remaining rows are zero. */
+	for (size_t i = 0; i < r; i++) {
+		for (size_t j = 0; j < k; j++) {
+			l->data[(i * k) + j] = (i < k && j >= i) ?
+					       a.data[(i * k) + j] : 0.0;
+		}
+	}
+	zsl_mtx_init(rt, zsl_mtx_entry_fn_identity);
+
+	rc = zsl_mtx_svd_jacobi(l->data, rt->data, k);
+	if (rc == 0) {
+		zsl_mtx_svd_finish(l->data, rt->data, s->data, k);
+		s->sz = k;
+
+		/* The left singular vectors of 'a' are Q times those of R. */
+		for (size_t j = nrefl; j-- > 0;) {
+			n = zsl_mtx_qrd_refl_v(&a, j, 0, hv.data);
+			zsl_mtx_house_left(l, j, 0, n, k, hv.data, tau.data[j],
+					   hw.data);
+		}
+	}
+
+	ws->used = mark;
+
+	return rc;
+}
+
+int
+zsl_mtx_svd_thin(struct zsl_mtx *m, struct zsl_mtx *u, struct zsl_vec *s,
+		 struct zsl_mtx *v)
+{
+	ZSL_WS_DEF(ws, zsl_mtx_ws_bytes(ZSL_MTX_WS_SVD_THIN, m->sz_rows,
+					m->sz_cols));
+
+	return zsl_mtx_svd_thin_ws(m, u, s, v, &ws);
+}
+
+int
+zsl_mtx_pinv_tol_ws(struct zsl_mtx *m, struct zsl_mtx *pinv, zsl_real_t tol,
+		    size_t *rank, struct zsl_ws *ws)
 {
+	int rc;
+	size_t r = m->sz_rows;
+	size_t c = m->sz_cols;
+	size_t k = r < c ? r : c;
+	size_t nz = 0;
+	size_t mark = ws->used;
 	zsl_real_t x;
-	size_t min = m->sz_cols;
-	zsl_real_t epsilon = 1E-6;
 
-	ZSL_MATRIX_DEF(u, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(e, m->sz_rows, m->sz_cols);
-	ZSL_MATRIX_DEF(v, m->sz_cols, m->sz_cols);
-	ZSL_MATRIX_DEF(et, m->sz_cols, m->sz_rows);
-	ZSL_MATRIX_DEF(ut, m->sz_rows, m->sz_rows);
-	ZSL_MATRIX_DEF(pas, m->sz_cols, m->sz_rows);
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if ((pinv->sz_rows != c) || (pinv->sz_cols != r)) {
+		return -EINVAL;
+	}
+#endif
+
+	if ((ws->sz - ws->used) < zsl_mtx_ws_pinv_sz(r, c)) {
+		return -ENOMEM;
+	}
 
-	/* Determine the SVD decomposition of 'm'. */
-	zsl_mtx_svd(m, &u, &e, &v, iter);
+	ZSL_WS_MATRIX_DEF(ws, u, r, k);
+	ZSL_WS_VECTOR_DEF(ws, s, k);
+	ZSL_WS_MATRIX_DEF(ws, v, c, k);
 
-	/* Transpose the 'u' matrix. */
-	zsl_mtx_trans(&u, &ut);
+	rc = zsl_mtx_svd_thin_ws(m, &u, &s, &v, ws);
+	if (rc) {
+		ws->used = mark;
+		return rc;
+	}
 
-	/* Set the value 'min' as the minimum of number of columns and number
-	 * of rows. */
-	if (m->sz_rows <= m->sz_cols) {
-		min = m->sz_rows;
+	/* Singular values below the tolerance are treated as zero. The
+	 * default follows the usual max(r, c) * eps * s_max rule. */
+	if (tol <= 0.0) {
+		tol = (zsl_real_t)(r > c ? r : c) * ZSL_EPSILON;
 	}
+	tol *= (k > 0) ? s.data[0] : 0.0;
 
-	for (size_t g = 0; g < min; g++) {
+	/* Scale the kept columns of 'v' by 1 / s, since pinv is
+	 * V * S^-1 * U^T. */
+	for (size_t j = 0; j < k; j++) {
+		if (s.data[j] <= tol) {
+			break;
+		}
+		for (size_t i = 0; i < c; i++) {
+			v.data[(i * k) + j] /= s.data[j];
+		}
+		nz++;
+	}
 
-		/* Invert the diagonal values in 'e'. If a value is zero, do
-		 * nothing to it. */
-		zsl_mtx_get(&e, g, g, &x);
-		if (((x < epsilon) || (x > -epsilon)) && x != 0.0) {
-			x = 1 / x;
-			zsl_mtx_set(&e, g, g, x);
+	for (size_t i = 0; i < c; i++) {
+		for (size_t j = 0; j < r; j++) {
+			x = 0.0;
+			for (size_t l = 0; l < nz; l++) {
+				x += v.data[(i * k) + l] * u.data[(j * k) + l];
+			}
+			pinv->data[(i * r) + j] = x;
 		}
 	}
 
-	/* Transpose the sigma matrix. */
-	zsl_mtx_trans(&e, &et);
+	if (rank != NULL) {
+		*rank = nz;
+	}
 
-	/* Multiply 'u' (transposed) times sigma (transposed and with inverted
-	 * eigenvalues) times 'v'. */
-	zsl_mtx_mult(&v, &et, &pas);
-	zsl_mtx_mult(&pas, &ut, pinv);
+	ws->used = mark;
 
 	return 0;
 }
-#endif
+
+int
+zsl_mtx_pinv_tol(struct zsl_mtx *m, struct zsl_mtx *pinv, zsl_real_t tol,
+		 size_t *rank)
+{
+	ZSL_WS_DEF(ws, zsl_mtx_ws_bytes(ZSL_MTX_WS_PINV, m->sz_rows,
+					m->sz_cols));
+
+	return zsl_mtx_pinv_tol_ws(m, pinv, tol, rank, &ws);
+}
+
+int
+zsl_mtx_pinv_ws(struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter,
+		struct zsl_ws *ws)
+{
+	return zsl_mtx_pinv_tol_ws(m, pinv, 0.0, NULL, ws);
+}
+
+int
+zsl_mtx_pinv(struct zsl_mtx *m, struct zsl_mtx *pinv, size_t iter)
+{
+	return zsl_mtx_pinv_tol(m, pinv, 0.0, NULL);
+}
 
 int
 zsl_mtx_min(struct zsl_mtx *m, zsl_real_t *x)
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/orientation/fixed.h>
+
+int zsl_quat_q31_from_quat(struct zsl_quat *q, struct zsl_quat_q31 *qq)
+{
+	qq->r = zsl_q31_from_real(q->r);
+	qq->i = zsl_q31_from_real(q->i);
+	qq->j = zsl_q31_from_real(q->j);
+	qq->k = zsl_q31_from_real(q->k);
+
+	return 0;
+}
+
+int zsl_quat_q31_to_quat(struct zsl_quat_q31 *qq, struct zsl_quat *q)
+{
+	q->r = zsl_q31_to_real(qq->r);
+	q->i = zsl_q31_to_real(qq->i);
+	q->j = zsl_q31_to_real(qq->j);
+	q->k = zsl_q31_to_real(qq->k);
+
+	return 0;
+}
+
+zsl_q31_t zsl_quat_q31_magn(struct zsl_quat_q31 *q)
+{
+	zsl_q31_t d[4] = { q->r, q->i, q->j, q->k };
+	struct zsl_vec_q31 v = { .sz = 4, .data = d };
+
+	return zsl_vec_q31_norm(&v);
+}
+
+/**
+ * Normalises the quaternion (x[0], x[1], x[2], x[3]), in any common
+ * fixed-point format, into 'q'.
+ */
+static void zsl_quat_q31_unit_from_i64(const int64_t *x, struct zsl_quat_q31 *q)
+{
+	zsl_q31_t d[4];
+	struct zsl_vec_q31 v = { .sz = 4, .data = d };
+
+	zsl_vec_q31_unit_from_i64(&v, x);
+	q->r = d[0];
+	q->i = d[1];
+	q->j = d[2];
+	q->k = d[3];
+}
+
+int zsl_quat_q31_to_unit(struct zsl_quat_q31 *q, struct zsl_quat_q31 *qn)
+{
+	int64_t x[4] = { q->r, q->i, q->j, q->k };
+
+	if ((x[0] | x[1] | x[2] | x[3]) == 0) {
+		qn->r = qn->i = qn->j = qn->k = 0;
+		return 0;
+	}
+
+	zsl_quat_q31_unit_from_i64(x, qn);
+
+	return 0;
+}
+
+int zsl_quat_q31_mult(struct zsl_quat_q31 *qa, struct zsl_quat_q31 *qb,
+		      struct zsl_quat_q31 *qm)
+{
+	int64_t a[4] = { qa->r, qa->i, qa->j, qa->k };
+	int64_t b[4] = { qb->r, qb->i, qb->j, qb->k };
+	int64_t m[4];
+
+	/* Each product is scaled to Q60 so that the sums can't overflow. The
+	 * copies also allow this function to be used as a destructive one. */
+	m[0] = ((a[0] * b[0]) >> 2) - ((a[1] * b[1]) >> 2) -
+	       ((a[2] * b[2]) >> 2) - ((a[3] * b[3]) >> 2);
+	m[1] = ((a[0] * b[1]) >> 2) + ((a[1] * b[0]) >> 2) +
+	       ((a[2] * b[3]) >> 2) - ((a[3] * b[2]) >> 2);
+	m[2] = ((a[0] * b[2]) >> 2) - ((a[1] * b[3]) >> 2) +
+	       ((a[2] * b[0]) >> 2) + ((a[3] * b[1]) >> 2);
+	m[3] = ((a[0] * b[3]) >> 2) + ((a[1] * b[2]) >> 2) -
+	       ((a[2] * b[1]) >> 2) + ((a[3] * b[0]) >> 2);
+
+	qm->r = zsl_q31_sat((m[0] + (1LL << 28)) >> 29);
+	qm->i = zsl_q31_sat((m[1] + (1LL << 28)) >> 29);
+	qm->j = zsl_q31_sat((m[2] + (1LL << 28)) >> 29);
+	qm->k = zsl_q31_sat((m[3] + (1LL << 28)) >> 29);
+
+	return 0;
+}
+
+int zsl_quat_q31_conj(struct zsl_quat_q31 *q, struct zsl_quat_q31 *qc)
+{
+	qc->r = q->r;
+	qc->i = zsl_q31_sat(-(int64_t)q->i);
+	qc->j = zsl_q31_sat(-(int64_t)q->j);
+	qc->k = zsl_q31_sat(-(int64_t)q->k);
+
+	return 0;
+}
+
+int zsl_quat_q31_lerp(struct zsl_quat_q31 *qa, struct zsl_quat_q31 *qb,
+		      zsl_q31_t t, struct zsl_quat_q31 *qi)
+{
+	struct zsl_quat_q31 qa_u;
+	struct zsl_quat_q31 qb_u;
+	int64_t x[4];
+
+	/* 1 - t, in Q31 but with room for 1.0 when t is zero. */
+	int64_t tc = (1LL << 31) - t;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure t is between 0 and 1 (included). */
+	if (t < 0) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Turn input quaternions into unit quaternions. */
+	zsl_quat_q31_to_unit(qa, &qa_u);
+	zsl_quat_q31_to_unit(qb, &qb_u);
+
+	/* Final result = qa * (1 - t) + qb * t, normalised. */
+	x[0] = qa_u.r * tc + (int64_t)qb_u.r * t;
+	x[1] = qa_u.i * tc + (int64_t)qb_u.i * t;
+	x[2] = qa_u.j * tc + (int64_t)qb_u.j * t;
+	x[3] = qa_u.k * tc + (int64_t)qb_u.k * t;
+
+	zsl_quat_q31_unit_from_i64(x, qi);
+
+	return 0;
+}
+
+int zsl_quat_q31_from_ang_vel(struct zsl_vec_q31 *w, struct zsl_quat_q31 *qin,
+			      zsl_q31_t t, struct zsl_quat_q31 *qout)
+{
+	struct zsl_quat_q31 q;
+	int64_t h[3];
+	int64_t x[4];
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure time is positive or zero and the angular velocity is a
+	 * tridimensional vector. */
+	if (w->sz != 3 || t < 0) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_quat_q31_to_unit(qin, &q);
+
+	/* 0.5 * t * w, from Q5.26 to Q31. */
+	for (size_t i = 0; i < 3; i++) {
+		h[i] = zsl_q31_sat(((int64_t)w->data[i] * t) >>
+				   (ZSL_FIX_GYRO_FRAC + 1));
+	}
+
+	/* q + (0, h) * q, in Q60 so that the sums can't overflow. */
+	x[0] = (int64_t)q.r * (1LL << 29) - ((h[0] * q.i) >> 2) -
+	       ((h[1] * q.j) >> 2) - ((h[2] * q.k) >> 2);
+	x[1] = (int64_t)q.i * (1LL << 29) + ((h[0] * q.r) >> 2) +
+	       ((h[1] * q.k) >> 2) - ((h[2] * q.j) >> 2);
+	x[2] = (int64_t)q.j * (1LL << 29) - ((h[0] * q.k) >> 2) +
+	       ((h[1] * q.r) >> 2) + ((h[2] * q.i) >> 2);
+	x[3] = (int64_t)q.k * (1LL << 29) + ((h[0] * q.j) >> 2) -
+	       ((h[1] * q.i) >> 2) + ((h[2] * q.r) >> 2);
+
+	zsl_quat_q31_unit_from_i64(x, qout);
+
+	return 0;
+}
+
+int zsl_quat_q31_from_euler(zsl_q31_t x, zsl_q31_t y, zsl_q31_t z,
+			    struct zsl_quat_q31 *q)
+{
+	zsl_q31_t roll_c, roll_s, pitch_c, pitch_s, yaw_c, yaw_s;
+	zsl_q31_t cc, ss, cs, sc;
+
+	/* Half of each binary angle. */
+	zsl_q31_sin_cos(x / 2, &roll_s, &roll_c);
+	zsl_q31_sin_cos(y / 2, &pitch_s, &pitch_c);
+	zsl_q31_sin_cos(z / 2, &yaw_s, &yaw_c);
+
+	cc = zsl_q31_mul(roll_c, pitch_c);
+	ss = zsl_q31_mul(roll_s, pitch_s);
+	cs = zsl_q31_mul(roll_c, pitch_s);
+	sc = zsl_q31_mul(roll_s, pitch_c);
+
+	q->r = zsl_q31_sub(zsl_q31_mul(cc, yaw_c), zsl_q31_mul(ss, yaw_s));
+	q->i = zsl_q31_add(zsl_q31_mul(sc, yaw_c), zsl_q31_mul(cs, yaw_s));
+	q->j = zsl_q31_sub(zsl_q31_mul(cs, yaw_c), zsl_q31_mul(sc, yaw_s));
+	q->k = zsl_q31_add(zsl_q31_mul(cc, yaw_s), zsl_q31_mul(ss, yaw_c));
+
+	return 0;
+}
@@ -10,12 +10,10 @@
 #include <zsl/orientation/fusion/fusion.h>
 #include <zsl/orientation/fusion/aqua.h>
 
-static uint32_t zsl_fus_aqua_freq;
-static uint32_t zsl_fus_aqua_initialised;
-
 static int zsl_fus_aqua(struct zsl_vec *a, struct zsl_vec *m,
 			struct zsl_vec *g, zsl_real_t *e_a, zsl_real_t *e_m,
-			zsl_real_t *alpha, zsl_real_t *beta, struct zsl_quat *q)
+			zsl_real_t *alpha, zsl_real_t *beta, zsl_real_t dt,
+			struct zsl_quat *q)
 {
 	int rc = 0;
 
@@ -39,7 +37,7 @@ static int zsl_fus_aqua(struct zsl_vec *a, struct zsl_vec *m,
 	/* Calculate an estimation of the orientation using only the data of the
 	 * gyroscope and quaternion integration. */
 	zsl_vec_scalar_mult(g, -1.0);
-	zsl_quat_from_ang_vel(g, q, 1.0 / zsl_fus_aqua_freq, q);
+	zsl_quat_from_ang_vel(g, q, dt, q);
 
 	/* Continue with the calculations only if the data from the accelerometer
 	 * is valid (non zero). */
@@ -165,9 +163,6 @@ static int zsl_fus_aqua_alpha_init(struct zsl_vec *a, zsl_real_t *alpha)
 		*alpha *= (0.2 - m_e) / 0.1;
 	}
 
-	/* Inidicate that we have already called this function. */
-	zsl_fus_aqua_initialised++;
-
 err:
 	return rc;
 }
@@ -178,8 +173,6 @@ int zsl_fus_aqua_init(uint32_t freq, void *cfg)
 
 	struct zsl_fus_aqua_cfg *mcfg = cfg;
 
-	(void)mcfg;
-
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure that the sample frequency is positive. */
 	if (freq <= 0.0) {
@@ -188,7 +181,8 @@ int zsl_fus_aqua_init(uint32_t freq, void *cfg)
 	}
 #endif
 
-	zsl_fus_aqua_freq = freq;
+	mcfg->freq = freq;
+	mcfg->initialised = false;
 
 err:
 	return rc;
@@ -200,18 +194,66 @@ int zsl_fus_aqua_feed(struct zsl_vec *a, struct zsl_vec *m,
 {
 	struct zsl_fus_aqua_cfg *mcfg = cfg;
 
-	if (mcfg->alpha < 0.0 || mcfg->alpha > 1.0 || mcfg->beta < 0.0 ||
-	    mcfg->beta > 1.0) {
+	if (mcfg->freq == 0 || mcfg->alpha < 0.0 || mcfg->alpha > 1.0 ||
+	    mcfg->beta < 0.0 || mcfg->beta > 1.0) {
 		return -EINVAL;
 	}
 
-	/* This functions should only be called once. */
-	if (!zsl_fus_aqua_initialised) {
+	/* Adjust alpha from the first sample fed after init. */
+	if (!mcfg->initialised) {
 		zsl_fus_aqua_alpha_init(a, &(mcfg->alpha));
+		mcfg->initialised = true;
 	}
 
 	return zsl_fus_aqua(a, m, g, &(mcfg->e_a), &(mcfg->e_m), &(mcfg->alpha),
-			    &(mcfg->beta), q);
+			    &(mcfg->beta), 1.0 / mcfg->freq, q);
+}
+
+int zsl_fus_aqua_feed_batch(const struct zsl_fus_batch *batch,
+			    struct zsl_quat *q, struct zsl_quat *q_out,
+			    void *cfg)
+{
+	int rc = 0;
+	zsl_real_t dt;
+	struct zsl_fus_aqua_cfg *mcfg = cfg;
+
+	if (mcfg->freq == 0 || mcfg->alpha < 0.0 || mcfg->alpha > 1.0 ||
+	    mcfg->beta < 0.0 || mcfg->beta > 1.0) {
+		return -EINVAL;
+	}
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+
+	for (size_t i = 0; i < batch->n; i++) {
+		rc = zsl_fus_batch_get(batch, i, mcfg->freq, &a, &m, &g, &dt);
+		if (rc) {
+			return rc;
+		}
+
+		/* Adjust alpha from the first sample fed after init. */
+		if (!mcfg->initialised) {
+			zsl_fus_aqua_alpha_init(batch->accel != NULL ? &a : NULL,
+						&(mcfg->alpha));
+			mcfg->initialised = true;
+		}
+
+		rc = zsl_fus_aqua(batch->accel != NULL ? &a : NULL,
+				  batch->mag != NULL ? &m : NULL,
+				  batch->gyro != NULL ? &g : NULL,
+				  &(mcfg->e_a), &(mcfg->e_m), &(mcfg->alpha),
+				  &(mcfg->beta), dt, q);
+		if (rc) {
+			return rc;
+		}
+
+		if (q_out != NULL) {
+			q_out[i] = *q;
+		}
+	}
+
+	return rc;
 }
 
 void zsl_fus_aqua_error(int error)
@@ -12,38 +12,188 @@
 #include <zsl/statistics.h>
 
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
-static zsl_real_t zsl_fus_cal_magn_f_shp(struct zsl_vec *H, struct zsl_vec *b)
+/**
+ * Residual and Jacobian of one sample for the sphere fitting, where 'p' holds
+ * the radius R followed by beta. The residual is |H + b| - R.
+ */
+static zsl_real_t zsl_fus_cal_magn_r_shp(const zsl_real_t *H,
+					 const zsl_real_t *p, zsl_real_t R,
+					 zsl_real_t *J)
+{
+	zsl_real_t u[3] = { H[0] + p[1], H[1] + p[2], H[2] + p[3] };
+	zsl_real_t f = ZSL_SQRT(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+
+	(void)R;
+
+	J[0] = -1.0;
+	for (size_t i = 0; i < 3; i++) {
+		J[i + 1] = (f > 0.0) ? u[i] / f : 0.0;
+	}
+
+	return f - p[0];
+}
+#endif
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * Residual and Jacobian of one sample for the ellipsoid fitting, where 'g'
+ * holds the upper triangle of K (row by row) followed by beta. The residual
+ * is |K(H + b)| - R for the radius R of the sphere fitting.
+ */
+static zsl_real_t zsl_fus_cal_magn_r_elli(const zsl_real_t *H,
+					  const zsl_real_t *g, zsl_real_t R,
+					  zsl_real_t *J)
 {
-	ZSL_VECTOR_DEF(Hb, 3);
-	zsl_vec_add(H, b, &Hb);
+	zsl_real_t u[3] = { H[0] + g[6], H[1] + g[7], H[2] + g[8] };
+	zsl_real_t v[3];
+	zsl_real_t f;
+
+	/* v = K(H + b). */
+	v[0] = g[0] * u[0] + g[1] * u[1] + g[2] * u[2];
+	v[1] = g[1] * u[0] + g[3] * u[1] + g[4] * u[2];
+	v[2] = g[2] * u[0] + g[4] * u[1] + g[5] * u[2];
+	f = ZSL_SQRT(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+	if (f > 0.0) {
+		v[0] /= f;
+		v[1] /= f;
+		v[2] /= f;
+	}
 
-	return zsl_vec_norm(&Hb);
+	/* Derivatives with respect to the entries of K. The off-diagonal ones
+	 * appear twice in K, since it is symmetric. */
+	J[0] = v[0] * u[0];
+	J[1] = v[0] * u[1] + v[1] * u[0];
+	J[2] = v[0] * u[2] + v[2] * u[0];
+	J[3] = v[1] * u[1];
+	J[4] = v[1] * u[2] + v[2] * u[1];
+	J[5] = v[2] * u[2];
+
+	/* Derivatives with respect to beta: K * v / f. */
+	J[6] = g[0] * v[0] + g[1] * v[1] + g[2] * v[2];
+	J[7] = g[1] * v[0] + g[3] * v[1] + g[4] * v[2];
+	J[8] = g[2] * v[0] + g[4] * v[1] + g[5] * v[2];
+
+	return f - R;
 }
 #endif
 
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
-static zsl_real_t zsl_fus_cal_magn_f_elli(struct zsl_vec *H, struct zsl_mtx *g)
+typedef zsl_real_t (*zsl_fus_cal_magn_res_t)(const zsl_real_t *H,
+					     const zsl_real_t *p, zsl_real_t R,
+					     zsl_real_t *J);
+
+/**
+ * Accumulates the normal equations JtJ and Jtr of the parameters 'p' in a
+ * single pass over the samples in 'm', and returns the squared residual sum.
+ */
+static zsl_real_t zsl_fus_cal_magn_acc(struct zsl_mtx *m,
+				       zsl_fus_cal_magn_res_t res,
+				       const zsl_real_t *p, zsl_real_t R,
+				       struct zsl_mtx *JtJ, struct zsl_mtx *Jtr)
 {
-	ZSL_MATRIX_DEF(K, 3, 3);
-	K.data[0] = g->data[0];
-	K.data[1] = K.data[3] = g->data[1];
-	K.data[2] = K.data[6] = g->data[2];
-	K.data[4] = g->data[3];
-	K.data[5] = K.data[7] = g->data[4];
-	K.data[8] = g->data[5];
-
-	ZSL_MATRIX_DEF(Hb, 3, 1);
-	Hb.data[0] = H->data[0] + g->data[6];
-	Hb.data[1] = H->data[1] + g->data[7];
-	Hb.data[2] = H->data[2] + g->data[8];
-
-	ZSL_MATRIX_DEF(KHb, 3, 1);
-	zsl_mtx_mult(&K, &Hb, &KHb);
-
-	ZSL_VECTOR_DEF(Hd, 3);
-	zsl_vec_from_arr(&Hd, KHb.data);
-
-	return zsl_vec_norm(&Hd);
+	size_t n = JtJ->sz_rows;
+	zsl_real_t J[9];
+	zsl_real_t r, S = 0.0;
+
+	zsl_mtx_init(JtJ, NULL);
+	zsl_mtx_init(Jtr, NULL);
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		r = res(&m->data[i * 3], p, R, J);
+		S += r * r;
+
+		/* Only the upper triangle of JtJ is accumulated. */
+		for (size_t a = 0; a < n; a++) {
+			Jtr->data[a] += J[a] * r;
+			for (size_t c = a; c < n; c++) {
+				JtJ->data[a * n + c] += J[a] * J[c];
+			}
+		}
+	}
+
+	for (size_t a = 1; a < n; a++) {
+		for (size_t c = 0; c < a; c++) {
+			JtJ->data[a * n + c] = JtJ->data[c * n + a];
+		}
+	}
+
+	return S;
+}
+#endif
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * Levenberg–Marquardt minimisation of the squared residual sum of 'res' over
+ * the 'n' parameters in 'p', which are updated in place. Each iteration
+ * makes one pass over the samples, and stops once the relative change in the
+ * residual sum or the parameters drops below ZSL_FUS_CAL_MAGN_TOL.
+ */
+static void zsl_fus_cal_magn_lm(struct zsl_mtx *m, zsl_fus_cal_magn_res_t res,
+				zsl_real_t *p, size_t n, zsl_real_t R,
+				zsl_real_t l, zsl_real_t mu)
+{
+	ZSL_MATRIX_DEF(JtJa, n, n);
+	ZSL_MATRIX_DEF(JtJb, n, n);
+	ZSL_MATRIX_DEF(Jtra, n, 1);
+	ZSL_MATRIX_DEF(Jtrb, n, 1);
+	ZSL_MATRIX_DEF(A, n, n);
+	ZSL_MATRIX_DEF(t, n, 1);
+	struct zsl_mtx *JtJ = &JtJa, *JtJ2 = &JtJb, *tmp;
+	struct zsl_mtx *Jtr = &Jtra, *Jtr2 = &Jtrb;
+	zsl_real_t p2[9];
+	zsl_real_t S, S2, dp, pp;
+
+	S = zsl_fus_cal_magn_acc(m, res, p, R, JtJ, Jtr);
+
+	for (size_t it = 0; it < ZSL_FUS_CAL_MAGN_MAX_ITER; it++) {
+		/* Solve (JtJ + l * diag(JtJ)) * t = Jtr for the step tau. */
+		zsl_mtx_copy(&A, JtJ);
+		for (size_t a = 0; a < n; a++) {
+			A.data[a * n + a] += l * JtJ->data[a * n + a];
+		}
+
+		if (zsl_mtx_solve_spd(&A, Jtr, &t) != 0) {
+			l *= mu;
+			continue;
+		}
+
+		dp = 0.0;
+		pp = 0.0;
+		for (size_t a = 0; a < n; a++) {
+			p2[a] = p[a] - t.data[a];
+			dp += t.data[a] * t.data[a];
+			pp += p[a] * p[a];
+		}
+
+		/* The pass that evaluates the new parameters also accumulates the
+		 * normal equations for the next step, should they be accepted. */
+		S2 = zsl_fus_cal_magn_acc(m, res, p2, R, JtJ2, Jtr2);
+
+		if (S2 < S) {
+			for (size_t a = 0; a < n; a++) {
+				p[a] = p2[a];
+			}
+			tmp = JtJ;
+			JtJ = JtJ2;
+			JtJ2 = tmp;
+			tmp = Jtr;
+			Jtr = Jtr2;
+			Jtr2 = tmp;
+			l /= mu;
+
+			if ((S - S2) <= ZSL_FUS_CAL_MAGN_TOL * S) {
+				break;
+			}
+			S = S2;
+		} else {
+			l *= mu;
+		}
+
+		if (dp <= ZSL_FUS_CAL_MAGN_TOL * ZSL_FUS_CAL_MAGN_TOL * pp) {
+			break;
+		}
+	}
 }
 #endif
 
@@ -108,226 +258,61 @@ int zsl_fus_cal_magn(struct zsl_mtx *m, zsl_real_t *l, zsl_real_t *mu,
 	}
 #endif
 
-	/* Make a copy of l. */
-	zsl_real_t l_copy = *l;
-
-
 	/* SPHERE FITTING. */
 
 	/* Calculate the initial value of beta (b) as the mean value of (x, y, z)
-	 * max and (x, y, z) min. */
-	ZSL_VECTOR_DEF(v, m->sz_rows);
-	ZSL_VECTOR_DEF(w, m->sz_rows);
-
-	zsl_real_t mean = 0.0;
+	 * max and (x, y, z) min, in a single pass over the samples. */
+	zsl_real_t min[3], max[3];
 
 	for (size_t i = 0; i < 3; i++) {
-		zsl_mtx_get_col(m, i, v.data);
-		zsl_vec_sort(&v, &w);
-		b->data[i] = -(w.data[m->sz_rows - 1] + w.data[0]) / 2.0;
-		mean += (w.data[m->sz_rows - 1] - w.data[0]) / 2.0;
-	}
-
-	/* R is a first estimation of the radius for the sphere fitting. */
-	zsl_real_t R = mean / 3.0;
-
-	/* Define needed variables. */
-	ZSL_VECTOR_DEF(H, 3);
-	ZSL_MATRIX_DEF(J, 1, 4);
-	ZSL_MATRIX_DEF(Jt, 4, 1);
-	ZSL_MATRIX_DEF(JtJ, 4, 4);
-	ZSL_MATRIX_DEF(idx, 4, 4);
-	ZSL_MATRIX_DEF(t, 4, 1);
-	zsl_real_t f, S = 0.0, S2;
-
-	/* Initialize the identity matrix. */
-	zsl_mtx_init(&idx, zsl_mtx_entry_fn_identity);
-
-	for (size_t j = 0; j < m->sz_rows; j++) {
-
-		/* Calculate the Jacobian matrix J. */
-		zsl_mtx_init(&J, NULL);
-		for (size_t i = 0; i < m->sz_rows; i++) {
-			zsl_mtx_get_row(m, i, H.data);
-			f = zsl_fus_cal_magn_f_shp(&H, b);
-			J.data[0] += 1.0;
-			J.data[1] += -(H.data[0] - b->data[0]) / f;
-			J.data[2] += -(H.data[1] - b->data[1]) / f;
-			J.data[3] += -(H.data[2] - b->data[2]) / f;
-		}
+		min[i] = max[i] = m->data[i];
+	}
 
-		/* Compute the transpose of J. */
-		zsl_mtx_trans(&J, &Jt);
-
-		/* Calculate the value of tau ('t'). */
-		zsl_mtx_get_row(m, j, H.data);
-		f = zsl_fus_cal_magn_f_shp(&H, b);
-		zsl_mtx_mult(&Jt, &J, &JtJ);
-		idx.data[0] = *l * JtJ.data[0];
-		idx.data[5] = *l * JtJ.data[5];
-		idx.data[10] = *l * JtJ.data[10];
-		idx.data[15] = *l * JtJ.data[15];
-		zsl_mtx_add_d(&JtJ, &idx);
-		zsl_mtx_inv(&JtJ, &idx);
-		zsl_mtx_mult(&idx, &Jt, &t);
-		zsl_mtx_scalar_mult_d(&t, -(R - f));
-
-		/* Calculate the new pair (R, b) by adding tau to the old values of R
-		 * and b. */
-		R += t.data[0];
-		b->data[0] += t.data[1];
-		b->data[1] += t.data[2];
-		b->data[2] += t.data[3];
-
-		if (j < (m->sz_rows - 1)) {
-
-			/* Calculate the squared residual sum of all samples. */
-			zsl_mtx_get_row(m, j + 1, H.data);
-			f = zsl_fus_cal_magn_f_shp(&H, b);
-			S2 = (S * j + (R - f) * (R - f)) / (zsl_real_t) (j + 1);
-
-			/* Update the value of lambda (l) with the information from the
-			 * squared residual sum. */
-			if (S2 < S) {
-				*l /= *mu;
-			} else {
-				*l *= *mu;
+	for (size_t j = 1; j < m->sz_rows; j++) {
+		for (size_t i = 0; i < 3; i++) {
+			zsl_real_t x = m->data[j * 3 + i];
+			if (x < min[i]) {
+				min[i] = x;
+			} else if (x > max[i]) {
+				max[i] = x;
 			}
-
-			S = S2;
 		}
 	}
 
-	/* ELLIPSOID FITTING. */
+	/* The sphere parameters are the radius R followed by beta. The first
+	 * estimation of R is the mean of the half-ranges of each axis. */
+	zsl_real_t s[4];
 
-	/* Initialize the matrix K as an identity matrix. */
-	zsl_mtx_init(K, zsl_mtx_entry_fn_identity);
-
-	/* Reset the value of lambda ('l') and the value of the sum (S). */
-	*l = l_copy;
-	S = 0.0;
-
-	/* Define gamma (g) and initialize it with the calculated values of
-	 * beta in the sphere fitting. */
-	ZSL_MATRIX_DEF(g, 9, 1);
-	g.data[0] = 1.0;
-	g.data[1] = 0.0;
-	g.data[2] = 0.0;
-	g.data[3] = 1.0;
-	g.data[4] = 0.0;
-	g.data[5] = 1.0;
-	g.data[6] = b->data[0];
-	g.data[7] = b->data[1];
-	g.data[8] = b->data[2];
-
-	/* Define needed variables. */
-	ZSL_MATRIX_DEF(N, 1, 9);
-	ZSL_MATRIX_DEF(Nt, 9, 1);
-	ZSL_MATRIX_DEF(NtN, 9, 9);
-	ZSL_MATRIX_DEF(idxN, 9, 9);
-	ZSL_MATRIX_DEF(tN, 9, 1);
-	zsl_real_t A, B, C;
-
-	/* Initialize the identity matrix. */
-	zsl_mtx_init(&idxN, zsl_mtx_entry_fn_identity);
-
-	/* Start the ellipsoid fitting algorithm. */
-	for (size_t j = 0; j < m->sz_rows; j++) {
-		zsl_mtx_init(&N, NULL);
-
-		for (size_t i = 0; i < m->sz_rows; i++) {
-			zsl_mtx_get_row(m, i, H.data);
-			f = zsl_fus_cal_magn_f_elli(&H, &g);
-
-			/* Define variables for repeated calculations. */
-			A = g.data[0] * (H.data[0] + b->data[0]) +
-			    g.data[1] * (H.data[1] + b->data[1]) +
-			    g.data[2] * (H.data[2] + b->data[2]);
-			B = g.data[1] * (H.data[0] + b->data[0]) +
-			    g.data[3] * (H.data[1] + b->data[1]) +
-			    g.data[4] * (H.data[2] + b->data[2]);
-			C = g.data[2] * (H.data[0] + b->data[0]) +
-			    g.data[4] * (H.data[1] + b->data[1]) +
-			    g.data[5] * (H.data[2] + b->data[2]);
-
-			/* Calculate the Jacobian matrix N. */
-			N.data[0] += -(H.data[0] + b->data[0]) * A / f;
-			N.data[1] += -(H.data[1] + b->data[1]) * B / f;
-			N.data[2] += -(H.data[2] + b->data[2]) * C / f;
-			N.data[3] += -((H.data[1] + b->data[1]) * A +
-				       (H.data[0] + b->data[0]) * B) / f;
-			N.data[4] += -((H.data[2] + b->data[2]) * A +
-				       (H.data[0] + b->data[0]) * C) / f;
-			N.data[5] += -((H.data[2] + b->data[2]) * B +
-				       (H.data[1] + b->data[1]) * C) / f;
-			N.data[6] += -A / f;
-			N.data[7] += -B / f;
-			N.data[8] += -C / f;
-		}
+	s[0] = 0.0;
+	for (size_t i = 0; i < 3; i++) {
+		s[i + 1] = -(max[i] + min[i]) / 2.0;
+		s[0] += (max[i] - min[i]) / 2.0;
+	}
+	s[0] /= 3.0;
 
-		/* Calculate the transpose of N. */
-		zsl_mtx_trans(&N, &Nt);
-
-		/* Calculate the value of tau (tN). */
-		zsl_mtx_get_row(m, j, H.data);
-		f = zsl_fus_cal_magn_f_elli(&H, &g);
-		zsl_mtx_mult(&Nt, &N, &NtN);
-		idxN.data[0] = *l * NtN.data[0];
-		idxN.data[10] = *l * NtN.data[10];
-		idxN.data[20] = *l * NtN.data[20];
-		idxN.data[30] = *l * NtN.data[30];
-		idxN.data[40] = *l * NtN.data[40];
-		idxN.data[50] = *l * NtN.data[50];
-		idxN.data[60] = *l * NtN.data[60];
-		idxN.data[70] = *l * NtN.data[70];
-		idxN.data[80] = *l * NtN.data[80];
-		zsl_mtx_add_d(&NtN, &idxN);
-		zsl_mtx_inv(&NtN, &idxN);
-		zsl_mtx_mult(&idxN, &Nt, &tN);
-		zsl_mtx_scalar_mult_d(&tN, -(R - f));
-
-		/* Calculate the new vector gamma. */
-		g.data[0] += tN.data[0];
-		g.data[1] += tN.data[1];
-		g.data[2] += tN.data[2];
-		g.data[3] += tN.data[3];
-		g.data[4] += tN.data[4];
-		g.data[5] += tN.data[5];
-		g.data[6] += tN.data[6];
-		g.data[7] += tN.data[7];
-		g.data[8] += tN.data[8];
-
-		if (j < (m->sz_rows - 1)) {
-
-			/* Calculate the squared residual sum of all samples. */
-			zsl_mtx_get_row(m, j + 1, H.data);
-			f = zsl_fus_cal_magn_f_elli(&H, &g);
-			S2 = (S * j + (R - f) * (R - f)) / (zsl_real_t) (j + 1);
-
-			/* Update the value of lambda (l) with the information from the
-			 * squared residual sum. */
-			if (S2 < S) {
-				*l /= *mu;
-			} else {
-				*l *= *mu;
-			}
+	zsl_fus_cal_magn_lm(m, zsl_fus_cal_magn_r_shp, s, 4, 0.0, *l, *mu);
 
-			S = S2;
-		}
-	}
+	/* ELLIPSOID FITTING. */
+
+	/* Define gamma (g), holding the upper triangle of K followed by beta,
+	 * and initialize it with K as the identity matrix and the values of
+	 * beta calculated in the sphere fitting. */
+	zsl_real_t g[9] = { 1.0, 0.0, 0.0, 1.0, 0.0, 1.0, s[1], s[2], s[3] };
+
+	zsl_fus_cal_magn_lm(m, zsl_fus_cal_magn_r_elli, g, 9, s[0], *l, *mu);
 
 	/* Calculate the matrix K. */
-	K->data[0] = g.data[0];
-	K->data[1] = K->data[3] = g.data[1];
-	K->data[2] = K->data[6] = g.data[2];
-	K->data[4] = g.data[3];
-	K->data[5] = K->data[7] = g.data[4];
-	K->data[8] = g.data[5];
+	K->data[0] = g[0];
+	K->data[1] = K->data[3] = g[1];
+	K->data[2] = K->data[6] = g[2];
+	K->data[4] = g[3];
+	K->data[5] = K->data[7] = g[4];
+	K->data[8] = g[5];
 
 	/* Calculate the vector beta ('b'). */
-	b->data[0] = g.data[6];
-	b->data[1] = g.data[7];
-	b->data[2] = g.data[8];
+	b->data[0] = g[6];
+	b->data[1] = g[7];
+	b->data[2] = g[8];
 
 	return 0;
 }
@@ -394,6 +379,281 @@ int zsl_fus_cal_magn_fast(struct zsl_mtx *m, zsl_real_t *me, struct zsl_mtx *K,
 }
 #endif
 
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * Calculates the symmetric square root 'r' of the 3x3 symmetric positive
+ * definite matrix 'm', using the Denman–Beavers iteration.
+ */
+static void zsl_fus_cal_sqrtm_3x3(struct zsl_mtx *m, struct zsl_mtx *r)
+{
+	ZSL_MATRIX_DEF(Z, 3, 3);
+	ZSL_MATRIX_DEF(Ri, 3, 3);
+	ZSL_MATRIX_DEF(Zi, 3, 3);
+	zsl_real_t y, d, n;
+
+	zsl_mtx_copy(r, m);
+	zsl_mtx_init(&Z, zsl_mtx_entry_fn_identity);
+
+	for (size_t it = 0; it < 32; it++) {
+		zsl_mtx_inv_3x3(r, &Ri);
+		zsl_mtx_inv_3x3(&Z, &Zi);
+
+		d = 0.0;
+		n = 0.0;
+		for (size_t i = 0; i < 9; i++) {
+			y = (r->data[i] + Zi.data[i]) / 2.0;
+			d += (y - r->data[i]) * (y - r->data[i]);
+			n += y * y;
+			r->data[i] = y;
+			Z.data[i] = (Z.data[i] + Ri.data[i]) / 2.0;
+		}
+
+		if (d <= 1E-28 * n) {
+			break;
+		}
+	}
+
+	/* Remove any asymmetry introduced by rounding. */
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = i + 1; j < 3; j++) {
+			y = (r->data[i * 3 + j] + r->data[j * 3 + i]) / 2.0;
+			r->data[i * 3 + j] = r->data[j * 3 + i] = y;
+		}
+	}
+}
+#endif
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+int zsl_fus_cal_magn_acc_init(struct zsl_fus_cal_magn_acc *acc,
+			      zsl_real_t *me, zsl_real_t ff)
+{
+	/* Use an approximation for me if no value provided. */
+	zsl_real_t m = (me == NULL) ? 50.0 : *me;
+
+	if (m <= 0.0 || ff <= 0.0 || ff > 1.0) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < 45; i++) {
+		acc->xtx[i] = 0.0;
+	}
+	for (size_t i = 0; i < 9; i++) {
+		acc->xty[i] = 0.0;
+	}
+
+	acc->me = m;
+	acc->ff = ff;
+	acc->n = 0;
+
+	return 0;
+}
+#endif
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+int zsl_fus_cal_magn_acc_push(struct zsl_fus_cal_magn_acc *acc,
+			      struct zsl_vec *h)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure that the sample is tridimensional. */
+	if (h->sz != 3) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Scale the sample to roughly unit length to keep XtX well
+	 * conditioned. */
+	zsl_real_t x = h->data[0] / acc->me;
+	zsl_real_t y = h->data[1] / acc->me;
+	zsl_real_t z = h->data[2] / acc->me;
+
+	/* The same quadric terms as zsl_sta_quad_fit. */
+	zsl_real_t t[9] = {
+		x * x, y * y, z * z,
+		2.0 * x * y, 2.0 * x * z, 2.0 * y * z,
+		2.0 * x, 2.0 * y, 2.0 * z
+	};
+	size_t k = 0;
+
+	if (acc->ff < 1.0) {
+		for (size_t i = 0; i < 45; i++) {
+			acc->xtx[i] *= acc->ff;
+		}
+		for (size_t i = 0; i < 9; i++) {
+			acc->xty[i] *= acc->ff;
+		}
+	}
+
+	for (size_t i = 0; i < 9; i++) {
+		for (size_t j = i; j < 9; j++) {
+			acc->xtx[k++] += t[i] * t[j];
+		}
+		acc->xty[i] += t[i];
+	}
+
+	acc->n++;
+
+	return 0;
+}
+#endif
+
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+int zsl_fus_cal_magn_acc_solve(struct zsl_fus_cal_magn_acc *acc,
+			       struct zsl_mtx *K, struct zsl_vec *b)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* 'K' must be a 3 x 3 matrix and 'b' a tridimensional vector. */
+	if (K->sz_rows != 3 || K->sz_cols != 3 || b->sz != 3) {
+		return -EINVAL;
+	}
+#endif
+
+	/* Nine coefficients need at least nine samples. */
+	if (acc->n < 9) {
+		return -EINVAL;
+	}
+
+	ZSL_MATRIX_DEF(xtx, 9, 9);
+	ZSL_MATRIX_DEF(xty, 9, 1);
+	ZSL_MATRIX_DEF(c, 9, 1);
+	size_t k = 0;
+
+	for (size_t i = 0; i < 9; i++) {
+		for (size_t j = i; j < 9; j++) {
+			xtx.data[i * 9 + j] = xtx.data[j * 9 + i] = acc->xtx[k++];
+		}
+		xty.data[i] = acc->xty[i];
+	}
+
+	if (zsl_mtx_solve_spd(&xtx, &xty, &c) != 0) {
+		return -ESINGULAR;
+	}
+
+	/* The fitted quadric is x^T A x + 2 v^T x = 1, with centre
+	 * x0 = -A^-1 v. */
+	ZSL_MATRIX_DEF(A, 3, 3);
+	ZSL_MATRIX_DEF(Ai, 3, 3);
+	zsl_real_t v[3] = { c.data[6], c.data[7], c.data[8] };
+	zsl_real_t x0[3];
+	zsl_real_t s;
+
+	A.data[0] = c.data[0];
+	A.data[1] = A.data[3] = c.data[3];
+	A.data[2] = A.data[6] = c.data[4];
+	A.data[4] = c.data[1];
+	A.data[5] = A.data[7] = c.data[5];
+	A.data[8] = c.data[2];
+
+	/* A must be positive definite for the quadric to be an ellipsoid. */
+	zsl_mtx_deter_3x3(&A, &s);
+	if (A.data[0] <= 0.0 ||
+	    A.data[0] * A.data[4] - A.data[1] * A.data[1] <= 0.0 || s <= 0.0) {
+		return -ESINGULAR;
+	}
+
+	zsl_mtx_inv_3x3(&A, &Ai);
+	s = 1.0;
+	for (size_t i = 0; i < 3; i++) {
+		x0[i] = -(Ai.data[i * 3] * v[0] + Ai.data[i * 3 + 1] * v[1] +
+			  Ai.data[i * 3 + 2] * v[2]);
+		s -= v[i] * x0[i];
+	}
+
+	/* Around its centre, the ellipsoid is (x - x0)^T A (x - x0) = s, so
+	 * K = sqrt(A / s) maps it to the unit sphere, and to a sphere of
+	 * radius 'me' once the samples are scaled back. */
+	if (s <= 0.0) {
+		return -ESINGULAR;
+	}
+
+	zsl_mtx_scalar_mult_d(&A, 1.0 / s);
+	zsl_fus_cal_sqrtm_3x3(&A, K);
+
+	for (size_t i = 0; i < 3; i++) {
+		b->data[i] = -x0[i] * acc->me;
+	}
+
+	return 0;
+}
+#endif
+
+int zsl_fus_cal_gyro_acc_init(struct zsl_fus_cal_gyro_acc *acc,
+			      zsl_real_t alpha, zsl_real_t thresh)
+{
+	if (alpha <= 0.0 || alpha > 1.0 || thresh <= 0.0) {
+		return -EINVAL;
+	}
+
+	acc->bias[0] = acc->bias[1] = acc->bias[2] = 0.0;
+	acc->alpha = alpha;
+	acc->thresh = thresh;
+	acc->n = 0;
+
+	return 0;
+}
+
+int zsl_fus_cal_gyro_acc_push(struct zsl_fus_cal_gyro_acc *acc,
+			      struct zsl_vec *g)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure that the sample is tridimensional. */
+	if (g->sz != 3) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_real_t d[3];
+	zsl_real_t w;
+
+	for (size_t i = 0; i < 3; i++) {
+		d[i] = g->data[i] - acc->bias[i];
+	}
+
+	/* Ignore samples taken while the sensor is moving. The first sample
+	 * seeds the estimate, so a bias larger than the threshold is still
+	 * found. */
+	if (acc->n > 0 &&
+	    d[0] * d[0] + d[1] * d[1] + d[2] * d[2] >
+	    acc->thresh * acc->thresh) {
+		return -EAGAIN;
+	}
+
+	/* Average the first samples with equal weights, so that the estimate
+	 * settles quickly, then switch to an exponential moving average. */
+	w = 1.0 / (zsl_real_t)(acc->n + 1);
+	if (w < acc->alpha) {
+		w = acc->alpha;
+	}
+
+	for (size_t i = 0; i < 3; i++) {
+		acc->bias[i] += w * d[i];
+	}
+
+	acc->n++;
+
+	return 0;
+}
+
+int zsl_fus_cal_gyro_acc_bias(struct zsl_fus_cal_gyro_acc *acc,
+			      struct zsl_vec *b)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure that the output vector is tridimensional. */
+	if (b->sz != 3) {
+		return -EINVAL;
+	}
+#endif
+
+	if (acc->n == 0) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < 3; i++) {
+		b->data[i] = -acc->bias[i];
+	}
+
+	return 0;
+}
+
 int zsl_fus_cal_corr_scalar(zsl_real_t *d, zsl_real_t *k, zsl_real_t *b,
 			    zsl_real_t *d_out)
 {
@@ -10,10 +10,9 @@
 #include <zsl/orientation/fusion/fusion.h>
 #include <zsl/orientation/fusion/complementary.h>
 
-static uint32_t zsl_fus_comp_freq = 0;
-
 static int zsl_fus_comp(struct zsl_vec *a, struct zsl_vec *m,
-			struct zsl_vec *g, zsl_real_t *alpha, struct zsl_quat *q)
+			struct zsl_vec *g, zsl_real_t *alpha, zsl_real_t dt,
+			struct zsl_quat *q)
 {
 	int rc = 0;
 
@@ -38,7 +37,7 @@ static int zsl_fus_comp(struct zsl_vec *a, struct zsl_vec *m,
 	/* Estimate the orientation (q_w) using the angular velocity data from the
 	 * gyroscope. */
 	struct zsl_quat q_w;
-	zsl_quat_from_ang_vel(g, q, 1.0 / zsl_fus_comp_freq, &q_w);
+	zsl_quat_from_ang_vel(g, q, dt, &q_w);
 
 	/* Continue with the calculations only if the data from the accelerometer
 	 * and magnetometer is valid (non zero). */
@@ -82,8 +81,6 @@ int zsl_fus_comp_init(uint32_t freq, void *cfg)
 
 	struct zsl_fus_comp_cfg *mcfg = cfg;
 
-	(void)mcfg;
-
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure that the sample frequency is positive. */
 	if (freq <= 0.0) {
@@ -92,7 +89,7 @@ int zsl_fus_comp_init(uint32_t freq, void *cfg)
 	}
 #endif
 
-	zsl_fus_comp_freq = freq;
+	mcfg->freq = freq;
 
 err:
 	return rc;
@@ -103,11 +100,49 @@ int zsl_fus_comp_feed(struct zsl_vec *a, struct zsl_vec *m,
 {
 	struct zsl_fus_comp_cfg *mcfg = cfg;
 
-	if (mcfg->alpha < 0.0 || mcfg->alpha > 1.0) {
+	if (mcfg->freq == 0 || mcfg->alpha < 0.0 || mcfg->alpha > 1.0) {
+		return -EINVAL;
+	}
+
+	return zsl_fus_comp(a, m, g, &(mcfg->alpha), 1.0 / mcfg->freq, q);
+}
+
+int zsl_fus_comp_feed_batch(const struct zsl_fus_batch *batch,
+			    struct zsl_quat *q, struct zsl_quat *q_out,
+			    void *cfg)
+{
+	int rc = 0;
+	zsl_real_t dt;
+	struct zsl_fus_comp_cfg *mcfg = cfg;
+
+	if (mcfg->freq == 0 || mcfg->alpha < 0.0 || mcfg->alpha > 1.0) {
 		return -EINVAL;
 	}
 
-	return zsl_fus_comp(a, m, g, &(mcfg->alpha), q);
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+
+	for (size_t i = 0; i < batch->n; i++) {
+		rc = zsl_fus_batch_get(batch, i, mcfg->freq, &a, &m, &g, &dt);
+		if (rc) {
+			return rc;
+		}
+
+		rc = zsl_fus_comp(batch->accel != NULL ? &a : NULL,
+				  batch->mag != NULL ? &m : NULL,
+				  batch->gyro != NULL ? &g : NULL,
+				  &(mcfg->alpha), dt, q);
+		if (rc) {
+			return rc;
+		}
+
+		if (q_out != NULL) {
+			q_out[i] = *q;
+		}
+	}
+
+	return rc;
 }
 
 void zsl_fus_comp_error(int error)
@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/orientation/fusion/fixed.h>
+
+/*
+ * The filters work in Q28, in 64-bit integers. This leaves room for the sums
+ * in the gradient and error terms, which can exceed 1.0, while the product of
+ * two values up to 8.0 can't overflow.
+ */
+#define ZSL_FUS_Q (28)
+
+static inline int64_t zsl_fus_q_mul(int64_t a, int64_t b)
+{
+	return (a * b) >> ZSL_FUS_Q;
+}
+
+/**
+ * Sets 'x' to the unit form of the Q31 vector 'v', in Q28. Returns false,
+ * leaving 'x' unchanged, if 'v' is zero.
+ */
+static bool zsl_fus_q_load_vec(struct zsl_vec_q31 *v, int64_t *x)
+{
+	zsl_q31_t d[3] = { v->data[0], v->data[1], v->data[2] };
+	struct zsl_vec_q31 u = { .sz = 3, .data = d };
+
+	if ((d[0] | d[1] | d[2]) == 0) {
+		return false;
+	}
+
+	zsl_vec_q31_to_unit(&u);
+	for (size_t i = 0; i < 3; i++) {
+		x[i] = d[i] >> (31 - ZSL_FUS_Q);
+	}
+
+	return true;
+}
+
+/**
+ * Normalises the 'n' Q28 values in 'x', with (1, 0, ...) for a zero vector.
+ */
+static void zsl_fus_q_unit(int64_t *x, size_t n)
+{
+	zsl_q31_t d[4];
+	struct zsl_vec_q31 u = { .sz = n, .data = d };
+
+	zsl_vec_q31_unit_from_i64(&u, x);
+	for (size_t i = 0; i < n; i++) {
+		x[i] = d[i] >> (31 - ZSL_FUS_Q);
+	}
+}
+
+/**
+ * Stores the unit form of the Q28 quaternion 'x' in 'q', with the full Q31
+ * precision.
+ */
+static void zsl_fus_q_store_quat(const int64_t *x, struct zsl_quat_q31 *q)
+{
+	zsl_q31_t d[4];
+	struct zsl_vec_q31 u = { .sz = 4, .data = d };
+
+	zsl_vec_q31_unit_from_i64(&u, x);
+	q->r = d[0];
+	q->i = d[1];
+	q->j = d[2];
+	q->k = d[3];
+}
+
+/**
+ * Sets 'x' to the unit form of 'q', in Q28.
+ */
+static void zsl_fus_q_load_quat(struct zsl_quat_q31 *q, int64_t *x)
+{
+	struct zsl_quat_q31 u;
+
+	zsl_quat_q31_to_unit(q, &u);
+	x[0] = u.r >> (31 - ZSL_FUS_Q);
+	x[1] = u.i >> (31 - ZSL_FUS_Q);
+	x[2] = u.j >> (31 - ZSL_FUS_Q);
+	x[3] = u.k >> (31 - ZSL_FUS_Q);
+}
+
+/**
+ * Fills 'r' with the rotation matrix, row by row, of the unit quaternion 'q'.
+ */
+static void zsl_fus_q_rot_mtx(const int64_t *q, int64_t *r)
+{
+	int64_t rr = zsl_fus_q_mul(q[0], q[0]);
+	int64_t ii = zsl_fus_q_mul(q[1], q[1]);
+	int64_t jj = zsl_fus_q_mul(q[2], q[2]);
+	int64_t kk = zsl_fus_q_mul(q[3], q[3]);
+	int64_t ij = zsl_fus_q_mul(q[1], q[2]);
+	int64_t ik = zsl_fus_q_mul(q[1], q[3]);
+	int64_t jk = zsl_fus_q_mul(q[2], q[3]);
+	int64_t ri = zsl_fus_q_mul(q[0], q[1]);
+	int64_t rj = zsl_fus_q_mul(q[0], q[2]);
+	int64_t rk = zsl_fus_q_mul(q[0], q[3]);
+
+	r[0] = rr + ii - jj - kk;
+	r[1] = 2 * (ij - rk);
+	r[2] = 2 * (ik + rj);
+	r[3] = 2 * (ij + rk);
+	r[4] = rr - ii + jj - kk;
+	r[5] = 2 * (jk - ri);
+	r[6] = 2 * (ik - rj);
+	r[7] = 2 * (jk + ri);
+	r[8] = rr - ii - jj + kk;
+}
+
+/**
+ * Sets (bx, bz) to the horizontal and vertical components of the unit
+ * magnetic field 'm' in the earth's frame, or to the cosine and sine of the
+ * inclination if 'incl' isn't NULL.
+ */
+static void zsl_fus_q_mag_ref(const int64_t *r, const int64_t *m,
+			      zsl_q31_t *incl, int64_t *bx, int64_t *bz)
+{
+	zsl_q31_t s, c;
+	int64_t h0, h1;
+
+	if (incl != NULL) {
+		zsl_q31_sin_cos(*incl, &s, &c);
+		*bx = c >> (31 - ZSL_FUS_Q);
+		*bz = s >> (31 - ZSL_FUS_Q);
+		return;
+	}
+
+	h0 = zsl_fus_q_mul(r[0], m[0]) + zsl_fus_q_mul(r[1], m[1]) +
+	     zsl_fus_q_mul(r[2], m[2]);
+	h1 = zsl_fus_q_mul(r[3], m[0]) + zsl_fus_q_mul(r[4], m[1]) +
+	     zsl_fus_q_mul(r[5], m[2]);
+
+	/* The root of a Q56 value is in Q28. */
+	*bx = zsl_fix_sqrt_u64((uint64_t)(h0 * h0 + h1 * h1));
+	*bz = zsl_fus_q_mul(r[6], m[0]) + zsl_fus_q_mul(r[7], m[1]) +
+	      zsl_fus_q_mul(r[8], m[2]);
+}
+
+/**
+ * Integrates the angular velocity 'w', in Q28, over one sample at 'freq' Hz
+ * into the unit quaternion 'q', as zsl_quat_from_ang_vel does.
+ */
+static void zsl_fus_q_integrate(int64_t *q, const int64_t *w, uint32_t freq)
+{
+	int64_t h[3];
+	int64_t x[4];
+
+	/* 0.5 * dt * w. */
+	for (size_t i = 0; i < 3; i++) {
+		h[i] = w[i] / (2 * (int64_t)freq);
+	}
+
+	x[0] = q[0] - zsl_fus_q_mul(h[0], q[1]) - zsl_fus_q_mul(h[1], q[2]) -
+	       zsl_fus_q_mul(h[2], q[3]);
+	x[1] = q[1] + zsl_fus_q_mul(h[0], q[0]) + zsl_fus_q_mul(h[1], q[3]) -
+	       zsl_fus_q_mul(h[2], q[2]);
+	x[2] = q[2] - zsl_fus_q_mul(h[0], q[3]) + zsl_fus_q_mul(h[1], q[0]) +
+	       zsl_fus_q_mul(h[2], q[1]);
+	x[3] = q[3] + zsl_fus_q_mul(h[0], q[2]) - zsl_fus_q_mul(h[1], q[1]) +
+	       zsl_fus_q_mul(h[2], q[0]);
+
+	for (size_t i = 0; i < 4; i++) {
+		q[i] = x[i];
+	}
+	zsl_fus_q_unit(q, 4);
+}
+
+/**
+ * Checks the arguments shared by all the filters.
+ */
+static int zsl_fus_q_check(struct zsl_vec_q31 *a, struct zsl_vec_q31 *m,
+			   struct zsl_vec_q31 *g, struct zsl_quat_q31 *q)
+{
+	if (g == NULL) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure that the input vectors are tridimensional. */
+	if ((a != NULL && (a->sz != 3)) || (m != NULL && (m->sz != 3)) ||
+	    g->sz != 3) {
+		return -EINVAL;
+	}
+	/* Make sure that the input quaternion is not zero. */
+	if ((q->r | q->i | q->j | q->k) == 0) {
+		return -EINVAL;
+	}
+#endif
+
+	return 0;
+}
+
+int zsl_fus_madg_q31_init(uint32_t freq, struct zsl_fus_madg_q31_cfg *cfg)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure that the sample frequency is positive. */
+	if (freq == 0) {
+		return -EINVAL;
+	}
+#endif
+
+	cfg->freq = freq;
+
+	return 0;
+}
+
+int zsl_fus_madg_q31_feed(struct zsl_vec_q31 *a, struct zsl_vec_q31 *m,
+			  struct zsl_vec_q31 *g, zsl_q31_t *incl,
+			  struct zsl_quat_q31 *q,
+			  struct zsl_fus_madg_q31_cfg *cfg)
+{
+	int64_t qv[4], av[3], mv[3], wv[3], r[9], f[3];
+	int64_t s[4] = { 0 };
+	int64_t bx, bz, k;
+	int rc;
+
+	if (cfg->freq == 0 || cfg->beta < 0) {
+		return -EINVAL;
+	}
+
+	rc = zsl_fus_q_check(a, m, g, q);
+	if (rc) {
+		return rc;
+	}
+
+	zsl_fus_q_load_quat(q, qv);
+
+	if (a != NULL && zsl_fus_q_load_vec(a, av)) {
+		zsl_fus_q_rot_mtx(qv, r);
+
+		/* Gradient of f_g, for the vertical rotated by q. */
+		f[0] = r[2] - av[0];
+		f[1] = r[5] - av[1];
+		f[2] = r[8] - av[2];
+		s[0] = zsl_fus_q_mul(-2 * qv[2], f[0]) +
+		       zsl_fus_q_mul(2 * qv[1], f[1]);
+		s[1] = zsl_fus_q_mul(2 * qv[3], f[0]) +
+		       zsl_fus_q_mul(2 * qv[0], f[1]) -
+		       zsl_fus_q_mul(4 * qv[1], f[2]);
+		s[2] = zsl_fus_q_mul(-2 * qv[0], f[0]) +
+		       zsl_fus_q_mul(2 * qv[3], f[1]) -
+		       zsl_fus_q_mul(4 * qv[2], f[2]);
+		s[3] = zsl_fus_q_mul(2 * qv[1], f[0]) +
+		       zsl_fus_q_mul(2 * qv[2], f[1]);
+
+		if (m != NULL && zsl_fus_q_load_vec(m, mv)) {
+			zsl_fus_q_mag_ref(r, mv, incl, &bx, &bz);
+
+			/* Gradient of f_b, for the field (bx, 0, bz) rotated
+			 * by q. */
+			for (size_t i = 0; i < 3; i++) {
+				f[i] = zsl_fus_q_mul(bx, r[i * 3]) +
+				       zsl_fus_q_mul(bz, r[i * 3 + 2]) - mv[i];
+			}
+
+			int64_t bxr = zsl_fus_q_mul(bx, qv[0]);
+			int64_t bxi = zsl_fus_q_mul(bx, qv[1]);
+			int64_t bxj = zsl_fus_q_mul(bx, qv[2]);
+			int64_t bxk = zsl_fus_q_mul(bx, qv[3]);
+			int64_t bzr = zsl_fus_q_mul(bz, qv[0]);
+			int64_t bzi = zsl_fus_q_mul(bz, qv[1]);
+			int64_t bzj = zsl_fus_q_mul(bz, qv[2]);
+			int64_t bzk = zsl_fus_q_mul(bz, qv[3]);
+
+			s[0] += zsl_fus_q_mul(-2 * bzj, f[0]) +
+				zsl_fus_q_mul(2 * bzi - 2 * bxk, f[1]) +
+				zsl_fus_q_mul(2 * bxj, f[2]);
+			s[1] += zsl_fus_q_mul(2 * bzk, f[0]) +
+				zsl_fus_q_mul(2 * bzj + 2 * bzr, f[1]) +
+				zsl_fus_q_mul(2 * bxk - 4 * bzi, f[2]);
+			s[2] += zsl_fus_q_mul(-4 * bxj - 2 * bzr, f[0]) +
+				zsl_fus_q_mul(2 * bxi - 2 * bzk, f[1]) +
+				zsl_fus_q_mul(2 * bxr - 2 * bzj, f[2]);
+			s[3] += zsl_fus_q_mul(-4 * bxk + 2 * bzi, f[0]) +
+				zsl_fus_q_mul(2 * bzj - 2 * bxr, f[1]) +
+				zsl_fus_q_mul(2 * bxi, f[2]);
+		}
+
+		/* Normalize the gradient, as zsl_vec_to_unit does. */
+		zsl_fus_q_unit(s, 4);
+	}
+
+	/* Integrate the angular velocity, from Q5.26 to Q28. */
+	for (size_t i = 0; i < 3; i++) {
+		wv[i] = (int64_t)g->data[i] * (1 << (ZSL_FUS_Q - ZSL_FIX_GYRO_FRAC));
+	}
+	zsl_fus_q_integrate(qv, wv, cfg->freq);
+
+	/* Apply the gradient descent step, with k = beta * dt. */
+	k = ((int64_t)cfg->beta >> (31 - ZSL_FUS_Q)) / cfg->freq;
+	for (size_t i = 0; i < 4; i++) {
+		qv[i] -= zsl_fus_q_mul(k, s[i]);
+	}
+
+	/* Normalize the output quaternion. */
+	zsl_fus_q_store_quat(qv, q);
+
+	return 0;
+}
+
+int zsl_fus_mahn_q31_init(uint32_t freq, struct zsl_fus_mahn_q31_cfg *cfg)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure that the sample frequency is positive. */
+	if (freq == 0) {
+		return -EINVAL;
+	}
+#endif
+
+	cfg->freq = freq;
+
+	return 0;
+}
+
+int zsl_fus_mahn_q31_feed(struct zsl_vec_q31 *a, struct zsl_vec_q31 *m,
+			  struct zsl_vec_q31 *g, zsl_q31_t *incl,
+			  struct zsl_quat_q31 *q,
+			  struct zsl_fus_mahn_q31_cfg *cfg)
+{
+	int64_t qv[4], av[3], mv[3], wv[3], r[9], v[3], e[3];
+	int64_t bx, bz, fb;
+	int64_t lim = cfg->integral_limit;
+	int rc;
+
+	if (cfg->freq == 0 || cfg->kp < 0 || cfg->ki < 0) {
+		return -EINVAL;
+	}
+
+	rc = zsl_fus_q_check(a, m, g, q);
+	if (rc) {
+		return rc;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	if (cfg->intfb.sz != 3) {
+		return -EINVAL;
+	}
+#endif
+
+	zsl_fus_q_load_quat(q, qv);
+
+	/* Angular velocity, from Q5.26 to Q28. */
+	for (size_t i = 0; i < 3; i++) {
+		wv[i] = (int64_t)g->data[i] * (1 << (ZSL_FUS_Q - ZSL_FIX_GYRO_FRAC));
+	}
+
+	if (a != NULL && zsl_fus_q_load_vec(a, av)) {
+		zsl_fus_q_rot_mtx(qv, r);
+
+		/* Gravity error: a x v, for the vertical 'v' rotated by q. */
+		e[0] = zsl_fus_q_mul(av[1], r[8]) - zsl_fus_q_mul(av[2], r[5]);
+		e[1] = zsl_fus_q_mul(av[2], r[2]) - zsl_fus_q_mul(av[0], r[8]);
+		e[2] = zsl_fus_q_mul(av[0], r[5]) - zsl_fus_q_mul(av[1], r[2]);
+
+		if (m != NULL && zsl_fus_q_load_vec(m, mv)) {
+			zsl_fus_q_mag_ref(r, mv, incl, &bx, &bz);
+
+			/* Magnetic error: m x bf, for the field (bx, 0, bz)
+			 * rotated by q. */
+			for (size_t i = 0; i < 3; i++) {
+				v[i] = zsl_fus_q_mul(bx, r[i * 3]) +
+				       zsl_fus_q_mul(bz, r[i * 3 + 2]);
+			}
+
+			e[0] += zsl_fus_q_mul(mv[1], v[2]) -
+				zsl_fus_q_mul(mv[2], v[1]);
+			e[1] += zsl_fus_q_mul(mv[2], v[0]) -
+				zsl_fus_q_mul(mv[0], v[2]);
+			e[2] += zsl_fus_q_mul(mv[0], v[1]) -
+				zsl_fus_q_mul(mv[1], v[0]);
+		}
+
+		for (size_t i = 0; i < 3; i++) {
+			/* Compute and limit the integral feedback, from e * dt
+			 * in Q28 to Q5.26. */
+			fb = cfg->intfb.data[i] + e[i] / (4 * (int64_t)cfg->freq);
+			fb = fb > lim ? lim : fb < -lim ? -lim : fb;
+			cfg->intfb.data[i] = zsl_q31_sat(fb);
+
+			/* Apply the integral and proportional feedback. */
+			wv[i] += zsl_fus_q_mul(cfg->ki >> (31 - ZSL_FUS_Q),
+					       fb * (1 << (ZSL_FUS_Q -
+							   ZSL_FIX_GYRO_FRAC)));
+			wv[i] += zsl_fus_q_mul(cfg->kp >> (31 - ZSL_FUS_Q), e[i]);
+		}
+	}
+
+	/* Integrate rate of change of the input quaternion using the modified
+	 * angular velocity data from the gyroscope, and normalize the output
+	 * quaternion. */
+	zsl_fus_q_integrate(qv, wv, cfg->freq);
+	zsl_fus_q_store_quat(qv, q);
+
+	return 0;
+}
+
+int zsl_fus_comp_q31_init(uint32_t freq, struct zsl_fus_comp_q31_cfg *cfg)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure that the sample frequency is positive. */
+	if (freq == 0) {
+		return -EINVAL;
+	}
+#endif
+
+	cfg->freq = freq;
+
+	return 0;
+}
+
+int zsl_fus_comp_q31_feed(struct zsl_vec_q31 *a, struct zsl_vec_q31 *m,
+			  struct zsl_vec_q31 *g, struct zsl_quat_q31 *q,
+			  struct zsl_fus_comp_q31_cfg *cfg)
+{
+	int64_t qv[4], av[3], mv[3], wv[3];
+	zsl_q31_t roll, pitch, yaw, sr, cr, sp, cp;
+	struct zsl_quat_q31 q_w, q_am;
+	int64_t nom, den;
+	int rc;
+
+	if (cfg->freq == 0 || cfg->alpha < 0) {
+		return -EINVAL;
+	}
+
+	rc = zsl_fus_q_check(a, m, g, q);
+	if (rc) {
+		return rc;
+	}
+
+	/* Estimate the orientation (q_w) using the angular velocity data from
+	 * the gyroscope. */
+	zsl_fus_q_load_quat(q, qv);
+	for (size_t i = 0; i < 3; i++) {
+		wv[i] = (int64_t)g->data[i] * (1 << (ZSL_FUS_Q - ZSL_FIX_GYRO_FRAC));
+	}
+	zsl_fus_q_integrate(qv, wv, cfg->freq);
+	zsl_fus_q_store_quat(qv, &q_w);
+
+	/* Without valid accelerometer and magnetometer data, the output is
+	 * just q_w. */
+	if (a == NULL || m == NULL || !zsl_fus_q_load_vec(a, av) ||
+	    !zsl_fus_q_load_vec(m, mv)) {
+		*q = q_w;
+		return 0;
+	}
+
+	/* Estimate the orientation (q_am) from the attitude given by the
+	 * acceleration and magnetic field, as zsl_att_from_accelmag does. */
+	roll = zsl_q31_atan2(av[1], av[2]);
+	pitch = zsl_q31_atan2(-av[0], zsl_fix_sqrt_u64((uint64_t)(
+				      av[1] * av[1] + av[2] * av[2])));
+	zsl_q31_sin_cos(roll, &sr, &cr);
+	zsl_q31_sin_cos(pitch, &sp, &cp);
+
+	/* Scale sr, cr, sp and cp to Q28 for the sums of products. */
+	sr >>= 31 - ZSL_FUS_Q;
+	cr >>= 31 - ZSL_FUS_Q;
+	sp >>= 31 - ZSL_FUS_Q;
+	cp >>= 31 - ZSL_FUS_Q;
+	nom = zsl_fus_q_mul(mv[2], sp) - zsl_fus_q_mul(mv[1], cp);
+	den = zsl_fus_q_mul(mv[0], cr) +
+	      zsl_fus_q_mul(sr, zsl_fus_q_mul(mv[1], sp) +
+			    zsl_fus_q_mul(mv[2], cp));
+	yaw = zsl_q31_atan2(nom, den);
+
+	zsl_quat_q31_from_euler(roll, pitch, yaw, &q_am);
+
+	/* The final estimation is a linear interpolation of q_w and q_am. */
+	return zsl_quat_q31_lerp(&q_w, &q_am, cfg->alpha, q);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zsl/orientation/fusion/fusion.h>
+
+int zsl_fus_batch_get(const struct zsl_fus_batch *batch, size_t i,
+		      uint32_t freq, struct zsl_vec *a, struct zsl_vec *m,
+		      struct zsl_vec *g, zsl_real_t *dt)
+{
+	/* Offset of the X value of sample i, and distance between axes. */
+	size_t base = (batch->layout == ZSL_FUS_BATCH_SOA) ? i : i * 3;
+	size_t stride = (batch->layout == ZSL_FUS_BATCH_SOA) ? batch->n : 1;
+
+	if (batch->dt != NULL) {
+		*dt = batch->dt[i];
+		if (!(*dt > 0.0)) {
+			return -EINVAL;
+		}
+	} else {
+		*dt = 1.0 / freq;
+	}
+
+	for (size_t j = 0; j < 3; j++) {
+		if (a != NULL && batch->accel != NULL) {
+			a->data[j] = batch->accel[base + j * stride];
+		}
+		if (m != NULL && batch->mag != NULL) {
+			m->data[j] = batch->mag[base + j * stride];
+		}
+		if (g != NULL && batch->gyro != NULL) {
+			g->data[j] = batch->gyro[base + j * stride];
+		}
+	}
+
+	return 0;
+}
+
+int zsl_fus_feed_batch(struct zsl_fus_drv *drv,
+		       const struct zsl_fus_batch *batch, struct zsl_quat *q,
+		       struct zsl_quat *q_out)
+{
+	int rc = 0;
+	zsl_real_t dt;
+
+	if (drv->feed_batch_handler != NULL) {
+		rc = drv->feed_batch_handler(batch, q, q_out, drv->config);
+		goto err;
+	}
+
+	/* The per-sample feed uses the fixed period set at init. */
+	if (batch->dt != NULL) {
+		rc = -ENOSYS;
+		goto err;
+	}
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+
+	for (size_t i = 0; i < batch->n; i++) {
+		/* feed_handler applies its own sample period, so 'dt' is
+		 * unused. */
+		zsl_fus_batch_get(batch, i, 1, &a, &m, &g, &dt);
+		rc = drv->feed_handler(batch->accel != NULL ? &a : NULL,
+				       batch->mag != NULL ? &m : NULL,
+				       batch->gyro != NULL ? &g : NULL,
+				       batch->incl, q, drv->config);
+		if (rc) {
+			goto err;
+		}
+		if (q_out != NULL) {
+			q_out[i] = *q;
+		}
+	}
+
+err:
+	if (rc && drv->error_handler != NULL) {
+		drv->error_handler(rc);
+	}
+
+	return rc;
+}
@@ -10,15 +10,79 @@
 #include <zsl/orientation/fusion/fusion.h>
 #include <zsl/orientation/fusion/kalman.h>
 
-static uint32_t zsl_fus_kalm_freq;
-static uint32_t zsl_fus_kalm_initialised;
+/*
+ * The filter state is the orientation quaternion and the measurement is the
+ * normalised accelerometer and magnetometer vectors, so every matrix in the
+ * update has a fixed size. The kernels below use plain arrays of these sizes
+ * instead of the generic zsl_mtx functions, which lets the compiler unroll
+ * them and avoids the operand copies zsl_mtx_mult makes.
+ */
+#define ZSL_FUS_KALM_N (4)
+#define ZSL_FUS_KALM_M (6)
+
+/**
+ * @brief Solves S * X = B for the MxN matrix X, where S is the symmetric
+ *        positive definite MxM innovation covariance. S is overwritten with
+ *        its Cholesky factor.
+ */
+static int zsl_fus_kalm_chol_solve(zsl_real_t s[ZSL_FUS_KALM_M][ZSL_FUS_KALM_M],
+				   zsl_real_t b[ZSL_FUS_KALM_M][ZSL_FUS_KALM_N],
+				   zsl_real_t x[ZSL_FUS_KALM_M][ZSL_FUS_KALM_N])
+{
+	zsl_real_t sum;
+
+	/* S = L * Lt, with L stored in the lower triangle of S. */
+	for (size_t j = 0; j < ZSL_FUS_KALM_M; j++) {
+		sum = s[j][j];
+		for (size_t k = 0; k < j; k++) {
+			sum -= s[j][k] * s[j][k];
+		}
+		if (!(sum > 0.0)) {
+			return -ESINGULAR;
+		}
+		s[j][j] = ZSL_SQRT(sum);
+
+		for (size_t i = j + 1; i < ZSL_FUS_KALM_M; i++) {
+			sum = s[i][j];
+			for (size_t k = 0; k < j; k++) {
+				sum -= s[i][k] * s[j][k];
+			}
+			s[i][j] = sum / s[j][j];
+		}
+	}
+
+	/* Forward substitution, L * Y = B. */
+	for (size_t i = 0; i < ZSL_FUS_KALM_M; i++) {
+		for (size_t c = 0; c < ZSL_FUS_KALM_N; c++) {
+			sum = b[i][c];
+			for (size_t k = 0; k < i; k++) {
+				sum -= s[i][k] * x[k][c];
+			}
+			x[i][c] = sum / s[i][i];
+		}
+	}
+
+	/* Back substitution, Lt * X = Y. */
+	for (size_t i = ZSL_FUS_KALM_M; i-- > 0;) {
+		for (size_t c = 0; c < ZSL_FUS_KALM_N; c++) {
+			sum = x[i][c];
+			for (size_t k = i + 1; k < ZSL_FUS_KALM_M; k++) {
+				sum -= s[k][i] * x[k][c];
+			}
+			x[i][c] = sum / s[i][i];
+		}
+	}
+
+	return 0;
+}
 
 static int zsl_fus_kalman(struct zsl_vec *g, struct zsl_vec *a,
 			  struct zsl_vec *m, zsl_real_t *var_g, zsl_real_t *var_a,
 			  zsl_real_t *var_m, zsl_real_t *incl, struct zsl_mtx *P,
-			  struct zsl_quat *q)
+			  zsl_real_t dt, struct zsl_quat *q)
 {
 	int rc = 0;
+	zsl_real_t sum;
 
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	if (a == NULL || a->sz != 3 || m == NULL || m->sz != 3 || g == NULL ||
@@ -26,55 +90,69 @@ static int zsl_fus_kalman(struct zsl_vec *g, struct zsl_vec *a,
 		rc = -EINVAL;
 		goto err;
 	}
+	/* Make sure that the covariance matrix P is 4x4. */
+	if (P->sz_rows != ZSL_FUS_KALM_N || P->sz_cols != ZSL_FUS_KALM_N) {
+		rc = -EINVAL;
+		goto err;
+	}
 #endif
 
+	/* P is stored row-major, and is symmetric. */
+	zsl_real_t (*p)[ZSL_FUS_KALM_N] = (zsl_real_t (*)[ZSL_FUS_KALM_N])P->data;
+
 	/* PREDICTION STEP. */
 
 	/* Useful constant to reduce the code. */
-	zsl_real_t if2 = 1.0 / (2.0 * zsl_fus_kalm_freq);
-
-	/* Calculate the matrix F and its transpose. */
-	ZSL_MATRIX_DEF(F, 4, 4);
-	ZSL_MATRIX_DEF(Ft, 4, 4);
-
-	zsl_real_t F_data[16] = {
-		1.0, -if2 * g->data[0], -if2 * g->data[1], -if2 * g->data[2],
-		if2 * g->data[0], 1.0, if2 * g->data[2], -if2 * g->data[1],
-		if2 * g->data[1], -if2 * g->data[2], 1.0, if2 * g->data[0],
-		if2 * g->data[2], if2 * g->data[1], -if2 * g->data[0], 1.0,
+	zsl_real_t if2 = dt / 2.0;
+
+	/* Calculate the state transition matrix F. */
+	zsl_real_t F[ZSL_FUS_KALM_N][ZSL_FUS_KALM_N] = {
+		{ 1.0, -if2 * g->data[0], -if2 * g->data[1], -if2 * g->data[2] },
+		{ if2 * g->data[0], 1.0, if2 * g->data[2], -if2 * g->data[1] },
+		{ if2 * g->data[1], -if2 * g->data[2], 1.0, if2 * g->data[0] },
+		{ if2 * g->data[2], if2 * g->data[1], -if2 * g->data[0], 1.0 },
 	};
 
-	zsl_mtx_from_arr(&F, F_data);
-	zsl_mtx_trans(&F, &Ft);
-
-	/* Calculate the matrix W and its transpose. */
-	ZSL_MATRIX_DEF(W, 4, 3);
-	ZSL_MATRIX_DEF(Wt, 3, 4);
-
-	zsl_real_t W_data[12] = {
-		-q->i, -q->j, -q->k,
-		q->r, -q->k,  q->j,
-		q->k,  q->r, -q->i,
-		-q->j,  q->i,  q->r
+	/* Calculate the matrix W, which maps the gyroscope noise to the
+	 * state. The process noise is Q = var_g * if2^2 * W * Wt. */
+	zsl_real_t W[ZSL_FUS_KALM_N][3] = {
+		{ -q->i, -q->j, -q->k },
+		{ q->r, -q->k,  q->j },
+		{ q->k,  q->r, -q->i },
+		{ -q->j,  q->i,  q->r },
 	};
+	zsl_real_t qs = *var_g * if2 * if2;
+
+	/* Calculate P = F * P * Ft + Q. Both terms are symmetric, so only the
+	 * upper triangle is computed and then mirrored. */
+	zsl_real_t FP[ZSL_FUS_KALM_N][ZSL_FUS_KALM_N];
+
+	for (size_t i = 0; i < ZSL_FUS_KALM_N; i++) {
+		for (size_t j = 0; j < ZSL_FUS_KALM_N; j++) {
+			sum = 0.0;
+			for (size_t k = 0; k < ZSL_FUS_KALM_N; k++) {
+				sum += F[i][k] * p[k][j];
+			}
+			FP[i][j] = sum;
+		}
+	}
 
-	zsl_mtx_from_arr(&W, W_data);
-	zsl_mtx_trans(&W, &Wt);
-
-	/* Calculate the matrix Q. */
-	ZSL_MATRIX_DEF(Q, 4, 4);
-	zsl_mtx_mult(&W, &Wt, &Q);
-	zsl_mtx_scalar_mult_d(&Q, *var_g * if2 * if2);
-
-	/* Calculate the matrix P. */
-	ZSL_MATRIX_DEF(FP, 4, 4);
-	zsl_mtx_mult(&F, P, &FP);
-	zsl_mtx_mult(&FP, &Ft, P);
-	zsl_mtx_add_d(P, &Q);
+	for (size_t i = 0; i < ZSL_FUS_KALM_N; i++) {
+		for (size_t j = i; j < ZSL_FUS_KALM_N; j++) {
+			sum = 0.0;
+			for (size_t k = 0; k < ZSL_FUS_KALM_N; k++) {
+				sum += FP[i][k] * F[j][k];
+			}
+			sum += qs * (W[i][0] * W[j][0] + W[i][1] * W[j][1] +
+				     W[i][2] * W[j][2]);
+			p[i][j] = sum;
+			p[j][i] = sum;
+		}
+	}
 
 	/* Calculate an estimation of the orientation using only the data of the
 	 * gyroscope and quaternion integration. */
-	zsl_quat_from_ang_vel(g, q, 1.0 / zsl_fus_kalm_freq, q);
+	zsl_quat_from_ang_vel(g, q, dt, q);
 
 	/* CORRECTION STEP. */
 
@@ -82,15 +160,6 @@ static int zsl_fus_kalman(struct zsl_vec *g, struct zsl_vec *a,
 	zsl_vec_to_unit(a);
 	zsl_vec_to_unit(m);
 
-	/* Define the measurement vector 'z'. */
-	ZSL_MATRIX_DEF(z, 6, 1);
-	z.data[0] = a->data[0];
-	z.data[1] = a->data[1];
-	z.data[2] = a->data[2];
-	z.data[3] = m->data[0];
-	z.data[4] = m->data[1];
-	z.data[5] = m->data[2];
-
 	/* Turn the data of the magnetometer into a pure quaterion. */
 	struct zsl_quat qm = {
 		.r = 0.0,
@@ -116,98 +185,116 @@ static int zsl_fus_kalman(struct zsl_vec *g, struct zsl_vec *a,
 	zsl_quat_to_unit_d(&mg);
 
 	/* Calculate the measurement model, h. To do this, use the predicted
-	 * orientation 'q' to rotate the quaternions 'grav' and 'magn'. */
-	ZSL_MATRIX_DEF(h, 6, 1);
+	 * orientation 'q' to rotate the quaternions 'grav' and 'magn'. The
+	 * innovation is v = z - h, where the measurement vector z holds the
+	 * accelerometer and magnetometer data. */
 	struct zsl_quat a2;
 	struct zsl_quat m2;
 
 	zsl_quat_rot(q, &gv, &a2);
 	zsl_quat_rot(q, &mg, &m2);
 
-	h.data[0] = 2.0 * a2.i;
-	h.data[1] = 2.0 * a2.j;
-	h.data[2] = 2.0 * a2.k;
-	h.data[3] = 2.0 * m2.i;
-	h.data[4] = 2.0 * m2.j;
-	h.data[5] = 2.0 * m2.k;
-
-	/* Calculate H, which is the Jacobian matrix of h. Calculate its
-	 * transpose too. */
-	ZSL_MATRIX_DEF(H, 6, 4);
-	ZSL_MATRIX_DEF(Ht, 4, 6);
+	zsl_real_t v[ZSL_FUS_KALM_M] = {
+		a->data[0] - 2.0 * a2.i,
+		a->data[1] - 2.0 * a2.j,
+		a->data[2] - 2.0 * a2.k,
+		m->data[0] - 2.0 * m2.i,
+		m->data[1] - 2.0 * m2.j,
+		m->data[2] - 2.0 * m2.k,
+	};
 
-	zsl_real_t H_data[24] = {
+	/* Calculate H, which is the Jacobian matrix of h. */
+	zsl_real_t H[ZSL_FUS_KALM_M][ZSL_FUS_KALM_N] = {
 		/* Fisrt 3 rows of the H matrix. */
-		q->j, -q->k, q->r, -q->i,
-		-q->i, -q->r, -q->k, -q->j,
-		0.0, 2.0 * q->i, 2.0 * q->j, 0.0,
+		{ q->j, -q->k, q->r, -q->i },
+		{ -q->i, -q->r, -q->k, -q->j },
+		{ 0.0, 2.0 * q->i, 2.0 * q->j, 0.0 },
 
 		/* Fourth row of the H matrix. */
-		-mg.k * q->j, mg.k * q->k, -2.0 * mg.i * q->j - mg.k * q->r,
-		-2.0 * mg.i * q->k + mg.k * q->i,
+		{ -mg.k * q->j, mg.k * q->k, -2.0 * mg.i * q->j - mg.k * q->r,
+		  -2.0 * mg.i * q->k + mg.k * q->i },
 
 		/* Fifth row of the H matrix. */
-		-mg.i * q->k + mg.k * q->i,  mg.i * q->j + mg.k * q->r,
-		mg.i * q->i + mg.k * q->k, -mg.i * q->r + mg.k * q->j,
+		{ -mg.i * q->k + mg.k * q->i,  mg.i * q->j + mg.k * q->r,
+		  mg.i * q->i + mg.k * q->k, -mg.i * q->r + mg.k * q->j },
 
 		/* Sixth row of the H matrix. */
-		mg.i * q->j, mg.i * q->k - 2.0 * mg.k * q->i,
-		mg.i * q->r - 2.0 * mg.k * q->j, mg.i * q->i
+		{ mg.i * q->j, mg.i * q->k - 2.0 * mg.k * q->i,
+		  mg.i * q->r - 2.0 * mg.k * q->j, mg.i * q->i },
 	};
 
-	zsl_mtx_from_arr(&H, H_data);
-	zsl_mtx_scalar_mult_d(&H, 2.0);
-	zsl_mtx_trans(&H, &Ht);
-
-	/* Define the R matrix with the variance of the accelerometer
-	 * and magnetometer. */
-	ZSL_MATRIX_DEF(R, 6, 6);
-	zsl_mtx_init(&R, zsl_mtx_entry_fn_identity);
-	zsl_mtx_set(&R, 0, 0, *var_a);
-	zsl_mtx_set(&R, 1, 1, *var_a);
-	zsl_mtx_set(&R, 2, 2, *var_a);
-	zsl_mtx_set(&R, 3, 3, *var_m);
-	zsl_mtx_set(&R, 4, 4, *var_m);
-	zsl_mtx_set(&R, 5, 5, *var_m);
-
-	/* Define the vector v, the matrix S and the matrix K. */
-	ZSL_MATRIX_DEF(v, 6, 1);
-	ZSL_MATRIX_DEF(S, 6, 6);
-	ZSL_MATRIX_DEF(K, 4, 6);
-
-	/* Calculation of v. */
-	zsl_mtx_sub(&z, &h, &v);
-
-	/* Calculation of S. */
-	ZSL_MATRIX_DEF(HP, 6, 4);
-	ZSL_MATRIX_DEF(HPHt, 6, 6);
-	zsl_mtx_mult(&H, P, &HP);
-	zsl_mtx_mult(&HP, &Ht, &HPHt);
-	zsl_mtx_add(&HPHt, &R, &S);
-
-	/* Calculation of K. */
-	ZSL_MATRIX_DEF(S_inv, 6, 6);
-	ZSL_MATRIX_DEF(PHt, 4, 6);
-	zsl_mtx_inv(&S, &S_inv);
-	zsl_mtx_mult(P, &Ht, &PHt);
-	zsl_mtx_mult(&PHt, &S_inv, &K);
-
-	/* Calculate the corrected matrix P. */
-	ZSL_MATRIX_DEF(idx, 4, 4);
-	ZSL_MATRIX_DEF(KH, 4, 4);
-	zsl_mtx_init(&idx, zsl_mtx_entry_fn_identity);
-	zsl_mtx_mult(&K, &H, &KH);
-	zsl_mtx_sub_d(&idx, &KH);
-	zsl_mtx_mult(&idx, P, P);
-
-	/* Calculate the corrected orientation quaternion q. */
-	ZSL_MATRIX_DEF(Kv, 4, 1);
-	zsl_mtx_mult(&K, &v, &Kv);
-
-	q->r += Kv.data[0];
-	q->i += Kv.data[1];
-	q->j += Kv.data[2];
-	q->k += Kv.data[3];
+	for (size_t i = 0; i < ZSL_FUS_KALM_M; i++) {
+		for (size_t j = 0; j < ZSL_FUS_KALM_N; j++) {
+			H[i][j] *= 2.0;
+		}
+	}
+
+	/* Calculate H * P, which is also the transpose of P * Ht. */
+	zsl_real_t HP[ZSL_FUS_KALM_M][ZSL_FUS_KALM_N];
+
+	for (size_t i = 0; i < ZSL_FUS_KALM_M; i++) {
+		for (size_t j = 0; j < ZSL_FUS_KALM_N; j++) {
+			sum = 0.0;
+			for (size_t k = 0; k < ZSL_FUS_KALM_N; k++) {
+				sum += H[i][k] * p[k][j];
+			}
+			HP[i][j] = sum;
+		}
+	}
+
+	/* Calculate the innovation covariance S = H * P * Ht + R, where R is
+	 * diagonal and holds the variance of the accelerometer and
+	 * magnetometer. */
+	zsl_real_t S[ZSL_FUS_KALM_M][ZSL_FUS_KALM_M];
+
+	for (size_t i = 0; i < ZSL_FUS_KALM_M; i++) {
+		for (size_t j = i; j < ZSL_FUS_KALM_M; j++) {
+			sum = 0.0;
+			for (size_t k = 0; k < ZSL_FUS_KALM_N; k++) {
+				sum += HP[i][k] * H[j][k];
+			}
+			S[i][j] = sum;
+			S[j][i] = sum;
+		}
+		S[i][i] += (i < 3) ? *var_a : *var_m;
+	}
+
+	/* Calculate the gain K = P * Ht * S^-1. Since S is symmetric positive
+	 * definite, the transpose of K is the solution of S * Kt = H * P, which
+	 * is found with a Cholesky factorisation of S. */
+	zsl_real_t Kt[ZSL_FUS_KALM_M][ZSL_FUS_KALM_N];
+
+	rc = zsl_fus_kalm_chol_solve(S, HP, Kt);
+	if (rc) {
+		goto err;
+	}
+
+	/* Calculate the corrected matrix P = (I - K * H) * P = P - K * H * P,
+	 * which is symmetric. */
+	for (size_t i = 0; i < ZSL_FUS_KALM_N; i++) {
+		for (size_t j = i; j < ZSL_FUS_KALM_N; j++) {
+			sum = p[i][j];
+			for (size_t k = 0; k < ZSL_FUS_KALM_M; k++) {
+				sum -= Kt[k][i] * HP[k][j];
+			}
+			p[i][j] = sum;
+			p[j][i] = sum;
+		}
+	}
+
+	/* Calculate the corrected orientation quaternion q = q + K * v. */
+	zsl_real_t Kv[ZSL_FUS_KALM_N] = { 0.0, 0.0, 0.0, 0.0 };
+
+	for (size_t k = 0; k < ZSL_FUS_KALM_M; k++) {
+		for (size_t i = 0; i < ZSL_FUS_KALM_N; i++) {
+			Kv[i] += Kt[k][i] * v[k];
+		}
+	}
+
+	q->r += Kv[0];
+	q->i += Kv[1];
+	q->j += Kv[2];
+	q->k += Kv[3];
 
 	/* Normalize the output quaternion. */
 	zsl_quat_to_unit_d(q);
@@ -254,9 +341,6 @@ static int zsl_fus_kalm_quat_init(struct zsl_vec *a, struct zsl_vec *m,
 	zsl_quat_from_rot_mtx(&mtx, q);
 	zsl_quat_to_unit_d(q);
 
-	/* Inidicate that we have already called this function. */
-	zsl_fus_kalm_initialised = 1;
-
 err:
 	return rc;
 }
@@ -275,9 +359,6 @@ static int zsl_fus_kalm_P_init(struct zsl_mtx *P)
 
 	zsl_mtx_init(P, zsl_mtx_entry_fn_identity);
 
-	/* Inidicate that we have already called this function. */
-	zsl_fus_kalm_initialised = 1;
-
 err:
 	return rc;
 }
@@ -288,8 +369,6 @@ int zsl_fus_kalm_init(uint32_t freq, void *cfg)
 
 	struct zsl_fus_kalm_cfg *mcfg = cfg;
 
-	(void)mcfg;
-
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure that the sample frequency is positive. */
 	if (freq <= 0.0) {
@@ -298,7 +377,8 @@ int zsl_fus_kalm_init(uint32_t freq, void *cfg)
 	}
 #endif
 
-	zsl_fus_kalm_freq = freq;
+	mcfg->freq = freq;
+	mcfg->initialised = false;
 
 err:
 	return rc;
@@ -309,18 +389,70 @@ int zsl_fus_kalm_feed(struct zsl_vec *a, struct zsl_vec *m, struct zsl_vec *g,
 {
 	struct zsl_fus_kalm_cfg *mcfg = cfg;
 
-	if (mcfg->var_g < 0.0 || mcfg->var_a < 0.0 || mcfg->var_m < 0.0) {
+	if (mcfg->freq == 0 || mcfg->var_g < 0.0 || mcfg->var_a < 0.0 ||
+	    mcfg->var_m < 0.0) {
 		return -EINVAL;
 	}
 
-	/* This functions should only be called once. */
-	if (!zsl_fus_kalm_initialised) {
+	/* Seed q and P from the first sample fed after init. */
+	if (!mcfg->initialised) {
 		zsl_fus_kalm_quat_init(a, m, q);
 		zsl_fus_kalm_P_init(&(mcfg->P));
+		mcfg->initialised = true;
 	}
 
 	return zsl_fus_kalman(g, a, m, &(mcfg->var_g), &(mcfg->var_a),
-			      &(mcfg->var_m), incl, &(mcfg->P), q);
+			      &(mcfg->var_m), incl, &(mcfg->P),
+			      1.0 / mcfg->freq, q);
+}
+
+int zsl_fus_kalm_feed_batch(const struct zsl_fus_batch *batch,
+			    struct zsl_quat *q, struct zsl_quat *q_out,
+			    void *cfg)
+{
+	int rc = 0;
+	zsl_real_t dt;
+	struct zsl_fus_kalm_cfg *mcfg = cfg;
+
+	if (mcfg->freq == 0 || mcfg->var_g < 0.0 || mcfg->var_a < 0.0 ||
+	    mcfg->var_m < 0.0) {
+		return -EINVAL;
+	}
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+
+	for (size_t i = 0; i < batch->n; i++) {
+		rc = zsl_fus_batch_get(batch, i, mcfg->freq, &a, &m, &g, &dt);
+		if (rc) {
+			return rc;
+		}
+
+		struct zsl_vec *ap = batch->accel != NULL ? &a : NULL;
+		struct zsl_vec *mp = batch->mag != NULL ? &m : NULL;
+		struct zsl_vec *gp = batch->gyro != NULL ? &g : NULL;
+
+		/* Seed q and P from the first sample fed after init. */
+		if (!mcfg->initialised) {
+			zsl_fus_kalm_quat_init(ap, mp, q);
+			zsl_fus_kalm_P_init(&(mcfg->P));
+			mcfg->initialised = true;
+		}
+
+		rc = zsl_fus_kalman(gp, ap, mp, &(mcfg->var_g), &(mcfg->var_a),
+				    &(mcfg->var_m), batch->incl, &(mcfg->P), dt,
+				    q);
+		if (rc) {
+			return rc;
+		}
+
+		if (q_out != NULL) {
+			q_out[i] = *q;
+		}
+	}
+
+	return rc;
 }
 
 void zsl_fus_kalm_error(int error)
@@ -8,12 +8,17 @@
 #include <math.h>
 #include <errno.h>
 #include <zsl/orientation/fusion/fusion.h>
+#include <zsl/fastmath.h>
 #include <zsl/orientation/fusion/madgwick.h>
 
-static uint32_t zsl_fus_madg_freq;
+/* Enable optimised x86-64 SSE2/AVX functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+#include <zsl/asm/x86/asm_x86_fusion.h>
+#endif
 
 static int zsl_fus_madgwick_imu(struct zsl_vec *g, struct zsl_vec *a,
-				zsl_real_t *beta, zsl_real_t *incl, struct zsl_quat *q)
+				zsl_real_t *beta, zsl_real_t dt, zsl_real_t *incl,
+				struct zsl_quat *q)
 {
 	int rc = 0;
 
@@ -87,16 +92,18 @@ static int zsl_fus_madgwick_imu(struct zsl_vec *g, struct zsl_vec *a,
 	}
 
 	/* Update the input quaternion with a modified quaternion integration. */
-	zsl_quat_from_ang_vel(g, q, 1.0 / zsl_fus_madg_freq, q);
-	q->r -= (1.0 / zsl_fus_madg_freq) * (*beta * grad.data[0]);
-	q->i -= (1.0 / zsl_fus_madg_freq) * (*beta * grad.data[1]);
-	q->j -= (1.0 / zsl_fus_madg_freq) * (*beta * grad.data[2]);
-	q->k -= (1.0 / zsl_fus_madg_freq) * (*beta * grad.data[3]);
+	zsl_quat_from_ang_vel(g, q, dt, q);
+	q->r -= dt * (*beta * grad.data[0]);
+	q->i -= dt * (*beta * grad.data[1]);
+	q->j -= dt * (*beta * grad.data[2]);
+	q->k -= dt * (*beta * grad.data[3]);
 
 	/* Normalize the output quaternion. */
 	zsl_quat_to_unit_d(q);
 
+#if CONFIG_ZSL_BOUNDS_CHECKS
 err:
+#endif
 	return rc;
 }
 
@@ -107,13 +114,15 @@ err:
  * @param a
  * @param m
  * @param beta
+ * @param dt
+ * @param incl
  * @param q
  *
  * @return int
  */
 static int zsl_fus_madgwick(struct zsl_vec *g, struct zsl_vec *a,
-			    struct zsl_vec *m, zsl_real_t *beta, zsl_real_t *incl,
-			    struct zsl_quat *q)
+			    struct zsl_vec *m, zsl_real_t *beta, zsl_real_t dt,
+			    zsl_real_t *incl, struct zsl_quat *q)
 {
 	int rc = 0;
 
@@ -133,7 +142,7 @@ static int zsl_fus_madgwick(struct zsl_vec *g, struct zsl_vec *a,
 
 	/* Use IMU algorithm if the magnetometer measurement is invalid. */
 	if ((m == NULL) || (ZSL_ABS(zsl_vec_norm(m)) < 1E-6)) {
-		return zsl_fus_madgwick_imu(g, a, beta, incl, q);
+		return zsl_fus_madgwick_imu(g, a, beta, dt, incl, q);
 	}
 
 	/* Convert the input quaternion to a unit quaternion. */
@@ -267,16 +276,18 @@ static int zsl_fus_madgwick(struct zsl_vec *g, struct zsl_vec *a,
 	}
 
 	/* Update the input quaternion with a modified quaternion integration. */
-	zsl_quat_from_ang_vel(g, q, 1.0 / zsl_fus_madg_freq, q);
-	q->r -= (1.0 / zsl_fus_madg_freq) * (*beta * grad.data[0]);
-	q->i -= (1.0 / zsl_fus_madg_freq) * (*beta * grad.data[1]);
-	q->j -= (1.0 / zsl_fus_madg_freq) * (*beta * grad.data[2]);
-	q->k -= (1.0 / zsl_fus_madg_freq) * (*beta * grad.data[3]);
+	zsl_quat_from_ang_vel(g, q, dt, q);
+	q->r -= dt * (*beta * grad.data[0]);
+	q->i -= dt * (*beta * grad.data[1]);
+	q->j -= dt * (*beta * grad.data[2]);
+	q->k -= dt * (*beta * grad.data[3]);
 
 	/* Normalize the output quaternion. */
 	zsl_quat_to_unit_d(q);
 
+#if CONFIG_ZSL_BOUNDS_CHECKS
 err:
+#endif
 	return rc;
 }
 
@@ -286,8 +297,6 @@ int zsl_fus_madg_init(uint32_t freq, void *cfg)
 
 	struct zsl_fus_madg_cfg *mcfg = cfg;
 
-	(void)mcfg;
-
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure that the sample frequency is positive. */
 	if (freq <= 0) {
@@ -296,9 +305,11 @@ int zsl_fus_madg_init(uint32_t freq, void *cfg)
 	}
 #endif
 
-	zsl_fus_madg_freq = freq;
+	mcfg->freq = freq;
 
+#if CONFIG_ZSL_BOUNDS_CHECKS
 err:
+#endif
 	return rc;
 }
 
@@ -307,11 +318,232 @@ int zsl_fus_madg_feed(struct zsl_vec *a, struct zsl_vec *m, struct zsl_vec *g,
 {
 	struct zsl_fus_madg_cfg *mcfg = cfg;
 
-	if (mcfg->beta < 0.0) {
+	if (mcfg->freq == 0 || mcfg->beta < 0.0) {
+		return -EINVAL;
+	}
+
+	return zsl_fus_madgwick(g, a, m, &(mcfg->beta), 1.0 / mcfg->freq,
+				incl, q);
+}
+
+int zsl_fus_madg_feed_batch(const struct zsl_fus_batch *batch,
+			    struct zsl_quat *q, struct zsl_quat *q_out,
+			    void *cfg)
+{
+	int rc = 0;
+	zsl_real_t dt;
+	struct zsl_fus_madg_cfg *mcfg = cfg;
+
+	if (mcfg->freq == 0 || mcfg->beta < 0.0) {
+		return -EINVAL;
+	}
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+
+	for (size_t i = 0; i < batch->n; i++) {
+		rc = zsl_fus_batch_get(batch, i, mcfg->freq, &a, &m, &g, &dt);
+		if (rc) {
+			return rc;
+		}
+
+		rc = zsl_fus_madgwick(batch->gyro != NULL ? &g : NULL,
+				      batch->accel != NULL ? &a : NULL,
+				      batch->mag != NULL ? &m : NULL,
+				      &(mcfg->beta), dt, batch->incl, q);
+		if (rc) {
+			return rc;
+		}
+
+		if (q_out != NULL) {
+			q_out[i] = *q;
+		}
+	}
+
+	return rc;
+}
+
+/**
+ * Updates filter 'l' of a call to zsl_fus_madg_feed_multi. This is the same
+ * computation as zsl_fus_madgwick, with the quaternion products expanded and
+ * the rotation matrix of the orientation shared between them. 'bx' and 'bz'
+ * are only used if 'incl' is true.
+ */
+static void zsl_fus_madg_lane(size_t l, const struct zsl_fus_vec_soa *a,
+			      const struct zsl_fus_vec_soa *m,
+			      const struct zsl_fus_vec_soa *g, bool incl,
+			      zsl_real_t bx, zsl_real_t bz, zsl_real_t beta,
+			      zsl_real_t dt, struct zsl_fus_quat_soa *q)
+{
+	zsl_real_t qr, qi, qj, qk, n;
+	zsl_real_t ax, ay, az, mx, my, mz;
+	zsl_real_t f0, f1, f2;
+	zsl_real_t s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+	zsl_real_t r[9];
+
+	/* Convert the input quaternion to a unit quaternion. */
+	n = ZSL_FAST_RSQRT(q->r[l] * q->r[l] + q->i[l] * q->i[l] +
+			   q->j[l] * q->j[l] + q->k[l] * q->k[l]);
+	qr = q->r[l] * n;
+	qi = q->i[l] * n;
+	qj = q->j[l] * n;
+	qk = q->k[l] * n;
+
+	if (a != NULL) {
+		ax = a->x[l];
+		ay = a->y[l];
+		az = a->z[l];
+		n = ax * ax + ay * ay + az * az;
+	} else {
+		n = 0.0;
+	}
+
+	/* Skip samples with a magnitude of 1E-6 or less. */
+	if (n > 1E-12) {
+		n = ZSL_FAST_RSQRT(n);
+		ax *= n;
+		ay *= n;
+		az *= n;
+
+		/* Rotation matrix of the orientation, row by row. */
+		r[0] = qr * qr + qi * qi - qj * qj - qk * qk;
+		r[1] = 2.0 * (qi * qj - qr * qk);
+		r[2] = 2.0 * (qi * qk + qr * qj);
+		r[3] = 2.0 * (qi * qj + qr * qk);
+		r[4] = qr * qr - qi * qi + qj * qj - qk * qk;
+		r[5] = 2.0 * (qj * qk - qr * qi);
+		r[6] = 2.0 * (qi * qk - qr * qj);
+		r[7] = 2.0 * (qj * qk + qr * qi);
+		r[8] = qr * qr - qi * qi - qj * qj + qk * qk;
+
+		/* Gradient of f_g, for the vertical rotated by q. */
+		f0 = r[2] - ax;
+		f1 = r[5] - ay;
+		f2 = r[8] - az;
+		s0 = -2.0 * qj * f0 + 2.0 * qi * f1;
+		s1 = 2.0 * qk * f0 + 2.0 * qr * f1 - 4.0 * qi * f2;
+		s2 = -2.0 * qr * f0 + 2.0 * qk * f1 - 4.0 * qj * f2;
+		s3 = 2.0 * qi * f0 + 2.0 * qj * f1;
+
+		if (m != NULL) {
+			mx = m->x[l];
+			my = m->y[l];
+			mz = m->z[l];
+			n = mx * mx + my * my + mz * mz;
+		} else {
+			n = 0.0;
+		}
+
+		if (n >= 1E-12) {
+			n = ZSL_FAST_RSQRT(n);
+			mx *= n;
+			my *= n;
+			mz *= n;
+
+			if (!incl) {
+				f0 = r[0] * mx + r[1] * my + r[2] * mz;
+				f1 = r[3] * mx + r[4] * my + r[5] * mz;
+				bx = ZSL_SQRT(f0 * f0 + f1 * f1);
+				bz = r[6] * mx + r[7] * my + r[8] * mz;
+			}
+
+			/* Gradient of f_b, for the field (bx, 0, bz) rotated by q. */
+			f0 = bx * r[0] + bz * r[2] - mx;
+			f1 = bx * r[3] + bz * r[5] - my;
+			f2 = bx * r[6] + bz * r[8] - mz;
+			s0 += -2.0 * bz * qj * f0 +
+			      (-2.0 * bx * qk + 2.0 * bz * qi) * f1 +
+			      2.0 * bx * qj * f2;
+			s1 += 2.0 * bz * qk * f0 +
+			      (2.0 * bz * qj + 2.0 * bz * qr) * f1 +
+			      (2.0 * bx * qk - 4.0 * bz * qi) * f2;
+			s2 += (-4.0 * bx * qj - 2.0 * bz * qr) * f0 +
+			      (2.0 * bx * qi - 2.0 * bz * qk) * f1 +
+			      (2.0 * bx * qr - 2.0 * bz * qj) * f2;
+			s3 += (-4.0 * bx * qk + 2.0 * bz * qi) * f0 +
+			      (-2.0 * bx * qr + 2.0 * bz * qj) * f1 +
+			      2.0 * bx * qi * f2;
+		}
+
+		/* Normalize the gradient, as zsl_vec_to_unit does. */
+		n = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+		if (n != 0.0) {
+			n = ZSL_FAST_RSQRT(n);
+			s0 *= n;
+			s1 *= n;
+			s2 *= n;
+			s3 *= n;
+		} else {
+			s0 = 1.0;
+		}
+	}
+
+	/* Integrate the angular velocity, as zsl_quat_from_ang_vel does. */
+	f0 = 0.5 * dt;
+	ax = qr + f0 * (-g->x[l] * qi - g->y[l] * qj - g->z[l] * qk);
+	ay = qi + f0 * (g->x[l] * qr + g->y[l] * qk - g->z[l] * qj);
+	az = qj + f0 * (-g->x[l] * qk + g->y[l] * qr + g->z[l] * qi);
+	mx = qk + f0 * (g->x[l] * qj - g->y[l] * qi + g->z[l] * qr);
+	n = ZSL_FAST_RSQRT(ax * ax + ay * ay + az * az + mx * mx);
+
+	/* Apply the gradient descent step and normalize the output. */
+	f1 = dt * beta;
+	qr = ax * n - f1 * s0;
+	qi = ay * n - f1 * s1;
+	qj = az * n - f1 * s2;
+	qk = mx * n - f1 * s3;
+	n = ZSL_FAST_RSQRT(qr * qr + qi * qi + qj * qj + qk * qk);
+	q->r[l] = qr * n;
+	q->i[l] = qi * n;
+	q->j[l] = qj * n;
+	q->k[l] = qk * n;
+}
+
+int zsl_fus_madg_feed_multi(size_t n, const struct zsl_fus_vec_soa *a,
+			    const struct zsl_fus_vec_soa *m,
+			    const struct zsl_fus_vec_soa *g, zsl_real_t *incl,
+			    struct zsl_fus_quat_soa *q,
+			    struct zsl_fus_madg_cfg *cfg)
+{
+	zsl_real_t bx = 0.0, bz = 0.0;
+	zsl_real_t dt;
+	size_t l = 0;
+
+	if (cfg->freq == 0 || cfg->beta < 0.0 || g == NULL) {
 		return -EINVAL;
 	}
 
-	return zsl_fus_madgwick(g, a, m, &(mcfg->beta), incl, q);
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure that none of the input quaternions is zero. */
+	for (size_t i = 0; i < n; i++) {
+		if (ZSL_SQRT(q->r[i] * q->r[i] + q->i[i] * q->i[i] +
+			     q->j[i] * q->j[i] + q->k[i] * q->k[i]) < 1E-6) {
+			return -EINVAL;
+		}
+	}
+#endif
+
+	dt = 1.0 / cfg->freq;
+
+	if (incl != NULL) {
+		bx = ZSL_COS(*incl * ZSL_PI / 180.0);
+		bz = ZSL_SIN(*incl * ZSL_PI / 180.0);
+	}
+
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+	for (; l + ZSL_X86_W <= n; l += ZSL_X86_W) {
+		zsl_x86_fus_madg(l, a, m, g, incl != NULL, bx, bz, cfg->beta, dt,
+				 q);
+	}
+#endif
+
+	for (; l < n; l++) {
+		zsl_fus_madg_lane(l, a, m, g, incl != NULL, bx, bz, cfg->beta, dt,
+				  q);
+	}
+
+	return 0;
 }
 
 void zsl_fus_madg_error(int error)
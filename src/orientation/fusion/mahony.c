@@ -8,14 +8,19 @@
 #include <math.h>
 #include <errno.h>
 #include <zsl/orientation/fusion/fusion.h>
+#include <zsl/fastmath.h>
 #include <zsl/orientation/fusion/mahony.h>
 
-static uint32_t zsl_fus_mahn_freq;
+/* Enable optimised x86-64 SSE2/AVX functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+#include <zsl/asm/x86/asm_x86_fusion.h>
+#endif
 
 static int zsl_fus_mahony_imu(struct zsl_vec *g, struct zsl_vec *a,
 			      zsl_real_t *Kp, zsl_real_t *Ki,
 			      struct zsl_vec *integralFB, 
 				  zsl_real_t integral_limit,
+				  zsl_real_t dt,
 				  zsl_real_t *incl,
 			      struct zsl_quat *q)
 {
@@ -66,9 +71,9 @@ static int zsl_fus_mahony_imu(struct zsl_vec *g, struct zsl_vec *a,
 		zsl_vec_cross(a, &v, &e);
 
 		/* Compute integral feedback. */
-		integralFB->data[0] += e.data[0] * (1.0 / zsl_fus_mahn_freq);
-		integralFB->data[1] += e.data[1] * (1.0 / zsl_fus_mahn_freq);
-		integralFB->data[2] += e.data[2] * (1.0 / zsl_fus_mahn_freq);
+		integralFB->data[0] += e.data[0] * dt;
+		integralFB->data[1] += e.data[1] * dt;
+		integralFB->data[2] += e.data[2] * dt;
 
 		/* Limit integral values */
 		if(integralFB->data[0] > integral_limit) {
@@ -102,19 +107,22 @@ static int zsl_fus_mahony_imu(struct zsl_vec *g, struct zsl_vec *a,
 
 	/* Integrate rate of change of the input quaternion using the modified
 	 * angular velocity data from the gyroscope. */
-	zsl_quat_from_ang_vel(g, q, 1.0 / zsl_fus_mahn_freq, q);
+	zsl_quat_from_ang_vel(g, q, dt, q);
 
 	/* Normalize the output quaternion. */
 	zsl_quat_to_unit_d(q);
 
+#if CONFIG_ZSL_BOUNDS_CHECKS
 err:
+#endif
 	return rc;
 }
 
 static int zsl_fus_mahony(struct zsl_vec *g, struct zsl_vec *a,
 			  struct zsl_vec *m, zsl_real_t *Kp, zsl_real_t *Ki,
 			  struct zsl_vec *integralFB,
-			  zsl_real_t integral_limit, zsl_real_t *incl, struct zsl_quat *q)
+			  zsl_real_t integral_limit, zsl_real_t dt, zsl_real_t *incl,
+			  struct zsl_quat *q)
 {
 	int rc = 0;
 
@@ -134,7 +142,8 @@ static int zsl_fus_mahony(struct zsl_vec *g, struct zsl_vec *a,
 
 	/* Use IMU algorithm if the magnetometer measurement is invalid. */
 	if ((m == NULL) || (ZSL_ABS(zsl_vec_norm(m)) < 1E-6)) {
-		return zsl_fus_mahony_imu(g, a, Kp, Ki, integralFB, integral_limit, incl, q);
+		return zsl_fus_mahony_imu(g, a, Kp, Ki, integralFB, integral_limit,
+					  dt, incl, q);
 	}
 
 	/* Continue with the calculations only if the data from the accelerometer
@@ -220,9 +229,9 @@ static int zsl_fus_mahony(struct zsl_vec *g, struct zsl_vec *a,
 		zsl_vec_add(&e_g, &e_b, &e);
 
 		/* Compute and apply integral feedback if enabled. */
-		integralFB->data[0] += e.data[0] * (1.0 / zsl_fus_mahn_freq);
-		integralFB->data[1] += e.data[1] * (1.0 / zsl_fus_mahn_freq);
-		integralFB->data[2] += e.data[2] * (1.0 / zsl_fus_mahn_freq);
+		integralFB->data[0] += e.data[0] * dt;
+		integralFB->data[1] += e.data[1] * dt;
+		integralFB->data[2] += e.data[2] * dt;
 
 		/* Limit integral values */
 		if(integralFB->data[0] > integral_limit) {
@@ -256,12 +265,14 @@ static int zsl_fus_mahony(struct zsl_vec *g, struct zsl_vec *a,
 
 	/* Integrate rate of change of the input quaternion using the modified
 	 * angular velocity data from the gyroscope. */
-	zsl_quat_from_ang_vel(g, q, 1.0 / zsl_fus_mahn_freq, q);
+	zsl_quat_from_ang_vel(g, q, dt, q);
 
 	/* Normalize the output quaternion. */
 	zsl_quat_to_unit_d(q);
 
+#if CONFIG_ZSL_BOUNDS_CHECKS
 err:
+#endif
 	return rc;
 }
 
@@ -271,8 +282,6 @@ int zsl_fus_mahn_init(uint32_t freq, void *cfg)
 
 	struct zsl_fus_mahn_cfg *mcfg = cfg;
 
-	(void)mcfg;
-
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure that the sample frequency is positive. */
 	if (freq <= 0.0) {
@@ -281,9 +290,11 @@ int zsl_fus_mahn_init(uint32_t freq, void *cfg)
 	}
 #endif
 
-	zsl_fus_mahn_freq = freq;
+	mcfg->freq = freq;
 
+#if CONFIG_ZSL_BOUNDS_CHECKS
 err:
+#endif
 	return rc;
 }
 
@@ -292,12 +303,222 @@ int zsl_fus_mahn_feed(struct zsl_vec *a, struct zsl_vec *m, struct zsl_vec *g,
 {
 	struct zsl_fus_mahn_cfg *mcfg = cfg;
 
-	if (mcfg->kp < 0.0 || mcfg->ki < 0.0) {
+	if (mcfg->freq == 0 || mcfg->kp < 0.0 || mcfg->ki < 0.0) {
 		return -EINVAL;
 	}
 
 	return zsl_fus_mahony(g, a, m, &(mcfg->kp), &(mcfg->ki), &(mcfg->intfb),
-			      mcfg->integral_limit, incl, q);
+			      mcfg->integral_limit, 1.0 / mcfg->freq, incl, q);
+}
+
+int zsl_fus_mahn_feed_batch(const struct zsl_fus_batch *batch,
+			    struct zsl_quat *q, struct zsl_quat *q_out,
+			    void *cfg)
+{
+	int rc = 0;
+	zsl_real_t dt;
+	struct zsl_fus_mahn_cfg *mcfg = cfg;
+
+	if (mcfg->freq == 0 || mcfg->kp < 0.0 || mcfg->ki < 0.0) {
+		return -EINVAL;
+	}
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+
+	for (size_t i = 0; i < batch->n; i++) {
+		rc = zsl_fus_batch_get(batch, i, mcfg->freq, &a, &m, &g, &dt);
+		if (rc) {
+			return rc;
+		}
+
+		rc = zsl_fus_mahony(batch->gyro != NULL ? &g : NULL,
+				    batch->accel != NULL ? &a : NULL,
+				    batch->mag != NULL ? &m : NULL,
+				    &(mcfg->kp), &(mcfg->ki), &(mcfg->intfb),
+				    mcfg->integral_limit, dt, batch->incl, q);
+		if (rc) {
+			return rc;
+		}
+
+		if (q_out != NULL) {
+			q_out[i] = *q;
+		}
+	}
+
+	return rc;
+}
+
+/**
+ * Updates filter 'l' of a call to zsl_fus_mahn_feed_multi. This is the same
+ * computation as zsl_fus_mahony, with the quaternion products expanded and
+ * the rotation matrix of the orientation shared between them. 'bx' and 'bz'
+ * are only used if 'incl' is true.
+ */
+static void zsl_fus_mahn_lane(size_t l, const struct zsl_fus_vec_soa *a,
+			      const struct zsl_fus_vec_soa *m,
+			      const struct zsl_fus_vec_soa *g, bool incl,
+			      zsl_real_t bx, zsl_real_t bz,
+			      struct zsl_fus_mahn_cfg *cfg, zsl_real_t dt,
+			      struct zsl_fus_vec_soa *intfb,
+			      struct zsl_fus_quat_soa *q)
+{
+	zsl_real_t qr, qi, qj, qk, n;
+	zsl_real_t ax, ay, az, mx, my, mz;
+	zsl_real_t v0, v1, v2, e0, e1, e2;
+	zsl_real_t gx = g->x[l], gy = g->y[l], gz = g->z[l];
+	zsl_real_t lim = cfg->integral_limit;
+	zsl_real_t r[9];
+
+	/* Convert the input quaternion to a unit quaternion. */
+	n = ZSL_FAST_RSQRT(q->r[l] * q->r[l] + q->i[l] * q->i[l] +
+			   q->j[l] * q->j[l] + q->k[l] * q->k[l]);
+	qr = q->r[l] * n;
+	qi = q->i[l] * n;
+	qj = q->j[l] * n;
+	qk = q->k[l] * n;
+
+	if (a != NULL) {
+		ax = a->x[l];
+		ay = a->y[l];
+		az = a->z[l];
+		n = ax * ax + ay * ay + az * az;
+	} else {
+		n = 0.0;
+	}
+
+	/* Skip samples with a magnitude of 1E-6 or less. */
+	if (n > 1E-12) {
+		n = ZSL_FAST_RSQRT(n);
+		ax *= n;
+		ay *= n;
+		az *= n;
+
+		/* Rotation matrix of the orientation, row by row. */
+		r[0] = qr * qr + qi * qi - qj * qj - qk * qk;
+		r[1] = 2.0 * (qi * qj - qr * qk);
+		r[2] = 2.0 * (qi * qk + qr * qj);
+		r[3] = 2.0 * (qi * qj + qr * qk);
+		r[4] = qr * qr - qi * qi + qj * qj - qk * qk;
+		r[5] = 2.0 * (qj * qk - qr * qi);
+		r[6] = 2.0 * (qi * qk - qr * qj);
+		r[7] = 2.0 * (qj * qk + qr * qi);
+		r[8] = qr * qr - qi * qi - qj * qj + qk * qk;
+
+		/* Gravity error: a x v, for the vertical 'v' rotated by q. */
+		e0 = ay * r[8] - az * r[5];
+		e1 = az * r[2] - ax * r[8];
+		e2 = ax * r[5] - ay * r[2];
+
+		if (m != NULL) {
+			mx = m->x[l];
+			my = m->y[l];
+			mz = m->z[l];
+			n = mx * mx + my * my + mz * mz;
+		} else {
+			n = 0.0;
+		}
+
+		if (n >= 1E-12) {
+			n = ZSL_FAST_RSQRT(n);
+			mx *= n;
+			my *= n;
+			mz *= n;
+
+			if (!incl) {
+				v0 = r[0] * mx + r[1] * my + r[2] * mz;
+				v1 = r[3] * mx + r[4] * my + r[5] * mz;
+				bx = ZSL_SQRT(v0 * v0 + v1 * v1);
+				bz = r[6] * mx + r[7] * my + r[8] * mz;
+			}
+
+			/* Magnetic error: m x bf, for the field (bx, 0, bz)
+			 * rotated by q. */
+			v0 = bx * r[0] + bz * r[2];
+			v1 = bx * r[3] + bz * r[5];
+			v2 = bx * r[6] + bz * r[8];
+			e0 += my * v2 - mz * v1;
+			e1 += mz * v0 - mx * v2;
+			e2 += mx * v1 - my * v0;
+		}
+
+		/* Compute and limit the integral feedback. */
+		v0 = intfb->x[l] + e0 * dt;
+		v1 = intfb->y[l] + e1 * dt;
+		v2 = intfb->z[l] + e2 * dt;
+		v0 = (v0 > lim) ? lim : ((v0 < -lim) ? -lim : v0);
+		v1 = (v1 > lim) ? lim : ((v1 < -lim) ? -lim : v1);
+		v2 = (v2 > lim) ? lim : ((v2 < -lim) ? -lim : v2);
+		intfb->x[l] = v0;
+		intfb->y[l] = v1;
+		intfb->z[l] = v2;
+
+		/* Apply the integral and proportional feedback. */
+		gx = gx + cfg->ki * v0 + cfg->kp * e0;
+		gy = gy + cfg->ki * v1 + cfg->kp * e1;
+		gz = gz + cfg->ki * v2 + cfg->kp * e2;
+	}
+
+	/* Integrate the angular velocity, as zsl_quat_from_ang_vel does, and
+	 * normalize the output. */
+	v0 = 0.5 * dt;
+	ax = qr + v0 * (-gx * qi - gy * qj - gz * qk);
+	ay = qi + v0 * (gx * qr + gy * qk - gz * qj);
+	az = qj + v0 * (-gx * qk + gy * qr + gz * qi);
+	mx = qk + v0 * (gx * qj - gy * qi + gz * qr);
+	n = ZSL_FAST_RSQRT(ax * ax + ay * ay + az * az + mx * mx);
+	q->r[l] = ax * n;
+	q->i[l] = ay * n;
+	q->j[l] = az * n;
+	q->k[l] = mx * n;
+}
+
+int zsl_fus_mahn_feed_multi(size_t n, const struct zsl_fus_vec_soa *a,
+			    const struct zsl_fus_vec_soa *m,
+			    const struct zsl_fus_vec_soa *g, zsl_real_t *incl,
+			    struct zsl_fus_vec_soa *intfb,
+			    struct zsl_fus_quat_soa *q,
+			    struct zsl_fus_mahn_cfg *cfg)
+{
+	zsl_real_t bx = 0.0, bz = 0.0;
+	zsl_real_t dt;
+	size_t l = 0;
+
+	if (cfg->freq == 0 || cfg->kp < 0.0 || cfg->ki < 0.0 || g == NULL) {
+		return -EINVAL;
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure that none of the input quaternions is zero. */
+	for (size_t i = 0; i < n; i++) {
+		if (ZSL_SQRT(q->r[i] * q->r[i] + q->i[i] * q->i[i] +
+			     q->j[i] * q->j[i] + q->k[i] * q->k[i]) < 1E-6) {
+			return -EINVAL;
+		}
+	}
+#endif
+
+	dt = 1.0 / cfg->freq;
+
+	if (incl != NULL) {
+		bx = ZSL_COS(*incl * ZSL_PI / 180.0);
+		bz = ZSL_SIN(*incl * ZSL_PI / 180.0);
+	}
+
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+	for (; l + ZSL_X86_W <= n; l += ZSL_X86_W) {
+		zsl_x86_fus_mahn(l, a, m, g, incl != NULL, bx, bz, cfg->kp,
+				 cfg->ki, cfg->integral_limit, dt, intfb, q);
+	}
+#endif
+
+	for (; l < n; l++) {
+		zsl_fus_mahn_lane(l, a, m, g, incl != NULL, bx, bz, cfg, dt, intfb,
+				  q);
+	}
+
+	return 0;
 }
 
 void zsl_fus_mahn_error(int error)
@@ -10,8 +10,6 @@
 #include <zsl/orientation/fusion/fusion.h>
 #include <zsl/orientation/fusion/saam.h>
 
-static uint32_t zsl_fus_saam_freq;
-
 static int zsl_fus_saam(struct zsl_vec *a, struct zsl_vec *m,
 			struct zsl_quat *q)
 {
@@ -73,7 +71,9 @@ int zsl_fus_saam_init(uint32_t freq, void *cfg)
 	}
 #endif
 
-	zsl_fus_saam_freq = freq;
+	/* SAAM is a static estimator, so the sample frequency is unused and
+	 * the filter keeps no state between calls. */
+	(void)cfg;
 
 err:
 	return rc;
@@ -85,6 +85,40 @@ int zsl_fus_saam_feed(struct zsl_vec *a, struct zsl_vec *m,
 	return zsl_fus_saam(a, m, q);
 }
 
+int zsl_fus_saam_feed_batch(const struct zsl_fus_batch *batch,
+			    struct zsl_quat *q, struct zsl_quat *q_out,
+			    void *cfg)
+{
+	int rc = 0;
+	zsl_real_t dt;
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+
+	/* SAAM needs both the accelerometer and magnetometer data. */
+	if (batch->accel == NULL || batch->mag == NULL) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < batch->n; i++) {
+		rc = zsl_fus_batch_get(batch, i, 1, &a, &m, NULL, &dt);
+		if (rc) {
+			return rc;
+		}
+
+		rc = zsl_fus_saam(&a, &m, q);
+		if (rc) {
+			return rc;
+		}
+
+		if (q_out != NULL) {
+			q_out[i] = *q;
+		}
+	}
+
+	return rc;
+}
+
 void zsl_fus_saam_error(int error)
 {
 	/* ToDo: Log error in default handler. */
@@ -8,9 +8,14 @@
 #include <errno.h>
 #include <stdio.h>
 #include <zsl/zsl.h>
+#include <zsl/fastmath.h>
 #include <zsl/vectors.h>
 #include <zsl/orientation/quaternions.h>
 
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+#include <zsl/asm/x86/asm_x86_quaternions.h>
+#endif
+
 /**
  * @brief Helper function to compare float values.
  *
@@ -62,18 +67,21 @@ zsl_real_t zsl_quat_magn(struct zsl_quat *q)
 int zsl_quat_to_unit(struct zsl_quat *q, struct zsl_quat *qn)
 {
 	int rc = 0;
-	zsl_real_t m = zsl_quat_magn(q);
+	zsl_real_t m2 = q->r * q->r + q->i * q->i + q->j * q->j + q->k * q->k;
+	zsl_real_t f;
 
-	if (ZSL_ABS(m) < 1E-6) {
+	/* Magnitude below 1E-6. */
+	if (m2 < 1E-12) {
 		qn->r = 0.0;
 		qn->i = 0.0;
 		qn->j = 0.0;
 		qn->k = 0.0;
 	} else {
-		qn->r = q->r / m;
-		qn->i = q->i / m;
-		qn->j = q->j / m;
-		qn->k = q->k / m;
+		f = ZSL_FAST_RSQRT(m2);
+		qn->r = q->r * f;
+		qn->i = q->i * f;
+		qn->j = q->j * f;
+		qn->k = q->k * f;
 	}
 
 	return rc;
@@ -352,19 +360,14 @@ err:
 	return rc;
 }
 
-int zsl_quat_slerp(struct zsl_quat *qa, struct zsl_quat *qb,
-		   zsl_real_t t, struct zsl_quat *qi)
+/**
+ * @brief Slerp between the unit quaternions 'qa_u' and 'qb_u', for a valid
+ *        interpolation factor 't'. Shared by zsl_quat_slerp and
+ *        zsl_quat_slerp_n.
+ */
+static int zsl_quat_slerp_unit(struct zsl_quat *qa_u, struct zsl_quat *qb_u,
+			       zsl_real_t t, struct zsl_quat *qi)
 {
-	int rc = 0;
-
-#if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure t is between 0 and 1 (included). */
-	if (t < 0.0 || t > 1.0) {
-		rc = -EINVAL;
-		goto err;
-	}
-#endif
-
 	struct zsl_quat q1, q2; /* Interim quats. */
 	zsl_real_t dot;         /* Dot product bewteen qa and qb. */
 	zsl_real_t phi;         /* arccos(dot). */
@@ -372,51 +375,29 @@ int zsl_quat_slerp(struct zsl_quat *qa, struct zsl_quat *qb,
 	zsl_real_t phi_st;      /* sin(phi * (t)). */
 	zsl_real_t phi_smt;     /* sin(phi * (1.0 - t)). */
 
-	/*
-	 * Unit quaternion slerp = qa * (qa^-1 * qb)^t
-	 *
-	 * We get there in a round-about way in this code, but we avoid pushing
-	 * and popping values on the stack with trivial calls to helper functions.
-	 */
-
-	/* Turn input quaternions into unit quaternions. */
-	struct zsl_quat qa_u;
-	struct zsl_quat qb_u;
-	zsl_quat_to_unit(qa, &qa_u);
-	zsl_quat_to_unit(qb, &qb_u);
-
 	/* When t = 0.0 or t = 1.0, just memcpy qa or qb. */
 	if (t == 0.0) {
-		qi->r = qa_u.r;
-		qi->i = qa_u.i;
-		qi->j = qa_u.j;
-		qi->k = qa_u.k;
-		goto err;
+		*qi = *qa_u;
+		return 0;
 	} else if (t == 1.0) {
-		qi->r = qb_u.r;
-		qi->i = qb_u.i;
-		qi->j = qb_u.j;
-		qi->k = qb_u.k;
-		goto err;
+		*qi = *qb_u;
+		return 0;
 	}
 
 	/* Compute the dot product of the two normalized input quaternions. */
-	dot = qa_u.r * qb_u.r + qa_u.i * qb_u.i + qa_u.j * qb_u.j + qa_u.k * qb_u.k;
+	dot = qa_u->r * qb_u->r + qa_u->i * qb_u->i + qa_u->j * qb_u->j +
+	      qa_u->k * qb_u->k;
 
 	/* The value dot is always between -1 and 1. If dot = 1.0, qa = qb and there
 	 * is no interpolation. */
 	if (ZSL_ABS(dot - 1.0) < 1E-6) {
-		qi->r = qa_u.r;
-		qi->i = qa_u.i;
-		qi->j = qa_u.j;
-		qi->k = qa_u.k;
-		goto err;
+		*qi = *qa_u;
+		return 0;
 	}
 
 	/* If dot = -1, then qa = - qb and the interpolation is invald. */
 	if (ZSL_ABS(dot + 1.0) < 1E-6) {
-		rc = -EINVAL;
-		goto err;
+		return -EINVAL;
 	}
 
 	/*
@@ -431,8 +412,8 @@ int zsl_quat_slerp(struct zsl_quat *qa, struct zsl_quat *qb,
 	phi_smt = ZSL_SIN(phi * (1.0 - t));
 
 	/* Calculate intermediate quats. */
-	zsl_quat_scale(&qa_u, phi_smt / phi_s, &q1);
-	zsl_quat_scale(&qb_u, phi_st / phi_s, &q2);
+	zsl_quat_scale(qa_u, phi_smt / phi_s, &q1);
+	zsl_quat_scale(qb_u, phi_st / phi_s, &q2);
 
 	/* Final result = q1 + q2. */
 	qi->r = q1.r + q2.r;
@@ -440,8 +421,33 @@ int zsl_quat_slerp(struct zsl_quat *qa, struct zsl_quat *qb,
 	qi->j = q1.j + q2.j;
 	qi->k = q1.k + q2.k;
 
-err:
-	return rc;
+	return 0;
+}
+
+int zsl_quat_slerp(struct zsl_quat *qa, struct zsl_quat *qb,
+		   zsl_real_t t, struct zsl_quat *qi)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure t is between 0 and 1 (included). */
+	if (t < 0.0 || t > 1.0) {
+		return -EINVAL;
+	}
+#endif
+
+	/*
+	 * Unit quaternion slerp = qa * (qa^-1 * qb)^t
+	 *
+	 * We get there in a round-about way in this code, but we avoid pushing
+	 * and popping values on the stack with trivial calls to helper functions.
+	 */
+
+	/* Turn input quaternions into unit quaternions. */
+	struct zsl_quat qa_u;
+	struct zsl_quat qb_u;
+	zsl_quat_to_unit(qa, &qa_u);
+	zsl_quat_to_unit(qb, &qb_u);
+
+	return zsl_quat_slerp_unit(&qa_u, &qb_u, t, qi);
 }
 
 int zsl_quat_from_ang_vel(struct zsl_vec *w, struct zsl_quat *qin,
@@ -509,12 +515,22 @@ err:
 	return rc;
 }
 
-int zsl_quat_to_euler(struct zsl_quat *q, struct zsl_euler *e)
+/**
+ * @brief Converts the quaternion 'q' to Euler angles, normalising it first.
+ *        Shared by zsl_quat_to_euler and zsl_quat_to_euler_n.
+ *
+ * With CONFIG_ZSL_FAST_MATH, the angles come from the asin and atan2
+ * approximations, but the normalisation always uses ZSL_SQRT: near the gimbal
+ * lock, asin amplifies any error in the magnitude of 'q'.
+ */
+static void zsl_quat_to_euler_one(const struct zsl_quat *q,
+				  struct zsl_euler *e)
 {
-	int rc = 0;
-	struct zsl_quat qn;
-
-	zsl_quat_to_unit(q, &qn);
+	zsl_real_t m2 = q->r * q->r + q->i * q->i + q->j * q->j + q->k * q->k;
+	zsl_real_t f = (m2 < 1E-12) ? 0.0 : 1.0 / ZSL_SQRT(m2);
+	struct zsl_quat qn = {
+		.r = q->r * f, .i = q->i * f, .j = q->j * f, .k = q->k * f
+	};
 	zsl_real_t gl = qn.i * qn.k + qn.j * qn.r;
 	zsl_real_t v = 2. * gl;
 
@@ -524,22 +540,27 @@ int zsl_quat_to_euler(struct zsl_quat *q, struct zsl_euler *e)
 		v = -1.0;
 	}
 
-	e->y = ZSL_ASIN(v);
+	e->y = ZSL_FAST_ASIN(v);
 
 	/* Gimbal lock case. */
 	if (ZSL_ABS(gl - 0.5) < 1E-6 || ZSL_ABS(gl + 0.5) < 1E-6) {
-		e->x = ZSL_ATAN2(2.0 * (qn.j * qn.k + qn.i * qn.r),
-				 1.0 - 2.0 * (qn.i * qn.i + qn.k * qn.k));
+		e->x = ZSL_FAST_ATAN2(2.0 * (qn.j * qn.k + qn.i * qn.r),
+				      1.0 - 2.0 * (qn.i * qn.i + qn.k * qn.k));
 		e->z = 0.0;
-		return rc;
+		return;
 	}
 
-	e->x = ZSL_ATAN2(2.0 * (qn.i * qn.r - qn.j * qn.k),
-			 1.0 - 2.0 * (qn.i * qn.i + qn.j * qn.j));
-	e->z = ZSL_ATAN2(2.0 * (qn.k * qn.r - qn.i * qn.j),
-			 1.0 - 2.0 * (qn.j * qn.j + qn.k * qn.k));
+	e->x = ZSL_FAST_ATAN2(2.0 * (qn.i * qn.r - qn.j * qn.k),
+			      1.0 - 2.0 * (qn.i * qn.i + qn.j * qn.j));
+	e->z = ZSL_FAST_ATAN2(2.0 * (qn.k * qn.r - qn.i * qn.j),
+			      1.0 - 2.0 * (qn.j * qn.j + qn.k * qn.k));
+}
 
-	return rc;
+int zsl_quat_to_euler(struct zsl_quat *q, struct zsl_euler *e)
+{
+	zsl_quat_to_euler_one(q, e);
+
+	return 0;
 }
 
 int zsl_quat_from_euler(struct zsl_euler *e, struct zsl_quat *q)
@@ -711,6 +732,108 @@ err:
 	return rc;
 }
 
+int zsl_quat_mult_n(size_t n, struct zsl_quat *qa, struct zsl_quat *qb,
+		    struct zsl_quat *qm)
+{
+	size_t l = 0;
+
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+	for (; l + ZSL_X86_W <= n; l += ZSL_X86_W) {
+		zsl_x86_quat_mult(&qa[l], &qb[l], &qm[l]);
+	}
+#endif
+
+	for (; l < n; l++) {
+		/* Copies, so that qm can be the same array as qa or qb. */
+		struct zsl_quat a = qa[l];
+		struct zsl_quat b = qb[l];
+
+		qm[l].r = a.r * b.r - a.i * b.i - a.j * b.j - a.k * b.k;
+		qm[l].i = a.r * b.i + a.i * b.r + a.j * b.k - a.k * b.j;
+		qm[l].j = a.r * b.j - a.i * b.k + a.j * b.r + a.k * b.i;
+		qm[l].k = a.r * b.k + a.i * b.j - a.j * b.i + a.k * b.r;
+	}
+
+	return 0;
+}
+
+int zsl_quat_rot_n(size_t n, struct zsl_quat *qa, const zsl_real_t *v,
+		   size_t v_stride, zsl_real_t *vr, size_t vr_stride)
+{
+	struct zsl_quat q;
+	zsl_real_t r[9];
+	zsl_real_t x, y, z;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure the points don't overlap each other. */
+	if (v_stride < 3 || vr_stride < 3) {
+		return -EINVAL;
+	}
+#endif
+
+	/* The rotation qn * (0, v) * qn^-1 of zsl_quat_rot, for the unit form
+	 * qn of qa, is the same for every point, so work out its matrix once.
+	 * A zero quaternion gives a zero matrix, as in zsl_quat_rot. */
+	zsl_quat_to_unit(qa, &q);
+	r[0] = q.r * q.r + q.i * q.i - q.j * q.j - q.k * q.k;
+	r[1] = 2.0 * (q.i * q.j - q.r * q.k);
+	r[2] = 2.0 * (q.i * q.k + q.r * q.j);
+	r[3] = 2.0 * (q.i * q.j + q.r * q.k);
+	r[4] = q.r * q.r - q.i * q.i + q.j * q.j - q.k * q.k;
+	r[5] = 2.0 * (q.j * q.k - q.r * q.i);
+	r[6] = 2.0 * (q.i * q.k - q.r * q.j);
+	r[7] = 2.0 * (q.j * q.k + q.r * q.i);
+	r[8] = q.r * q.r - q.i * q.i - q.j * q.j + q.k * q.k;
+
+	for (size_t l = 0; l < n; l++) {
+		x = v[l * v_stride];
+		y = v[l * v_stride + 1];
+		z = v[l * v_stride + 2];
+		vr[l * vr_stride] = r[0] * x + r[1] * y + r[2] * z;
+		vr[l * vr_stride + 1] = r[3] * x + r[4] * y + r[5] * z;
+		vr[l * vr_stride + 2] = r[6] * x + r[7] * y + r[8] * z;
+	}
+
+	return 0;
+}
+
+int zsl_quat_slerp_n(size_t n, struct zsl_quat *qa, struct zsl_quat *qb,
+		     zsl_real_t t, struct zsl_quat *qi)
+{
+	struct zsl_quat qa_u;
+	struct zsl_quat qb_u;
+	int rc = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure t is between 0 and 1 (included). */
+	if (t < 0.0 || t > 1.0) {
+		return -EINVAL;
+	}
+#endif
+
+	for (size_t l = 0; l < n; l++) {
+		zsl_quat_to_unit(&qa[l], &qa_u);
+		zsl_quat_to_unit(&qb[l], &qb_u);
+
+		/* Carry on past pairs that can't be interpolated, which are
+		 * left unchanged as in zsl_quat_slerp. */
+		if (zsl_quat_slerp_unit(&qa_u, &qb_u, t, &qi[l])) {
+			rc = -EINVAL;
+		}
+	}
+
+	return rc;
+}
+
+int zsl_quat_to_euler_n(size_t n, struct zsl_quat *q, struct zsl_euler *e)
+{
+	for (size_t l = 0; l < n; l++) {
+		zsl_quat_to_euler_one(&q[l], &e[l]);
+	}
+
+	return 0;
+}
+
 int zsl_quat_print(struct zsl_quat *q)
 {
 	printf("%.16f + %.16f i + %.16f j + %.16f k\n",
@@ -11,6 +11,45 @@
 #include <zsl/zsl.h>
 #include <zsl/statistics.h>
 
+/**
+ * @brief Assigns the ranks 'lo' and 'hi' of the two values whose mean is the
+ *        p'th percentile of 'n' sorted values. When the percentile falls
+ *        between two values, 'lo' and 'hi' are the same rank.
+ */
+static void zsl_sta_percentile_ranks(size_t n, zsl_real_t p, size_t *lo,
+				     size_t *hi)
+{
+	zsl_real_t x = (p * n) / 100.;
+	zsl_real_t per = ZSL_FLOOR(x);
+
+	*hi = (size_t)per;
+	*lo = *hi;
+
+	/* On an exact rank, use the mean with the value below. p = 0 and
+	 * p = 100 are clamped to the smallest and largest values. */
+	if (x == per && *hi > 0) {
+		*lo = *hi - 1;
+	}
+	if (*hi >= n) {
+		*hi = n - 1;
+	}
+	if (*lo >= n) {
+		*lo = n - 1;
+	}
+}
+
+/**
+ * @brief Returns the p'th percentile of the already sorted vector 'w'.
+ */
+static zsl_real_t zsl_sta_percentile_sorted(struct zsl_vec *w, zsl_real_t p)
+{
+	size_t lo, hi;
+
+	zsl_sta_percentile_ranks(w->sz, p, &lo, &hi);
+
+	return (w->data[hi] + w->data[lo]) / 2.;
+}
+
 int zsl_sta_mean(struct zsl_vec *v, zsl_real_t *m)
 {
 	zsl_vec_ar_mean(v, m);
@@ -32,11 +71,9 @@ int zsl_sta_trim_mean(struct zsl_vec *v, zsl_real_t p, zsl_real_t *m)
 	size_t first_val = 0, count = 0;
 
 	*m = 0.0;
-	zsl_sta_percentile(v, p, &per_l);
-	zsl_sta_percentile(v, 100 - p, &per_h);
-
-	zsl_vec_init(&w);
 	zsl_vec_sort(v, &w);
+	per_l = zsl_sta_percentile_sorted(&w, p);
+	per_h = zsl_sta_percentile_sorted(&w, 100 - p);
 
 	for (size_t i = 0; i < v->sz; i++) {
 		if (w.data[i] >= per_l && w.data[i] <= per_h) {
@@ -156,36 +193,48 @@ int zsl_sta_demean(struct zsl_vec *v, struct zsl_vec *w)
 }
 
 int zsl_sta_percentile(struct zsl_vec *v, zsl_real_t p, zsl_real_t *val)
+{
+	ZSL_VECTOR_DEF(w, v->sz);
+
+	zsl_vec_copy(&w, v);
+
+	return zsl_sta_percentile_inplace(&w, p, val);
+}
+
+int zsl_sta_percentile_inplace(struct zsl_vec *v, zsl_real_t p,
+			       zsl_real_t *val)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
 	/* Make sure p is between 0 and 100. */
 	if (p > 100.0 || p < 0.0) {
 		return -EINVAL;
 	}
+
+	/* Make sure v isn't empty. */
+	if (v->sz == 0) {
+		return -EINVAL;
+	}
 #endif
 
-	ZSL_VECTOR_DEF(w, v->sz);
+	size_t k[2];
+	zsl_real_t q[2];
 
-	zsl_vec_init(&w);
-	zsl_vec_sort(v, &w);
+	zsl_sta_percentile_ranks(v->sz, p, &k[0], &k[1]);
+	zsl_vec_select(v, k, 2, q);
 
-	zsl_real_t x = (p * v->sz) / 100.;
-	zsl_real_t per = ZSL_FLOOR(x);
-
-	if (x == per) {
-		*val = (w.data[(int)per] + w.data[(int)per - 1]) / 2.;
-	} else {
-		*val = w.data[(int)per];
-	}
+	*val = (q[1] + q[0]) / 2.;
 
 	return 0;
 }
 
 int zsl_sta_median(struct zsl_vec *v, zsl_real_t *m)
 {
-	zsl_sta_percentile(v, 50, m);
+	return zsl_sta_percentile(v, 50, m);
+}
 
-	return 0;
+int zsl_sta_median_inplace(struct zsl_vec *v, zsl_real_t *m)
+{
+	return zsl_sta_percentile_inplace(v, 50, m);
 }
 
 int zsl_sta_weighted_median(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *m)
@@ -235,19 +284,49 @@ int zsl_sta_weighted_median(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *m)
 int zsl_sta_quart(struct zsl_vec *v, zsl_real_t *q1, zsl_real_t *q2,
 		  zsl_real_t *q3)
 {
-	zsl_sta_percentile(v, 25, q1);
-	zsl_sta_percentile(v, 50, q2);
-	zsl_sta_percentile(v, 75, q3);
+	ZSL_VECTOR_DEF(w, v->sz);
+
+	zsl_vec_copy(&w, v);
+
+	return zsl_sta_quart_inplace(&w, q1, q2, q3);
+}
+
+int zsl_sta_quart_inplace(struct zsl_vec *v, zsl_real_t *q1, zsl_real_t *q2,
+			  zsl_real_t *q3)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v isn't empty. */
+	if (v->sz == 0) {
+		return -EINVAL;
+	}
+#endif
+
+	size_t k[6];
+	zsl_real_t q[6];
+
+	/* The ranks for the three quartiles are ascending, so they can all be
+	 * selected in one pass. */
+	zsl_sta_percentile_ranks(v->sz, 25, &k[0], &k[1]);
+	zsl_sta_percentile_ranks(v->sz, 50, &k[2], &k[3]);
+	zsl_sta_percentile_ranks(v->sz, 75, &k[4], &k[5]);
+	zsl_vec_select(v, k, 6, q);
+
+	*q1 = (q[1] + q[0]) / 2.;
+	*q2 = (q[3] + q[2]) / 2.;
+	*q3 = (q[5] + q[4]) / 2.;
 
 	return 0;
 }
 
 int zsl_sta_quart_range(struct zsl_vec *v, zsl_real_t *r)
 {
-	zsl_real_t q1, q3;
+	int rc;
+	zsl_real_t q1, q2, q3;
 
-	zsl_sta_percentile(v, 25, &q1);
-	zsl_sta_percentile(v, 75, &q3);
+	rc = zsl_sta_quart(v, &q1, &q2, &q3);
+	if (rc) {
+		return rc;
+	}
 
 	*r = q3 - q1;
 
@@ -340,28 +419,36 @@ int zsl_sta_mean_abs_dev(struct zsl_vec *v, zsl_real_t *m)
 
 int zsl_sta_median_abs_dev(struct zsl_vec *v, zsl_real_t *m)
 {
-	ZSL_VECTOR_DEF(med, v->sz);
+	int rc;
 	zsl_real_t median;
 
-	zsl_sta_median(v, &median);
+	/* The same scratch vector is used for both medians. */
+	ZSL_VECTOR_DEF(med, v->sz);
+
+	zsl_vec_copy(&med, v);
+	rc = zsl_sta_median_inplace(&med, &median);
+	if (rc) {
+		return rc;
+	}
+
 	for (size_t i = 0; i < v->sz; i++) {
 		med.data[i] = ZSL_ABS(v->data[i] - median);
 	}
 
-	zsl_sta_median(&med, m);
-
-	return 0;
+	return zsl_sta_median_inplace(&med, m);
 }
 
 int zsl_sta_var(struct zsl_vec *v, zsl_real_t *var)
 {
-	ZSL_VECTOR_DEF(w, v->sz);
+	zsl_real_t m, d;
+
 	*var = 0;
 
-	zsl_sta_demean(v, &w);
+	zsl_sta_mean(v, &m);
 
 	for (size_t i = 0; i < v->sz; i++) {
-		*var += w.data[i] * w.data[i];
+		d = v->data[i] - m;
+		*var += d * d;
 	}
 
 	*var /= v->sz - 1;
@@ -389,15 +476,14 @@ int zsl_sta_covar(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *c)
 	}
 #endif
 
-	ZSL_VECTOR_DEF(v_dm, v->sz);
-	ZSL_VECTOR_DEF(w_dm, w->sz);
+	zsl_real_t mv, mw;
 
-	zsl_sta_demean(v, &v_dm);
-	zsl_sta_demean(w, &w_dm);
+	zsl_sta_mean(v, &mv);
+	zsl_sta_mean(w, &mw);
 
 	*c = 0;
 	for (size_t i = 0; i < v->sz; i++) {
-		*c += v_dm.data[i] * w_dm.data[i];
+		*c += (v->data[i] - mv) * (w->data[i] - mw);
 	}
 
 	*c /= v->sz - 1;
@@ -462,76 +548,155 @@ int zsl_sta_linear_reg(struct zsl_vec *x, struct zsl_vec *y,
 	return 0;
 }
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
-int zsl_sta_mult_linear_reg(struct zsl_mtx *x, struct zsl_vec *y,
-			    struct zsl_vec *b, zsl_real_t *r)
+/**
+ * @brief Adds the row 'x' of a least-squares problem, with its right-hand side
+ *        in x[p], to the 'p' x ('p' + 1) triangular factor 'r' with a sequence
+ *        of Givens rotations. 'x' is scaled by 'sw' first, and is overwritten.
+ *        Also adds the squares of the row to the column norms in 'nrm'.
+ *
+ * The last column of 'r' holds Q^T y, so 'r' is all that is needed to solve
+ * the problem, whatever the number of rows.
+ */
+static void zsl_sta_ls_push(zsl_real_t *r, zsl_real_t *nrm, size_t p,
+			    zsl_real_t *x, zsl_real_t sw)
 {
+	zsl_real_t c, s, h, t;
 
-#if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure matrices and vectors' sizes match. */
-	if (x->sz_rows != y->sz || x->sz_cols + 1 != b->sz) {
-		return -EINVAL;
+	for (size_t j = 0; j <= p; j++) {
+		x[j] *= sw;
 	}
-#endif
-
-	ZSL_MATRIX_DEF(x_exp, x->sz_rows, (x->sz_cols + 1));
-	ZSL_MATRIX_DEF(x_trans, (x->sz_cols + 1), x->sz_rows);
-	ZSL_MATRIX_DEF(xx, (x->sz_cols + 1), (x->sz_cols + 1));
-	ZSL_MATRIX_DEF(xinv, (x->sz_cols + 1), (x->sz_cols + 1));
-	ZSL_MATRIX_DEF(ymtx, y->sz, 1);
-	ZSL_MATRIX_DEF(xtemp, (x->sz_cols + 1), x->sz_rows);
-	ZSL_MATRIX_DEF(bmtx, (x->sz_cols + 1), 1);
-	ZSL_MATRIX_DEF(xtemp2, x->sz_rows, 1);
-	ZSL_MATRIX_DEF(emtx, x->sz_rows, 1);
-
-	zsl_real_t v[x->sz_rows];
-	zsl_mtx_init(&x_exp, NULL);
-	for (size_t i = 0; i < x->sz_rows; i++) {
-		v[i] = 1.;
+	for (size_t j = 0; j < p; j++) {
+		nrm[j] += x[j] * x[j];
 	}
 
-	zsl_mtx_set_col(&x_exp, 0, v);
-	for (size_t j = 0; j < x->sz_cols; j++) {
-		zsl_mtx_get_col(x, j, v);
-		zsl_mtx_set_col(&x_exp, j + 1, v);
+	for (size_t j = 0; j < p; j++) {
+		if (x[j] == 0.0) {
+			continue;
+		}
+
+		/* Rotate (r_jj, x_j) onto (h, 0). */
+		h = ZSL_SQRT(r[j * (p + 1) + j] * r[j * (p + 1) + j] +
+			     x[j] * x[j]);
+		c = r[j * (p + 1) + j] / h;
+		s = x[j] / h;
+		r[j * (p + 1) + j] = h;
+
+		for (size_t k = j + 1; k <= p; k++) {
+			t = r[j * (p + 1) + k];
+			r[j * (p + 1) + k] = c * t + s * x[k];
+			x[k] = c * x[k] - s * t;
+		}
 	}
+}
+
+/**
+ * @brief Solves R b = Q^T y by back substitution, with 'r' as built by
+ *        zsl_sta_ls_push from 'n' rows.
+ *
+ * Returns -EINVAL if a column is, within n * epsilon of its norm, a linear
+ * combination of the previous ones.
+ */
+static int zsl_sta_ls_solve(zsl_real_t *r, zsl_real_t *nrm, size_t p,
+			    size_t n, zsl_real_t *b)
+{
+	zsl_real_t x;
 
-	zsl_mtx_trans(&x_exp, &x_trans);
-	zsl_mtx_mult(&x_trans, &x_exp, &xx);
+	for (size_t j = 0; j < p; j++) {
+		if (ZSL_ABS(r[j * (p + 1) + j]) <=
+		    n * ZSL_EPSILON * ZSL_SQRT(nrm[j])) {
+			return -EINVAL;
+		}
+	}
 
-	zsl_real_t det;
-	zsl_mtx_deter(&xx, &det);
-	if (ZSL_ABS(det) < 1E-6) {
-		/*
-		 * Currently limited to square matrices. pinv could be used,
-		 * but is too resource-intensive to add at the momemt.
-		 */
-		return -EINVAL;
-	} else {
-		zsl_mtx_inv(&xx, &xinv);
+	for (size_t j = p; j-- > 0;) {
+		x = r[j * (p + 1) + p];
+		for (size_t k = j + 1; k < p; k++) {
+			x -= r[j * (p + 1) + k] * b[k];
+		}
+		b[j] = x / r[j * (p + 1) + j];
 	}
 
-	zsl_mtx_from_arr(&ymtx, y->data);
-	zsl_mtx_mult(&xinv, &x_trans, &xtemp);
-	zsl_mtx_mult(&xtemp, &ymtx, &bmtx);
-	zsl_vec_from_arr(b, bmtx.data);
+	return 0;
+}
+
+/**
+ * @brief Computes the coefficient of determination of the fit 'b' of the
+ *        multiple linear regression of 'y' on the columns of 'x'.
+ */
+static zsl_real_t zsl_sta_ls_r2(struct zsl_mtx *x, struct zsl_vec *y,
+				struct zsl_vec *b)
+{
+	zsl_real_t e, ymean;
+	zsl_real_t e_norm = 0.0, ysum = 0.0;
 
-	zsl_mtx_mult(&x_exp, &bmtx, &xtemp2);
-	zsl_mtx_sub(&ymtx, &xtemp2, &emtx);
-	zsl_real_t e_norm = 0.0, ymean, ysum = 0.0;
 	zsl_sta_mean(y, &ymean);
-	for (size_t g = 0; g < x->sz_rows; g++) {
-		e_norm += emtx.data[g] * emtx.data[g];
-		ysum += (y->data[g] - ymean) * (y->data[g] - ymean);
+	for (size_t i = 0; i < x->sz_rows; i++) {
+		e = y->data[i] - b->data[0];
+		for (size_t j = 0; j < x->sz_cols; j++) {
+			e -= x->data[(i * x->sz_cols) + j] * b->data[j + 1];
+		}
+		e_norm += e * e;
+		ysum += (y->data[i] - ymean) * (y->data[i] - ymean);
 	}
 
-	*r = 1. - e_norm / ysum;
+	return 1. - e_norm / ysum;
+}
+
+/**
+ * @brief Fits the multiple linear regression of 'y' on the columns of 'x',
+ *        with the rows weighted by 1 / w_i if 'w' isn't NULL.
+ */
+static int zsl_sta_ls_linear_reg(struct zsl_mtx *x, struct zsl_vec *y,
+				 struct zsl_vec *w, struct zsl_vec *b,
+				 zsl_real_t *r)
+{
+	size_t p = x->sz_cols + 1;
+	zsl_real_t rt[p * (p + 1)];
+	zsl_real_t nrm[p];
+	zsl_real_t row[p + 1];
+	int rc;
+
+	memset(rt, 0, sizeof(rt));
+	memset(nrm, 0, sizeof(nrm));
+
+	for (size_t i = 0; i < x->sz_rows; i++) {
+		row[0] = 1.;
+		memcpy(&row[1], &x->data[i * x->sz_cols],
+		       x->sz_cols * sizeof(zsl_real_t));
+		row[p] = y->data[i];
+		zsl_sta_ls_push(rt, nrm, p, row,
+				w == NULL ? 1. : ZSL_SQRT(1. / w->data[i]));
+	}
+
+	rc = zsl_sta_ls_solve(rt, nrm, p, x->sz_rows, b->data);
+	if (rc) {
+		/*
+		 * The columns of 'x' aren't linearly independent, so the
+		 * coefficients aren't unique. zsl_mtx_pinv_tol could pick the
+		 * minimum-norm ones, but it needs the whole design matrix in
+		 * memory, where this solver only keeps the p x p factor.
+		 */
+		return rc;
+	}
+
+	*r = zsl_sta_ls_r2(x, y, b);
 
 	return 0;
 }
+
+int zsl_sta_mult_linear_reg(struct zsl_mtx *x, struct zsl_vec *y,
+			    struct zsl_vec *b, zsl_real_t *r)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure matrices and vectors' sizes match. */
+	if (x->sz_rows != y->sz || x->sz_cols + 1 != b->sz) {
+		return -EINVAL;
+	}
 #endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
+	return zsl_sta_ls_linear_reg(x, y, NULL, b, r);
+}
+
 int zsl_sta_weighted_mult_linear_reg(struct zsl_mtx *x, struct zsl_vec *y,
 				     struct zsl_vec *w, struct zsl_vec *b, zsl_real_t *r)
 {
@@ -540,154 +705,430 @@ int zsl_sta_weighted_mult_linear_reg(struct zsl_mtx *x, struct zsl_vec *y,
 	if (x->sz_rows != y->sz || x->sz_cols + 1 != b->sz || x->sz_rows != w->sz) {
 		return -EINVAL;
 	}
-	/* Make sure no weight is zero. */
-	for (size_t k = 0; k < w->sz; k++) {
-		if (ZSL_ABS(w->data[k]) < 1E-6) {
+#endif
+
+	/* Make sure all weights are positive, as 1 / w_i scales the rows. This
+	 * also rejects NaN weights. */
+	for (size_t k = 0; k < x->sz_rows; k++) {
+		if (!(w->data[k] >= 1E-6)) {
 			return -EINVAL;
 		}
 	}
+
+	return zsl_sta_ls_linear_reg(x, y, w, b, r);
+}
+
+int zsl_sta_quad_fit(struct zsl_mtx *m, struct zsl_vec *b)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure matrices and vectors' sizes are adequate. */
+	if (m->sz_cols != 3 || b->sz != 9) {
+		return -EINVAL;
+	}
 #endif
 
-	ZSL_MATRIX_DEF(x_exp, x->sz_rows, (x->sz_cols + 1));
-	ZSL_MATRIX_DEF(x_trans, (x->sz_cols + 1), x->sz_rows);
-	ZSL_MATRIX_DEF(xw, (x->sz_cols + 1), x->sz_rows);
-	ZSL_MATRIX_DEF(xx, (x->sz_cols + 1), (x->sz_cols + 1));
-	ZSL_MATRIX_DEF(xinv, (x->sz_cols + 1), (x->sz_cols + 1));
-	ZSL_MATRIX_DEF(ymtx, y->sz, 1);
-	ZSL_MATRIX_DEF(xtemp, (x->sz_cols + 1), x->sz_rows);
-	ZSL_MATRIX_DEF(bmtx, (x->sz_cols + 1), 1);
-	ZSL_MATRIX_DEF(xtemp2, x->sz_rows, 1);
-	ZSL_MATRIX_DEF(emtx, x->sz_rows, 1);
-	ZSL_MATRIX_DEF(idx, w->sz, w->sz);
-
-	zsl_mtx_init(&idx, zsl_mtx_entry_fn_identity);
-	for (size_t k = 0; k < w->sz; k++) {
-		w->data[k] = 1. / w->data[k];
-		zsl_mtx_scalar_mult_row_d(&idx, k, w->data[k]);
-	}
-
-	zsl_real_t v[x->sz_rows];
-	zsl_mtx_init(&x_exp, NULL);
-	for (size_t i = 0; i < x->sz_rows; i++) {
-		v[i] = 1.;
+	zsl_real_t rt[9 * 10] = { 0.0 };
+	zsl_real_t nrm[9] = { 0.0 };
+	zsl_real_t xv[10];
+	zsl_real_t *mv;
+
+	for (size_t i = 0; i < m->sz_rows; i++) {
+		mv = &m->data[i * 3];
+		xv[0] = mv[0] * mv[0];
+		xv[1] = mv[1] * mv[1];
+		xv[2] = mv[2] * mv[2];
+		xv[3] = 2.0 * mv[0] * mv[1];
+		xv[4] = 2.0 * mv[0] * mv[2];
+		xv[5] = 2.0 * mv[1] * mv[2];
+		xv[6] = 2.0 * mv[0];
+		xv[7] = 2.0 * mv[1];
+		xv[8] = 2.0 * mv[2];
+		xv[9] = 1.0;
+		zsl_sta_ls_push(rt, nrm, 9, xv, 1.0);
 	}
 
-	zsl_mtx_set_col(&x_exp, 0, v);
-	for (size_t j = 0; j < x->sz_cols; j++) {
-		zsl_mtx_get_col(x, j, v);
-		zsl_mtx_set_col(&x_exp, j + 1, v);
+	return zsl_sta_ls_solve(rt, nrm, 9, m->sz_rows, b->data);
+}
+
+int zsl_sta_abs_err(zsl_real_t *val, zsl_real_t *exp_val, zsl_real_t *err)
+{
+	*err = ZSL_ABS(*val - *exp_val);
+
+	return 0;
+}
+
+int zsl_sta_rel_err(zsl_real_t *val, zsl_real_t *exp_val, zsl_real_t *err)
+{
+	*err = ZSL_ABS(100. * *val - 100. * *exp_val) / *exp_val;
+
+	return 0;
+}
+
+int zsl_sta_sta_err(struct zsl_vec *v, zsl_real_t *err)
+{
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v has at least dimension 1. */
+	if (v->sz == 0) {
+		return -EINVAL;
 	}
+#endif
 
-	zsl_mtx_trans(&x_exp, &x_trans);
-	zsl_mtx_mult(&x_trans, &idx, &xw);
-	zsl_mtx_mult(&xw, &x_exp, &xx);
+	zsl_real_t var;
+	zsl_sta_var(v, &var);
+	*err = ZSL_SQRT(var / v->sz);
 
-	zsl_real_t det;
-	zsl_mtx_deter(&xx, &det);
-	if (ZSL_ABS(det) < 1E-6) {
-		/*
-		 * Currently limited to square matrices. pinv could be used,
-		 * but is too resource-intensive to add at the momemt.
-		 */
+	return 0;
+}
+
+int zsl_sta_acc_reset(struct zsl_sta_acc *acc)
+{
+	acc->n = 0;
+	acc->mean = 0.0;
+	acc->m2 = 0.0;
+
+	return 0;
+}
+
+int zsl_sta_acc_push(struct zsl_sta_acc *acc, zsl_real_t x)
+{
+	zsl_real_t d = x - acc->mean;
+
+	acc->n++;
+	acc->mean += d / (zsl_real_t)acc->n;
+	acc->m2 += d * (x - acc->mean);
+
+	return 0;
+}
+
+int zsl_sta_acc_merge(struct zsl_sta_acc *a, struct zsl_sta_acc *b)
+{
+	size_t n = a->n + b->n;
+	zsl_real_t d, f;
+
+	if (b->n == 0) {
+		return 0;
+	}
+
+	/* Combine the partial moments (Chan et al.). */
+	d = b->mean - a->mean;
+	f = (zsl_real_t)b->n / (zsl_real_t)n;
+	a->mean += d * f;
+	a->m2 += b->m2 + d * d * (zsl_real_t)a->n * f;
+	a->n = n;
+
+	return 0;
+}
+
+int zsl_sta_acc_mean(struct zsl_sta_acc *acc, zsl_real_t *m)
+{
+	if (acc->n == 0) {
 		return -EINVAL;
-	} else {
-		zsl_mtx_inv(&xx, &xinv);
 	}
 
-	zsl_mtx_from_arr(&ymtx, y->data);
-	zsl_mtx_mult(&xinv, &xw, &xtemp);
-	zsl_mtx_mult(&xtemp, &ymtx, &bmtx);
-	zsl_vec_from_arr(b, bmtx.data);
+	*m = acc->mean;
 
-	zsl_mtx_mult(&x_exp, &bmtx, &xtemp2);
-	zsl_mtx_sub(&ymtx, &xtemp2, &emtx);
-	zsl_real_t e_norm = 0.0, ymean, ysum = 0.0;
-	zsl_sta_mean(y, &ymean);
-	for (size_t g = 0; g < x->sz_rows; g++) {
-		e_norm += emtx.data[g] * emtx.data[g];
-		ysum += (y->data[g] - ymean) * (y->data[g] - ymean);
+	return 0;
+}
+
+int zsl_sta_acc_var(struct zsl_sta_acc *acc, zsl_real_t *var)
+{
+	if (acc->n < 2) {
+		return -EINVAL;
 	}
 
-	*r = 1. - e_norm / ysum;
+	*var = acc->m2 / (zsl_real_t)(acc->n - 1);
 
 	return 0;
 }
-#endif
 
-#ifndef CONFIG_ZSL_SINGLE_PRECISION
-int zsl_sta_quad_fit(struct zsl_mtx *m, struct zsl_vec *b)
+int zsl_sta_acc_std_dev(struct zsl_sta_acc *acc, zsl_real_t *s)
 {
-#if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure matrices and vectors' sizes are adequate. */
-	if (m->sz_cols != 3 || b->sz != 9) {
+	int rc;
+	zsl_real_t var;
+
+	rc = zsl_sta_acc_var(acc, &var);
+	if (rc) {
+		return rc;
+	}
+
+	*s = ZSL_SQRT(var);
+
+	return 0;
+}
+
+int zsl_sta_acc_xy_reset(struct zsl_sta_acc_xy *acc)
+{
+	acc->n = 0;
+	acc->mean_x = 0.0;
+	acc->mean_y = 0.0;
+	acc->m2_x = 0.0;
+	acc->m2_y = 0.0;
+	acc->c_xy = 0.0;
+
+	return 0;
+}
+
+int zsl_sta_acc_xy_push(struct zsl_sta_acc_xy *acc, zsl_real_t x,
+			zsl_real_t y)
+{
+	zsl_real_t dx = x - acc->mean_x;
+	zsl_real_t dy = y - acc->mean_y;
+
+	acc->n++;
+	acc->mean_x += dx / (zsl_real_t)acc->n;
+	acc->mean_y += dy / (zsl_real_t)acc->n;
+	acc->m2_x += dx * (x - acc->mean_x);
+	acc->m2_y += dy * (y - acc->mean_y);
+	acc->c_xy += dx * (y - acc->mean_y);
+
+	return 0;
+}
+
+int zsl_sta_acc_xy_merge(struct zsl_sta_acc_xy *a, struct zsl_sta_acc_xy *b)
+{
+	size_t n = a->n + b->n;
+	zsl_real_t dx, dy, f;
+
+	if (b->n == 0) {
+		return 0;
+	}
+
+	dx = b->mean_x - a->mean_x;
+	dy = b->mean_y - a->mean_y;
+	f = (zsl_real_t)b->n / (zsl_real_t)n;
+	a->mean_x += dx * f;
+	a->mean_y += dy * f;
+	a->m2_x += b->m2_x + dx * dx * (zsl_real_t)a->n * f;
+	a->m2_y += b->m2_y + dy * dy * (zsl_real_t)a->n * f;
+	a->c_xy += b->c_xy + dx * dy * (zsl_real_t)a->n * f;
+	a->n = n;
+
+	return 0;
+}
+
+int zsl_sta_acc_xy_covar(struct zsl_sta_acc_xy *acc, zsl_real_t *c)
+{
+	if (acc->n < 2) {
 		return -EINVAL;
 	}
-#endif
 
-	ZSL_MATRIX_DEF(x, m->sz_rows, 9);
-	ZSL_VECTOR_DEF(xv, 9);
-	ZSL_VECTOR_DEF(mv, 3);
-	ZSL_MATRIX_DEF(y, m->sz_rows, 1);
+	*c = acc->c_xy / (zsl_real_t)(acc->n - 1);
 
-	for (size_t i = 0; i < m->sz_rows; i++) {
-		zsl_mtx_get_row(m, i, mv.data);
-		xv.data[0] = mv.data[0] * mv.data[0];
-		xv.data[1] = mv.data[1] * mv.data[1];
-		xv.data[2] = mv.data[2] * mv.data[2];
-		xv.data[3] = 2.0 * mv.data[0] * mv.data[1];
-		xv.data[4] = 2.0 * mv.data[0] * mv.data[2];
-		xv.data[5] = 2.0 * mv.data[1] * mv.data[2];
-		xv.data[6] = 2.0 * mv.data[0];
-		xv.data[7] = 2.0 * mv.data[1];
-		xv.data[8] = 2.0 * mv.data[2];
-		zsl_mtx_set_row(&x, i, xv.data);
-		y.data[i] = 1.0;
+	return 0;
+}
+
+int zsl_sta_acc_xy_linear_reg(struct zsl_sta_acc_xy *acc,
+			      struct zsl_sta_linreg *c)
+{
+	if (acc->n < 2 || acc->m2_x == 0.0) {
+		return -EINVAL;
+	}
+
+	c->slope = acc->c_xy / acc->m2_x;
+	c->intercept = acc->mean_y - c->slope * acc->mean_x;
+
+	/* A constant y has no correlation, rather than 0 / 0. */
+	if (acc->m2_y == 0.0) {
+		c->correlation = 0.0;
+	} else {
+		c->correlation = acc->c_xy / ZSL_SQRT(acc->m2_x * acc->m2_y);
+	}
+
+	return 0;
+}
+
+/** The index of the top level of a quantile sketch. */
+#define ZSL_STA_QSKETCH_TOP (ZSL_STA_QSKETCH_LEVELS - 1)
+
+/**
+ * @brief Returns the next value of the xorshift generator in sketch 'sk'.
+ */
+static uint32_t zsl_sta_qsketch_rand(struct zsl_sta_qsketch *sk)
+{
+	uint32_t x = sk->seed;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	sk->seed = x;
+
+	return x;
+}
+
+/**
+ * @brief Sorts level 'h' of sketch 'sk' and keeps every other value, doubling
+ *        their weight, alternating between the odd and even values.
+ *
+ * @return The number of values kept.
+ */
+static size_t zsl_sta_qsketch_halve(struct zsl_sta_qsketch *sk, size_t h)
+{
+	struct zsl_vec v = { .sz = sk->count[h], .data = sk->data[h] };
+	size_t j = 0;
+
+	zsl_vec_sort(&v, &v);
+	for (size_t i = sk->offset[h]; i < v.sz; i += 2) {
+		v.data[j++] = v.data[i];
+	}
+	sk->offset[h] ^= 1;
+	sk->count[h] = j;
+
+	return j;
+}
+
+/**
+ * @brief Halves every level of sketch 'sk' in place, which doubles the weight
+ *        of every level and frees half of the top level.
+ */
+static void zsl_sta_qsketch_collapse(struct zsl_sta_qsketch *sk)
+{
+	for (size_t h = 0; h < ZSL_STA_QSKETCH_LEVELS; h++) {
+		zsl_sta_qsketch_halve(sk, h);
 	}
+	sk->shift++;
+}
+
+/**
+ * @brief Promotes every other value of the full level 'h' of sketch 'sk',
+ *        below the top level, to level h + 1.
+ */
+static void zsl_sta_qsketch_compact(struct zsl_sta_qsketch *sk, size_t h)
+{
+	/* Make room in the next level first. A collapse also halves 'h'. */
+	if (sk->count[h + 1] + (sk->count[h] + 1) / 2 > ZSL_STA_QSKETCH_K) {
+		if (h + 1 == ZSL_STA_QSKETCH_TOP) {
+			zsl_sta_qsketch_collapse(sk);
+		} else {
+			zsl_sta_qsketch_compact(sk, h + 1);
+		}
+	}
+
+	zsl_sta_qsketch_halve(sk, h);
+	memcpy(&sk->data[h + 1][sk->count[h + 1]], sk->data[h],
+	       sk->count[h] * sizeof(zsl_real_t));
+	sk->count[h + 1] += sk->count[h];
+	sk->count[h] = 0;
+}
+
+/**
+ * @brief Adds 'x', with a weight of 2^e, to sketch 'sk'.
+ */
+static void zsl_sta_qsketch_add(struct zsl_sta_qsketch *sk, zsl_real_t x,
+				size_t e)
+{
+	size_t h;
+
+	for (;;) {
+		/* Values lighter than level 0 are kept at random, with a
+		 * probability that preserves their expected weight. */
+		if (e < sk->shift) {
+			if (sk->shift - e >= 32 ||
+			    (zsl_sta_qsketch_rand(sk) &
+			     ((1UL << (sk->shift - e)) - 1)) != 0) {
+				return;
+			}
+			e = sk->shift;
+		}
+
+		h = e - sk->shift;
+		if (h > ZSL_STA_QSKETCH_TOP) {
+			zsl_sta_qsketch_collapse(sk);
+			continue;
+		}
 
-	ZSL_MATRIX_DEF(xt, 9, m->sz_rows);
-	ZSL_MATRIX_DEF(xtx, 9, 9);
-	ZSL_MATRIX_DEF(inv, 9, 9);
-	ZSL_MATRIX_DEF(xtmp, 9, (m->sz_rows));
-	ZSL_MATRIX_DEF(btmp, 9, 1);
+		if (sk->count[h] < ZSL_STA_QSKETCH_K) {
+			sk->data[h][sk->count[h]++] = x;
+			return;
+		}
 
-	zsl_mtx_trans(&x, &xt);
-	zsl_mtx_mult(&xt, &x, &xtx);
-	zsl_mtx_inv(&xtx, &inv);
-	zsl_mtx_mult(&inv, &xt, &xtmp);
-	zsl_mtx_mult(&xtmp, &y, &btmp);
+		/* The level is full. Either may change sk->shift. */
+		if (h == ZSL_STA_QSKETCH_TOP) {
+			zsl_sta_qsketch_collapse(sk);
+		} else {
+			zsl_sta_qsketch_compact(sk, h);
+		}
+	}
+}
 
-	zsl_vec_from_arr(b, btmp.data);
+int zsl_sta_qsketch_reset(struct zsl_sta_qsketch *sk)
+{
+	memset(sk, 0, sizeof(*sk));
+	sk->seed = 0x2545F491;
 
 	return 0;
 }
-#endif
 
-int zsl_sta_abs_err(zsl_real_t *val, zsl_real_t *exp_val, zsl_real_t *err)
+int zsl_sta_qsketch_insert(struct zsl_sta_qsketch *sk, zsl_real_t x)
 {
-	*err = ZSL_ABS(*val - *exp_val);
+	zsl_sta_qsketch_add(sk, x, 0);
+	sk->n++;
 
 	return 0;
 }
 
-int zsl_sta_rel_err(zsl_real_t *val, zsl_real_t *exp_val, zsl_real_t *err)
+int zsl_sta_qsketch_merge(struct zsl_sta_qsketch *a, struct zsl_sta_qsketch *b)
 {
-	*err = ZSL_ABS(100. * *val - 100. * *exp_val) / *exp_val;
+	for (size_t h = 0; h < ZSL_STA_QSKETCH_LEVELS; h++) {
+		for (size_t i = 0; i < b->count[h]; i++) {
+			zsl_sta_qsketch_add(a, b->data[h][i], h + b->shift);
+		}
+	}
+
+	a->n += b->n;
 
 	return 0;
 }
 
-int zsl_sta_sta_err(struct zsl_vec *v, zsl_real_t *err)
+int zsl_sta_qsketch_percentile(struct zsl_sta_qsketch *sk, zsl_real_t p,
+			       zsl_real_t *val)
 {
+	struct zsl_vec v;
+	size_t idx[ZSL_STA_QSKETCH_LEVELS] = { 0 };
+	size_t total = 0;
+	size_t cum = 0;
+	size_t k[2];
+	zsl_real_t q[2];
+	size_t h, best, r = 0;
+
 #if CONFIG_ZSL_BOUNDS_CHECKS
-	/* Make sure v has at least dimension 1. */
-	if (v->sz == 0) {
+	/* Make sure p is between 0 and 100. */
+	if (p > 100.0 || p < 0.0) {
 		return -EINVAL;
 	}
 #endif
 
-	zsl_real_t var;
-	zsl_sta_var(v, &var);
-	*err = ZSL_SQRT(var / v->sz);
+	for (h = 0; h < ZSL_STA_QSKETCH_LEVELS; h++) {
+		v.sz = sk->count[h];
+		v.data = sk->data[h];
+		zsl_vec_sort(&v, &v);
+		total += v.sz << (h + sk->shift);
+	}
+
+	if (total == 0) {
+		return -EINVAL;
+	}
+
+	/* Walk the levels in ascending order of value, as in a merge, until
+	 * the cumulative weight passes both ranks. */
+	zsl_sta_percentile_ranks(total, p, &k[0], &k[1]);
+	while (r < 2) {
+		best = ZSL_STA_QSKETCH_LEVELS;
+		for (h = 0; h < ZSL_STA_QSKETCH_LEVELS; h++) {
+			if (idx[h] < sk->count[h] &&
+			    (best == ZSL_STA_QSKETCH_LEVELS ||
+			     sk->data[h][idx[h]] < sk->data[best][idx[best]])) {
+				best = h;
+			}
+		}
+
+		cum += (size_t)1 << (best + sk->shift);
+		while (r < 2 && k[r] < cum) {
+			q[r++] = sk->data[best][idx[best]];
+		}
+		idx[best]++;
+	}
+
+	*val = (q[1] + q[0]) / 2.;
 
 	return 0;
 }
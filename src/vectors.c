@@ -10,12 +10,18 @@
 #include <string.h>
 #include <zsl/vectors.h>
 #include <zsl/zsl.h>
+#include <zsl/fastmath.h>
 
 /* Enable optimised ARM Thumb/Thumb2 functions if available. */
 #if (CONFIG_ZSL_PLATFORM_OPT == 1 || CONFIG_ZSL_PLATFORM_OPT == 2)
 #include <zsl/asm/arm/asm_arm_vectors.h>
 #endif
 
+/* Enable optimised x86-64 SSE2/AVX functions if available. */
+#if (CONFIG_ZSL_PLATFORM_OPT == 3)
+#include <zsl/asm/x86/asm_x86_vectors.h>
+#endif
+
 int zsl_vec_init(struct zsl_vec *v)
 {
 	memset(v->data, 0, v->sz * sizeof(zsl_real_t));
@@ -85,6 +91,7 @@ int zsl_vec_add(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
 }
 #endif
 
+#if !asm_vec_sub
 int zsl_vec_sub(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
 {
 #if CONFIG_ZSL_BOUNDS_CHECKS
@@ -100,6 +107,7 @@ int zsl_vec_sub(struct zsl_vec *v, struct zsl_vec *w, struct zsl_vec *x)
 
 	return 0;
 }
+#endif
 
 int zsl_vec_neg(struct zsl_vec *v)
 {
@@ -196,6 +204,7 @@ zsl_real_t zsl_vec_dist(struct zsl_vec *v, struct zsl_vec *w)
 	return zsl_vec_norm(&x);
 }
 
+#if !asm_vec_dot
 int zsl_vec_dot(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *d)
 {
 	zsl_real_t res = 0.0;
@@ -215,7 +224,9 @@ int zsl_vec_dot(struct zsl_vec *v, struct zsl_vec *w, zsl_real_t *d)
 
 	return 0;
 }
+#endif
 
+#if !asm_vec_norm
 zsl_real_t zsl_vec_norm(struct zsl_vec *v)
 {
 	/*
@@ -226,6 +237,7 @@ zsl_real_t zsl_vec_norm(struct zsl_vec *v)
 	}
 	return ZSL_SQRT(zsl_vec_sum_of_sqrs(v));
 }
+#endif
 
 int zsl_vec_project(struct zsl_vec *u, struct zsl_vec *v, struct zsl_vec *w)
 {
@@ -249,7 +261,7 @@ int zsl_vec_project(struct zsl_vec *u, struct zsl_vec *v, struct zsl_vec *w)
 
 int zsl_vec_to_unit(struct zsl_vec *v)
 {
-	zsl_real_t norm = zsl_vec_norm(v);
+	zsl_real_t norm2;
 
 	/*
 	 *            v
@@ -257,9 +269,11 @@ int zsl_vec_to_unit(struct zsl_vec *v)
 	 *           |v|
 	 */
 
+	zsl_vec_dot(v, v, &norm2);
+
 	/* Avoid divide by zero errors. */
-	if (norm != 0.0) {
-		zsl_vec_scalar_mult(v, 1.0 / norm);
+	if (norm2 != 0.0) {
+		zsl_vec_scalar_mult(v, ZSL_FAST_RSQRT(norm2));
 	} else {
 		/* TODO: What is the best approach here? */
 		/* On div by zero clear vector and return v[0] = 1.0. */
@@ -429,85 +443,255 @@ int zsl_vec_contains(struct zsl_vec *v, zsl_real_t val, zsl_real_t eps)
 }
 
 /**
- * @brief Quicksort implementation used by zsl_vec_sort.
- *
- * @param v    	Unsorted input vector.
- * @param low 	Low index value.
- * @param high  High index value.
+ * Partitions of this many elements or fewer are finished with an insertion
+ * sort, which beats further partitioning on short runs.
+ */
+#define ZSL_VEC_SORT_INSERTION_SZ (16U)
+
+static inline void zsl_vec_sort_swap(zsl_real_t *a, zsl_real_t *b)
+{
+	zsl_real_t t = *a;
+
+	*a = *b;
+	*b = t;
+}
+
+/**
+ * @brief Insertion sort used by zsl_vec_sort for short partitions.
  *
- * @return 0 if everything executed properly, otherwise a negative error code.
+ * @param d     The values to sort in place.
+ * @param n     The number of values in 'd'.
  */
-static int zsl_vec_quicksort(struct zsl_vec *v, size_t low, size_t high)
+static void zsl_vec_insertion_sort(zsl_real_t *d, size_t n)
 {
-	size_t i, j, p;
 	zsl_real_t t;
+	size_t j;
 
-	if (low < high) {
-		p = low;
-		i = low;
-		j = high;
+	for (size_t i = 1; i < n; i++) {
+		t = d[i];
+		for (j = i; j > 0 && d[j - 1] > t; j--) {
+			d[j] = d[j - 1];
+		}
+		d[j] = t;
+	}
+}
 
-		while (i < j) {
-			while (v->data[i] <= v->data[p] && i <= high) {
-				i++;
+/**
+ * @brief Heapsort used by zsl_vec_sort when partitioning degrades, which
+ *        bounds the worst case to O(n log n).
+ *
+ * @param d     The values to sort in place.
+ * @param n     The number of values in 'd'.
+ */
+static void zsl_vec_heapsort(zsl_real_t *d, size_t n)
+{
+	size_t root, child, end;
+
+	/* Build a max-heap, then repeatedly move the largest value to the end
+	 * and sift the new root down. */
+	for (size_t start = n / 2; start-- > 0;) {
+		for (root = start; (child = 2 * root + 1) < n; root = child) {
+			if (child + 1 < n && d[child] < d[child + 1]) {
+				child++;
 			}
-			while (v->data[j] > v->data[p] && j >= low) {
-				j--;
+			if (d[root] >= d[child]) {
+				break;
 			}
-			if (i < j) {
-				t = v->data[i];
-				v->data[i] = v->data[j];
-				v->data[j] = t;
+			zsl_vec_sort_swap(&d[root], &d[child]);
+		}
+	}
+
+	for (end = n - 1; end > 0; end--) {
+		zsl_vec_sort_swap(&d[0], &d[end]);
+		for (root = 0; (child = 2 * root + 1) < end; root = child) {
+			if (child + 1 < end && d[child] < d[child + 1]) {
+				child++;
+			}
+			if (d[root] >= d[child]) {
+				break;
 			}
+			zsl_vec_sort_swap(&d[root], &d[child]);
 		}
+	}
+}
 
-		t = v->data[j];
-		v->data[j] = v->data[p];
-		v->data[p] = t;
+/**
+ * @brief Partitions 'n' > 2 values around a median-of-three pivot, using a
+ *        Hoare partition, which handles repeated values without degrading.
+ *
+ * @param d     The values to partition in place.
+ * @param n     The number of values in 'd'.
+ *
+ * @return The index 'i', with 0 < i < n, such that no value in d[0..i) is
+ *         greater than any value in d[i..n).
+ */
+static size_t zsl_vec_partition(zsl_real_t *d, size_t n)
+{
+	size_t i, j, mid;
+	zsl_real_t p;
 
-		zsl_vec_quicksort(v, low, i - 1);
-		zsl_vec_quicksort(v, j + 1, high);
+	/* Order the first, middle and last values, so that the first and last
+	 * act as sentinels for the scans below. */
+	mid = n / 2;
+	if (d[mid] < d[0]) {
+		zsl_vec_sort_swap(&d[mid], &d[0]);
+	}
+	if (d[n - 1] < d[mid]) {
+		zsl_vec_sort_swap(&d[n - 1], &d[mid]);
+		if (d[mid] < d[0]) {
+			zsl_vec_sort_swap(&d[mid], &d[0]);
+		}
 	}
+	p = d[mid];
 
-	return 0;
+	/* Values below 'i' are <= p, values above 'j' are >= p. The explicit
+	 * bounds only matter for unordered values (NaN). */
+	i = 0;
+	j = n - 1;
+	for (;;) {
+		while (d[++i] < p && i < n - 1) {
+		}
+		while (d[--j] > p && j > 0) {
+		}
+		if (i >= j) {
+			return i;
+		}
+		zsl_vec_sort_swap(&d[i], &d[j]);
+	}
 }
 
-int zsl_vec_sort(struct zsl_vec *v, struct zsl_vec *w)
+/**
+ * @brief Introsort implementation used by zsl_vec_sort.
+ *
+ * Quicksort that only recurses into the smaller partition, so the recursion
+ * depth is at most log2(n), and falls back to heapsort for partitions that
+ * recurse more than 'depth' times.
+ *
+ * @param d     The values to sort in place.
+ * @param n     The number of values in 'd'.
+ * @param depth The number of partitioning passes left before falling back to
+ *              heapsort.
+ */
+static void zsl_vec_introsort(zsl_real_t *d, size_t n, size_t depth)
 {
-	/* Set counters to zero. */
-	size_t count = 0;
-	size_t count2 = 0;
-	size_t i, j, k;
+	size_t i;
 
-	ZSL_VECTOR_DEF(u, v->sz);
-	zsl_vec_init(&u);
+	while (n > ZSL_VEC_SORT_INSERTION_SZ) {
+		if (depth == 0) {
+			zsl_vec_heapsort(d, n);
+			return;
+		}
+		depth--;
+
+		i = zsl_vec_partition(d, n);
+
+		/* Recurse into the smaller half, iterate on the larger one. */
+		if (i < n - i) {
+			zsl_vec_introsort(d, i, depth);
+			d += i;
+			n -= i;
+		} else {
+			zsl_vec_introsort(d + i, n - i, depth);
+			n = i;
+		}
+	}
 
-	/* Copy the vector 'v' into the vector 'u' with no repeated values. */
-	for (j = 0; j < v->sz; j++) {
-		if (v->data[j] >= 1E-5 || v->data[j] <= 1E-5) {
-			if (zsl_vec_contains(&u, v->data[j], 1E-5) == 0) {
-				u.data[count] = v->data[j];
-				count++;
-			}
+	zsl_vec_insertion_sort(d, n);
+}
+
+/**
+ * @brief Introselect implementation used by zsl_vec_select.
+ *
+ * Like zsl_vec_introsort, but only partitions that contain one of the
+ * requested ranks are processed further, which takes O(n) time on average
+ * for a fixed number of ranks.
+ *
+ * @param d     The values to partially sort in place.
+ * @param n     The number of values in 'd'.
+ * @param k     Ascending ranks to place, offset by 'base'.
+ * @param nk    The number of ranks in 'k'.
+ * @param base  The index of d[0] in the complete vector.
+ * @param depth The number of partitioning passes left before falling back to
+ *              heapsort.
+ */
+static void zsl_vec_introselect(zsl_real_t *d, size_t n, size_t *k, size_t nk,
+				size_t base, size_t depth)
+{
+	size_t i, m;
+
+	while (nk > 0) {
+		if (n <= ZSL_VEC_SORT_INSERTION_SZ) {
+			zsl_vec_insertion_sort(d, n);
+			return;
+		}
+		if (depth == 0) {
+			zsl_vec_heapsort(d, n);
+			return;
+		}
+		depth--;
+
+		i = zsl_vec_partition(d, n);
+
+		/* Ranks below base + i are in the left partition. */
+		for (m = 0; m < nk && k[m] < base + i; m++) {
 		}
+
+		zsl_vec_introselect(d, i, k, m, base, depth);
+		d += i;
+		n -= i;
+		k += m;
+		nk -= m;
+		base += i;
+	}
+}
+
+int zsl_vec_sort(struct zsl_vec *v, struct zsl_vec *w)
+{
+	size_t depth = 0;
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure v and w are equal length. */
+	if (v->sz != w->sz) {
+		return -EINVAL;
 	}
+#endif
 
-	if (zsl_vec_contains(v, 0.0, 1E-5) > 0) {
-		count++;
+	if (w->data != v->data) {
+		memcpy(w->data, v->data, v->sz * sizeof(zsl_real_t));
 	}
 
-	u.sz = count;
+	/* Allow 2 * log2(n) partitioning passes before using heapsort. */
+	for (size_t n = v->sz; n > 1; n >>= 1) {
+		depth += 2;
+	}
+
+	zsl_vec_introsort(w->data, v->sz, depth);
+
+	return 0;
+}
 
-	/* Sort the vector with no repeated values 'u'. */
-	zsl_vec_quicksort(&u, 0, count - 1);
+int zsl_vec_select(struct zsl_vec *v, size_t *k, size_t n, zsl_real_t *val)
+{
+	size_t depth = 0;
 
-	/* Add back the repeated values in the correct order into the vector 'w'. */
-	for (i = 0; i < count; i++) {
-		for (k = 0; k < zsl_vec_contains(v, u.data[i], 1E-5); k++) {
-			w->data[count2] = u.data[i];
-			count2++;
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Make sure the ranks are ascending and within v. */
+	for (size_t i = 0; i < n; i++) {
+		if (k[i] >= v->sz || (i > 0 && k[i] < k[i - 1])) {
+			return -EINVAL;
 		}
 	}
+#endif
+
+	for (size_t sz = v->sz; sz > 1; sz >>= 1) {
+		depth += 2;
+	}
+
+	zsl_vec_introselect(v->data, v->sz, k, n, 0, depth);
+
+	for (size_t i = 0; i < n; i++) {
+		val[i] = v->data[k[i]];
+	}
 
 	return 0;
 }
@@ -90,6 +90,45 @@ ZTEST(zsl_tests, test_fus_cal_rot_axis_angle)
 	zassert_true(rc == -EINVAL, NULL);
 }
 
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+/**
+ * Fills the 26x3 matrix 'e' with one sample in each of the 26 directions of
+ * the unit cube around the origin, on the ellipsoid |kt(H + bt)| = 50.
+ */
+static void cal_ellipsoid(struct zsl_mtx *e, zsl_real_t *kt, zsl_real_t *bt)
+{
+	ZSL_MATRIX_DEF(Kt, 3, 3);
+	ZSL_MATRIX_DEF(Ki, 3, 3);
+	ZSL_MATRIX_DEF(U, 3, 1);
+	ZSL_MATRIX_DEF(H, 3, 1);
+	ZSL_VECTOR_DEF(u, 3);
+	size_t n = 0;
+
+	zsl_mtx_from_arr(&Kt, kt);
+	zsl_mtx_inv(&Kt, &Ki);
+	for (int x = -1; x <= 1; x++) {
+		for (int y = -1; y <= 1; y++) {
+			for (int z = -1; z <= 1; z++) {
+				if (x == 0 && y == 0 && z == 0) {
+					continue;
+				}
+				u.data[0] = x;
+				u.data[1] = y;
+				u.data[2] = z;
+				zsl_vec_to_unit(&u);
+				zsl_vec_scalar_mult(&u, 50.0);
+				zsl_mtx_from_arr(&U, u.data);
+				zsl_mtx_mult(&Ki, &U, &H);
+				for (size_t i = 0; i < 3; i++) {
+					e->data[n * 3 + i] = H.data[i] - bt[i];
+				}
+				n++;
+			}
+		}
+	}
+}
+#endif
+
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
 ZTEST(zsl_tests_double, test_fus_cal_magn)
 {
@@ -121,26 +160,49 @@ ZTEST(zsl_tests_double, test_fus_cal_magn)
 		-9.0, -2.8,  7.3
 	};
 
-	/* Assign arrays to matrices. */
-	rc = zsl_mtx_from_arr(&m, a);
-	zassert_true(rc == 0, NULL);
+	/* Soft and hard iron errors of the samples in 'e'. */
+	zsl_real_t kt[9] = {
+		1.20,  0.10, -0.05,
+		0.10,  0.90,  0.08,
+		-0.05,  0.08,  1.10
+	};
+	zsl_real_t bt[3] = { -12.5, 4.2, 30.1 };
+
+	ZSL_MATRIX_DEF(e, 26, 3);
+	ZSL_VECTOR_DEF(h, 3);
+	ZSL_VECTOR_DEF(c, 3);
+	zsl_real_t s;
+
+	cal_ellipsoid(&e, kt, bt);
 
-	/* Compute the ellipsoid fitting. */
-	rc = zsl_fus_cal_magn(&m, &l, &mu, &K, &b);
+	/* Compute the ellipsoid fitting. The radius of the fitted ellipsoid
+	 * comes from the sphere fitting, so K matches Kt up to a scale. */
+	rc = zsl_fus_cal_magn(&e, &l, &mu, &K, &b);
 	zassert_true(rc == 0, NULL);
-	zassert_true(val_is_equal(K.data[0], 0.600621, 1E-6), NULL);
-	zassert_true(val_is_equal(K.data[1], -0.610451, 1E-6), NULL);
-	zassert_true(val_is_equal(K.data[2], -0.318351, 1E-6), NULL);
-	zassert_true(val_is_equal(K.data[3], -0.610451, 1E-6), NULL);
-	zassert_true(val_is_equal(K.data[4], 1.968980, 1E-6), NULL);
-	zassert_true(val_is_equal(K.data[5], 0.152699, 1E-6), NULL);
-	zassert_true(val_is_equal(K.data[6], -0.318351, 1E-6), NULL);
-	zassert_true(val_is_equal(K.data[7], 0.152699, 1E-6), NULL);
-	zassert_true(val_is_equal(K.data[8], 2.868776, 1E-6), NULL);
+	s = kt[0] / K.data[0];
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(K.data[i] * s, kt[i], 1E-6), NULL);
+	}
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(b.data[i], bt[i], 1E-6), NULL);
+	}
+
+	/* All corrected samples lie on the same sphere. */
+	zsl_mtx_get_row(&e, 0, h.data);
+	zsl_fus_cal_corr_vec(&h, &K, &b, &c);
+	s = zsl_vec_norm(&c);
+	for (size_t j = 1; j < e.sz_rows; j++) {
+		zsl_mtx_get_row(&e, j, h.data);
+		zsl_fus_cal_corr_vec(&h, &K, &b, &c);
+		zassert_true(val_is_equal(zsl_vec_norm(&c), s, 1E-6), NULL);
+	}
+
+	/* The damping parameter is left unchanged. */
+	zassert_true(val_is_equal(l, 1.0, 1E-12), NULL);
 
-	zassert_true(val_is_equal(b.data[0], -1.211677, 1E-6), NULL);
-	zassert_true(val_is_equal(b.data[1], -1.842987, 1E-6), NULL);
-	zassert_true(val_is_equal(b.data[2], 0.087542, 1E-6), NULL);
+	/* Assign arrays to matrices. */
+	rc = zsl_mtx_from_arr(&m, a);
+	zassert_true(rc == 0, NULL);
 
 	/* Special cases where inputs are invalid. */
 	rc = zsl_fus_cal_magn(&m2, &l, &mu, &K, &b);
@@ -221,6 +283,208 @@ ZTEST(zsl_tests_double, test_fus_cal_magn_fast)
 }
 #endif
 
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+ZTEST(zsl_tests_double, test_fus_cal_magn_acc)
+{
+	int rc = 0;
+
+	struct zsl_fus_cal_magn_acc acc;
+
+	ZSL_MATRIX_DEF(e, 26, 3);
+	ZSL_MATRIX_DEF(e2, 26, 3);
+	ZSL_MATRIX_DEF(K, 3, 3);
+	ZSL_MATRIX_DEF(K2, 3, 4);
+	ZSL_VECTOR_DEF(b, 3);
+	ZSL_VECTOR_DEF(b2, 4);
+	ZSL_VECTOR_DEF(h, 3);
+	ZSL_VECTOR_DEF(h2, 4);
+	ZSL_VECTOR_DEF(c, 3);
+
+	zsl_real_t me = 50.0, me2 = -7.0;
+
+	/* Soft and hard iron errors of the samples in 'e' and 'e2'. */
+	zsl_real_t kt[9] = {
+		1.20,  0.10, -0.05,
+		0.10,  0.90,  0.08,
+		-0.05,  0.08,  1.10
+	};
+	zsl_real_t bt[3] = { -12.5, 4.2, 30.1 };
+	zsl_real_t kt2[9] = {
+		0.95, -0.04,  0.02,
+		-0.04,  1.05,  0.00,
+		0.02,  0.00,  0.98
+	};
+	zsl_real_t bt2[3] = { -10.0, 6.0, 27.5 };
+
+	cal_ellipsoid(&e, kt, bt);
+	cal_ellipsoid(&e2, kt2, bt2);
+
+	/* Push the samples one by one. Nine are needed for a solution. */
+	rc = zsl_fus_cal_magn_acc_init(&acc, &me, 1.0);
+	zassert_true(rc == 0, NULL);
+	for (size_t j = 0; j < e.sz_rows; j++) {
+		zsl_mtx_get_row(&e, j, h.data);
+		rc = zsl_fus_cal_magn_acc_push(&acc, &h);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_fus_cal_magn_acc_solve(&acc, &K, &b);
+		zassert_true(rc == (j < 8 ? -EINVAL : 0), NULL);
+	}
+
+	/* Samples on |Kt(H + bt)| = me give back Kt and bt. */
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(K.data[i], kt[i], 1E-6), NULL);
+	}
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(b.data[i], bt[i], 1E-6), NULL);
+	}
+
+	/* The output corrects the samples onto the sphere of radius me. */
+	for (size_t j = 0; j < e.sz_rows; j++) {
+		zsl_mtx_get_row(&e, j, h.data);
+		rc = zsl_fus_cal_corr_vec(&h, &K, &b, &c);
+		zassert_true(rc == 0, NULL);
+		zassert_true(val_is_equal(zsl_vec_norm(&c), me, 1E-6), NULL);
+	}
+
+	/* With a forgetting factor, the calibration follows the sensor once its
+	 * errors change. */
+	rc = zsl_fus_cal_magn_acc_init(&acc, NULL, 0.9);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(acc.me, 50.0, 1E-12), NULL);
+	for (size_t j = 0; j < e.sz_rows; j++) {
+		zsl_mtx_get_row(&e, j, h.data);
+		zsl_fus_cal_magn_acc_push(&acc, &h);
+	}
+	for (size_t k = 0; k < 10; k++) {
+		for (size_t j = 0; j < e2.sz_rows; j++) {
+			zsl_mtx_get_row(&e2, j, h.data);
+			zsl_fus_cal_magn_acc_push(&acc, &h);
+		}
+	}
+	rc = zsl_fus_cal_magn_acc_solve(&acc, &K, &b);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(K.data[i], kt2[i], 1E-6), NULL);
+	}
+	for (size_t i = 0; i < 3; i++) {
+		zassert_true(val_is_equal(b.data[i], bt2[i], 1E-6), NULL);
+	}
+
+	/* Samples on a plane don't describe an ellipsoid. */
+	rc = zsl_fus_cal_magn_acc_init(&acc, &me, 1.0);
+	zassert_true(rc == 0, NULL);
+	for (size_t j = 0; j < 20; j++) {
+		h.data[0] = 40.0 * ZSL_COS(0.3 * j);
+		h.data[1] = 30.0 * ZSL_SIN(0.3 * j) + j;
+		h.data[2] = 5.0;
+		zsl_fus_cal_magn_acc_push(&acc, &h);
+	}
+	rc = zsl_fus_cal_magn_acc_solve(&acc, &K, &b);
+	zassert_true(rc == -ESINGULAR, NULL);
+
+	/* Special cases where inputs are invalid. */
+	rc = zsl_fus_cal_magn_acc_init(&acc, &me2, 1.0);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fus_cal_magn_acc_init(&acc, &me, 0.0);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fus_cal_magn_acc_init(&acc, &me, 1.5);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fus_cal_magn_acc_push(&acc, &h2);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fus_cal_magn_acc_solve(&acc, &K2, &b);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fus_cal_magn_acc_solve(&acc, &K, &b2);
+	zassert_true(rc == -EINVAL, NULL);
+}
+#endif
+
+ZTEST(zsl_tests, test_fus_cal_gyro_acc)
+{
+	int rc = 0;
+
+	struct zsl_fus_cal_gyro_acc acc;
+
+	ZSL_VECTOR_DEF(g, 3);
+	ZSL_VECTOR_DEF(g2, 4);
+	ZSL_VECTOR_DEF(b, 3);
+	ZSL_VECTOR_DEF(b2, 4);
+
+	rc = zsl_fus_cal_gyro_acc_init(&acc, 0.1, 0.05);
+	zassert_true(rc == 0, NULL);
+
+	/* No bias is available before the first sample at rest. */
+	rc = zsl_fus_cal_gyro_acc_bias(&acc, &b);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* The first 1 / alpha samples at rest are simply averaged. */
+	for (size_t j = 0; j < 10; j++) {
+		zsl_real_t d = (j % 2) ? 0.002 : -0.002;
+
+		g.data[0] = 0.010 + d;
+		g.data[1] = -0.020 - d;
+		g.data[2] = 0.005;
+		rc = zsl_fus_cal_gyro_acc_push(&acc, &g);
+		zassert_true(rc == 0, NULL);
+	}
+
+	rc = zsl_fus_cal_gyro_acc_bias(&acc, &b);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(b.data[0], -0.010, 1E-6), NULL);
+	zassert_true(val_is_equal(b.data[1], 0.020, 1E-6), NULL);
+	zassert_true(val_is_equal(b.data[2], -0.005, 1E-6), NULL);
+
+	/* Samples taken while moving are ignored. */
+	g.data[0] = 0.8;
+	g.data[1] = -0.3;
+	g.data[2] = 0.1;
+	rc = zsl_fus_cal_gyro_acc_push(&acc, &g);
+	zassert_true(rc == -EAGAIN, NULL);
+	rc = zsl_fus_cal_gyro_acc_bias(&acc, &b);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(b.data[0], -0.010, 1E-6), NULL);
+
+	/* After that, new samples at rest have a weight of alpha. */
+	g.data[0] = 0.020;
+	g.data[1] = -0.020;
+	g.data[2] = 0.005;
+	rc = zsl_fus_cal_gyro_acc_push(&acc, &g);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_fus_cal_gyro_acc_bias(&acc, &b);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(b.data[0], -0.011, 1E-6), NULL);
+	zassert_true(val_is_equal(b.data[1], 0.020, 1E-6), NULL);
+
+	/* A bias larger than the threshold is seeded by the first sample. */
+	rc = zsl_fus_cal_gyro_acc_init(&acc, 0.1, 0.05);
+	zassert_true(rc == 0, NULL);
+	for (size_t j = 0; j < 20; j++) {
+		zsl_real_t d = (j % 2) ? 0.01 : -0.01;
+
+		g.data[0] = 0.30 + d;
+		g.data[1] = -0.25;
+		g.data[2] = 0.12 - d;
+		rc = zsl_fus_cal_gyro_acc_push(&acc, &g);
+		zassert_true(rc == 0, NULL);
+	}
+	rc = zsl_fus_cal_gyro_acc_bias(&acc, &b);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(b.data[0], -0.30, 1E-3), NULL);
+	zassert_true(val_is_equal(b.data[1], 0.25, 1E-6), NULL);
+	zassert_true(val_is_equal(b.data[2], -0.12, 1E-3), NULL);
+
+	/* Special cases where inputs are invalid. */
+	rc = zsl_fus_cal_gyro_acc_init(&acc, 0.0, 0.05);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fus_cal_gyro_acc_init(&acc, 1.5, 0.05);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fus_cal_gyro_acc_init(&acc, 0.1, 0.0);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fus_cal_gyro_acc_push(&acc, &g2);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_fus_cal_gyro_acc_bias(&acc, &b2);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
 ZTEST(zsl_tests, test_fus_cal_corr_scalar)
 {
 	int rc = 0;
@@ -9,6 +9,7 @@
 #include <zsl/colorimetry.h>
 #include "floatcheck.h"
 #include "data.h"
+#include "../../src/colorimetry/ohno2014.h"
 
 ZTEST(zsl_tests, test_conv_spd_xyz)
 {
@@ -251,3 +252,112 @@ ZTEST(zsl_tests, test_conv_uv60_cct_ohno2014)
 
 	/* TODO: Add further tests! */
 }
+
+ZTEST(zsl_tests, test_conv_uv60_cct_ohno2014_order)
+{
+	int rc;
+	struct zsl_clr_cct cct;
+	struct zsl_clr_cct cct_n[8];
+
+	/* Near 19593 K, near 1000 K, 7243.94 K, 2900 K + Duv 0.02, 2011 K,
+	 * near 19788 K, 2938 K and near 1000 K again, so that each lookup
+	 * starts far from its match. */
+	struct zsl_clr_uv60 uv[8] = {
+		{ .uv60_u = 0.18401170, .uv60_v = 0.27743864 },
+		{ .uv60_u = 0.44806562, .uv60_v = 0.35460468 },
+		{ .uv60_u = 0.197153338321965, .uv60_v = 0.305540116604965 },
+		{ .uv60_u = 0.247629, .uv60_v = 0.367808 },
+		{ .uv60_u = 0.30412, .uv60_v = 0.35898 },
+		{ .uv60_u = 0.18396060, .uv60_v = 0.27728300 },
+		{ .uv60_u = 0.25309737, .uv60_v = 0.34765305 },
+		{ .uv60_u = 0.44806562, .uv60_v = 0.35460468 }
+	};
+
+	/* The lookup in zsl_clr_conv_uv60_cct_n starts from the previous
+	 * match, which shouldn't change the result. */
+	memset(cct_n, 0, sizeof cct_n);
+	rc = zsl_clr_conv_uv60_cct_n(ZSL_CLR_UV_CCT_METHOD_OHNO2014, 8, uv,
+				     cct_n);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 8; i++) {
+		memset(&cct, 0, sizeof cct);
+		rc = zsl_clr_conv_uv60_cct(ZSL_CLR_UV_CCT_METHOD_OHNO2014,
+					   &uv[i], &cct);
+		zassert_true(rc == 0, NULL);
+		zassert_true(cct_n[i].cct == cct.cct, NULL);
+		zassert_true(cct_n[i].duv == cct.duv, NULL);
+		zassert_false(cct_n[i].cct_invalid, NULL);
+		zassert_false(cct_n[i].duv_invalid, NULL);
+	}
+
+	zassert_true(val_is_equal(cct_n[1].cct, 1000.0, 10.0), NULL);
+	zassert_true(val_is_equal(cct_n[2].cct, 7243.94, 10.0), NULL);
+	zassert_true(val_is_equal(cct_n[5].cct, 19788.466262, 20.0), NULL);
+	zassert_true(val_is_equal(cct_n[6].cct, 2938.0, 10.0), NULL);
+
+	/* The search skips blocks of lookup records by their bounding
+	 * circles, so each record must lie inside its block's circle. The
+	 * radius gets 1E-6 of slack for the rounding of the tables in single
+	 * precision, well within the 1E-5 margin of the search. */
+	for (size_t j = 0; j < OHNO2014_LOOKUP_RECS; j++) {
+		const zsl_real_t *bd =
+			zsl_clr_conv_ohno_2014_bound[j / OHNO2014_BLOCK_RECS];
+		zsl_real_t du = zsl_clr_conv_ct_uv_ohno_2014_data[j][1] - bd[0];
+		zsl_real_t dv = zsl_clr_conv_ct_uv_ohno_2014_data[j][2] - bd[1];
+		zsl_real_t r = bd[2] + 1E-6;
+
+		zassert_true(du * du + dv * dv <= r * r, NULL);
+	}
+}
+
+ZTEST(zsl_tests, test_conv_uv60_cct_n)
+{
+	int rc;
+	struct zsl_clr_cct cct;
+	struct zsl_clr_cct cct_n[4];
+	enum zsl_clr_uv_cct_method methods[3] = {
+		ZSL_CLR_UV_CCT_METHOD_MCCAMY,
+		ZSL_CLR_UV_CCT_METHOD_OHNO2011,
+		ZSL_CLR_UV_CCT_METHOD_OHNO2014
+	};
+
+	/* 2011 K, 2900 K + Duv 0.02, 7057.7 K, and below 1000 K. */
+	struct zsl_clr_uv60 uv[4] = {
+		{ .uv60_u = 0.30412, .uv60_v = 0.35898 },
+		{ .uv60_u = 0.247629, .uv60_v = 0.367808 },
+		{ .uv60_u = 0.197888, .uv60_v = 0.306665 },
+		{ .uv60_u = 0.5, .uv60_v = 0.35 }
+	};
+
+	/* Each pair should match a call to zsl_clr_conv_uv60_cct. */
+	for (size_t m = 0; m < 3; m++) {
+		memset(cct_n, 0, sizeof cct_n);
+		rc = zsl_clr_conv_uv60_cct_n(methods[m], 3, uv, cct_n);
+		zassert_true(rc == 0, NULL);
+		for (size_t i = 0; i < 3; i++) {
+			memset(&cct, 0, sizeof cct);
+			rc = zsl_clr_conv_uv60_cct(methods[m], &uv[i], &cct);
+			zassert_true(rc == 0, NULL);
+			zassert_true(val_is_equal(cct_n[i].cct, cct.cct, 1E-6),
+				     NULL);
+			zassert_true(val_is_equal(cct_n[i].duv, cct.duv, 1E-6),
+				     NULL);
+			zassert_true(cct_n[i].cct_invalid == cct.cct_invalid,
+				     NULL);
+			zassert_true(cct_n[i].duv_invalid == cct.duv_invalid,
+				     NULL);
+		}
+	}
+
+	/* An out of range pair is flagged, and the others still converted. */
+	memset(cct_n, 0, sizeof cct_n);
+	rc = zsl_clr_conv_uv60_cct_n(ZSL_CLR_UV_CCT_METHOD_OHNO2014, 4, uv,
+				     cct_n);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(cct_n[3].cct_invalid, NULL);
+	zassert_true(cct_n[3].duv_invalid, NULL);
+	for (size_t i = 0; i < 3; i++) {
+		zassert_false(cct_n[i].cct_invalid, NULL);
+		zassert_false(cct_n[i].duv_invalid, NULL);
+	}
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/fastmath.h>
+#include "floatcheck.h"
+
+ZTEST(zsl_tests, test_fast_horner)
+{
+	zsl_real_t c[4] = { 1.0, -2.0, 0.5, 3.0 };
+	zsl_real_t x;
+
+	for (int i = -20; i <= 20; i++) {
+		x = i * 0.25;
+		zassert_true(val_is_equal(zsl_horner(x, c, 4),
+					  1.0 - 2.0 * x + 0.5 * x * x +
+					  3.0 * x * x * x, 1E-4), NULL);
+	}
+
+	/* No coefficients, or a constant. */
+	zassert_true(val_is_equal(zsl_horner(2.0, c, 0), 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(zsl_horner(2.0, c, 1), 1.0, 1E-6), NULL);
+}
+
+ZTEST(zsl_tests, test_fast_rsqrt)
+{
+	zsl_real_t x;
+
+	/* Relative error over several decades. */
+	for (int i = -30; i <= 30; i++) {
+		x = ZSL_POW(10.0, i * 0.2) * 1.37;
+		zassert_true(val_is_equal(zsl_fast_rsqrt(x) * ZSL_SQRT(x), 1.0,
+					  2E-7), NULL);
+	}
+}
+
+ZTEST(zsl_tests, test_fast_atan2)
+{
+	zsl_real_t a, x, y;
+
+	/* Around the circle, for several radii. */
+	for (int i = -180; i <= 180; i += 5) {
+		a = i * ZSL_PI / 180.0;
+		for (zsl_real_t r = 0.01; r < 1000.0; r *= 10.0) {
+			x = r * ZSL_COS(a);
+			y = r * ZSL_SIN(a);
+			zassert_true(val_is_equal(zsl_fast_atan2(y, x),
+						  ZSL_ATAN2(y, x), 1.2E-5), NULL);
+		}
+	}
+
+	/* Axes and origin. */
+	zassert_true(val_is_equal(zsl_fast_atan2(0.0, 0.0), 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(zsl_fast_atan2(1.0, 0.0), ZSL_PI / 2.0,
+				  1E-6), NULL);
+	zassert_true(val_is_equal(zsl_fast_atan2(-1.0, 0.0), -ZSL_PI / 2.0,
+				  1E-6), NULL);
+	zassert_true(val_is_equal(zsl_fast_atan2(0.0, -1.0), ZSL_PI, 1E-6),
+		     NULL);
+}
+
+ZTEST(zsl_tests, test_fast_asin)
+{
+	zsl_real_t x;
+
+	for (int i = -100; i <= 100; i++) {
+		x = i * 0.01;
+		zassert_true(val_is_equal(zsl_fast_asin(x), ZSL_ASIN(x), 3E-7),
+			     NULL);
+	}
+
+	/* Out of range inputs are clipped. */
+	zassert_true(val_is_equal(zsl_fast_asin(1.5), ZSL_PI / 2.0, 1E-6),
+		     NULL);
+	zassert_true(val_is_equal(zsl_fast_asin(-1.5), -ZSL_PI / 2.0, 1E-6),
+		     NULL);
+}
+
+ZTEST(zsl_tests, test_fast_exp)
+{
+	zsl_real_t x;
+
+	for (int i = -80; i <= 80; i++) {
+		x = i * 0.5;
+		zassert_true(val_is_equal(zsl_fast_exp(x) / ZSL_EXP(x), 1.0,
+					  3E-7), NULL);
+	}
+
+	zassert_true(val_is_equal(zsl_fast_exp(0.0), 1.0, 1E-6), NULL);
+}
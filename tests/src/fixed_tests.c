@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2021 Kevin Townsend
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zsl/zsl.h>
+#include <zsl/fixed.h>
+#include <zsl/orientation/fixed.h>
+#include <zsl/orientation/fusion/fusion.h>
+#include <zsl/orientation/fusion/fixed.h>
+#include "floatcheck.h"
+
+#if CONFIG_ZSL_FIXED
+
+/* Number of filter iterations compared against the floating-point filters. */
+#define FIX_FUS_STEPS 50
+
+static bool quat_q31_is_equal(struct zsl_quat_q31 *qq, struct zsl_quat *q,
+			      zsl_real_t eps)
+{
+	return val_is_equal(zsl_q31_to_real(qq->r), q->r, eps) &&
+	       val_is_equal(zsl_q31_to_real(qq->i), q->i, eps) &&
+	       val_is_equal(zsl_q31_to_real(qq->j), q->j, eps) &&
+	       val_is_equal(zsl_q31_to_real(qq->k), q->k, eps);
+}
+
+/**
+ * Fills 'a', 'm' and 'g', and their Q31 counterparts, with the samples of
+ * step 'i' of a slowly rotating sensor.
+ */
+static void fix_fus_fill(int i, struct zsl_vec *a, struct zsl_vec *m,
+			 struct zsl_vec *g, struct zsl_vec_q31 *aq,
+			 struct zsl_vec_q31 *mq, struct zsl_vec_q31 *gq)
+{
+	zsl_real_t t = (zsl_real_t)i / 10.0;
+
+	a->data[0] = 0.01 + 0.1 * ZSL_SIN(t);
+	a->data[1] = -1.01 + 0.05 * ZSL_COS(t);
+	a->data[2] = -0.02 + 0.1 * ZSL_COS(2.0 * t);
+	m->data[0] = -0.66 + 0.1 * ZSL_COS(t);
+	m->data[1] = -0.98;
+	m->data[2] = -0.43 + 0.1 * ZSL_SIN(t);
+	g->data[0] = 0.09 + 0.2 * ZSL_SIN(t);
+	g->data[1] = -0.28;
+	g->data[2] = -0.07 + 0.3 * ZSL_COS(t);
+
+	for (size_t j = 0; j < 3; j++) {
+		/* The accelerometer and magnetometer are scaled by 1/2 to fit
+		 * Q31, which doesn't change their direction. */
+		aq->data[j] = zsl_q31_from_real(a->data[j] / 2.0);
+		mq->data[j] = zsl_q31_from_real(m->data[j] / 2.0);
+		gq->data[j] = (zsl_q31_t)ZSL_ROUND(g->data[j] *
+						   (1 << ZSL_FIX_GYRO_FRAC));
+	}
+}
+
+ZTEST(zsl_tests, test_fix_arith)
+{
+	/* Saturating arithmetic. */
+	zassert_equal(zsl_q31_add(ZSL_Q31(0.75), ZSL_Q31(0.5)), ZSL_Q31_MAX,
+		      NULL);
+	zassert_equal(zsl_q31_sub(ZSL_Q31(-0.75), ZSL_Q31(0.5)), ZSL_Q31_MIN,
+		      NULL);
+	zassert_equal(zsl_q31_mul(ZSL_Q31_MIN, ZSL_Q31_MIN), ZSL_Q31_MAX, NULL);
+	zassert_equal(zsl_q31_mul(ZSL_Q31(0.5), ZSL_Q31(-0.5)), ZSL_Q31(-0.25),
+		      NULL);
+	zassert_equal(zsl_q15_add(ZSL_Q15(0.75), ZSL_Q15(0.5)), ZSL_Q15_MAX,
+		      NULL);
+	zassert_equal(zsl_q15_mul(ZSL_Q15_MIN, ZSL_Q15_MIN), ZSL_Q15_MAX, NULL);
+	zassert_equal(zsl_q15_mul(ZSL_Q15(0.5), ZSL_Q15(0.25)), ZSL_Q15(0.125),
+		      NULL);
+
+	/* Conversions. */
+	zassert_equal(ZSL_Q31(1.0), ZSL_Q31_MAX, NULL);
+	zassert_equal(ZSL_Q31(-1.0), ZSL_Q31_MIN, NULL);
+	zassert_equal(zsl_q31_from_real(2.0), ZSL_Q31_MAX, NULL);
+	zassert_equal(zsl_q31_from_real(-0.5), ZSL_Q31(-0.5), NULL);
+	zassert_equal(zsl_q15_to_q31(ZSL_Q15(0.5)), ZSL_Q31(0.5), NULL);
+	zassert_equal(zsl_q31_to_q15(ZSL_Q31_MAX), ZSL_Q15_MAX, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(ZSL_Q31(0.3)), 0.3, 1E-9),
+		     NULL);
+
+	/* Division. */
+	zassert_equal(zsl_q31_div(ZSL_Q31(0.25), ZSL_Q31(0.5)), ZSL_Q31(0.5),
+		      NULL);
+	zassert_equal(zsl_q31_div(ZSL_Q31(-0.5), ZSL_Q31(0.25)), ZSL_Q31_MIN,
+		      NULL);
+	zassert_equal(zsl_q31_div(ZSL_Q31(0.5), 0), ZSL_Q31_MAX, NULL);
+	zassert_equal(zsl_q31_div(0, 0), 0, NULL);
+
+	/* Square root. */
+	zassert_equal(zsl_q31_sqrt(ZSL_Q31(0.25)), ZSL_Q31(0.5), NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(zsl_q31_sqrt(ZSL_Q31(0.3))),
+				  ZSL_SQRT(0.3), 1E-7), NULL);
+	zassert_equal(zsl_q31_sqrt(ZSL_Q31(-0.25)), 0, NULL);
+	zassert_equal(zsl_fix_sqrt_u64(1ULL << 62), 1UL << 31, NULL);
+	zassert_equal(zsl_fix_sqrt_u64(99), 9, NULL);
+}
+
+ZTEST(zsl_tests, test_fix_trig)
+{
+	zsl_q31_t s, c, a;
+	zsl_real_t x;
+
+	for (int i = -175; i < 180; i += 7) {
+		x = (zsl_real_t)i * ZSL_PI / 180.0;
+		zsl_q31_sin_cos(ZSL_Q31_DEG(i), &s, &c);
+		zassert_true(val_is_equal(zsl_q31_to_real(s), ZSL_SIN(x), 1E-6),
+			     NULL);
+		zassert_true(val_is_equal(zsl_q31_to_real(c), ZSL_COS(x), 1E-6),
+			     NULL);
+
+		/* The angle of (c, s) is the original angle. */
+		a = zsl_q31_atan2(s, c);
+		zassert_true(val_is_equal(zsl_q31_to_real(a) * ZSL_PI, x, 1E-6),
+			     NULL);
+	}
+
+	/* Only the ratio of the arguments matters. */
+	a = zsl_q31_atan2(3, -4);
+	zassert_true(val_is_equal(zsl_q31_to_real(a) * ZSL_PI,
+				  ZSL_ATAN2(3.0, -4.0), 1E-6), NULL);
+
+	/* Small points below the x axis are scaled up with y negative. */
+	a = zsl_q31_atan2(-3, 4);
+	zassert_true(val_is_equal(zsl_q31_to_real(a) * ZSL_PI,
+				  ZSL_ATAN2(-3.0, 4.0), 1E-6), NULL);
+	a = zsl_q31_atan2(-3, -4);
+	zassert_true(val_is_equal(zsl_q31_to_real(a) * ZSL_PI,
+				  ZSL_ATAN2(-3.0, -4.0), 1E-6), NULL);
+	zassert_equal(zsl_q31_atan2(0, 0), 0, NULL);
+}
+
+ZTEST(zsl_tests, test_fix_vec)
+{
+	int rc;
+	zsl_q31_t d;
+	zsl_q15_t raw[3] = { 1200, -1600, 0 };
+
+	ZSL_VECTOR_Q31_DEF(v, 3);
+	ZSL_VECTOR_Q31_DEF(w, 3);
+	ZSL_VECTOR_Q31_DEF(x, 3);
+	ZSL_VECTOR_Q31_DEF(y, 4);
+
+	rc = zsl_vec_q31_init(&v);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(v.data[0] | v.data[1] | v.data[2], 0, NULL);
+
+	/* Raw samples, normalised to a unit vector. */
+	rc = zsl_vec_q31_from_q15(&v, raw);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(v.data[0], (zsl_q31_t)1200 << 16, NULL);
+	rc = zsl_vec_q31_to_unit(&v);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(v.data[0]), 0.6, 1E-8), NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(v.data[1]), -0.8, 1E-8), NULL);
+	zassert_equal(v.data[2], 0, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(zsl_vec_q31_norm(&v)), 1.0,
+				  1E-8), NULL);
+
+	/* A zero vector becomes (1, 0, 0). */
+	zsl_vec_q31_init(&x);
+	zsl_vec_q31_to_unit(&x);
+	zassert_equal(x.data[0], ZSL_Q31_MAX, NULL);
+	zassert_equal(x.data[1] | x.data[2], 0, NULL);
+
+	/* Saturating addition and subtraction. */
+	w.data[0] = ZSL_Q31(0.5);
+	w.data[1] = ZSL_Q31(-0.5);
+	w.data[2] = ZSL_Q31(0.25);
+	rc = zsl_vec_q31_add(&v, &w, &x);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(x.data[0], ZSL_Q31_MAX, NULL);
+	zassert_equal(x.data[1], ZSL_Q31_MIN, NULL);
+	zassert_equal(x.data[2], ZSL_Q31(0.25), NULL);
+	rc = zsl_vec_q31_sub(&w, &v, &x);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(x.data[0]), -0.1, 1E-8), NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(x.data[1]), 0.3, 1E-8), NULL);
+
+	/* Dot and cross products. */
+	rc = zsl_vec_q31_dot(&v, &w, &d);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(d), 0.7, 1E-8), NULL);
+	rc = zsl_vec_q31_cross(&v, &w, &x);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(x.data[0]), -0.2, 1E-8), NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(x.data[1]), -0.15, 1E-8),
+		     NULL);
+	zassert_true(val_is_equal(zsl_q31_to_real(x.data[2]), 0.1, 1E-8), NULL);
+
+	rc = zsl_vec_q31_scalar_mult(&w, ZSL_Q31(0.5));
+	zassert_true(rc == 0, NULL);
+	zassert_equal(w.data[2], ZSL_Q31(0.125), NULL);
+
+	/* Mismatched sizes. */
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	rc = zsl_vec_q31_add(&v, &y, &x);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_vec_q31_dot(&v, &y, &d);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_vec_q31_cross(&v, &w, &y);
+	zassert_true(rc == -EINVAL, NULL);
+#endif
+}
+
+ZTEST(zsl_tests, test_quat_q31)
+{
+	int rc;
+	struct zsl_quat qa = { .r = 0.5, .i = -0.3, .j = 0.7, .k = 0.1 };
+	struct zsl_quat qb = { .r = 0.2, .i = 0.4, .j = -0.6, .k = 0.5 };
+	struct zsl_quat q, qr;
+	struct zsl_quat_q31 qqa, qqb, qq;
+	struct zsl_euler e = { .x = 0.3, .y = -1.1, .z = 2.5 };
+
+	ZSL_VECTOR_DEF(w, 3);
+	ZSL_VECTOR_Q31_DEF(wq, 3);
+
+	zsl_quat_q31_from_quat(&qa, &qqa);
+	zsl_quat_q31_from_quat(&qb, &qqb);
+
+	/* Conversion back. */
+	zsl_quat_q31_to_quat(&qqa, &q);
+	zassert_true(val_is_equal(q.j, 0.7, 1E-9), NULL);
+
+	/* Magnitude and normalisation. */
+	zassert_true(val_is_equal(zsl_q31_to_real(zsl_quat_q31_magn(&qqa)),
+				  zsl_quat_magn(&qa), 1E-8), NULL);
+	rc = zsl_quat_q31_to_unit(&qqa, &qq);
+	zassert_true(rc == 0, NULL);
+	zsl_quat_to_unit(&qa, &qr);
+	zassert_true(quat_q31_is_equal(&qq, &qr, 1E-6), NULL);
+
+	/* Multiplication and conjugation. */
+	rc = zsl_quat_q31_mult(&qqa, &qqb, &qq);
+	zassert_true(rc == 0, NULL);
+	zsl_quat_mult(&qa, &qb, &qr);
+	zassert_true(quat_q31_is_equal(&qq, &qr, 1E-6), NULL);
+	rc = zsl_quat_q31_conj(&qqa, &qq);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(qq.i, -qqa.i, NULL);
+
+	/* Interpolation. */
+	rc = zsl_quat_q31_lerp(&qqa, &qqb, ZSL_Q31(0.3), &qq);
+	zassert_true(rc == 0, NULL);
+	zsl_quat_lerp(&qa, &qb, 0.3, &qr);
+	zassert_true(quat_q31_is_equal(&qq, &qr, 1E-7), NULL);
+
+	/* Integration of the angular velocity. */
+	w.data[0] = 1.5;
+	w.data[1] = -0.4;
+	w.data[2] = 3.1;
+	for (size_t i = 0; i < 3; i++) {
+		wq.data[i] = ZSL_Q_GYRO(w.data[i]);
+	}
+	rc = zsl_quat_q31_from_ang_vel(&wq, &qqa, ZSL_Q31(0.01), &qq);
+	zassert_true(rc == 0, NULL);
+	zsl_quat_from_ang_vel(&w, &qa, 0.01, &qr);
+	zassert_true(quat_q31_is_equal(&qq, &qr, 1E-7), NULL);
+
+	/* Euler angles. */
+	rc = zsl_quat_q31_from_euler(zsl_q31_from_real(e.x / ZSL_PI),
+				     zsl_q31_from_real(e.y / ZSL_PI),
+				     zsl_q31_from_real(e.z / ZSL_PI), &qq);
+	zassert_true(rc == 0, NULL);
+	zsl_quat_from_euler(&e, &qr);
+	zassert_true(quat_q31_is_equal(&qq, &qr, 1E-7), NULL);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	rc = zsl_quat_q31_lerp(&qqa, &qqb, ZSL_Q31(-0.3), &qq);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_quat_q31_from_ang_vel(&wq, &qqa, ZSL_Q31(-0.01), &qq);
+	zassert_true(rc == -EINVAL, NULL);
+#endif
+}
+
+ZTEST(zsl_tests, test_fus_madg_q31)
+{
+	int rc;
+	zsl_real_t incl = 4.0 / 3.0;
+	zsl_q31_t inclq = zsl_q31_from_real(incl / 180.0);
+	struct zsl_fus_madg_cfg cfg = { .beta = 0.7 };
+	struct zsl_fus_madg_q31_cfg cfgq = { .beta = ZSL_Q31(0.7) };
+	struct zsl_quat q = { .r = 1.0, .i = 0.0, .j = 0.0, .k = 0.0 };
+	struct zsl_quat_q31 qq = { .r = ZSL_Q31_MAX, .i = 0, .j = 0, .k = 0 };
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+	ZSL_VECTOR_Q31_DEF(aq, 3);
+	ZSL_VECTOR_Q31_DEF(mq, 3);
+	ZSL_VECTOR_Q31_DEF(gq, 3);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	rc = zsl_fus_madg_q31_init(0, &cfgq);
+	zassert_true(rc == -EINVAL, NULL);
+#endif
+	rc = zsl_fus_madg_q31_init(100, &cfgq);
+	zassert_true(rc == 0, NULL);
+	zsl_fus_madg_init(100, &cfg);
+
+	/* Follow the floating-point filter, with and without the inclination
+	 * and with missing sensor data. */
+	for (int i = 0; i < FIX_FUS_STEPS; i++) {
+		fix_fus_fill(i, &a, &m, &g, &aq, &mq, &gq);
+		if (i < FIX_FUS_STEPS / 2) {
+			rc = zsl_fus_madg_q31_feed(&aq, &mq, &gq, NULL, &qq,
+						   &cfgq);
+			zsl_fus_madg_feed(&a, &m, &g, NULL, &q, &cfg);
+		} else if (i < FIX_FUS_STEPS - 5) {
+			rc = zsl_fus_madg_q31_feed(&aq, &mq, &gq, &inclq, &qq,
+						   &cfgq);
+			zsl_fus_madg_feed(&a, &m, &g, &incl, &q, &cfg);
+		} else {
+			rc = zsl_fus_madg_q31_feed(&aq, NULL, &gq, NULL, &qq,
+						   &cfgq);
+			zsl_fus_madg_feed(&a, NULL, &g, NULL, &q, &cfg);
+		}
+		zassert_true(rc == 0, NULL);
+		zassert_true(quat_q31_is_equal(&qq, &q, 1E-4), NULL);
+	}
+
+	/* Without accelerometer data, only the gyroscope is integrated. */
+	rc = zsl_fus_madg_q31_feed(NULL, &mq, &gq, NULL, &qq, &cfgq);
+	zassert_true(rc == 0, NULL);
+	zsl_fus_madg_feed(NULL, &m, &g, NULL, &q, &cfg);
+	zassert_true(quat_q31_is_equal(&qq, &q, 1E-4), NULL);
+
+	/* Invalid arguments. */
+	rc = zsl_fus_madg_q31_feed(&aq, &mq, NULL, NULL, &qq, &cfgq);
+	zassert_true(rc == -EINVAL, NULL);
+	cfgq.beta = ZSL_Q31(-0.1);
+	rc = zsl_fus_madg_q31_feed(&aq, &mq, &gq, NULL, &qq, &cfgq);
+	zassert_true(rc == -EINVAL, NULL);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	cfgq.beta = ZSL_Q31(0.7);
+	gq.sz = 5;
+	rc = zsl_fus_madg_q31_feed(&aq, &mq, &gq, NULL, &qq, &cfgq);
+	zassert_true(rc == -EINVAL, NULL);
+	gq.sz = 3;
+	qq.r = qq.i = qq.j = qq.k = 0;
+	rc = zsl_fus_madg_q31_feed(&aq, &mq, &gq, NULL, &qq, &cfgq);
+	zassert_true(rc == -EINVAL, NULL);
+#endif
+}
+
+ZTEST(zsl_tests, test_fus_mahn_q31)
+{
+	int rc;
+	zsl_real_t incl = 4.0 / 3.0;
+	zsl_q31_t inclq = zsl_q31_from_real(incl / 180.0);
+	zsl_real_t intfb[3] = { 0.0, 0.0, 0.0 };
+	zsl_q31_t intfbq[3] = { 0, 0, 0 };
+	struct zsl_fus_mahn_cfg cfg = {
+		.kp = 0.6,
+		.ki = 0.2,
+		.integral_limit = 0.05,
+		.intfb = {
+			.sz = 3,
+			.data = intfb,
+		},
+	};
+	struct zsl_fus_mahn_q31_cfg cfgq = {
+		.kp = ZSL_Q31(0.6),
+		.ki = ZSL_Q31(0.2),
+		.integral_limit = ZSL_Q_GYRO(0.05),
+		.intfb = {
+			.sz = 3,
+			.data = intfbq,
+		},
+	};
+	struct zsl_quat q = { .r = 1.0, .i = 0.0, .j = 0.0, .k = 0.0 };
+	struct zsl_quat_q31 qq = { .r = ZSL_Q31_MAX, .i = 0, .j = 0, .k = 0 };
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+	ZSL_VECTOR_Q31_DEF(aq, 3);
+	ZSL_VECTOR_Q31_DEF(mq, 3);
+	ZSL_VECTOR_Q31_DEF(gq, 3);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	rc = zsl_fus_mahn_q31_init(0, &cfgq);
+	zassert_true(rc == -EINVAL, NULL);
+#endif
+	rc = zsl_fus_mahn_q31_init(100, &cfgq);
+	zassert_true(rc == 0, NULL);
+	zsl_fus_mahn_init(100, &cfg);
+
+	/* Follow the floating-point filter, including the integral feedback,
+	 * which reaches its limit. */
+	for (int i = 0; i < FIX_FUS_STEPS; i++) {
+		fix_fus_fill(i, &a, &m, &g, &aq, &mq, &gq);
+		if (i < FIX_FUS_STEPS / 2) {
+			rc = zsl_fus_mahn_q31_feed(&aq, &mq, &gq, NULL, &qq,
+						   &cfgq);
+			zsl_fus_mahn_feed(&a, &m, &g, NULL, &q, &cfg);
+		} else if (i < FIX_FUS_STEPS - 5) {
+			rc = zsl_fus_mahn_q31_feed(&aq, &mq, &gq, &inclq, &qq,
+						   &cfgq);
+			zsl_fus_mahn_feed(&a, &m, &g, &incl, &q, &cfg);
+		} else {
+			rc = zsl_fus_mahn_q31_feed(&aq, NULL, &gq, NULL, &qq,
+						   &cfgq);
+			zsl_fus_mahn_feed(&a, NULL, &g, NULL, &q, &cfg);
+		}
+		zassert_true(rc == 0, NULL);
+		zassert_true(quat_q31_is_equal(&qq, &q, 1E-4), NULL);
+		for (size_t j = 0; j < 3; j++) {
+			zassert_true(val_is_equal((zsl_real_t)intfbq[j] /
+						  (1 << ZSL_FIX_GYRO_FRAC),
+						  intfb[j], 1E-5), NULL);
+		}
+	}
+
+	/* Invalid arguments. */
+	rc = zsl_fus_mahn_q31_feed(&aq, &mq, NULL, NULL, &qq, &cfgq);
+	zassert_true(rc == -EINVAL, NULL);
+	cfgq.ki = ZSL_Q31(-0.1);
+	rc = zsl_fus_mahn_q31_feed(&aq, &mq, &gq, NULL, &qq, &cfgq);
+	zassert_true(rc == -EINVAL, NULL);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	cfgq.ki = ZSL_Q31(0.2);
+	cfgq.intfb.sz = 4;
+	rc = zsl_fus_mahn_q31_feed(&aq, &mq, &gq, NULL, &qq, &cfgq);
+	zassert_true(rc == -EINVAL, NULL);
+#endif
+}
+
+ZTEST(zsl_tests, test_fus_comp_q31)
+{
+	int rc;
+	struct zsl_fus_comp_cfg cfg = { .alpha = 0.02 };
+	struct zsl_fus_comp_q31_cfg cfgq = { .alpha = ZSL_Q31(0.02) };
+	struct zsl_quat q = { .r = 1.0, .i = 0.0, .j = 0.0, .k = 0.0 };
+	struct zsl_quat_q31 qq = { .r = ZSL_Q31_MAX, .i = 0, .j = 0, .k = 0 };
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+	ZSL_VECTOR_Q31_DEF(aq, 3);
+	ZSL_VECTOR_Q31_DEF(mq, 3);
+	ZSL_VECTOR_Q31_DEF(gq, 3);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	rc = zsl_fus_comp_q31_init(0, &cfgq);
+	zassert_true(rc == -EINVAL, NULL);
+#endif
+	rc = zsl_fus_comp_q31_init(100, &cfgq);
+	zassert_true(rc == 0, NULL);
+	zsl_fus_comp_init(100, &cfg);
+
+	for (int i = 0; i < FIX_FUS_STEPS; i++) {
+		fix_fus_fill(i, &a, &m, &g, &aq, &mq, &gq);
+		if (i < FIX_FUS_STEPS - 5) {
+			rc = zsl_fus_comp_q31_feed(&aq, &mq, &gq, &qq, &cfgq);
+			zsl_fus_comp_feed(&a, &m, &g, NULL, &q, &cfg);
+		} else {
+			rc = zsl_fus_comp_q31_feed(&aq, NULL, &gq, &qq, &cfgq);
+			zsl_fus_comp_feed(&a, NULL, &g, NULL, &q, &cfg);
+		}
+		zassert_true(rc == 0, NULL);
+		zassert_true(quat_q31_is_equal(&qq, &q, 1E-4), NULL);
+	}
+
+	/* Invalid arguments. */
+	rc = zsl_fus_comp_q31_feed(&aq, &mq, NULL, &qq, &cfgq);
+	zassert_true(rc == -EINVAL, NULL);
+	cfgq.alpha = ZSL_Q31(-0.1);
+	rc = zsl_fus_comp_q31_feed(&aq, &mq, &gq, &qq, &cfgq);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
+#endif /* CONFIG_ZSL_FIXED */
@@ -154,6 +154,87 @@ ZTEST(zsl_tests, test_fus_madgwick)
 	zassert_true(rc == -EINVAL, NULL);
 }
 
+ZTEST(zsl_tests, test_fus_multi_instance)
+{
+	int rc = 0;
+
+	struct zsl_fus_madg_cfg cfg_a = { .beta = 0.7 };
+	struct zsl_fus_madg_cfg cfg_b = { .beta = 0.7 };
+	struct zsl_fus_madg_cfg cfg_ref = { .beta = 0.7 };
+
+	struct zsl_fus_drv drv_a = {
+		.init_handler = zsl_fus_madg_init,
+		.feed_handler = zsl_fus_madg_feed,
+		.error_handler = zsl_fus_madg_error,
+		.config = &cfg_a,
+	};
+
+	struct zsl_fus_drv drv_b = {
+		.init_handler = zsl_fus_madg_init,
+		.feed_handler = zsl_fus_madg_feed,
+		.error_handler = zsl_fus_madg_error,
+		.config = &cfg_b,
+	};
+
+	struct zsl_quat qa = { .r = 1.0, .i = 0.0, .j = 0.0, .k = 0.0 };
+	struct zsl_quat qb = { .r = 1.0, .i = 0.0, .j = 0.0, .k = 0.0 };
+	struct zsl_quat qref = { .r = 1.0, .i = 0.0, .j = 0.0, .k = 0.0 };
+
+	zsl_real_t a_data[3] = { 0.01, -1.01, -0.02 };
+	zsl_real_t m_data[3] = { -66.0, -98.0, -43.0 };
+	zsl_real_t g_data[3] = { 0.09, -0.28, -0.07 };
+
+	ZSL_VECTOR_DEF(a, 3);
+	ZSL_VECTOR_DEF(m, 3);
+	ZSL_VECTOR_DEF(g, 3);
+
+	/* An instance that was never initialised has no sample rate. */
+	zsl_vec_from_arr(&a, a_data);
+	zsl_vec_from_arr(&m, m_data);
+	zsl_vec_from_arr(&g, g_data);
+	rc = zsl_fus_madg_feed(&a, &m, &g, NULL, &qref, &cfg_ref);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Run two filters with different sample rates side by side. */
+	rc = drv_a.init_handler(100, drv_a.config);
+	zassert_true(rc == 0, NULL);
+	rc = drv_b.init_handler(50, drv_b.config);
+	zassert_true(rc == 0, NULL);
+
+	for (size_t i = 0; i < 10; i++) {
+		zsl_vec_from_arr(&a, a_data);
+		zsl_vec_from_arr(&m, m_data);
+		zsl_vec_from_arr(&g, g_data);
+		rc = drv_a.feed_handler(&a, &m, &g, NULL, &qa, drv_a.config);
+		zassert_true(rc == 0, NULL);
+
+		zsl_vec_from_arr(&a, a_data);
+		zsl_vec_from_arr(&m, m_data);
+		zsl_vec_from_arr(&g, g_data);
+		rc = drv_b.feed_handler(&a, &m, &g, NULL, &qb, drv_b.config);
+		zassert_true(rc == 0, NULL);
+	}
+
+	/* The 100 Hz instance must match a filter that ran on its own. */
+	rc = zsl_fus_madg_init(100, &cfg_ref);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 10; i++) {
+		zsl_vec_from_arr(&a, a_data);
+		zsl_vec_from_arr(&m, m_data);
+		zsl_vec_from_arr(&g, g_data);
+		rc = zsl_fus_madg_feed(&a, &m, &g, NULL, &qref, &cfg_ref);
+		zassert_true(rc == 0, NULL);
+	}
+
+	zassert_true(val_is_equal(qa.r, qref.r, 1E-9), NULL);
+	zassert_true(val_is_equal(qa.i, qref.i, 1E-9), NULL);
+	zassert_true(val_is_equal(qa.j, qref.j, 1E-9), NULL);
+	zassert_true(val_is_equal(qa.k, qref.k, 1E-9), NULL);
+
+	/* The 50 Hz instance integrates twice the time step per sample. */
+	zassert_false(val_is_equal(qa.i, qb.i, 1E-4), NULL);
+}
+
 ZTEST(zsl_tests, test_fus_mahony)
 {
 	int rc = 0;
@@ -906,18 +987,18 @@ ZTEST(zsl_tests, test_fus_kalman)
 	/* Run the kalman algorithm. */
 	rc = kalm_drv.feed_handler(&a, &m, &g, NULL, &q, kalm_drv.config);
 	zassert_true(rc == 0, NULL);
-	zassert_true(val_is_equal(q.r, 0.3186651048490019, 1E-6), NULL);
-	zassert_true(val_is_equal(q.i, 0.6386866767275943, 1E-6), NULL);
-	zassert_true(val_is_equal(q.j, 0.4721142772080947, 1E-6), NULL);
-	zassert_true(val_is_equal(q.k, 0.5173393365852964, 1E-6), NULL);
+	zassert_true(val_is_equal(q.r, 0.3186623054123134, 1E-6), NULL);
+	zassert_true(val_is_equal(q.i, 0.6386851559960363, 1E-6), NULL);
+	zassert_true(val_is_equal(q.j, 0.4721149053493977, 1E-6), NULL);
+	zassert_true(val_is_equal(q.k, 0.5173423651379788, 1E-6), NULL);
 
 	/* Run the kalman algorithm with dip angle provided. */
 	rc = kalm_drv.feed_handler(&a, &m, &g, &incl, &q, kalm_drv.config);
 	zassert_true(rc == 0, NULL);
-	zassert_true(val_is_equal(q.r, 0.7715963603719183, 1E-6), NULL);
-	zassert_true(val_is_equal(q.i, 0.0123858064715810, 1E-6), NULL);
-	zassert_true(val_is_equal(q.j, 0.5043103125990586, 1E-6), NULL);
-	zassert_true(val_is_equal(q.k, 0.3875006542769926, 1E-6), NULL);
+	zassert_true(val_is_equal(q.r, 0.7715944707687140, 1E-6), NULL);
+	zassert_true(val_is_equal(q.i, 0.0123854382554456, 1E-6), NULL);
+	zassert_true(val_is_equal(q.j, 0.5043119520871355, 1E-6), NULL);
+	zassert_true(val_is_equal(q.k, 0.3875022949356961, 1E-6), NULL);
 
 	/* Run the kalman algorithm without accelerometer data. An error
 	 * is expected. */
@@ -964,3 +1045,395 @@ ZTEST(zsl_tests, test_fus_kalman)
 	rc = kalm_drv.feed_handler(&a, &m, &g2, NULL, &q, kalm_drv.config);
 	zassert_true(rc == -EINVAL, NULL);
 }
+
+/* Number of samples in the batch used by test_fus_feed_batch. */
+#define FUS_BATCH_N (16)
+
+ZTEST(zsl_tests, test_fus_feed_batch)
+{
+	int rc = 0;
+
+	zsl_real_t acc[FUS_BATCH_N * 3];
+	zsl_real_t mag[FUS_BATCH_N * 3];
+	zsl_real_t gyr[FUS_BATCH_N * 3];
+	zsl_real_t acc_soa[FUS_BATCH_N * 3];
+	zsl_real_t mag_soa[FUS_BATCH_N * 3];
+	zsl_real_t gyr_soa[FUS_BATCH_N * 3];
+	zsl_real_t dt[FUS_BATCH_N];
+
+	struct zsl_quat q_ref[FUS_BATCH_N];
+	struct zsl_quat q_out[FUS_BATCH_N];
+	struct zsl_quat q;
+
+	/* A slowly rotating sensor, stored as AoS and SoA. */
+	for (size_t i = 0; i < FUS_BATCH_N; i++) {
+		zsl_real_t s[9] = {
+			0.01 + 0.01 * i, -1.01, -0.02 - 0.005 * i,
+			-66.0 + 0.5 * i, -98.0, -43.0 - 0.5 * i,
+			0.09, -0.28 + 0.02 * i, -0.07,
+		};
+
+		for (size_t j = 0; j < 3; j++) {
+			acc[i * 3 + j] = s[j];
+			mag[i * 3 + j] = s[3 + j];
+			gyr[i * 3 + j] = s[6 + j];
+			acc_soa[j * FUS_BATCH_N + i] = s[j];
+			mag_soa[j * FUS_BATCH_N + i] = s[3 + j];
+			gyr_soa[j * FUS_BATCH_N + i] = s[6 + j];
+		}
+		dt[i] = 0.01;
+	}
+
+	struct zsl_fus_batch aos = {
+		.n = FUS_BATCH_N,
+		.layout = ZSL_FUS_BATCH_AOS,
+		.accel = acc,
+		.mag = mag,
+		.gyro = gyr,
+	};
+
+	struct zsl_fus_batch soa = {
+		.n = FUS_BATCH_N,
+		.layout = ZSL_FUS_BATCH_SOA,
+		.accel = acc_soa,
+		.mag = mag_soa,
+		.gyro = gyr_soa,
+	};
+
+	struct zsl_fus_madg_cfg madg_cfg = { .beta = 0.7 };
+	zsl_real_t intfb[3];
+	struct zsl_fus_mahn_cfg mahn_cfg = {
+		.kp = 0.02,
+		.ki = 0.1,
+		.integral_limit = 10000.0,
+		.intfb = { .sz = 3, .data = intfb },
+	};
+	struct zsl_fus_comp_cfg comp_cfg = { .alpha = 0.7 };
+	struct zsl_fus_aqua_cfg aqua_cfg = {
+		.alpha = 0.7,
+		.beta = 0.7,
+		.e_a = 0.9,
+		.e_m = 0.9,
+	};
+	ZSL_MATRIX_DEF(P, 4, 4);
+	struct zsl_fus_kalm_cfg kalm_cfg = {
+		.var_g = 0.3 * 0.3,
+		.var_a = 0.5 * 0.5,
+		.var_m = 0.8 * 0.8,
+		.P = P,
+	};
+
+	struct zsl_fus_drv drvs[] = {
+		{
+			.init_handler = zsl_fus_madg_init,
+			.feed_handler = zsl_fus_madg_feed,
+			.feed_batch_handler = zsl_fus_madg_feed_batch,
+			.config = &madg_cfg,
+		},
+		{
+			.init_handler = zsl_fus_mahn_init,
+			.feed_handler = zsl_fus_mahn_feed,
+			.feed_batch_handler = zsl_fus_mahn_feed_batch,
+			.config = &mahn_cfg,
+		},
+		{
+			.init_handler = zsl_fus_saam_init,
+			.feed_handler = zsl_fus_saam_feed,
+			.feed_batch_handler = zsl_fus_saam_feed_batch,
+			.config = NULL,
+		},
+		{
+			.init_handler = zsl_fus_comp_init,
+			.feed_handler = zsl_fus_comp_feed,
+			.feed_batch_handler = zsl_fus_comp_feed_batch,
+			.config = &comp_cfg,
+		},
+		{
+			.init_handler = zsl_fus_aqua_init,
+			.feed_handler = zsl_fus_aqua_feed,
+			.feed_batch_handler = zsl_fus_aqua_feed_batch,
+			.config = &aqua_cfg,
+		},
+		{
+			.init_handler = zsl_fus_kalm_init,
+			.feed_handler = zsl_fus_kalm_feed,
+			.feed_batch_handler = zsl_fus_kalm_feed_batch,
+			.config = &kalm_cfg,
+		},
+	};
+
+	for (size_t d = 0; d < ARRAY_SIZE(drvs); d++) {
+		struct zsl_fus_drv *drv = &drvs[d];
+		struct zsl_fus_drv drv_ref = *drv;
+
+		/* Reference: one feed_handler call per sample. */
+		drv_ref.feed_batch_handler = NULL;
+		zsl_vec_init(&mahn_cfg.intfb);
+		zsl_quat_init(&q, ZSL_QUAT_TYPE_IDENTITY);
+		rc = drv->init_handler(100, drv->config);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_fus_feed_batch(&drv_ref, &aos, &q, q_ref);
+		zassert_true(rc == 0, NULL);
+
+		/* Native AoS batch. */
+		zsl_vec_init(&mahn_cfg.intfb);
+		zsl_quat_init(&q, ZSL_QUAT_TYPE_IDENTITY);
+		rc = drv->init_handler(100, drv->config);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_fus_feed_batch(drv, &aos, &q, q_out);
+		zassert_true(rc == 0, NULL);
+		for (size_t i = 0; i < FUS_BATCH_N; i++) {
+			zassert_true(val_is_equal(q_out[i].r, q_ref[i].r, 1E-9), NULL);
+			zassert_true(val_is_equal(q_out[i].i, q_ref[i].i, 1E-9), NULL);
+			zassert_true(val_is_equal(q_out[i].j, q_ref[i].j, 1E-9), NULL);
+			zassert_true(val_is_equal(q_out[i].k, q_ref[i].k, 1E-9), NULL);
+		}
+		zassert_true(val_is_equal(q.r, q_ref[FUS_BATCH_N - 1].r, 1E-9),
+			     NULL);
+
+		/* Native SoA batch, with time steps at the init rate. */
+		zsl_vec_init(&mahn_cfg.intfb);
+		zsl_quat_init(&q, ZSL_QUAT_TYPE_IDENTITY);
+		rc = drv->init_handler(100, drv->config);
+		zassert_true(rc == 0, NULL);
+		soa.dt = dt;
+		rc = zsl_fus_feed_batch(drv, &soa, &q, q_out);
+		soa.dt = NULL;
+		zassert_true(rc == 0, NULL);
+		for (size_t i = 0; i < FUS_BATCH_N; i++) {
+			zassert_true(val_is_equal(q_out[i].r, q_ref[i].r, 1E-6), NULL);
+			zassert_true(val_is_equal(q_out[i].i, q_ref[i].i, 1E-6), NULL);
+			zassert_true(val_is_equal(q_out[i].j, q_ref[i].j, 1E-6), NULL);
+			zassert_true(val_is_equal(q_out[i].k, q_ref[i].k, 1E-6), NULL);
+		}
+	}
+
+	/* Time steps must be positive. */
+	zsl_quat_init(&q, ZSL_QUAT_TYPE_IDENTITY);
+	rc = zsl_fus_madg_init(100, &madg_cfg);
+	zassert_true(rc == 0, NULL);
+	dt[5] = 0.0;
+	aos.dt = dt;
+	rc = zsl_fus_feed_batch(&drvs[0], &aos, &q, NULL);
+	zassert_true(rc == -EINVAL, NULL);
+	dt[5] = -0.01;
+	rc = zsl_fus_feed_batch(&drvs[0], &aos, &q, NULL);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* The per-sample fallback can't honour time steps. */
+	dt[5] = 0.01;
+	drvs[0].feed_batch_handler = NULL;
+	rc = zsl_fus_feed_batch(&drvs[0], &aos, &q, NULL);
+	zassert_true(rc == -ENOSYS, NULL);
+}
+
+#define FUS_MULTI_N (11)
+
+/**
+ * Fills sample 't' of the 'n' sensors used by the multi-filter tests, with
+ * no accelerometer data for sensor 2 and no magnetometer data for sensor 5.
+ */
+static void fus_multi_fill(size_t t, zsl_real_t *acc, zsl_real_t *mag,
+			   zsl_real_t *gyr, size_t n)
+{
+	for (size_t l = 0; l < n; l++) {
+		zsl_real_t d = 0.01 * (zsl_real_t)(l + t);
+
+		acc[l] = 0.01 + d;
+		acc[n + l] = -1.01;
+		acc[2 * n + l] = -0.02 - 0.5 * d;
+		mag[l] = -66.0 + 10.0 * d;
+		mag[n + l] = -98.0;
+		mag[2 * n + l] = -43.0 - 10.0 * d;
+		gyr[l] = 0.09;
+		gyr[n + l] = -0.28 + d;
+		gyr[2 * n + l] = -0.07 * (zsl_real_t)l;
+	}
+
+	acc[2] = acc[n + 2] = acc[2 * n + 2] = 0.0;
+	mag[5] = mag[n + 5] = mag[2 * n + 5] = 0.0;
+}
+
+ZTEST(zsl_tests, test_fus_madg_feed_multi)
+{
+	int rc = 0;
+	zsl_real_t acc[FUS_MULTI_N * 3];
+	zsl_real_t mag[FUS_MULTI_N * 3];
+	zsl_real_t gyr[FUS_MULTI_N * 3];
+	zsl_real_t qd[FUS_MULTI_N * 4];
+	struct zsl_quat q_ref[FUS_MULTI_N];
+	zsl_real_t incl = 66.0;
+
+	struct zsl_fus_vec_soa a = { acc, acc + FUS_MULTI_N,
+				     acc + 2 * FUS_MULTI_N };
+	struct zsl_fus_vec_soa m = { mag, mag + FUS_MULTI_N,
+				     mag + 2 * FUS_MULTI_N };
+	struct zsl_fus_vec_soa g = { gyr, gyr + FUS_MULTI_N,
+				     gyr + 2 * FUS_MULTI_N };
+	struct zsl_fus_quat_soa q = { qd, qd + FUS_MULTI_N,
+				      qd + 2 * FUS_MULTI_N,
+				      qd + 3 * FUS_MULTI_N };
+	struct zsl_fus_madg_cfg cfg = { .beta = 0.7 };
+
+	ZSL_VECTOR_DEF(av, 3);
+	ZSL_VECTOR_DEF(mv, 3);
+	ZSL_VECTOR_DEF(gv, 3);
+
+	rc = zsl_fus_madg_init(100, &cfg);
+	zassert_true(rc == 0, NULL);
+
+	for (size_t l = 0; l < FUS_MULTI_N; l++) {
+		zsl_quat_init(&q_ref[l], ZSL_QUAT_TYPE_IDENTITY);
+		q.r[l] = 1.0;
+		q.i[l] = q.j[l] = q.k[l] = 0.0;
+	}
+
+	/* Compare against one zsl_fus_madg_feed call per sensor, with and
+	 * without the inclination. */
+	for (size_t t = 0; t < 20; t++) {
+		zsl_real_t *ip = (t & 1) ? &incl : NULL;
+
+		fus_multi_fill(t, acc, mag, gyr, FUS_MULTI_N);
+		rc = zsl_fus_madg_feed_multi(FUS_MULTI_N, &a, &m, &g, ip, &q,
+					     &cfg);
+		zassert_true(rc == 0, NULL);
+
+		for (size_t l = 0; l < FUS_MULTI_N; l++) {
+			zsl_vec_from_arr(&av, (zsl_real_t[]){ a.x[l], a.y[l],
+							      a.z[l] });
+			zsl_vec_from_arr(&mv, (zsl_real_t[]){ m.x[l], m.y[l],
+							      m.z[l] });
+			zsl_vec_from_arr(&gv, (zsl_real_t[]){ g.x[l], g.y[l],
+							      g.z[l] });
+			rc = zsl_fus_madg_feed(&av, &mv, &gv, ip, &q_ref[l],
+					       &cfg);
+			zassert_true(rc == 0, NULL);
+		}
+	}
+
+	for (size_t l = 0; l < FUS_MULTI_N; l++) {
+		zassert_true(val_is_equal(q.r[l], q_ref[l].r, 1E-5), NULL);
+		zassert_true(val_is_equal(q.i[l], q_ref[l].i, 1E-5), NULL);
+		zassert_true(val_is_equal(q.j[l], q_ref[l].j, 1E-5), NULL);
+		zassert_true(val_is_equal(q.k[l], q_ref[l].k, 1E-5), NULL);
+	}
+
+	/* Gyroscope only. */
+	rc = zsl_fus_madg_feed_multi(FUS_MULTI_N, NULL, NULL, &g, NULL, &q,
+				     &cfg);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_fus_madg_feed(NULL, NULL, &gv, NULL, &q_ref[FUS_MULTI_N - 1],
+			       &cfg);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(q.k[FUS_MULTI_N - 1],
+				  q_ref[FUS_MULTI_N - 1].k, 1E-5), NULL);
+
+	/* Invalid inputs leave every filter unchanged. */
+	q.r[3] = q.i[3] = q.j[3] = q.k[3] = 0.0;
+	qd[0] = 0.5;
+	rc = zsl_fus_madg_feed_multi(FUS_MULTI_N, &a, &m, &g, NULL, &q, &cfg);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(val_is_equal(qd[0], 0.5, 1E-6), NULL);
+	q.r[3] = 1.0;
+	rc = zsl_fus_madg_feed_multi(FUS_MULTI_N, &a, &m, NULL, NULL, &q, &cfg);
+	zassert_true(rc == -EINVAL, NULL);
+	cfg.beta = -0.1;
+	rc = zsl_fus_madg_feed_multi(FUS_MULTI_N, &a, &m, &g, NULL, &q, &cfg);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(val_is_equal(qd[0], 0.5, 1E-6), NULL);
+}
+
+ZTEST(zsl_tests, test_fus_mahn_feed_multi)
+{
+	int rc = 0;
+	zsl_real_t acc[FUS_MULTI_N * 3];
+	zsl_real_t mag[FUS_MULTI_N * 3];
+	zsl_real_t gyr[FUS_MULTI_N * 3];
+	zsl_real_t qd[FUS_MULTI_N * 4];
+	zsl_real_t fbd[FUS_MULTI_N * 3] = { 0 };
+	zsl_real_t fb_ref[FUS_MULTI_N][3] = { 0 };
+	struct zsl_quat q_ref[FUS_MULTI_N];
+	zsl_real_t incl = 66.0;
+
+	struct zsl_fus_vec_soa a = { acc, acc + FUS_MULTI_N,
+				     acc + 2 * FUS_MULTI_N };
+	struct zsl_fus_vec_soa m = { mag, mag + FUS_MULTI_N,
+				     mag + 2 * FUS_MULTI_N };
+	struct zsl_fus_vec_soa g = { gyr, gyr + FUS_MULTI_N,
+				     gyr + 2 * FUS_MULTI_N };
+	struct zsl_fus_vec_soa intfb = { fbd, fbd + FUS_MULTI_N,
+					 fbd + 2 * FUS_MULTI_N };
+	struct zsl_fus_quat_soa q = { qd, qd + FUS_MULTI_N,
+				      qd + 2 * FUS_MULTI_N,
+				      qd + 3 * FUS_MULTI_N };
+	struct zsl_fus_mahn_cfg cfg = {
+		.kp = 0.5,
+		.ki = 0.1,
+		.integral_limit = 0.002,
+		.intfb = { .sz = 3 },
+	};
+
+	ZSL_VECTOR_DEF(av, 3);
+	ZSL_VECTOR_DEF(mv, 3);
+	ZSL_VECTOR_DEF(gv, 3);
+
+	rc = zsl_fus_mahn_init(100, &cfg);
+	zassert_true(rc == 0, NULL);
+
+	for (size_t l = 0; l < FUS_MULTI_N; l++) {
+		zsl_quat_init(&q_ref[l], ZSL_QUAT_TYPE_IDENTITY);
+		q.r[l] = 1.0;
+		q.i[l] = q.j[l] = q.k[l] = 0.0;
+	}
+
+	/* Compare against one zsl_fus_mahn_feed call per sensor, each with
+	 * its own integral feedback, which reaches the limit. */
+	for (size_t t = 0; t < 20; t++) {
+		zsl_real_t *ip = (t & 1) ? &incl : NULL;
+
+		fus_multi_fill(t, acc, mag, gyr, FUS_MULTI_N);
+		rc = zsl_fus_mahn_feed_multi(FUS_MULTI_N, &a, &m, &g, ip, &intfb,
+					     &q, &cfg);
+		zassert_true(rc == 0, NULL);
+
+		for (size_t l = 0; l < FUS_MULTI_N; l++) {
+			zsl_vec_from_arr(&av, (zsl_real_t[]){ a.x[l], a.y[l],
+							      a.z[l] });
+			zsl_vec_from_arr(&mv, (zsl_real_t[]){ m.x[l], m.y[l],
+							      m.z[l] });
+			zsl_vec_from_arr(&gv, (zsl_real_t[]){ g.x[l], g.y[l],
+							      g.z[l] });
+			cfg.intfb.data = fb_ref[l];
+			rc = zsl_fus_mahn_feed(&av, &mv, &gv, ip, &q_ref[l],
+					       &cfg);
+			zassert_true(rc == 0, NULL);
+		}
+	}
+
+	for (size_t l = 0; l < FUS_MULTI_N; l++) {
+		zassert_true(val_is_equal(q.r[l], q_ref[l].r, 1E-5), NULL);
+		zassert_true(val_is_equal(q.i[l], q_ref[l].i, 1E-5), NULL);
+		zassert_true(val_is_equal(q.j[l], q_ref[l].j, 1E-5), NULL);
+		zassert_true(val_is_equal(q.k[l], q_ref[l].k, 1E-5), NULL);
+		zassert_true(val_is_equal(intfb.x[l], fb_ref[l][0], 1E-6), NULL);
+		zassert_true(val_is_equal(intfb.y[l], fb_ref[l][1], 1E-6), NULL);
+		zassert_true(val_is_equal(intfb.z[l], fb_ref[l][2], 1E-6), NULL);
+	}
+
+	/* The sensor without accelerometer data has no feedback. */
+	zassert_true(intfb.x[2] == 0.0, NULL);
+
+	/* Invalid inputs. */
+	rc = zsl_fus_mahn_feed_multi(FUS_MULTI_N, &a, &m, NULL, NULL, &intfb,
+				     &q, &cfg);
+	zassert_true(rc == -EINVAL, NULL);
+	q.r[3] = q.i[3] = q.j[3] = q.k[3] = 0.0;
+	rc = zsl_fus_mahn_feed_multi(FUS_MULTI_N, &a, &m, &g, NULL, &intfb,
+				     &q, &cfg);
+	zassert_true(rc == -EINVAL, NULL);
+	q.r[3] = 1.0;
+	cfg.kp = -0.1;
+	rc = zsl_fus_mahn_feed_multi(FUS_MULTI_N, &a, &m, &g, NULL, &intfb,
+				     &q, &cfg);
+	zassert_true(rc == -EINVAL, NULL);
+}
@@ -859,6 +859,125 @@ ZTEST(zsl_tests, test_matrix_mult_rect)
 	zassert_equal(mref.data[11], mc.data[11], NULL);
 }
 
+/**
+ * @brief zsl_mtx_gemm unit tests.
+ *
+ * This test verifies the zsl_mtx_gemm function, including the alpha/beta
+ * scaling, transposed inputs, aliased output and products that span more
+ * than one cache block.
+ */
+ZTEST(zsl_tests, test_matrix_gemm)
+{
+	int rc = 0;
+	zsl_real_t sum;
+
+	ZSL_MATRIX_DEF(mc, 2, 2);
+	ZSL_MATRIX_DEF(md, 3, 3);
+	ZSL_MATRIX_DEF(mref, 3, 3);
+
+	/* Input matrix a (2x3). */
+	zsl_real_t data_a[6] = { 1.0, 2.0, 3.0,
+				 4.0, 5.0, 6.0 };
+	struct zsl_mtx ma = {
+		.sz_rows = 2,
+		.sz_cols = 3,
+		.data = data_a
+	};
+
+	/* Input matrix b (3x2). */
+	zsl_real_t data_b[6] = { 1.0, 0.0,
+				 2.0, 1.0,
+				 0.0, 3.0 };
+	struct zsl_mtx mb = {
+		.sz_rows = 3,
+		.sz_cols = 2,
+		.data = data_b
+	};
+
+	/* Expected outputs. */
+	zsl_real_t dt_ab[4] = { 10.5, 22.5, 28.5, 46.5 };
+	zsl_real_t dt_ata[9] = { 17.0, 22.0, 27.0,
+				 22.0, 29.0, 36.0,
+				 27.0, 36.0, 45.0 };
+	zsl_real_t dt_aat[4] = { 14.0, 32.0, 32.0, 77.0 };
+	zsl_real_t dt_btat[4] = { 5.0, 14.0, 11.0, 23.0 };
+
+	/* mc = 2 * a * b + 0.5 * mc. */
+	for (size_t g = 0; g < 4; g++) {
+		mc.data[g] = 1.0;
+	}
+	rc = zsl_mtx_gemm(false, false, 2.0, &ma, &mb, 0.5, &mc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 4; g++) {
+		zassert_equal(mc.data[g], dt_ab[g], NULL);
+	}
+
+	/* md = at * a. */
+	rc = zsl_mtx_gemm(true, false, 1.0, &ma, &ma, 0.0, &md);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_equal(md.data[g], dt_ata[g], NULL);
+	}
+
+	/* mc = a * at. */
+	rc = zsl_mtx_gemm(false, true, 1.0, &ma, &ma, 0.0, &mc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 4; g++) {
+		zassert_equal(mc.data[g], dt_aat[g], NULL);
+	}
+
+	/* mc = bt * at. */
+	rc = zsl_mtx_gemm(true, true, 1.0, &mb, &ma, 0.0, &mc);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 4; g++) {
+		zassert_equal(mc.data[g], dt_btat[g], NULL);
+	}
+
+	/* md = md * md, with the output aliasing both inputs. */
+	rc = zsl_mtx_mult(&md, &md, &mref);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_gemm(false, false, 1.0, &md, &md, 0.0, &md);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 9; g++) {
+		zassert_equal(md.data[g], mref.data[g], NULL);
+	}
+
+	/* In the following examples, an error is expected due to invalid
+	 * shapes. */
+	rc = zsl_mtx_gemm(false, false, 1.0, &ma, &ma, 0.0, &mc);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_gemm(false, false, 1.0, &ma, &mb, 0.0, &md);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	/* A product large enough to span several blocks and partial tiles. */
+	static zsl_real_t data_x[6 * 35];
+	static zsl_real_t data_y[35 * 67];
+	static zsl_real_t data_z[6 * 67];
+	struct zsl_mtx mx = { .sz_rows = 6, .sz_cols = 35, .data = data_x };
+	struct zsl_mtx my = { .sz_rows = 35, .sz_cols = 67, .data = data_y };
+	struct zsl_mtx mz = { .sz_rows = 6, .sz_cols = 67, .data = data_z };
+
+	for (size_t g = 0; g < 6 * 35; g++) {
+		data_x[g] = (zsl_real_t)((g * 7 + 3) % 11) - 5.0;
+	}
+	for (size_t g = 0; g < 35 * 67; g++) {
+		data_y[g] = (zsl_real_t)((g * 5 + 1) % 13) - 6.0;
+	}
+
+	rc = zsl_mtx_mult(&mx, &my, &mz);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 6; i++) {
+		for (size_t j = 0; j < 67; j++) {
+			sum = 0.0;
+			for (size_t k = 0; k < 35; k++) {
+				sum += data_x[(i * 35) + k] *
+				       data_y[(k * 67) + j];
+			}
+			zassert_equal(data_z[(i * 67) + j], sum, NULL);
+		}
+	}
+}
+
 ZTEST(zsl_tests, test_matrix_mult_d)
 {
 	int rc = 0;
@@ -1428,11 +1547,127 @@ ZTEST(zsl_tests, test_matrix_deter)
 		.data = data
 	};
 
+	/* Singular input matrix (row 3 is the sum of rows 1 and 2). */
+	zsl_real_t data2[16] = { 1.0, 2.0, 3.0, 4.0,
+				 0.0, 1.0, 5.0, 2.0,
+				 1.0, 3.0, 8.0, 6.0,
+				 7.0, 1.0, 0.0, 2.0 };
+	struct zsl_mtx m2 = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data2
+	};
+
+	/* Non-square input matrix. */
+	ZSL_MATRIX_DEF(m3, 4, 5);
+
 	rc = zsl_mtx_deter(&m, &x);
 	zassert_equal(rc, 0, NULL);
 
 	/* Check the output. */
-	zassert_equal(x, -509.0, NULL);
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+	zassert_true(val_is_equal(x, -509.0, 1E-2), NULL);
+#else
+	zassert_true(val_is_equal(x, -509.0, 1E-6), NULL);
+#endif
+
+	rc = zsl_mtx_deter(&m2, &x);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(x, 0.0, 1E-5), NULL);
+
+	/* In the following example, an error is expected due to an invalid
+	 * input matrix. */
+	rc = zsl_mtx_deter(&m3, &x);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+ZTEST(zsl_tests, test_matrix_lu)
+{
+	int rc = 0;
+	size_t p[4];
+	zsl_real_t x;
+
+	ZSL_MATRIX_DEF(lu, 4, 4);
+	ZSL_MATRIX_DEF(l, 4, 4);
+	ZSL_MATRIX_DEF(u, 4, 4);
+	ZSL_MATRIX_DEF(pm, 4, 4);
+	ZSL_MATRIX_DEF(prod, 4, 4);
+	ZSL_MATRIX_DEF(mc, 3, 4);
+
+	/* Input matrix. */
+	zsl_real_t data[16] = {  2.0, -1.0,  0.0,  3.0,
+				 4.0,  1.0, -2.0,  1.0,
+				 -2.0,  5.0,  3.0,  0.0,
+				 6.0,  0.0,  1.0, -4.0 };
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Expected output, with L below the diagonal and U on and above it. */
+	zsl_real_t dt[16] = {  6.0,           0.0,  1.0,          -4.0,
+			       -0.3333333333,  5.0,  3.3333333333, -1.3333333333,
+			       0.6666666667,  0.2, -3.3333333333,  3.9333333333,
+			       0.3333333333, -0.2, -0.1,           4.46 };
+	size_t pt[4] = { 3, 2, 2, 3 };
+
+	rc = zsl_mtx_lu(&m, &lu, p);
+	zassert_equal(rc, 0, NULL);
+
+	/* Check the output. */
+	for (size_t g = 0; g < 16; g++) {
+		zassert_true(val_is_equal(lu.data[g], dt[g], 1E-5), NULL);
+	}
+	for (size_t g = 0; g < 4; g++) {
+		zassert_equal(p[g], pt[g], NULL);
+	}
+
+	/* Rebuild L and U, and make sure that L * U is equal to the input
+	 * matrix with the pivot row interchanges applied. */
+	zsl_mtx_init(&l, zsl_mtx_entry_fn_identity);
+	zsl_mtx_init(&u, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			zsl_mtx_get(&lu, i, j, &x);
+			if (j < i) {
+				zsl_mtx_set(&l, i, j, x);
+			} else {
+				zsl_mtx_set(&u, i, j, x);
+			}
+		}
+	}
+	zsl_mtx_mult(&l, &u, &prod);
+
+	zsl_mtx_copy(&pm, &m);
+	for (size_t k = 0; k < 4; k++) {
+		zsl_real_t row[4];
+		zsl_real_t row2[4];
+
+		zsl_mtx_get_row(&pm, k, row);
+		zsl_mtx_get_row(&pm, p[k], row2);
+		zsl_mtx_set_row(&pm, k, row2);
+		zsl_mtx_set_row(&pm, p[k], row);
+	}
+
+	for (size_t g = 0; g < 16; g++) {
+		zassert_true(val_is_equal(prod.data[g], pm.data[g], 1E-5), NULL);
+	}
+
+	/* Decompose the matrix in place. */
+	zsl_mtx_copy(&pm, &m);
+	rc = zsl_mtx_lu(&pm, &pm, p);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 16; g++) {
+		zassert_true(val_is_equal(pm.data[g], dt[g], 1E-5), NULL);
+	}
+
+	/* In the following examples, an error is expected due to invalid input
+	 * matrices. */
+	rc = zsl_mtx_lu(&mc, &lu, p);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_lu(&m, &mc, p);
+	zassert_equal(rc, -EINVAL, NULL);
 }
 
 ZTEST(zsl_tests, test_matrix_gauss_elim)
@@ -1951,6 +2186,166 @@ ZTEST(zsl_tests, test_matrix_cholesky)
 	zassert_equal(rc, -EINVAL, NULL);
 }
 
+ZTEST(zsl_tests, test_matrix_solve)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(x, 4, 2);
+	ZSL_MATRIX_DEF(ax, 4, 2);
+	ZSL_MATRIX_DEF(xb, 4, 3);
+
+	/* Input matrix. */
+	zsl_real_t data[16] = {  2.0,  1.0, -1.0,  3.0,
+				 4.0, -6.0,  0.0,  1.0,
+				 -2.0,  7.0,  2.0,  0.0,
+				 1.0,  0.0,  5.0, -3.0 };
+
+	struct zsl_mtx ma = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Right-hand side, two columns. */
+	zsl_real_t datb[8] = {  1.0,  2.0,
+				0.0, -1.0,
+				3.0,  0.0,
+				-2.0,  4.0 };
+
+	struct zsl_mtx mb = {
+		.sz_rows = 4,
+		.sz_cols = 2,
+		.data = datb
+	};
+
+	/* Singular input matrix (the third row is the sum of the first
+	 * two). */
+	zsl_real_t datc[16] = {  1.0,  2.0,  3.0,  4.0,
+				 2.0,  0.0,  1.0, -1.0,
+				 3.0,  2.0,  4.0,  3.0,
+				 0.0,  1.0, -2.0,  5.0 };
+
+	struct zsl_mtx mc = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = datc
+	};
+
+	/* Expected output (computed with numpy). */
+	zsl_real_t dt[8] = {  -8.6206896551724,  13.7931034482759,
+			      -4.1034482758621,   6.9655172413793,
+			      7.2413793103448, -10.5862068965517,
+			      9.8620689655172, -14.3793103448276 };
+
+	/* Solve a * x = b. */
+	rc = zsl_mtx_solve(&ma, &mb, &x);
+	zassert_equal(rc, 0, NULL);
+
+	/* Check the output and the residual. */
+	for (size_t g = 0; g < 8; g++) {
+		zassert_true(val_is_equal(x.data[g], dt[g], 1E-4), NULL);
+	}
+	rc = zsl_mtx_mult(&ma, &x, &ax);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 8; g++) {
+		zassert_true(val_is_equal(ax.data[g], mb.data[g], 1E-4), NULL);
+	}
+
+	/* Solve in place, overwriting 'b'. */
+	rc = zsl_mtx_solve(&ma, &mb, &mb);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 8; g++) {
+		zassert_true(val_is_equal(mb.data[g], x.data[g], 1E-6), NULL);
+	}
+
+	/* A singular matrix has no unique solution. */
+	rc = zsl_mtx_solve(&mc, &x, &ax);
+	zassert_equal(rc, -ESINGULAR, NULL);
+
+	/* In the following examples, an error is expected due to invalid
+	 * shapes. */
+	rc = zsl_mtx_solve(&mb, &x, &ax);
+	zassert_equal(rc, -EINVAL, NULL);
+	rc = zsl_mtx_solve(&ma, &x, &xb);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
+ZTEST(zsl_tests, test_matrix_solve_spd)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(x, 3, 1);
+	ZSL_MATRIX_DEF(ax, 3, 1);
+
+	/* Input symmetric positive definite matrix. */
+	zsl_real_t data[9] = {   4.0,  12.0, -16.0,
+				 12.0,  37.0, -43.0,
+				 -16.0, -43.0,  98.0 };
+
+	struct zsl_mtx ma = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* Input symmetric matrix that isn't positive definite. */
+	zsl_real_t datb[9] = { 1.0, 2.0, 3.0,
+			       2.0, 1.0, 4.0,
+			       3.0, 4.0, 1.0 };
+
+	struct zsl_mtx mb = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = datb
+	};
+
+	/* Input non-symmetric matrix. */
+	zsl_real_t datc[9] = { 4.0, 1.0, 0.0,
+			       2.0, 5.0, 1.0,
+			       0.0, 3.0, 6.0 };
+
+	struct zsl_mtx mc = {
+		.sz_rows = 3,
+		.sz_cols = 3,
+		.data = datc
+	};
+
+	/* Right-hand side. */
+	zsl_real_t datv[3] = { 1.0, 2.0, 3.0 };
+
+	struct zsl_mtx mv = {
+		.sz_rows = 3,
+		.sz_cols = 1,
+		.data = datv
+	};
+
+	/* Expected output. */
+	zsl_real_t dt[3] = { 343.0 / 12.0, -23.0 / 3.0, 4.0 / 3.0 };
+
+	/* Solve a * x = v. */
+	rc = zsl_mtx_solve_spd(&ma, &mv, &x);
+	zassert_equal(rc, 0, NULL);
+
+	/* Check the output and the residual. */
+	for (size_t g = 0; g < 3; g++) {
+		zassert_true(val_is_equal(x.data[g], dt[g], 1E-3), NULL);
+	}
+	rc = zsl_mtx_mult(&ma, &x, &ax);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 3; g++) {
+		zassert_true(val_is_equal(ax.data[g], mv.data[g], 1E-3), NULL);
+	}
+
+	/* A matrix that isn't positive definite is rejected. */
+	rc = zsl_mtx_solve_spd(&mb, &mv, &x);
+	zassert_equal(rc, -ESINGULAR, NULL);
+
+	/* In the following example, an error is expected due to an invalid
+	 * input matrix. */
+	rc = zsl_mtx_solve_spd(&mc, &mv, &x);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
 ZTEST(zsl_tests, test_matrix_balance)
 {
 	int rc;
@@ -2249,6 +2644,76 @@ ZTEST(zsl_tests, test_matrix_qrd_hess)
 	}
 }
 
+ZTEST(zsl_tests, test_matrix_qrd_compact)
+{
+	int rc;
+
+	ZSL_MATRIX_DEF(qr, 5, 3);
+	ZSL_MATRIX_DEF(q, 5, 5);
+	ZSL_MATRIX_DEF(r, 5, 3);
+	ZSL_MATRIX_DEF(qtm, 5, 3);
+	ZSL_MATRIX_DEF(mq, 5, 3);
+	ZSL_MATRIX_DEF(qtq, 5, 5);
+	ZSL_VECTOR_DEF(tau, 3);
+
+	/* Input matrix, taller than it is wide. */
+	zsl_real_t data[15] = { 2.0, -1.0, 0.5,
+				4.0, 3.0, -2.0,
+				-1.0, 0.0, 6.0,
+				0.0, 5.0, 1.0,
+				3.0, -2.0, -4.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 5,
+		.sz_cols = 3,
+		.data = data
+	};
+
+	/* Compute the compact form, and form Q. */
+	rc = zsl_mtx_qrd_compact(&m, &qr, &tau, false);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_qrd_form_q(&qr, &tau, false, &q);
+	zassert_equal(rc, 0, NULL);
+
+	/* Q should be orthogonal. */
+	rc = zsl_mtx_gemm(true, false, 1.0, &q, &q, 0.0, &qtq);
+	zassert_equal(rc, 0, NULL);
+	for (size_t i = 0; i < 5; i++) {
+		for (size_t j = 0; j < 5; j++) {
+			zassert_true(val_is_equal(qtq.data[(i * 5) + j],
+						  i == j ? 1.0 : 0.0, 1E-5),
+				     NULL);
+		}
+	}
+
+	/* Q * R should give back the input. */
+	for (size_t i = 0; i < 5; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			r.data[(i * 3) + j] = (j >= i) ? qr.data[(i * 3) + j] :
+					      0.0;
+		}
+	}
+	rc = zsl_mtx_mult(&q, &r, &mq);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 15; g++) {
+		zassert_true(val_is_equal(mq.data[g], m.data[g], 1E-5), NULL);
+	}
+
+	/* Q^T * m should be R, without forming Q. */
+	rc = zsl_mtx_copy(&qtm, &m);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_qrd_apply_qt(&qr, &tau, false, &qtm);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 15; g++) {
+		zassert_true(val_is_equal(qtm.data[g], r.data[g], 1E-5), NULL);
+	}
+
+	/* A too short 'tau' should be rejected. */
+	tau.sz = 2;
+	rc = zsl_mtx_qrd_compact(&m, &qr, &tau, false);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
 ZTEST(zsl_tests_double, test_matrix_qrd_iter)
 {
@@ -2383,6 +2848,197 @@ ZTEST(zsl_tests_double, test_matrix_eigenvalues)
 }
 #endif
 
+ZTEST(zsl_tests, test_matrix_eigenvalues_francis)
+{
+	int rc;
+	size_t iter;
+	size_t found;
+
+	ZSL_VECTOR_DEF(re, 4);
+	ZSL_VECTOR_DEF(im, 4);
+	ZSL_VECTOR_DEF(re2, 4);
+
+	/* Input real-eigenvalue matrix. */
+	zsl_real_t data[16] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0,
+				5.0, 3.0, -5.0, 2.0 };
+
+	struct zsl_mtx ma = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Input complex-eigenvalue matrix. */
+	zsl_real_t datb[16] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0,
+				9.0, 3.0, -5.0, 2.0 };
+
+	struct zsl_mtx mb = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = datb
+	};
+
+	/* Expected output, sorted. */
+	re2.data[0] = -2.6841592178899276;
+	re2.data[1] = -0.9999999802303374;
+	re2.data[2] = 1.8493811427083884;
+	re2.data[3] = 4.8347780554139375;
+
+	/* Expected output, as (re, im) pairs. */
+	zsl_real_t exp[8] = { 3.5462835, 0.59842464,
+			      3.5462835, -0.59842464,
+			      -3.09256701, 0.0,
+			      -1.0, 0.0 };
+
+	rc = zsl_mtx_eigenvalues_francis(&ma, &re, &im, 0.0, 120, &iter);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(iter > 0, NULL);
+	zassert_true(iter <= 12, NULL);
+	for (size_t i = 0; i < 4; i++) {
+		zassert_true(val_is_equal(im.data[i], 0.0, 1E-6), NULL);
+	}
+	zsl_vec_sort(&re, &re);
+	zassert_true(zsl_vec_is_equal(&re, &re2, 1E-4), NULL);
+
+	/* Every complex eigenvalue should be found, with its conjugate. */
+	rc = zsl_mtx_eigenvalues_francis(&mb, &re, &im, 0.0, 120, &iter);
+	zassert_equal(rc, 0, NULL);
+	for (size_t g = 0; g < 4; g++) {
+		found = 0;
+		for (size_t i = 0; i < 4; i++) {
+			if (val_is_equal(re.data[i], exp[g * 2], 1E-4) &&
+			    val_is_equal(im.data[i], exp[(g * 2) + 1], 1E-4)) {
+				found++;
+			}
+		}
+		zassert_equal(found, 1, NULL);
+	}
+
+	/* Not enough iterations. */
+	rc = zsl_mtx_eigenvalues_francis(&mb, &re, &im, 0.0, 1, &iter);
+	zassert_equal(rc, -ECONVERGE, NULL);
+	zassert_equal(iter, 1, NULL);
+}
+
+ZTEST(zsl_tests, test_matrix_eigen_sym)
+{
+	int rc;
+	zsl_real_t x;
+
+	ZSL_VECTOR_DEF(v, 4);
+	ZSL_VECTOR_DEF(v2, 4);
+	ZSL_VECTOR_DEF(v3, 2);
+	ZSL_MATRIX_DEF(mev, 4, 4);
+	ZSL_MATRIX_DEF(mev3, 2, 2);
+
+	/* Input symmetric matrix. */
+	zsl_real_t data[16] = { 1.0, 2.0, 4.0, 0.0,
+				2.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 5.0,
+				0.0, -2.0, 5.0, -1.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 4,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Input 2x2 matrix with a repeated eigenvalue. */
+	zsl_real_t datb[4] = { 3.0, 0.0,
+			       0.0, 3.0 };
+
+	struct zsl_mtx mb = {
+		.sz_rows = 2,
+		.sz_cols = 2,
+		.data = datb
+	};
+
+	/* Expected output, in decreasing order. */
+	v2.data[0] = 7.4199113544017665;
+	v2.data[1] = 2.7935849909013921;
+	v2.data[2] = -0.9244614420638188;
+	v2.data[3] = -9.2890349032381003;
+
+	rc = zsl_mtx_eigen_sym(&m, &v, &mev);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_vec_is_equal(&v, &v2, 1E-4), NULL);
+
+	/* m * mev = mev * diag(v), and mev is orthonormal. */
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			x = 0.0;
+			for (size_t k = 0; k < 4; k++) {
+				x += m.data[(i * 4) + k] * mev.data[(k * 4) + j];
+			}
+			zassert_true(val_is_equal(x, v.data[j] *
+						  mev.data[(i * 4) + j], 1E-4),
+				     NULL);
+
+			x = 0.0;
+			for (size_t k = 0; k < 4; k++) {
+				x += mev.data[(k * 4) + i] * mev.data[(k * 4) + j];
+			}
+			zassert_true(val_is_equal(x, i == j ? 1.0 : 0.0, 1E-5),
+				     NULL);
+		}
+	}
+
+	/* Eigenvalues only. */
+	zsl_vec_init(&v);
+	rc = zsl_mtx_eigen_sym(&m, &v, NULL);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_vec_is_equal(&v, &v2, 1E-4), NULL);
+
+	/* A repeated eigenvalue still has a full set of eigenvectors. */
+	rc = zsl_mtx_eigen_sym(&mb, &v3, &mev3);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(v3.data[0], 3.0, 1E-6), NULL);
+	zassert_true(val_is_equal(v3.data[1], 3.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mev3.data[0], 1.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mev3.data[1], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mev3.data[2], 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(mev3.data[3], 1.0, 1E-6), NULL);
+
+	/* A non-diagonal 2x2 input needs a Jacobi rotation. */
+	datb[0] = 2.0;
+	datb[1] = 1.0;
+	datb[2] = 1.0;
+	datb[3] = 2.0;
+	rc = zsl_mtx_eigen_sym(&mb, &v3, &mev3);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(val_is_equal(v3.data[0], 3.0, 1E-6), NULL);
+	zassert_true(val_is_equal(v3.data[1], 1.0, 1E-6), NULL);
+
+	/* mb * mev3 = mev3 * diag(v3), and mev3 is orthonormal. */
+	for (size_t i = 0; i < 2; i++) {
+		for (size_t j = 0; j < 2; j++) {
+			x = 0.0;
+			for (size_t k = 0; k < 2; k++) {
+				x += mb.data[(i * 2) + k] * mev3.data[(k * 2) + j];
+			}
+			zassert_true(val_is_equal(x, v3.data[j] *
+						  mev3.data[(i * 2) + j], 1E-6),
+				     NULL);
+
+			x = 0.0;
+			for (size_t k = 0; k < 2; k++) {
+				x += mev3.data[(k * 2) + i] * mev3.data[(k * 2) + j];
+			}
+			zassert_true(val_is_equal(x, i == j ? 1.0 : 0.0, 1E-6),
+				     NULL);
+		}
+	}
+
+	/* 'v' is too small. */
+	v3.sz = 1;
+	rc = zsl_mtx_eigen_sym(&mb, &v3, &mev3);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
 ZTEST(zsl_tests_double, test_matrix_eigenvectors)
 {
@@ -2643,6 +3299,94 @@ ZTEST(zsl_tests_double, test_matrix_svd)
 }
 #endif
 
+ZTEST(zsl_tests, test_matrix_svd_thin)
+{
+	int rc;
+	size_t rank;
+	zsl_real_t x;
+
+	ZSL_MATRIX_DEF(u, 3, 3);
+	ZSL_MATRIX_DEF(v, 4, 3);
+	ZSL_VECTOR_DEF(s, 3);
+	ZSL_VECTOR_DEF(s2, 3);
+	ZSL_MATRIX_DEF(pinv, 2, 4);
+
+	/* Input matrix, wider than it is tall. */
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	/* Input rank-1 matrix. */
+	zsl_real_t datb[8] = { 1.0, 2.0,
+			       2.0, 4.0,
+			       3.0, 6.0,
+			       -1.0, -2.0 };
+
+	struct zsl_mtx mb = {
+		.sz_rows = 4,
+		.sz_cols = 2,
+		.data = datb
+	};
+
+	/* Expected singular values. */
+	s2.data[0] = 6.8246886030;
+	s2.data[1] = 5.3940011894;
+	s2.data[2] = 0.5730415692;
+
+	rc = zsl_mtx_svd_thin(&m, &u, &s, &v);
+	zassert_equal(rc, 0, NULL);
+	zassert_true(zsl_vec_is_equal(&s, &s2, 1E-4), NULL);
+
+	/* u * diag(s) * v^T should give back the input. */
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			x = 0.0;
+			for (size_t l = 0; l < 3; l++) {
+				x += u.data[(i * 3) + l] * s.data[l] *
+				     v.data[(j * 3) + l];
+			}
+			zassert_true(val_is_equal(x, data[(i * 4) + j], 1E-4),
+				     NULL);
+		}
+	}
+
+	/* The columns of 'v' should be orthonormal. */
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			x = 0.0;
+			for (size_t l = 0; l < 4; l++) {
+				x += v.data[(l * 3) + i] * v.data[(l * 3) + j];
+			}
+			zassert_true(val_is_equal(x, i == j ? 1.0 : 0.0, 1E-5),
+				     NULL);
+		}
+	}
+
+	/* The pseudo-inverse of a rank-1 matrix is m^T / |m|^2. */
+	rc = zsl_mtx_pinv_tol(&mb, &pinv, 1E-4, &rank);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(rank, 1, NULL);
+	for (size_t i = 0; i < 2; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			zassert_true(val_is_equal(pinv.data[(i * 4) + j],
+						  datb[(j * 2) + i] / 75.0,
+						  1E-5),
+				     NULL);
+		}
+	}
+
+	/* 'u' has the wrong shape. */
+	u.sz_cols = 2;
+	rc = zsl_mtx_svd_thin(&m, &u, &s, &v);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
 #ifndef CONFIG_ZSL_SINGLE_PRECISION
 ZTEST(zsl_tests_double, test_matrix_pinv)
 {
@@ -2690,6 +3434,89 @@ ZTEST(zsl_tests_double, test_matrix_pinv)
 }
 #endif
 
+#ifndef CONFIG_ZSL_SINGLE_PRECISION
+ZTEST(zsl_tests_double, test_matrix_pinv_ws)
+{
+	int rc;
+	size_t bytes;
+	static zsl_real_t buf[512];
+	struct zsl_ws ws;
+
+	ZSL_MATRIX_DEF(pinv, 4, 3);
+	ZSL_MATRIX_DEF(pinv2, 4, 3);
+
+	/* Input  matrix. */
+	zsl_real_t data[12] = { 1.0, 2.0, -1.0, 0.0,
+				0.0, 3.0, 4.0, -2.0,
+				4.0, 4.0, -3.0, 0.0 };
+
+	struct zsl_mtx m = {
+		.sz_rows = 3,
+		.sz_cols = 4,
+		.data = data
+	};
+
+	bytes = zsl_mtx_ws_bytes(ZSL_MTX_WS_PINV, 3, 4);
+	zassert_true(bytes <= sizeof(buf), NULL);
+
+	/* A workspace that is one element too small must be rejected. */
+	rc = zsl_ws_init(&ws, buf, bytes - sizeof(zsl_real_t));
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_pinv_ws(&m, &pinv, 1500, &ws);
+	zassert_equal(rc, -ENOMEM, NULL);
+	zassert_equal(ws.used, 0, NULL);
+
+	/* An exactly sized workspace must match the stack-based version. */
+	rc = zsl_ws_init(&ws, buf, bytes);
+	zassert_equal(rc, 0, NULL);
+	rc = zsl_mtx_pinv_ws(&m, &pinv, 1500, &ws);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ws.used, 0, NULL);
+	zassert_true(ws.peak * sizeof(zsl_real_t) <= bytes, NULL);
+
+	rc = zsl_mtx_pinv(&m, &pinv2, 1500);
+	zassert_equal(rc, 0, NULL);
+
+	for (size_t g = 0; g < (pinv.sz_rows * pinv.sz_cols); g++) {
+		zassert_true(val_is_equal(pinv.data[g], pinv2.data[g], 1E-12),
+			     NULL);
+	}
+}
+#endif
+
+ZTEST(zsl_tests, test_matrix_ws)
+{
+	int rc;
+	zsl_real_t buf[8];
+	struct zsl_ws ws;
+	struct zsl_mtx m;
+	struct zsl_vec v;
+
+	rc = zsl_ws_init(&ws, buf, sizeof(buf));
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(ws.sz, 8, NULL);
+
+	rc = zsl_ws_mtx(&ws, &m, 2, 3);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(m.data, buf, NULL);
+	zassert_equal(ws.used, 6, NULL);
+
+	/* Only two elements are left. */
+	rc = zsl_ws_vec(&ws, &v, 3);
+	zassert_equal(rc, -ENOMEM, NULL);
+	zassert_equal(ws.used, 6, NULL);
+
+	rc = zsl_ws_vec(&ws, &v, 2);
+	zassert_equal(rc, 0, NULL);
+	zassert_equal(v.data, &buf[6], NULL);
+	zassert_equal(ws.used, 8, NULL);
+	zassert_equal(ws.peak, 8, NULL);
+
+	/* Releasing everything keeps the high-water mark. */
+	ws.used = 0;
+	zassert_equal(ws.peak, 8, NULL);
+}
+
 ZTEST(zsl_tests, test_matrix_min)
 {
 	int rc = 0;
@@ -846,22 +846,28 @@ ZTEST(zsl_tests, test_quat_to_euler)
 		.k = 0.642970
 	};
 	struct zsl_euler e = { .x = 0.0, .y = 0.0, .z = 0.0 };
+#ifdef CONFIG_ZSL_FAST_MATH
+	/* The error bound of zsl_fast_atan2. */
+	zsl_real_t tol = 1.2E-5;
+#else
+	zsl_real_t tol = 1E-6;
+#endif
 
 	rc = zsl_quat_to_euler(&q, &e);
 	zassert_true(rc == 0, NULL);
 
-	zassert_true(val_is_equal(e.x, 0.035148, 1E-6), NULL);
-	zassert_true(val_is_equal(e.y, 0.024579, 1E-6), NULL);
-	zassert_true(val_is_equal(e.z, 3.059905, 1E-6), NULL);
+	zassert_true(val_is_equal(e.x, 0.035148, tol), NULL);
+	zassert_true(val_is_equal(e.y, 0.024579, tol), NULL);
+	zassert_true(val_is_equal(e.z, 3.059905, tol), NULL);
 
 	/* Case in which gimbal lock ocurrs. */
 	rc = zsl_quat_to_euler(&q2, &e);
 	zassert_true(rc == 0, NULL);
-	zassert_true(val_is_equal(e.x, -2.283185, 1E-6), NULL);
+	zassert_true(val_is_equal(e.x, -2.283185, tol), NULL);
 #ifdef CONFIG_ZSL_SINGLE_PRECISION
 	zassert_true(val_is_equal(e.y, 1.570796, 1E-3), NULL);
 #else
-	zassert_true(val_is_equal(e.y, 1.570796, 1E-6), NULL);
+	zassert_true(val_is_equal(e.y, 1.570796, tol), NULL);
 #endif
 	zassert_true(val_is_equal(e.z, 0.0, 1E-6), NULL);
 }
@@ -1044,3 +1050,173 @@ ZTEST(zsl_tests, test_quat_from_axis_angle)
 	rc = zsl_quat_from_axis_angle(&a3, &b, &q);
 	zassert_true(rc == -EINVAL, NULL);
 }
+
+/* Quaternions for the array functions. 11 of them, so that both the block
+ * loop and the remainder of zsl_quat_mult_n are used with any vector width. */
+static void quat_n_fill(struct zsl_quat *q, size_t n, zsl_real_t s)
+{
+	for (size_t l = 0; l < n; l++) {
+		q[l].r = 0.5 + s * l;
+		q[l].i = -0.25 + 0.1 * l;
+		q[l].j = 0.75 - s * 0.2 * l;
+		q[l].k = 0.125 * s + 0.05 * l;
+	}
+}
+
+ZTEST(zsl_tests, test_quat_mult_n)
+{
+	int rc;
+	struct zsl_quat qa[11];
+	struct zsl_quat qb[11];
+	struct zsl_quat qm[11];
+	struct zsl_quat q;
+
+	quat_n_fill(qa, 11, 0.3);
+	quat_n_fill(qb, 11, -0.7);
+
+	rc = zsl_quat_mult_n(11, qa, qb, qm);
+	zassert_true(rc == 0, NULL);
+	for (size_t l = 0; l < 11; l++) {
+		zsl_quat_mult(&qa[l], &qb[l], &q);
+		zassert_true(val_is_equal(qm[l].r, q.r, 1E-6), NULL);
+		zassert_true(val_is_equal(qm[l].i, q.i, 1E-6), NULL);
+		zassert_true(val_is_equal(qm[l].j, q.j, 1E-6), NULL);
+		zassert_true(val_is_equal(qm[l].k, q.k, 1E-6), NULL);
+	}
+
+	/* In place, with the output in the first input array. */
+	rc = zsl_quat_mult_n(11, qa, qb, qa);
+	zassert_true(rc == 0, NULL);
+	for (size_t l = 0; l < 11; l++) {
+		zassert_true(val_is_equal(qa[l].r, qm[l].r, 1E-6), NULL);
+		zassert_true(val_is_equal(qa[l].i, qm[l].i, 1E-6), NULL);
+		zassert_true(val_is_equal(qa[l].j, qm[l].j, 1E-6), NULL);
+		zassert_true(val_is_equal(qa[l].k, qm[l].k, 1E-6), NULL);
+	}
+}
+
+ZTEST(zsl_tests, test_quat_rot_n)
+{
+	int rc;
+	struct zsl_quat qa = {
+		.r = -0.936457,
+		.i = -0.093751,
+		.j = -0.281252,
+		.k = -0.187502
+	};
+	struct zsl_quat qb;
+	struct zsl_quat qr;
+	struct zsl_quat qz = { .r = 0.0, .i = 0.0, .j = 0.0, .k = 0.0 };
+
+	/* Five (x, y, z, w) points, w being an unrelated value. */
+	zsl_real_t v[20];
+	zsl_real_t vr[15];
+
+	for (size_t l = 0; l < 5; l++) {
+		v[l * 4] = 1.6 + l;
+		v[l * 4 + 1] = -2.1 * l;
+		v[l * 4 + 2] = 123.0 - 10.0 * l;
+		v[l * 4 + 3] = 42.0;
+	}
+
+	rc = zsl_quat_rot_n(5, &qa, v, 4, vr, 3);
+	zassert_true(rc == 0, NULL);
+	for (size_t l = 0; l < 5; l++) {
+		qb.r = 0.0;
+		qb.i = v[l * 4];
+		qb.j = v[l * 4 + 1];
+		qb.k = v[l * 4 + 2];
+		zsl_quat_rot(&qa, &qb, &qr);
+		zassert_true(val_is_equal(vr[l * 3], qr.i, 1E-4), NULL);
+		zassert_true(val_is_equal(vr[l * 3 + 1], qr.j, 1E-4), NULL);
+		zassert_true(val_is_equal(vr[l * 3 + 2], qr.k, 1E-4), NULL);
+	}
+
+	/* Rotate in place, leaving the fourth value of each point alone. */
+	rc = zsl_quat_rot_n(5, &qa, v, 4, v, 4);
+	zassert_true(rc == 0, NULL);
+	for (size_t l = 0; l < 5; l++) {
+		zassert_true(val_is_equal(v[l * 4], vr[l * 3], 1E-6), NULL);
+		zassert_true(val_is_equal(v[l * 4 + 1], vr[l * 3 + 1], 1E-6),
+			     NULL);
+		zassert_true(val_is_equal(v[l * 4 + 2], vr[l * 3 + 2], 1E-6),
+			     NULL);
+		zassert_true(val_is_equal(v[l * 4 + 3], 42.0, 1E-6), NULL);
+	}
+
+	/* A zero quaternion gives zero points, as zsl_quat_rot does. */
+	rc = zsl_quat_rot_n(5, &qz, v, 4, vr, 3);
+	zassert_true(rc == 0, NULL);
+	for (size_t l = 0; l < 15; l++) {
+		zassert_true(val_is_equal(vr[l], 0.0, 1E-6), NULL);
+	}
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* Points can't overlap each other. */
+	rc = zsl_quat_rot_n(5, &qa, v, 2, vr, 3);
+	zassert_true(rc == -EINVAL, NULL);
+	rc = zsl_quat_rot_n(5, &qa, v, 4, vr, 2);
+	zassert_true(rc == -EINVAL, NULL);
+#endif
+}
+
+ZTEST(zsl_tests, test_quat_slerp_n)
+{
+	int rc;
+	struct zsl_quat qa[11];
+	struct zsl_quat qb[11];
+	struct zsl_quat qi[11];
+	struct zsl_quat q;
+
+	quat_n_fill(qa, 11, 0.3);
+	quat_n_fill(qb, 11, -0.7);
+
+	rc = zsl_quat_slerp_n(11, qa, qb, 0.3, qi);
+	zassert_true(rc == 0, NULL);
+	for (size_t l = 0; l < 11; l++) {
+		zsl_quat_slerp(&qa[l], &qb[l], 0.3, &q);
+		zassert_true(val_is_equal(qi[l].r, q.r, 1E-6), NULL);
+		zassert_true(val_is_equal(qi[l].i, q.i, 1E-6), NULL);
+		zassert_true(val_is_equal(qi[l].j, q.j, 1E-6), NULL);
+		zassert_true(val_is_equal(qi[l].k, q.k, 1E-6), NULL);
+	}
+
+	/* Opposite quaternions can't be interpolated. The other pairs are. */
+	zsl_quat_init(&qi[0], ZSL_QUAT_TYPE_EMPTY);
+	zsl_quat_init(&qi[1], ZSL_QUAT_TYPE_EMPTY);
+	qb[0].r = -qa[0].r;
+	qb[0].i = -qa[0].i;
+	qb[0].j = -qa[0].j;
+	qb[0].k = -qa[0].k;
+	rc = zsl_quat_slerp_n(2, qa, qb, 0.3, qi);
+	zassert_true(rc == -EINVAL, NULL);
+	zassert_true(val_is_equal(qi[0].r, 0.0, 1E-6), NULL);
+	zsl_quat_slerp(&qa[1], &qb[1], 0.3, &q);
+	zassert_true(val_is_equal(qi[1].r, q.r, 1E-6), NULL);
+	zassert_true(val_is_equal(qi[1].k, q.k, 1E-6), NULL);
+
+#if CONFIG_ZSL_BOUNDS_CHECKS
+	/* t must be between 0 and 1. */
+	rc = zsl_quat_slerp_n(11, qa, qb, 1.1, qi);
+	zassert_true(rc == -EINVAL, NULL);
+#endif
+}
+
+ZTEST(zsl_tests, test_quat_to_euler_n)
+{
+	int rc;
+	struct zsl_quat q[11];
+	struct zsl_euler e[11];
+	struct zsl_euler e1;
+
+	quat_n_fill(q, 11, 0.3);
+
+	rc = zsl_quat_to_euler_n(11, q, e);
+	zassert_true(rc == 0, NULL);
+	for (size_t l = 0; l < 11; l++) {
+		zsl_quat_to_euler(&q[l], &e1);
+		zassert_true(val_is_equal(e[l].x, e1.x, 1E-6), NULL);
+		zassert_true(val_is_equal(e[l].y, e1.y, 1E-6), NULL);
+		zassert_true(val_is_equal(e[l].z, e1.z, 1E-6), NULL);
+	}
+}
@@ -237,6 +237,73 @@ ZTEST(zsl_tests, test_sta_percentile)
 	zassert_true(rc == -EINVAL, NULL);
 }
 
+ZTEST(zsl_tests, test_sta_percentile_inplace)
+{
+	int rc;
+	zsl_real_t val, ref, q1, q2, q3;
+	uint32_t seed = 0x2545F491;
+
+	ZSL_VECTOR_DEF(v, 101);
+	ZSL_VECTOR_DEF(w, 101);
+	ZSL_VECTOR_DEF(s, 101);
+
+	/* Pseudo-random values with repeats. */
+	for (size_t i = 0; i < v.sz; i++) {
+		seed = seed * 1664525U + 1013904223U;
+		v.data[i] = (zsl_real_t)((seed >> 16) % 50U) / 4.0;
+	}
+	rc = zsl_vec_sort(&v, &s);
+	zassert_true(rc == 0, NULL);
+
+	/* Compare the selection-based results with the sorted vector. */
+	for (size_t p = 0; p <= 100; p++) {
+		zsl_real_t x = (p * v.sz) / 100.;
+		size_t k = (size_t)x;
+
+		if (p == 100) {
+			ref = s.data[v.sz - 1];
+		} else if (x == k && k > 0) {
+			ref = (s.data[k] + s.data[k - 1]) / 2.;
+		} else {
+			ref = s.data[k];
+		}
+
+		rc = zsl_sta_percentile(&v, p, &val);
+		zassert_true(rc == 0, NULL);
+		zassert_true(val_is_equal(val, ref, 1E-6), NULL);
+
+		zsl_vec_copy(&w, &v);
+		rc = zsl_sta_percentile_inplace(&w, p, &val);
+		zassert_true(rc == 0, NULL);
+		zassert_true(val_is_equal(val, ref, 1E-6), NULL);
+	}
+
+	/* The median of an odd-length vector is the middle value. */
+	zsl_vec_copy(&w, &v);
+	rc = zsl_sta_median_inplace(&w, &val);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(val, s.data[50], 1E-6), NULL);
+
+	/* The in-place quartiles must match the ones computed on a copy. */
+	zsl_vec_copy(&w, &v);
+	rc = zsl_sta_quart_inplace(&w, &q1, &q2, &q3);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_sta_percentile(&v, 25, &val);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(q1, val, 1E-6), NULL);
+	zassert_true(val_is_equal(q2, s.data[50], 1E-6), NULL);
+	rc = zsl_sta_percentile(&v, 75, &val);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(q3, val, 1E-6), NULL);
+
+	/* The permuted vector must hold the same values. */
+	rc = zsl_vec_sort(&w, &w);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < w.sz; i++) {
+		zassert_equal(w.data[i], s.data[i], NULL);
+	}
+}
+
 ZTEST(zsl_tests, test_sta_median)
 {
 	int rc;
@@ -831,6 +898,88 @@ ZTEST(zsl_tests_double, test_sta_quadric_fitting)
 }
 #endif
 
+ZTEST(zsl_tests, test_sta_least_squares_qr)
+{
+	int rc;
+	zsl_real_t r = 0.0;
+	zsl_real_t t;
+
+	ZSL_MATRIX_DEF(x, 50, 3);
+	ZSL_VECTOR_DEF(y, 50);
+	ZSL_VECTOR_DEF(w, 50);
+	ZSL_VECTOR_DEF(b, 4);
+	ZSL_MATRIX_DEF(m, 24, 3);
+	ZSL_VECTOR_DEF(q, 9);
+
+	/* Expected quadric: the sphere of radius 2 centred on (1, 0, -1). */
+	zsl_real_t qe[9] = { 0.5, 0.5, 0.5, 0.0, 0.0, 0.0, -0.5, 0.0, 0.5 };
+
+	/* Exact data for y = 1.5 + 2 * x0 - 0.5 * x1 + 0.25 * x2. */
+	for (size_t i = 0; i < 50; i++) {
+		x.data[i * 3] = (zsl_real_t)(i % 7) - 3.0;
+		x.data[i * 3 + 1] = ZSL_SIN((zsl_real_t)i);
+		x.data[i * 3 + 2] = 0.5 * (zsl_real_t)((i * i) % 11);
+		y.data[i] = 1.5 + 2.0 * x.data[i * 3] -
+			    0.5 * x.data[i * 3 + 1] + 0.25 * x.data[i * 3 + 2];
+		w.data[i] = 2.0;
+	}
+
+	rc = zsl_sta_mult_linear_reg(&x, &y, &b, &r);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(b.data[0], 1.5, 1E-4), NULL);
+	zassert_true(val_is_equal(b.data[1], 2.0, 1E-4), NULL);
+	zassert_true(val_is_equal(b.data[2], -0.5, 1E-4), NULL);
+	zassert_true(val_is_equal(b.data[3], 0.25, 1E-4), NULL);
+	zassert_true(val_is_equal(r, 1.0, 1E-4), NULL);
+
+	/* Equal weights give the same fit, and the weights are unchanged. */
+	rc = zsl_sta_weighted_mult_linear_reg(&x, &y, &w, &b, &r);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(b.data[0], 1.5, 1E-4), NULL);
+	zassert_true(val_is_equal(b.data[3], 0.25, 1E-4), NULL);
+	zassert_true(val_is_equal(r, 1.0, 1E-4), NULL);
+	zassert_true(val_is_equal(w.data[0], 2.0, 1E-6), NULL);
+
+	/* Down-weighting one bad sample pulls the fit back to the line. */
+	y.data[10] += 100.0;
+	w.data[10] = 1E6;
+	rc = zsl_sta_weighted_mult_linear_reg(&x, &y, &w, &b, &r);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(b.data[1], 2.0, 1E-3), NULL);
+
+	/* A negative, zero or NaN weight. */
+	w.data[10] = -2.0;
+	rc = zsl_sta_weighted_mult_linear_reg(&x, &y, &w, &b, &r);
+	zassert_true(rc == -EINVAL, NULL);
+	w.data[10] = 0.0;
+	rc = zsl_sta_weighted_mult_linear_reg(&x, &y, &w, &b, &r);
+	zassert_true(rc == -EINVAL, NULL);
+	w.data[10] = NAN;
+	rc = zsl_sta_weighted_mult_linear_reg(&x, &y, &w, &b, &r);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Points on a sphere, at four latitudes and six longitudes. */
+	for (size_t i = 0; i < 24; i++) {
+		t = (zsl_real_t)(i / 6) * 0.7 - 1.0;
+		m.data[i * 3] = 1.0 + 2.0 * ZSL_COS(t) *
+				ZSL_COS((zsl_real_t)(i % 6) * ZSL_PI / 3.0);
+		m.data[i * 3 + 1] = 2.0 * ZSL_COS(t) *
+				    ZSL_SIN((zsl_real_t)(i % 6) * ZSL_PI / 3.0);
+		m.data[i * 3 + 2] = -1.0 + 2.0 * ZSL_SIN(t);
+	}
+
+	rc = zsl_sta_quad_fit(&m, &q);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < 9; i++) {
+		zassert_true(val_is_equal(q.data[i], qe[i], 1E-4), NULL);
+	}
+
+	/* Eight points can't determine the nine coefficients. */
+	m.sz_rows = 8;
+	rc = zsl_sta_quad_fit(&m, &q);
+	zassert_true(rc == -EINVAL, NULL);
+}
+
 ZTEST(zsl_tests, test_sta_absolute_error)
 {
 	int rc;
@@ -877,3 +1026,200 @@ ZTEST(zsl_tests, test_sta_standard_error)
 	rc = zsl_sta_sta_err(&w, &err);
 	zassert_true(rc == -EINVAL, NULL);
 }
+
+ZTEST(zsl_tests, test_sta_acc)
+{
+	int rc;
+	zsl_real_t m, var, s;
+	struct zsl_sta_acc acc, acc2;
+
+	zsl_real_t a[10] = { -2.0, 1.0, 3.0, 1.5, 1.5, -2.0, 1.0, -5.0, 1.0, -2.0 };
+
+	rc = zsl_sta_acc_reset(&acc);
+	zassert_true(rc == 0, NULL);
+
+	/* No samples have been pushed yet. */
+	rc = zsl_sta_acc_mean(&acc, &m);
+	zassert_true(rc == -EINVAL, NULL);
+
+	rc = zsl_sta_acc_push(&acc, a[0]);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_sta_acc_var(&acc, &var);
+	zassert_true(rc == -EINVAL, NULL);
+
+	for (size_t i = 1; i < 10; i++) {
+		rc = zsl_sta_acc_push(&acc, a[i]);
+		zassert_true(rc == 0, NULL);
+	}
+
+	/* Same data set as test_sta_variance. */
+	rc = zsl_sta_acc_mean(&acc, &m);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(m, -0.2, 1E-6), NULL);
+	rc = zsl_sta_acc_var(&acc, &var);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(var, 5.9, 1E-6), NULL);
+	rc = zsl_sta_acc_std_dev(&acc, &s);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(s, 2.42899156029, 1E-6), NULL);
+
+	/* Merging two partial accumulators must give the same result. */
+	zsl_sta_acc_reset(&acc);
+	zsl_sta_acc_reset(&acc2);
+	for (size_t i = 0; i < 3; i++) {
+		zsl_sta_acc_push(&acc, a[i]);
+	}
+	for (size_t i = 3; i < 10; i++) {
+		zsl_sta_acc_push(&acc2, a[i]);
+	}
+	rc = zsl_sta_acc_merge(&acc, &acc2);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(acc.n, 10, NULL);
+	zsl_sta_acc_mean(&acc, &m);
+	zassert_true(val_is_equal(m, -0.2, 1E-6), NULL);
+	zsl_sta_acc_var(&acc, &var);
+	zassert_true(val_is_equal(var, 5.9, 1E-6), NULL);
+
+	/* Merging into an empty accumulator copies the other one. */
+	zsl_sta_acc_reset(&acc);
+	rc = zsl_sta_acc_merge(&acc, &acc2);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(acc.n, acc2.n, NULL);
+	zassert_true(val_is_equal(acc.mean, acc2.mean, 1E-6), NULL);
+	zassert_true(val_is_equal(acc.m2, acc2.m2, 1E-6), NULL);
+}
+
+ZTEST(zsl_tests, test_sta_acc_xy)
+{
+	int rc;
+	zsl_real_t c;
+	struct zsl_sta_acc_xy acc, acc2;
+	struct zsl_sta_linreg coef;
+
+	zsl_real_t a[15] = { 1.47, 1.50, 1.52, 1.55, 1.57,
+			     1.60, 1.63, 1.65, 1.68, 1.70,
+			     1.73, 1.75, 1.78, 1.80, 1.83 };
+	zsl_real_t b[15] = { 52.21, 53.12, 54.48, 55.84, 57.20,
+			     58.57, 59.93, 61.29, 63.11, 64.47,
+			     66.28, 68.10, 69.92, 72.19, 74.46 };
+
+	zsl_sta_acc_xy_reset(&acc);
+	zsl_sta_acc_xy_reset(&acc2);
+
+	/* A single pair isn't enough for a regression. */
+	rc = zsl_sta_acc_xy_push(&acc, a[0], b[0]);
+	zassert_true(rc == 0, NULL);
+	rc = zsl_sta_acc_xy_linear_reg(&acc, &coef);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Split the data between two accumulators and merge them. */
+	for (size_t i = 1; i < 8; i++) {
+		zsl_sta_acc_xy_push(&acc, a[i], b[i]);
+	}
+	for (size_t i = 8; i < 15; i++) {
+		zsl_sta_acc_xy_push(&acc2, a[i], b[i]);
+	}
+	rc = zsl_sta_acc_xy_merge(&acc, &acc2);
+	zassert_true(rc == 0, NULL);
+
+	/* Same data set as test_sta_linear_regression. */
+	rc = zsl_sta_acc_xy_linear_reg(&acc, &coef);
+	zassert_true(rc == 0, NULL);
+#ifdef CONFIG_ZSL_SINGLE_PRECISION
+	zassert_true(val_is_equal(coef.slope, 61.2721865421074341, 1E-3), NULL);
+	zassert_true(val_is_equal(coef.intercept, -39.061955918838656, 1E-3),
+		     NULL);
+	zassert_true(val_is_equal(coef.correlation, 0.994583793576875, 1E-5),
+		     NULL);
+#else
+	zassert_true(val_is_equal(coef.slope, 61.2721865421074341, 1E-6), NULL);
+	zassert_true(val_is_equal(coef.intercept, -39.061955918838656, 1E-6),
+		     NULL);
+	zassert_true(val_is_equal(coef.correlation, 0.994583793576875, 1E-6),
+		     NULL);
+#endif
+
+	rc = zsl_sta_acc_xy_covar(&acc, &c);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(c, 0.7995728571428571, 1E-5), NULL);
+
+	/* A constant y gives a horizontal line with no correlation. */
+	zsl_sta_acc_xy_reset(&acc);
+	for (size_t i = 0; i < 15; i++) {
+		zsl_sta_acc_xy_push(&acc, a[i], 2.5);
+	}
+	rc = zsl_sta_acc_xy_linear_reg(&acc, &coef);
+	zassert_true(rc == 0, NULL);
+	zassert_true(val_is_equal(coef.slope, 0.0, 1E-6), NULL);
+	zassert_true(val_is_equal(coef.intercept, 2.5, 1E-6), NULL);
+	zassert_true(coef.correlation == 0.0, NULL);
+}
+
+ZTEST(zsl_tests, test_sta_qsketch)
+{
+	int rc;
+	zsl_real_t val, ref, lo, hi;
+	uint32_t seed = 0x9E3779B9;
+	static struct zsl_sta_qsketch sk, sk2;
+	static zsl_real_t data[1000];
+
+	struct zsl_vec v = { .sz = 10, .data = data };
+
+	zsl_real_t a[10] = { -3.0, 1.0, 2.0, 8.5, -3.5, 4.0, 7.0, -2.0, 0.0, 6.0 };
+
+	/* An empty sketch has no percentiles. */
+	zsl_sta_qsketch_reset(&sk);
+	rc = zsl_sta_qsketch_percentile(&sk, 50, &val);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* With fewer than ZSL_STA_QSKETCH_K values the sketch is exact. */
+	for (size_t i = 0; i < 10; i++) {
+		data[i] = a[i];
+		zsl_sta_qsketch_insert(&sk, a[i]);
+	}
+	for (zsl_real_t p = 0.0; p <= 100.0; p += 2.5) {
+		rc = zsl_sta_qsketch_percentile(&sk, p, &val);
+		zassert_true(rc == 0, NULL);
+		rc = zsl_sta_percentile(&v, p, &ref);
+		zassert_true(rc == 0, NULL);
+		zassert_true(val_is_equal(val, ref, 1E-6), NULL);
+	}
+
+	rc = zsl_sta_qsketch_percentile(&sk, 103, &val);
+	zassert_true(rc == -EINVAL, NULL);
+
+	/* Split 1000 pseudo-random values between two sketches and merge
+	 * them. The estimates must stay within 5% of n in rank. */
+	zsl_sta_qsketch_reset(&sk);
+	zsl_sta_qsketch_reset(&sk2);
+	v.sz = 1000;
+	for (size_t i = 0; i < v.sz; i++) {
+		seed = seed * 1664525U + 1013904223U;
+		data[i] = (zsl_real_t)(seed >> 8) / (zsl_real_t)(1U << 24);
+		zsl_sta_qsketch_insert(i < 600 ? &sk : &sk2, data[i]);
+	}
+	rc = zsl_sta_qsketch_merge(&sk, &sk2);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(sk.n, 1000, NULL);
+
+	for (zsl_real_t p = 5.0; p <= 95.0; p += 5.0) {
+		rc = zsl_sta_qsketch_percentile(&sk, p, &val);
+		zassert_true(rc == 0, NULL);
+		zsl_sta_percentile(&v, p - 5.0, &lo);
+		zsl_sta_percentile(&v, p + 5.0, &hi);
+		zassert_true(val >= lo && val <= hi, NULL);
+	}
+
+	/* A stream long enough for the sketch to sample its input. */
+	zsl_sta_qsketch_reset(&sk);
+	for (size_t i = 0; i < 100000; i++) {
+		seed = seed * 1664525U + 1013904223U;
+		zsl_sta_qsketch_insert(&sk, (zsl_real_t)(seed >> 8) /
+					    (zsl_real_t)(1U << 24));
+	}
+	for (zsl_real_t p = 10.0; p <= 90.0; p += 10.0) {
+		rc = zsl_sta_qsketch_percentile(&sk, p, &val);
+		zassert_true(rc == 0, NULL);
+		zassert_true(val_is_equal(val, p / 100.0, 0.05), NULL);
+	}
+}
@@ -916,3 +916,88 @@ ZTEST(zsl_tests, test_vector_sort)
 	zassert_equal(wp.data[3], ws.data[3], NULL);
 	zassert_equal(wp.data[4], ws.data[4], NULL);
 }
+
+ZTEST(zsl_tests, test_vector_sort_large)
+{
+	int rc;
+	uint32_t seed = 12345;
+	zsl_real_t sum, sum2;
+
+	ZSL_VECTOR_DEF(v, 500);
+	ZSL_VECTOR_DEF(w, 500);
+
+	/* Pseudo-random values with many repeats, to exercise partitioning. */
+	sum = 0.0;
+	for (size_t i = 0; i < v.sz; i++) {
+		seed = seed * 1103515245U + 12345U;
+		v.data[i] = (zsl_real_t)((seed >> 16) % 64U) - 32.0;
+		sum += v.data[i];
+	}
+
+	rc = zsl_vec_sort(&v, &w);
+	zassert_true(rc == 0, NULL);
+	sum2 = w.data[0];
+	for (size_t i = 1; i < w.sz; i++) {
+		zassert_true(w.data[i - 1] <= w.data[i], NULL);
+		sum2 += w.data[i];
+	}
+	zassert_equal(sum, sum2, NULL);
+
+	/* Reverse-sorted input, sorted in place. */
+	for (size_t i = 0; i < v.sz; i++) {
+		v.data[i] = (zsl_real_t)(v.sz - i);
+	}
+	rc = zsl_vec_sort(&v, &v);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < v.sz; i++) {
+		zassert_equal(v.data[i], (zsl_real_t)(i + 1), NULL);
+	}
+
+	/* Constant input. */
+	for (size_t i = 0; i < v.sz; i++) {
+		v.data[i] = 2.5;
+	}
+	rc = zsl_vec_sort(&v, &w);
+	zassert_true(rc == 0, NULL);
+	for (size_t i = 0; i < w.sz; i++) {
+		zassert_equal(w.data[i], 2.5, NULL);
+	}
+}
+
+ZTEST(zsl_tests, test_vector_select)
+{
+	int rc;
+	size_t k[3] = { 0, 4, 8 };
+	size_t kbad[2] = { 4, 2 };
+	zsl_real_t val[3];
+
+	ZSL_VECTOR_DEF(v, 9);
+
+	zsl_real_t a[9] = { 3.0, -1.0, 4.5, 4.5, 0.0, -7.0, 2.0, 9.0, 1.0 };
+
+	rc = zsl_vec_from_arr(&v, a);
+	zassert_true(rc == 0, NULL);
+
+	/* Minimum, median and maximum in a single call. */
+	rc = zsl_vec_select(&v, k, 3, val);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(val[0], -7.0, NULL);
+	zassert_equal(val[1], 2.0, NULL);
+	zassert_equal(val[2], 9.0, NULL);
+	zassert_equal(v.data[4], 2.0, NULL);
+
+	/* Repeated values. */
+	k[0] = 6;
+	k[1] = 7;
+	rc = zsl_vec_select(&v, k, 2, val);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(val[0], 4.5, NULL);
+	zassert_equal(val[1], 4.5, NULL);
+
+	/* Ranks that are out of order or out of range are rejected. */
+	rc = zsl_vec_select(&v, kbad, 2, val);
+	zassert_true(rc == -EINVAL, NULL);
+	k[0] = 9;
+	rc = zsl_vec_select(&v, k, 1, val);
+	zassert_true(rc == -EINVAL, NULL);
+}